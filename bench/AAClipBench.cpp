@@ -82,6 +82,68 @@ private:
     typedef Benchmark INHERITED;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// This bench clips to the same complex path again and again, across save/restore and tiles
+// offset by whole pixels, as when a picture is played back tile by tile.  Or, if fresh, to a
+// new copy of the path each time, which no cache can help with and mustn't slow down.
+class AAClipRepeatBench : public Benchmark {
+    SkString fName;
+    SkPath   fClipPath;
+    SkRect   fDrawRect;
+    bool     fDoAA;
+    bool     fFresh;
+
+    static const int kTileSize = 64;
+    static const int kTiles = 4;
+
+public:
+    AAClipRepeatBench(bool doAA, bool fresh) : fDoAA(doAA), fFresh(fresh) {
+        fName.printf("aaclip_%s_%s", fresh ? "fresh" : "repeat", doAA ? "AA" : "BW");
+
+        // a star with curved points, far from a rect, round rect or oval
+        const int kPoints = 24;
+        for (int i = 0; i <= kPoints; ++i) {
+            const SkScalar angle = i * 2 * SK_ScalarPI / kPoints;
+            const SkPoint inner = SkPoint::Make(150 + 60 * SkScalarCos(angle),
+                                                150 + 60 * SkScalarSin(angle));
+            const SkPoint outer = SkPoint::Make(150 + 140 * SkScalarCos(angle + 0.1f),
+                                                150 + 140 * SkScalarSin(angle + 0.1f));
+            if (0 == i) {
+                fClipPath.moveTo(inner);
+            } else {
+                fClipPath.quadTo(outer, inner);
+            }
+        }
+        fClipPath.close();
+        fDrawRect.set(0, 0, SkIntToScalar(kTileSize * kTiles), SkIntToScalar(kTileSize * kTiles));
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        this->setupPaint(&paint);
+
+        for (int i = 0; i < loops; ++i) {
+            const int tile = i % (kTiles * kTiles);
+            canvas->save();
+            canvas->translate(-SkIntToScalar(tile % kTiles * kTileSize),
+                              -SkIntToScalar(tile / kTiles * kTileSize));
+            if (fFresh) {
+                SkPath path;
+                path.addPath(fClipPath);
+                canvas->clipPath(path, SkRegion::kIntersect_Op, fDoAA);
+            } else {
+                canvas->clipPath(fClipPath, SkRegion::kIntersect_Op, fDoAA);
+            }
+            canvas->drawRect(fDrawRect, paint);
+            canvas->restore();
+        }
+    }
+private:
+    typedef Benchmark INHERITED;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // This bench tests out nested clip stacks. It is intended to simulate
 // how WebKit nests clips.
@@ -212,6 +274,44 @@ private:
     typedef Benchmark INHERITED;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// This bench intersects two aaclips whose rows are busy with short runs.
+class AAClipIntersectBench : public Benchmark {
+    SkAAClip fClipA;
+    SkAAClip fClipB;
+
+public:
+    AAClipIntersectBench() {
+        SkPath stripes, spokes;
+        for (int i = 0; i < 160; ++i) {
+            stripes.addRect(SkRect::MakeXYWH(i * 2.75f, 0, 1.25f, 400));
+        }
+        for (int i = 0; i < 120; ++i) {
+            const SkScalar angle = i * SK_ScalarPI / 60;
+            spokes.moveTo(220, 200);
+            spokes.lineTo(220 + 300 * SkScalarCos(angle), 200 + 300 * SkScalarSin(angle));
+            spokes.lineTo(220 + 300 * SkScalarCos(angle + 0.02f),
+                          200 + 300 * SkScalarSin(angle + 0.02f));
+            spokes.close();
+        }
+        const SkRegion bounds(SkIRect::MakeWH(440, 400));
+        fClipA.setPath(stripes, &bounds);
+        fClipB.setPath(spokes, &bounds);
+    }
+
+protected:
+    const char* onGetName() override { return "aaclip_intersect_busy"; }
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkAAClip clip;
+            clip.op(fClipA, fClipB, SkRegion::kIntersect_Op);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 class AAClipRegionBench : public Benchmark {
 public:
@@ -249,9 +349,14 @@ DEF_BENCH(return new AAClipBuilderBench(false, true);)
 DEF_BENCH(return new AAClipBuilderBench(true, false);)
 DEF_BENCH(return new AAClipBuilderBench(true, true);)
 DEF_BENCH(return new AAClipRegionBench();)
+DEF_BENCH(return new AAClipIntersectBench();)
 DEF_BENCH(return new AAClipBench(false, false);)
 DEF_BENCH(return new AAClipBench(false, true);)
 DEF_BENCH(return new AAClipBench(true, false);)
 DEF_BENCH(return new AAClipBench(true, true);)
+DEF_BENCH(return new AAClipRepeatBench(false, false);)
+DEF_BENCH(return new AAClipRepeatBench(true, false);)
+DEF_BENCH(return new AAClipRepeatBench(false, true);)
+DEF_BENCH(return new AAClipRepeatBench(true, true);)
 DEF_BENCH(return new NestedAAClipBench(false);)
 DEF_BENCH(return new NestedAAClipBench(true);)
@@ -8,6 +8,7 @@
 #include "Benchmark.h"
 #include "SkCanvas.h"
 #include "SkPath.h"
+#include "SkScan.h"
 #include "sk_tool_utils.h"
 
 enum Align {
@@ -24,13 +25,18 @@ class BigPathBench : public Benchmark {
     SkString    fName;
     Align       fAlign;
     bool        fRound;
+    bool        fAnalytic;
 
 public:
-    BigPathBench(Align align, bool round) : fAlign(align), fRound(round) {
+    BigPathBench(Align align, bool round, bool analytic = false)
+        : fAlign(align), fRound(round), fAnalytic(analytic) {
         fName.printf("bigpath_%s", gAlignName[fAlign]);
         if (round) {
             fName.append("_round");
         }
+        if (analytic) {
+            fName.append("_analytic");
+        }
     }
 
 protected:
@@ -68,9 +74,12 @@ protected:
                 break;
         }
 
+        const bool forceAnalytic = gSkForceAnalyticAA;
+        gSkForceAnalyticAA = forceAnalytic || fAnalytic;
         for (int i = 0; i < loops; i++) {
             canvas->drawPath(fPath, paint);
         }
+        gSkForceAnalyticAA = forceAnalytic;
     }
 
 private:
@@ -84,3 +93,11 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+DEF_BENCH( return new BigPathBench(kLeft_Align,     false, true); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align,   false, true); )
+DEF_BENCH( return new BigPathBench(kRight_Align,    false, true); )
+
+DEF_BENCH( return new BigPathBench(kLeft_Align,     true,  true); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align,   true,  true); )
+DEF_BENCH( return new BigPathBench(kRight_Align,    true,  true); )
@@ -118,11 +118,21 @@ DEF_BENCH(return new BitmapFilterScaleBench(64, 256);)
 class PixmapScalerBench: public Benchmark {
     SkBitmapScaler::ResizeMethod    fMethod;
     SkString                        fName;
+    SkISize                         fSrcSize, fDstSize;
+    int                             fResizesPerLoop;
     SkBitmap                        fSrc, fDst;
 
 public:
-    PixmapScalerBench(SkBitmapScaler::ResizeMethod method, const char suffix[]) : fMethod(method) {
-        fName.printf("pixmapscaler_%s", suffix);
+    PixmapScalerBench(SkBitmapScaler::ResizeMethod method, const char suffix[])
+        : PixmapScalerBench(method, suffix, SkISize::Make(640, 480), SkISize::Make(300, 250), 16)
+    {}
+
+    // Larger resizes are named for their sizes, and run once per loop.
+    PixmapScalerBench(SkBitmapScaler::ResizeMethod method, const char suffix[],
+                      SkISize srcSize, SkISize dstSize)
+        : PixmapScalerBench(method, suffix, srcSize, dstSize, 1) {
+        fName.appendf("_%dx%d_%dx%d", srcSize.width(), srcSize.height(),
+                      dstSize.width(), dstSize.height());
     }
 
 protected:
@@ -137,21 +147,30 @@ protected:
     }
 
     void onDelayedSetup() override {
-        fSrc.allocN32Pixels(640, 480);
+        fSrc.allocN32Pixels(fSrcSize.width(), fSrcSize.height());
         fSrc.eraseColor(SK_ColorWHITE);
-        fDst.allocN32Pixels(300, 250);
+        fDst.allocN32Pixels(fDstSize.width(), fDstSize.height());
     }
 
     void onDraw(int loops, SkCanvas*) override {
         SkPixmap src, dst;
         fSrc.peekPixels(&src);
         fDst.peekPixels(&dst);
-        for (int i = 0; i < loops * 16; i++) {
+        for (int i = 0; i < loops * fResizesPerLoop; i++) {
             SkBitmapScaler::Resize(dst, src, fMethod);
         }
     }
 
 private:
+    PixmapScalerBench(SkBitmapScaler::ResizeMethod method, const char suffix[],
+                      SkISize srcSize, SkISize dstSize, int resizesPerLoop)
+        : fMethod(method)
+        , fSrcSize(srcSize)
+        , fDstSize(dstSize)
+        , fResizesPerLoop(resizesPerLoop) {
+        fName.printf("pixmapscaler_%s", suffix);
+    }
+
     typedef Benchmark INHERITED;
 };
 DEF_BENCH( return new PixmapScalerBench(SkBitmapScaler::RESIZE_LANCZOS3, "lanczos");  )
@@ -159,3 +178,13 @@ DEF_BENCH( return new PixmapScalerBench(SkBitmapScaler::RESIZE_MITCHELL, "mitche
 DEF_BENCH( return new PixmapScalerBench(SkBitmapScaler::RESIZE_HAMMING,  "hamming");  )
 DEF_BENCH( return new PixmapScalerBench(SkBitmapScaler::RESIZE_TRIANGLE, "triangle"); )
 DEF_BENCH( return new PixmapScalerBench(SkBitmapScaler::RESIZE_BOX,      "box");      )
+
+// A 4k texture down to a thumbnail, and a 24 megapixel photo down to 1080p.
+DEF_BENCH( return new PixmapScalerBench(SkBitmapScaler::RESIZE_LANCZOS3, "lanczos",
+                                        SkISize::Make(4096, 4096), SkISize::Make(256, 256)); )
+DEF_BENCH( return new PixmapScalerBench(SkBitmapScaler::RESIZE_MITCHELL, "mitchell",
+                                        SkISize::Make(4096, 4096), SkISize::Make(256, 256)); )
+DEF_BENCH( return new PixmapScalerBench(SkBitmapScaler::RESIZE_LANCZOS3, "lanczos",
+                                        SkISize::Make(6000, 4000), SkISize::Make(1920, 1080)); )
+DEF_BENCH( return new PixmapScalerBench(SkBitmapScaler::RESIZE_MITCHELL, "mitchell",
+                                        SkISize::Make(6000, 4000), SkISize::Make(1920, 1080)); )
@@ -6,6 +6,7 @@
  */
 
 #include "Benchmark.h"
+#include "OptsTierBench.h"
 #include "SkBlurImageFilter.h"
 #include "SkOffsetImageFilter.h"
 #include "SkCanvas.h"
@@ -162,3 +163,20 @@ DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, tr
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, false, true, true);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, true, true, true);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, false, true, true);)
+
+// These blur with SkOpts::box_blur_*; compare each CPU tier's version.
+DEF_OPTS_TIER_BENCHES(return new BlurImageFilterBench(BLUR_SIGMA_SMALL, BLUR_SIGMA_SMALL,
+                                                      false, false, false))
+DEF_OPTS_TIER_BENCHES(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE,
+                                                      false, false, false))
+
+// Sweep sigma across the switch from box blurs to the recursive Gaussian.
+DEF_BENCH(return new BlurImageFilterBench(2, 2, false, false, false);)
+DEF_BENCH(return new BlurImageFilterBench(4, 4, false, false, false);)
+DEF_BENCH(return new BlurImageFilterBench(8, 8, false, false, false);)
+DEF_BENCH(return new BlurImageFilterBench(16, 16, false, false, false);)
+DEF_BENCH(return new BlurImageFilterBench(32, 32, false, false, false);)
+DEF_BENCH(return new BlurImageFilterBench(64, 64, false, false, false);)
+DEF_BENCH(return new BlurImageFilterBench(128, 128, false, false, false);)
+DEF_BENCH(return new BlurImageFilterBench(200, 200, false, false, false);)
+DEF_BENCH(return new BlurImageFilterBench(200, 0, false, false, false);)
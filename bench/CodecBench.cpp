@@ -16,14 +16,18 @@
 DEFINE_bool(zero_init, false, "Pretend our destination is zero-intialized, simulating Android?");
 
 CodecBench::CodecBench(SkString baseName, SkData* encoded, SkColorType colorType,
-        SkAlphaType alphaType)
+        SkAlphaType alphaType, int maxThreads)
     : fColorType(colorType)
     , fAlphaType(alphaType)
+    , fMaxThreads(maxThreads)
     , fData(SkRef(encoded))
 {
     // Parse filename and the color type to give the benchmark a useful name
     fName.printf("Codec_%s_%s%s", baseName.c_str(), color_type_to_str(colorType),
             alpha_type_to_str(alphaType));
+    if (maxThreads) {
+        fName.appendf("_threads%d", maxThreads);
+    }
 #ifdef SK_DEBUG
     // Ensure that we can create an SkCodec from this data.
     SkAutoTDelete<SkCodec> codec(SkCodec::NewFromData(fData));
@@ -55,6 +59,9 @@ void CodecBench::onDraw(int n, SkCanvas* canvas) {
     if (FLAGS_zero_init) {
         options.fZeroInitialized = SkCodec::kYes_ZeroInitialized;
     }
+    if (fMaxThreads) {
+        options.fMaxThreads = fMaxThreads;
+    }
     for (int i = 0; i < n; i++) {
         colorCount = 256;
         codec.reset(SkCodec::NewFromData(fData));
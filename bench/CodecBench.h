@@ -20,7 +20,10 @@
 class CodecBench : public Benchmark {
 public:
     // Calls encoded->ref()
-    CodecBench(SkString basename, SkData* encoded, SkColorType colorType, SkAlphaType alphaType);
+    // If maxThreads is not 0, decodes with SkCodec::Options::fMaxThreads set to it, and names
+    // the bench for it.
+    CodecBench(SkString basename, SkData* encoded, SkColorType colorType, SkAlphaType alphaType,
+               int maxThreads = 0);
 
 protected:
     const char* onGetName() override;
@@ -32,6 +35,7 @@ private:
     SkString                fName;
     const SkColorType       fColorType;
     const SkAlphaType       fAlphaType;
+    const int               fMaxThreads;
     SkAutoTUnref<SkData>    fData;
     SkImageInfo             fInfo;          // Set in onDelayedSetup.
     SkAutoMalloc            fPixelStorage;
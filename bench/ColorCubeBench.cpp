@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 #include "Benchmark.h"
+#include "OptsTierBench.h"
 #include "SkCanvas.h"
 #include "SkColorCubeFilter.h"
 #include "SkGradientShader.h"
@@ -100,3 +101,6 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new ColorCubeBench(); )
+
+// This filters with SkOpts::color_cube_filter_span; compare each CPU tier's version.
+DEF_OPTS_TIER_BENCHES(return new ColorCubeBench())
@@ -9,7 +9,7 @@
 #include "SkCanvas.h"
 #include "SkColorPriv.h"
 #include "SkGradientShader.h"
-#include "SkLinearGradient.h"
+#include "SkGradientShaderPriv.h"
 #include "SkPaint.h"
 #include "SkShader.h"
 #include "SkString.h"
@@ -32,6 +32,9 @@ static const SkColor gColors[] = {
     SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorWHITE, SK_ColorBLACK,
     SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorWHITE, SK_ColorBLACK,
     SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorWHITE, SK_ColorBLACK, // 10 lines, 50 colors
+    SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorWHITE, SK_ColorBLACK,
+    SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorWHITE, SK_ColorBLACK,
+    SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorWHITE, SK_ColorBLACK, // 13 lines, 65 colors
 };
 
 static const SkColor gShallowColors[] = { 0xFF555555, 0xFF444444 };
@@ -43,14 +46,20 @@ static const GradData gGradData[] = {
     { 50, gColors, nullptr, "_hicolor" }, // many color gradient
     { 3, gColors, nullptr, "_3color" },
     { 2, gShallowColors, nullptr, "_shallow" },
+    { 8, gColors, nullptr, "_8color" },
+    { 16, gColors, nullptr, "_16color" },
+    { 64, gColors, nullptr, "_64color" },
 };
 
+static uint32_t grad_flags(bool force4f) {
+    return force4f ? SkGradientShaderBase::kForce4fContext_PrivateFlag : 0;
+}
+
 /// Ignores scale
 static sk_sp<SkShader> MakeLinear(const SkPoint pts[2], const GradData& data,
                                   SkShader::TileMode tm, float scale, bool force4f) {
-    const uint32_t flags = force4f ? SkLinearGradient::kForce4fContext_PrivateFlag : 0;
     return SkGradientShader::MakeLinear(pts, data.fColors, data.fPos,
-                                        data.fCount, tm, flags, nullptr);
+                                        data.fCount, tm, grad_flags(force4f), nullptr);
 }
 
 static sk_sp<SkShader> MakeRadial(const SkPoint pts[2], const GradData& data,
@@ -59,7 +68,7 @@ static sk_sp<SkShader> MakeRadial(const SkPoint pts[2], const GradData& data,
     center.set(SkScalarAve(pts[0].fX, pts[1].fX),
                SkScalarAve(pts[0].fY, pts[1].fY));
     return SkGradientShader::MakeRadial(center, center.fX * scale, data.fColors,
-                                        data.fPos, data.fCount, tm);
+                                        data.fPos, data.fCount, tm, grad_flags(force4f), nullptr);
 }
 
 /// Ignores scale
@@ -68,7 +77,8 @@ static sk_sp<SkShader> MakeSweep(const SkPoint pts[2], const GradData& data,
     SkPoint center;
     center.set(SkScalarAve(pts[0].fX, pts[1].fX),
                SkScalarAve(pts[0].fY, pts[1].fY));
-    return SkGradientShader::MakeSweep(center.fX, center.fY, data.fColors, data.fPos, data.fCount);
+    return SkGradientShader::MakeSweep(center.fX, center.fY, data.fColors, data.fPos, data.fCount,
+                                       grad_flags(force4f), nullptr);
 }
 
 /// Ignores scale
@@ -81,7 +91,8 @@ static sk_sp<SkShader> MakeConical(const SkPoint pts[2], const GradData& data,
                 SkScalarInterp(pts[0].fY, pts[1].fY, SkIntToScalar(1)/4));
     return SkGradientShader::MakeTwoPointConical(center1, (pts[1].fX - pts[0].fX) / 7,
                                                  center0, (pts[1].fX - pts[0].fX) / 2,
-                                                 data.fColors, data.fPos, data.fCount, tm);
+                                                 data.fColors, data.fPos, data.fCount, tm,
+                                                 grad_flags(force4f), nullptr);
 }
 
 /// Ignores scale
@@ -94,7 +105,8 @@ static sk_sp<SkShader> MakeConicalZeroRad(const SkPoint pts[2], const GradData&
                 SkScalarInterp(pts[0].fY, pts[1].fY, SkIntToScalar(1)/4));
     return SkGradientShader::MakeTwoPointConical(center1, 0.0,
                                                  center0, (pts[1].fX - pts[0].fX) / 2,
-                                                 data.fColors, data.fPos, data.fCount, tm);
+                                                 data.fColors, data.fPos, data.fCount, tm,
+                                                 grad_flags(force4f), nullptr);
 }
 
 /// Ignores scale
@@ -108,7 +120,7 @@ static sk_sp<SkShader> MakeConicalOutside(const SkPoint pts[2], const GradData&
     return SkGradientShader::MakeTwoPointConical(center0, radius0,
                                                  center1, radius1,
                                                  data.fColors, data.fPos,
-                                                 data.fCount, tm);
+                                                 data.fCount, tm, grad_flags(force4f), nullptr);
 }
 
 /// Ignores scale
@@ -122,7 +134,7 @@ static sk_sp<SkShader> MakeConicalOutsideZeroRad(const SkPoint pts[2], const Gra
     return SkGradientShader::MakeTwoPointConical(center0, 0.0,
                                                  center1, radius1,
                                                  data.fColors, data.fPos,
-                                                 data.fCount, tm);
+                                                 data.fCount, tm, grad_flags(force4f), nullptr);
 }
 
 typedef sk_sp<SkShader> (*GradMaker)(const SkPoint pts[2], const GradData& data,
@@ -294,6 +306,28 @@ DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[1], SkShader::kM
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[2], SkShader::kMirror_TileMode,
                                     kRect_GeomType, 1, true); )
 
+// 4f, by stop count
+#define DEF_4F_STOPS_BENCHES(type)                                                          \
+    DEF_BENCH( return new GradientBench(type, gGradData[0], SkShader::kClamp_TileMode,      \
+                                        kRect_GeomType, 1, true); )                         \
+    DEF_BENCH( return new GradientBench(type, gGradData[2], SkShader::kClamp_TileMode,      \
+                                        kRect_GeomType, 1, true); )                         \
+    DEF_BENCH( return new GradientBench(type, gGradData[4], SkShader::kClamp_TileMode,      \
+                                        kRect_GeomType, 1, true); )                         \
+    DEF_BENCH( return new GradientBench(type, gGradData[5], SkShader::kClamp_TileMode,      \
+                                        kRect_GeomType, 1, true); )                         \
+    DEF_BENCH( return new GradientBench(type, gGradData[6], SkShader::kClamp_TileMode,      \
+                                        kRect_GeomType, 1, true); )
+
+DEF_4F_STOPS_BENCHES(kRadial_GradType)
+DEF_4F_STOPS_BENCHES(kSweep_GradType)
+DEF_4F_STOPS_BENCHES(kConical_GradType)
+DEF_4F_STOPS_BENCHES(kConicalOut_GradType)
+DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[6], SkShader::kRepeat_TileMode,
+                                    kRect_GeomType, 1, true); )
+DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[6], SkShader::kMirror_TileMode,
+                                    kRect_GeomType, 1, true); )
+
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[0]); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[1]); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[2]); )
@@ -317,12 +351,15 @@ DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[0], SkShader::kC
 
 DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[0], SkShader::kMirror_TileMode); )
 DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[0], SkShader::kRepeat_TileMode); )
+DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[6]); )
 DEF_BENCH( return new GradientBench(kSweep_GradType); )
 DEF_BENCH( return new GradientBench(kSweep_GradType, gGradData[1]); )
 DEF_BENCH( return new GradientBench(kSweep_GradType, gGradData[2]); )
+DEF_BENCH( return new GradientBench(kSweep_GradType, gGradData[6]); )
 DEF_BENCH( return new GradientBench(kConical_GradType); )
 DEF_BENCH( return new GradientBench(kConical_GradType, gGradData[1]); )
 DEF_BENCH( return new GradientBench(kConical_GradType, gGradData[2]); )
+DEF_BENCH( return new GradientBench(kConical_GradType, gGradData[6]); )
 DEF_BENCH( return new GradientBench(kConicalZero_GradType); )
 DEF_BENCH( return new GradientBench(kConicalZero_GradType, gGradData[1]); )
 DEF_BENCH( return new GradientBench(kConicalZero_GradType, gGradData[2]); )
@@ -7,6 +7,8 @@
 
 #include "Benchmark.h"
 #include "SkResourceCache.h"
+#include "SkString.h"
+#include "SkTaskGroup.h"
 
 namespace {
 static void* gGlobalAddress;
@@ -72,6 +74,54 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Finds Recs in the global cache from several threads at once, to see how the static
+// API scales as threads contend for it.  Each thread looks up its own run of keys, so
+// with enough shards they should rarely need the same lock.
+class ImageCacheMTBench : public Benchmark {
+    enum {
+        CACHE_COUNT = 500
+    };
+public:
+    ImageCacheMTBench(int threads) : fThreads(threads) {
+        fName.printf("imagecache_mt_%d", threads);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onPreDraw(SkCanvas*) override {
+        // Other benches may have pushed our Recs out, so make sure they're all there.
+        // Adding a Key that's already in the cache just deletes the new Rec.
+        for (int i = 0; i < CACHE_COUNT; ++i) {
+            SkResourceCache::Add(new TestRec(TestKey(i), i));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup().batch(fThreads, [&](int thread) {
+            for (int i = 0; i < loops; ++i) {
+                TestKey key((thread * CACHE_COUNT / fThreads + i) % CACHE_COUNT);
+                SkResourceCache::Find(key, TestRec::Visitor, nullptr);
+            }
+        });
+    }
+
+private:
+    int      fThreads;
+    SkString fName;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new ImageCacheBench(); )
+DEF_BENCH( return new ImageCacheMTBench(1); )
+DEF_BENCH( return new ImageCacheMTBench(4); )
+DEF_BENCH( return new ImageCacheMTBench(16); )
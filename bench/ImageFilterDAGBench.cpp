@@ -9,7 +9,13 @@
 #include "SkBlurImageFilter.h"
 #include "SkDisplacementMapEffect.h"
 #include "SkCanvas.h"
+#include "SkDropShadowImageFilter.h"
+#include "SkLightingImageFilter.h"
 #include "SkMergeImageFilter.h"
+#include "SkMorphologyImageFilter.h"
+#include "SkPoint3.h"
+#include "SkSpecialImage.h"
+#include "SkXfermodeImageFilter.h"
 
 
 // Exercise a blur filter connected to 5 inputs of the same merge filter.
@@ -76,5 +82,75 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Filter a large raster image through a DAG of blurs, a drop shadow, a dilate and a lighting
+// filter, letting filterImage() use up to "threads" threads.  Everything but the lighting filter
+// can be filtered in bands, and the merge's branches can run in parallel, so comparing each run
+// to its threads1 run gives the speedup.
+class ImageFilterThreadsBench : public Benchmark {
+public:
+    ImageFilterThreadsBench(int threads) : fThreads(threads) {
+        fName.printf("image_filter_dag_threads%d", threads);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return kNonRendering_Backend == backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(kSize, kSize);
+        SkCanvas canvas(bitmap);
+        canvas.clear(SK_ColorTRANSPARENT);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < 16; ++i) {
+            paint.setColor(0xFF000000 | (0x123456 * (i + 1)));
+            canvas.drawCircle(SkIntToScalar(64 + 60 * i), SkIntToScalar(64 + 57 * i), 80, paint);
+        }
+        fSource = SkSpecialImage::MakeFromRaster(nullptr, SkIRect::MakeWH(kSize, kSize), bitmap);
+
+        sk_sp<SkImageFilter> blur(SkBlurImageFilter::Make(8, 8, nullptr));
+        sk_sp<SkImageFilter> shadow(SkDropShadowImageFilter::Make(
+                10, 10, 6, 6, SK_ColorBLACK,
+                SkDropShadowImageFilter::kDrawShadowAndForeground_ShadowMode, blur));
+        sk_sp<SkImageFilter> glow(SkXfermodeImageFilter::Make(
+                SkXfermode::Make(SkXfermode::kScreen_Mode),
+                SkDilateImageFilter::Make(4, 4, nullptr), SkBlurImageFilter::Make(12, 12, nullptr),
+                nullptr));
+        sk_sp<SkImageFilter> lit(SkLightingImageFilter::MakeDistantLitDiffuse(
+                SkPoint3::Make(1, 1, 1), SK_ColorWHITE, 2, 1, blur));
+        sk_sp<SkImageFilter> inputs[] = { shadow, glow, lit };
+        fFilter = SkMergeImageFilter::Make(inputs, SK_ARRAY_COUNT(inputs));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeWH(kSize, kSize), nullptr,
+                                   fThreads);
+        for (int i = 0; i < loops; ++i) {
+            SkIPoint offset;
+            sk_sp<SkSpecialImage> result(fFilter->filterImage(fSource.get(), ctx, &offset));
+        }
+    }
+
+private:
+    static const int kSize = 1024;
+
+    int                   fThreads;
+    SkString              fName;
+    sk_sp<SkSpecialImage> fSource;
+    sk_sp<SkImageFilter>  fFilter;
+
+    typedef Benchmark INHERITED;
+};
+
 DEF_BENCH(return new ImageFilterDAGBench;)
 DEF_BENCH(return new ImageFilterDisplacedBlur;)
+DEF_BENCH(return new ImageFilterThreadsBench(1);)
+DEF_BENCH(return new ImageFilterThreadsBench(2);)
+DEF_BENCH(return new ImageFilterThreadsBench(4);)
+DEF_BENCH(return new ImageFilterThreadsBench(8);)
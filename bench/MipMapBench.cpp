@@ -13,10 +13,16 @@ class MipMapBench: public Benchmark {
     SkBitmap fBitmap;
     SkString fName;
     const int fW, fH;
+    const int fLoopScale;
+    const bool fLazy;
 
 public:
-    MipMapBench(int w, int h) : fW(w), fH(h) {
-        fName.printf("mipmap_build_%dx%d", w, h);
+    MipMapBench(int w, int h) : MipMapBench(w, h, 4, false) {}
+
+    // Builds lazily and extracts the first level only, as drawing just a little smaller would.
+    MipMapBench(int w, int h, int loopScale, bool lazy)
+        : fW(w), fH(h), fLoopScale(loopScale), fLazy(lazy) {
+        fName.printf("mipmap_build_%s%dx%d", lazy ? "lazy_" : "", w, h);
     }
 
 protected:
@@ -32,8 +38,13 @@ protected:
     }
 
     void onDraw(int loops, SkCanvas*) override {
-        for (int i = 0; i < loops * 4; i++) {
-            SkMipMap::Build(fBitmap, nullptr)->unref();
+        for (int i = 0; i < loops * fLoopScale; i++) {
+            SkMipMap* mipmap = SkMipMap::Build(fBitmap, nullptr, fLazy);
+            if (fLazy) {
+                SkMipMap::Level level;
+                mipmap->extractLevel(SkSize::Make(0.75f, 0.75f), &level);
+            }
+            mipmap->unref();
         }
     }
 
@@ -48,3 +59,8 @@ DEF_BENCH( return new MipMapBench(511, 511); )
 DEF_BENCH( return new MipMapBench(512, 511); )
 DEF_BENCH( return new MipMapBench(511, 512); )
 DEF_BENCH( return new MipMapBench(512, 512); )
+
+// Large images, built whole and lazily.
+DEF_BENCH( return new MipMapBench(4096, 4096, 1, false); )
+DEF_BENCH( return new MipMapBench(4095, 4095, 1, false); )
+DEF_BENCH( return new MipMapBench(4096, 4096, 1, true); )
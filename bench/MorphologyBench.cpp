@@ -6,6 +6,7 @@
  */
 
 #include "Benchmark.h"
+#include "OptsTierBench.h"
 #include "SkCanvas.h"
 #include "SkMorphologyImageFilter.h"
 #include "SkPaint.h"
@@ -96,3 +97,7 @@ DEF_BENCH( return new MorphologyBench(REAL, kErode_MT); )
 DEF_BENCH( return new MorphologyBench(REAL, kDilate_MT); )
 
 DEF_BENCH( return new MorphologyBench(0, kErode_MT); )
+
+// These filter with SkOpts::dilate_* and erode_*; compare each CPU tier's version.
+DEF_OPTS_TIER_BENCHES(return new MorphologyBench(BIG, kErode_MT))
+DEF_OPTS_TIER_BENCHES(return new MorphologyBench(BIG, kDilate_MT))
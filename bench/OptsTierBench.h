@@ -0,0 +1,81 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef OptsTierBench_DEFINED
+#define OptsTierBench_DEFINED
+
+#include "Benchmark.h"
+#include "SkOpts.h"
+#include "SkString.h"
+
+// Runs another Benchmark with SkOpts limited to a single tier of CPU-specific code,
+// so we can compare, e.g., the SSE4.1 and AVX2 versions of the same bench in one run.
+// Benches for tiers this CPU can't run are skipped.
+class OptsTierBench : public Benchmark {
+public:
+    OptsTierBench(Benchmark* bench, SkOpts::Tier tier) : fBench(bench), fTier(tier) {
+        static const char* kTierNames[] = {
+            "portable", "ssse3", "sse41", "avx2", "avx512", "neon",
+        };
+        static_assert(SK_ARRAY_COUNT(kTierNames) == SkOpts::kBest_Tier + 1, "");
+        fName.printf("%s_%s", fBench->getName(), kTierNames[tier]);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return SkOpts::SupportsTier(fTier) && fBench->isSuitableFor(backend);
+    }
+
+    int calculateLoops(int defaultLoops) const override {
+        return fBench->calculateLoops(defaultLoops);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    SkIPoint onGetSize() override { return fBench->getSize(); }
+
+    // Some benches capture SkOpts function pointers during setup, so we limit the tier there too.
+    void onDelayedSetup() override {
+        SkOpts::InitUpToTierForTesting(fTier);
+        fBench->delayedSetup();
+        SkOpts::InitUpToTierForTesting(SkOpts::kBest_Tier);
+    }
+
+    void onPerCanvasPreDraw(SkCanvas* canvas) override {
+        SkOpts::InitUpToTierForTesting(fTier);
+        fBench->perCanvasPreDraw(canvas);
+    }
+    void onPerCanvasPostDraw(SkCanvas* canvas) override {
+        fBench->perCanvasPostDraw(canvas);
+        SkOpts::InitUpToTierForTesting(SkOpts::kBest_Tier);
+    }
+
+    void onPreDraw(SkCanvas* canvas) override { fBench->preDraw(canvas); }
+    void onPostDraw(SkCanvas* canvas) override { fBench->postDraw(canvas); }
+
+    void onDraw(int loops, SkCanvas* canvas) override { fBench->draw(loops, canvas); }
+
+private:
+    SkAutoTUnref<Benchmark> fBench;
+    SkOpts::Tier            fTier;
+    SkString                fName;
+
+    typedef Benchmark INHERITED;
+};
+
+// Registers one OptsTierBench per SkOpts tier around the Benchmark made by code.
+#define DEF_OPTS_TIER_BENCH(code, tier) \
+    DEF_BENCH( return new OptsTierBench([]() -> Benchmark* { code; }(), SkOpts::tier); )
+
+#define DEF_OPTS_TIER_BENCHES(code)                \
+    DEF_OPTS_TIER_BENCH(code, kPortable_Tier)      \
+    DEF_OPTS_TIER_BENCH(code, kSSSE3_Tier)         \
+    DEF_OPTS_TIER_BENCH(code, kSSE41_Tier)         \
+    DEF_OPTS_TIER_BENCH(code, kAVX2_Tier)          \
+    DEF_OPTS_TIER_BENCH(code, kAVX512_Tier)        \
+    DEF_OPTS_TIER_BENCH(code, kNEON_Tier)
+
+#endif
@@ -8,6 +8,7 @@
 #include "Benchmark.h"
 #include "Resources.h"
 #include "SkAutoPixmapStorage.h"
+#include "SkCanvas.h"
 #include "SkData.h"
 #include "SkGradientShader.h"
 #include "SkImage.h"
@@ -207,6 +208,61 @@ struct WStreamWriteTextBenchmark : public Benchmark {
     }
 };
 
+// A long document: 500 pages of text, paths and an image of their own.
+// nanobench reports the peak RSS along with the time, which shows whether
+// pages are let go of as they are finished.
+struct PDFLongDocumentBench : public Benchmark {
+    static const int kPages = 500;
+    sk_sp<SkImage> fImages[4];
+
+    const char* onGetName() override { return "PDFLongDocument_500"; }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        SkRandom random;
+        for (sk_sp<SkImage>& image : fImages) {
+            SkAutoPixmapStorage pixmap;
+            pixmap.alloc(SkImageInfo::MakeN32Premul(256, 256));
+            for (int y = 0; y < pixmap.height(); y++) {
+                for (int x = 0; x < pixmap.width(); x++) {
+                    *pixmap.writable_addr32(x, y) = SkPreMultiplyColor(
+                            (random.nextU() & 0x00FFFFFF) | 0xFF000000);
+                }
+            }
+            image = SkImage::MakeRasterCopy(pixmap);
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            NullWStream nullStream;
+            sk_sp<SkDocument> doc(SkPDFMakeDocument(&nullStream, nullptr, 72, nullptr));
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            for (int page = 0; page < kPages; page++) {
+                SkCanvas* canvas = doc->beginPage(612, 792);
+                for (int line = 0; line < 40; line++) {
+                    SkString text;
+                    text.printf("Page %d, line %d: the quick brown fox jumps over the lazy dog.",
+                                page, line);
+                    canvas->drawText(text.c_str(), text.size(),
+                                     36, SkIntToScalar(48 + 12 * line), paint);
+                }
+                canvas->drawCircle(306, 600, 50 + (page % 50), paint);
+                // Every page gets its own image, so none are shared between pages.
+                canvas->save();
+                canvas->translate(SkIntToScalar(page % 100), 0);
+                canvas->drawImageRect(fImages[page % SK_ARRAY_COUNT(fImages)].get(),
+                                      SkIRect::MakeXYWH(page % 128, page / 128, 128, 252),
+                                      SkRect::MakeXYWH(36, 540, 128, 252), nullptr);
+                canvas->restore();
+                doc->endPage();
+            }
+            doc->close();
+        }
+    }
+};
+
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
@@ -214,3 +270,4 @@ DEF_BENCH(return new PDFCompressionBench;)
 DEF_BENCH(return new PDFScalarBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WStreamWriteTextBenchmark;)
+DEF_BENCH(return new PDFLongDocumentBench;)
@@ -12,13 +12,15 @@
 #include "SkPaint.h"
 #include "SkPath.h"
 #include "SkRandom.h"
+#include "SkScan.h"
 #include "SkShader.h"
 #include "SkString.h"
 #include "SkTArray.h"
 
 enum Flags {
-    kStroke_Flag = 1 << 0,
-    kBig_Flag    = 1 << 1
+    kStroke_Flag     = 1 << 0,
+    kBig_Flag        = 1 << 1,
+    kAnalyticAA_Flag = 1 << 2,  // Fill with SkScan_AAAPath instead of supersampling.
 };
 
 #define FLAGS00  Flags(0)
@@ -48,6 +50,9 @@ protected:
                      fFlags & kStroke_Flag ? "stroke" : "fill",
                      fFlags & kBig_Flag ? "big" : "small");
         this->appendName(&fName);
+        if (fFlags & kAnalyticAA_Flag) {
+            fName.append("_analytic");
+        }
         return fName.c_str();
     }
 
@@ -68,9 +73,12 @@ protected:
         }
         count >>= (3 * complexity());
 
+        const bool forceAnalytic = gSkForceAnalyticAA;
+        gSkForceAnalyticAA = forceAnalytic || (fFlags & kAnalyticAA_Flag);
         for (int i = 0; i < count; i++) {
             canvas->drawPath(path, paint);
         }
+        gSkForceAnalyticAA = forceAnalytic;
     }
 
 private:
@@ -1021,6 +1029,35 @@ DEF_BENCH( return new LongCurvedPathBench(FLAGS01); )
 DEF_BENCH( return new LongLinePathBench(FLAGS00); )
 DEF_BENCH( return new LongLinePathBench(FLAGS01); )
 
+// The same fills with analytic AA, to compare against the supersampled ones above.
+static Flags analytic(Flags flags) { return Flags(flags | kAnalyticAA_Flag); }
+
+DEF_BENCH( return new TrianglePathBench(analytic(FLAGS00)); )
+DEF_BENCH( return new TrianglePathBench(analytic(FLAGS01)); )
+DEF_BENCH( return new TrianglePathBench(analytic(FLAGS10)); )
+DEF_BENCH( return new TrianglePathBench(analytic(FLAGS11)); )
+
+DEF_BENCH( return new RectPathBench(analytic(FLAGS00)); )
+DEF_BENCH( return new RectPathBench(analytic(FLAGS10)); )
+
+DEF_BENCH( return new OvalPathBench(analytic(FLAGS00)); )
+DEF_BENCH( return new OvalPathBench(analytic(FLAGS01)); )
+DEF_BENCH( return new OvalPathBench(analytic(FLAGS10)); )
+DEF_BENCH( return new OvalPathBench(analytic(FLAGS11)); )
+
+DEF_BENCH( return new CirclePathBench(analytic(FLAGS00)); )
+DEF_BENCH( return new CirclePathBench(analytic(FLAGS01)); )
+DEF_BENCH( return new CirclePathBench(analytic(FLAGS10)); )
+DEF_BENCH( return new CirclePathBench(analytic(FLAGS11)); )
+
+DEF_BENCH( return new SawToothPathBench(analytic(FLAGS00)); )
+DEF_BENCH( return new SawToothPathBench(analytic(FLAGS01)); )
+
+DEF_BENCH( return new LongCurvedPathBench(analytic(FLAGS00)); )
+DEF_BENCH( return new LongCurvedPathBench(analytic(FLAGS01)); )
+DEF_BENCH( return new LongLinePathBench(analytic(FLAGS00)); )
+DEF_BENCH( return new LongLinePathBench(analytic(FLAGS01)); )
+
 DEF_BENCH( return new PathCreateBench(); )
 DEF_BENCH( return new PathCopyBench(); )
 DEF_BENCH( return new PathTransformBench(true); )
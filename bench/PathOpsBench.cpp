@@ -0,0 +1,142 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkPath.h"
+#include "SkPathOps.h"
+#include "SkPoint.h"
+#include "SkRandom.h"
+#include "SkString.h"
+
+// Unions many building footprints at once with SkOpBuilder, as a map renderer would:
+// rectangles and L-shapes, scattered over blocks so some overlap and most don't.
+class PathOpsBuilderUnionBench : public Benchmark {
+public:
+    explicit PathOpsBuilderUnionBench(int count) : fCount(count) {
+        fName.printf("pathops_builder_union_%d", count);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return kNonRendering_Backend == backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        const int blocks = SkScalarCeilToInt(SkScalarSqrt(SkIntToScalar(fCount) / 8));
+        for (int index = 0; index < fCount; ++index) {
+            const int block = rand.nextULessThan(blocks * blocks);
+            const SkScalar x = rand.nextRangeScalar(0, 80) + 100 * (block % blocks),
+                           y = rand.nextRangeScalar(0, 80) + 100 * (block / blocks),
+                           w = rand.nextRangeScalar(4, 20),
+                           h = rand.nextRangeScalar(4, 20);
+            SkPath& path = fPaths.push_back();
+            if (index & 1) {
+                path.addRect(x, y, x + w, y + h);
+            } else {
+                path.moveTo(x, y);
+                path.lineTo(x + w, y);
+                path.lineTo(x + w, y + h / 2);
+                path.lineTo(x + w / 2, y + h / 2);
+                path.lineTo(x + w / 2, y + h);
+                path.lineTo(x, y + h);
+                path.close();
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkOpBuilder builder;
+            for (int index = 0; index < fPaths.count(); ++index) {
+                builder.add(fPaths[index], kUnion_SkPathOp);
+            }
+            SkPath result;
+            builder.resolve(&result);
+        }
+    }
+
+private:
+    int              fCount;
+    SkString         fName;
+    SkTArray<SkPath> fPaths;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PathOpsBuilderUnionBench(100); )
+DEF_BENCH( return new PathOpsBuilderUnionBench(1000); )
+
+// A closed, wavy ring of count lines or cubics around (cx, cy), like a detailed outline.
+static void make_wavy_ring(SkPath* path, SkScalar cx, SkScalar cy, int count, bool cubics) {
+    auto point = [=](SkScalar step) {
+        const SkScalar angle = step * 2 * SK_ScalarPI / count,
+                       radius = 100 + 5 * SkScalarSin(angle * 37);
+        return SkPoint::Make(cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle));
+    };
+    path->moveTo(point(0));
+    for (int index = 1; index <= count; ++index) {
+        if (cubics) {
+            path->cubicTo(point(index - 0.67f), point(index - 0.33f), point(SkIntToScalar(index)));
+        } else {
+            path->lineTo(point(SkIntToScalar(index)));
+        }
+    }
+    path->close();
+}
+
+// Op and Simplify on two overlapping outlines of many segments, where most segment pairs are far
+// apart and only those near the outlines' crossings intersect.
+class PathOpsBench : public Benchmark {
+public:
+    PathOpsBench(int count, bool cubics, bool simplify)
+        : fCount(count), fCubics(cubics), fSimplify(simplify) {
+        fName.printf("pathops_%s_%s_%d", simplify ? "simplify" : "op",
+                     cubics ? "cubics" : "lines", count);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return kNonRendering_Backend == backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        make_wavy_ring(&fA, 0, 0, fCount, fCubics);
+        make_wavy_ring(&fB, 60, 30, fCount, fCubics);
+        fBoth = fA;
+        fBoth.addPath(fB);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPath result;
+        for (int i = 0; i < loops; ++i) {
+            if (fSimplify) {
+                Simplify(fBoth, &result);
+            } else {
+                Op(fA, fB, kIntersect_SkPathOp, &result);
+            }
+        }
+    }
+
+private:
+    int      fCount;
+    bool     fCubics;
+    bool     fSimplify;
+    SkString fName;
+    SkPath   fA, fB, fBoth;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PathOpsBench(1000, false, false); )
+DEF_BENCH( return new PathOpsBench(1000, false, true); )
+DEF_BENCH( return new PathOpsBench(1000, true, false); )
+DEF_BENCH( return new PathOpsBench(1000, true, true); )
@@ -10,20 +10,34 @@
 
 class PerlinNoiseBench : public Benchmark {
     SkISize fSize;
+    SkPerlinNoiseShader::Type fType;
+    int fNumOctaves;
+    bool fStitchTiles;
+    SkString fName;
 
 public:
-    PerlinNoiseBench()  {
+    PerlinNoiseBench(SkPerlinNoiseShader::Type type = SkPerlinNoiseShader::kFractalNoise_Type,
+                     int numOctaves = 3, bool stitchTiles = false)
+        : fType(type)
+        , fNumOctaves(numOctaves)
+        , fStitchTiles(stitchTiles) {
         fSize = SkISize::Make(80, 80);
+        fName.set("perlinnoise");
+        if (type != SkPerlinNoiseShader::kFractalNoise_Type || numOctaves != 3 || stitchTiles) {
+            fName.appendf("_%s_%d%s",
+                          type == SkPerlinNoiseShader::kFractalNoise_Type ? "fractal"
+                                                                          : "turbulence",
+                          numOctaves, stitchTiles ? "_stitched" : "");
+        }
     }
 
 protected:
     const char* onGetName() override {
-        return "perlinnoise";
+        return fName.c_str();
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
-        this->test(loops, canvas, 0, 0, SkPerlinNoiseShader::kFractalNoise_Type,
-                   0.1f, 0.1f, 3, 0, false);
+        this->test(loops, canvas, 0, 0, fType, 0.1f, 0.1f, fNumOctaves, 0, fStitchTiles);
     }
 
 private:
@@ -60,3 +74,5 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new PerlinNoiseBench(); )
+DEF_BENCH( return new PerlinNoiseBench(SkPerlinNoiseShader::kTurbulence_Type, 3, false); )
+DEF_BENCH( return new PerlinNoiseBench(SkPerlinNoiseShader::kFractalNoise_Type, 8, true); )
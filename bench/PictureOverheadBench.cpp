@@ -6,10 +6,12 @@
  */
 
 // A benchmark designed to isolate the constant overheads of picture recording.
-// We record an empty picture and a picture with one draw op to force memory allocation.
+// We record an empty picture and a picture with one draw op to force memory allocation, and a
+// picture of many small paths.
 
 #include "Benchmark.h"
 #include "SkCanvas.h"
+#include "SkPath.h"
 #include "SkPictureRecorder.h"
 
 template <bool kDraw>
@@ -33,3 +35,32 @@ struct PictureOverheadBench : public Benchmark {
 
 DEF_BENCH(return (new PictureOverheadBench<false>);)
 DEF_BENCH(return (new PictureOverheadBench< true>);)
+
+// Records many small paths, each built and dropped by the client, as text and icons often are.
+// Finishing the picture packs their points and verbs into one block instead of one per path.
+struct PicturePathsOverheadBench : public Benchmark {
+    const char* onGetName() override { return "picture_overhead_paths"; }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPictureRecorder rec;
+        SkPaint paint;
+        for (int i = 0; i < loops; i++) {
+            SkCanvas* canvas = rec.beginRecording(SkRect::MakeWH(2000,3000));
+            for (int j = 0; j < 100; j++) {
+                const SkScalar x = SkIntToScalar(j % 10 * 20),
+                               y = SkIntToScalar(j / 10 * 20);
+                SkPath path;
+                path.moveTo(x, y);
+                path.lineTo(x + 10, y);
+                path.quadTo(x + 15, y + 5, x + 10, y + 10);
+                path.lineTo(x, y + 10);
+                path.close();
+                canvas->drawPath(path, paint);
+            }
+            (void)rec.finishRecordingAsPicture();
+        }
+    }
+};
+
+DEF_BENCH(return (new PicturePathsOverheadBench);)
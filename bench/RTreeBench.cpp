@@ -22,8 +22,13 @@ typedef SkRect (*MakeRectProc)(SkRandom&, int, int);
 // Time how long it takes to build an R-Tree.
 class RTreeBuildBench : public Benchmark {
 public:
-    RTreeBuildBench(const char* name, MakeRectProc proc) : fProc(proc) {
+    RTreeBuildBench(const char* name, MakeRectProc proc, int count = NUM_BUILD_RECTS)
+        : fProc(proc)
+        , fCount(count) {
         fName.printf("rtree_%s_build", name);
+        if (count != NUM_BUILD_RECTS) {
+            fName.appendf("_%d", count);
+        }
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -36,19 +41,20 @@ protected:
     }
     void onDraw(int loops, SkCanvas* canvas) override {
         SkRandom rand;
-        SkAutoTMalloc<SkRect> rects(NUM_BUILD_RECTS);
-        for (int i = 0; i < NUM_BUILD_RECTS; ++i) {
-            rects[i] = fProc(rand, i, NUM_BUILD_RECTS);
+        SkAutoTMalloc<SkRect> rects(fCount);
+        for (int i = 0; i < fCount; ++i) {
+            rects[i] = fProc(rand, i, fCount);
         }
 
         for (int i = 0; i < loops; ++i) {
             SkRTree tree;
-            tree.insert(rects.get(), NUM_BUILD_RECTS);
+            tree.insert(rects.get(), fCount);
             SkASSERT(rects != nullptr);  // It'd break this bench if the tree took ownership of rects.
         }
     }
 private:
     MakeRectProc fProc;
+    int fCount;
     SkString fName;
     typedef Benchmark INHERITED;
 };
@@ -56,8 +62,13 @@ private:
 // Time how long it takes to perform queries on an R-Tree.
 class RTreeQueryBench : public Benchmark {
 public:
-    RTreeQueryBench(const char* name, MakeRectProc proc) : fProc(proc) {
+    RTreeQueryBench(const char* name, MakeRectProc proc, int count = NUM_QUERY_RECTS)
+        : fProc(proc)
+        , fCount(count) {
         fName.printf("rtree_%s_query", name);
+        if (count != NUM_QUERY_RECTS) {
+            fName.appendf("_%d", count);
+        }
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -69,11 +80,11 @@ protected:
     }
     void onDelayedSetup() override {
         SkRandom rand;
-        SkAutoTMalloc<SkRect> rects(NUM_QUERY_RECTS);
-        for (int i = 0; i < NUM_QUERY_RECTS; ++i) {
-            rects[i] = fProc(rand, i, NUM_QUERY_RECTS);
+        SkAutoTMalloc<SkRect> rects(fCount);
+        for (int i = 0; i < fCount; ++i) {
+            rects[i] = fProc(rand, i, fCount);
         }
-        fTree.insert(rects.get(), NUM_QUERY_RECTS);
+        fTree.insert(rects.get(), fCount);
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
@@ -91,6 +102,7 @@ protected:
 private:
     SkRTree fTree;
     MakeRectProc fProc;
+    int fCount;
     SkString fName;
     typedef Benchmark INHERITED;
 };
@@ -125,6 +137,19 @@ static inline SkRect make_concentric_rects(SkRandom&, int index, int numRects) {
     return SkRect::MakeWH(SkIntToScalar(index+1), SkIntToScalar(index+1));
 }
 
+// Small rects down a long page, GRID_WIDTH to a row, in order or scattered over the same page.
+static inline SkRect make_page_rects(SkRandom& rand, int index, int numRects) {
+    const SkScalar cell = GENERATE_EXTENTS / GRID_WIDTH;
+    return SkRect::MakeXYWH(cell * (index % GRID_WIDTH), cell * (index / GRID_WIDTH),
+                            rand.nextRangeF(1, 3 * cell), rand.nextRangeF(1, 3 * cell));
+}
+static inline SkRect make_scattered_rects(SkRandom& rand, int index, int numRects) {
+    const SkScalar cell = GENERATE_EXTENTS / GRID_WIDTH;
+    const SkScalar height = cell * (numRects / GRID_WIDTH);
+    return SkRect::MakeXYWH(rand.nextRangeF(0, GENERATE_EXTENTS), rand.nextRangeF(0, height),
+                            rand.nextRangeF(1, 3 * cell), rand.nextRangeF(1, 3 * cell));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH(return new RTreeBuildBench("XY", &make_XYordered_rects));
@@ -136,3 +161,9 @@ DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects));
 DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects));
 DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects));
 DEF_BENCH(return new RTreeQueryBench("concentric", &make_concentric_rects));
+
+// Trees the size of those recorded for long pages, queried near the top of the page.
+DEF_BENCH(return new RTreeBuildBench("page", &make_page_rects, 500000));
+DEF_BENCH(return new RTreeBuildBench("scattered", &make_scattered_rects, 500000));
+DEF_BENCH(return new RTreeQueryBench("page", &make_page_rects, 500000));
+DEF_BENCH(return new RTreeQueryBench("scattered", &make_scattered_rects, 500000));
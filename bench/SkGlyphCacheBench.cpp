@@ -12,6 +12,7 @@
 #include "SkCanvas.h"
 #include "SkGlyphCache_Globals.h"
 #include "SkGraphics.h"
+#include "SkOSFile.h"
 #include "SkTaskGroup.h"
 #include "SkTypeface.h"
 #include "sk_tool_utils.h"
@@ -114,7 +115,132 @@ private:
     SkString fName;
 };
 
+// Many threads drawing the same text at the same size all hit one shared strike.
+class SkGlyphCacheSharedStrike : public Benchmark {
+public:
+    explicit SkGlyphCacheSharedStrike(int threads) : fThreads(threads) { }
+
+protected:
+    const char* onGetName() override {
+        fName.printf("SkGlyphCacheSharedStrike_%d", fThreads);
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fTypeface.reset(sk_tool_utils::create_portable_typeface("serif", SkTypeface::kNormal));
+        fPaint.setAntiAlias(true);
+        fPaint.setTextSize(24);
+        fPaint.setTypeface(fTypeface);
+        // Warm up the strike, so we measure only lookups.
+        this->lookupGlyphs();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int work = 0; work < loops; work++) {
+            SkTaskGroup().batch(fThreads, [&](int) { this->lookupGlyphs(); });
+        }
+    }
+
+private:
+    void lookupGlyphs() const {
+        SkAutoGlyphCacheNoGamma autoCache(fPaint, nullptr, nullptr);
+        SkGlyphCache* cache = autoCache.getCache();
+        for (int lookups = 0; lookups < 10; lookups++) {
+            for (int c = ' '; c < 'z'; c++) {
+                const SkGlyph& g = cache->getUnicharMetrics(c);
+                cache->findImage(g);
+            }
+        }
+    }
+
+    typedef Benchmark INHERITED;
+    const int fThreads;
+    SkAutoTUnref<SkTypeface> fTypeface;
+    SkPaint fPaint;
+    SkString fName;
+};
+
+// The first frame of text after a restart: the font cache is empty, and each glyph comes either
+// from the scaler (cold) or from strikes saved to disk by an earlier run (warm).
+class SkGlyphCacheFirstFrame : public Benchmark {
+public:
+    explicit SkGlyphCacheFirstFrame(bool warm) : fWarm(warm) { }
+
+protected:
+    const char* onGetName() override {
+        return fWarm ? "SkGlyphCacheFirstFrame_warm" : "SkGlyphCacheFirstFrame_cold";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kRaster_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fTypeface.reset(sk_tool_utils::create_portable_typeface("serif", SkTypeface::kNormal));
+        fPaint.setAntiAlias(true);
+        fPaint.setTypeface(fTypeface);
+        const char* tmp = getenv("TMPDIR");
+        fDir = SkOSPath::Join(tmp ? tmp : ".", "SkGlyphCacheFirstFrame");
+    }
+
+    void onPerCanvasPreDraw(SkCanvas* canvas) override {
+        if (fWarm) {
+            // Save the strikes once, as an earlier run would have.
+            sk_mkdir(fDir.c_str());
+            SkGraphics::SetFontCacheDirectory(fDir.c_str());
+            this->drawFrame(canvas);
+            SkGraphics::PurgeFontCache();
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        if (!fWarm) {
+            return;
+        }
+        SkGraphics::SetFontCacheDirectory(nullptr);
+        SkGraphics::PurgeFontCache();
+
+        // Leave nothing behind in the tmp dir.
+        SkOSFile::Iter iter(fDir.c_str());
+        for (SkString name; iter.next(&name);) {
+            remove(SkOSPath::Join(fDir.c_str(), name.c_str()).c_str());
+        }
+        remove(fDir.c_str());
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int work = 0; work < loops; work++) {
+            SkGraphics::PurgeFontCache();
+            this->drawFrame(canvas);
+        }
+    }
+
+private:
+    void drawFrame(SkCanvas* canvas) {
+        static const char kText[] = "The quick brown fox jumps over the lazy dog 0123456789";
+        for (int size = 8; size < 32; size += 2) {
+            fPaint.setTextSize(SkIntToScalar(size));
+            canvas->drawText(kText, sizeof(kText) - 1, 0, SkIntToScalar(size * 2), fPaint);
+        }
+    }
+
+    typedef Benchmark INHERITED;
+    const bool fWarm;
+    SkAutoTUnref<SkTypeface> fTypeface;
+    SkPaint fPaint;
+    SkString fDir;
+};
+
 DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
+DEF_BENCH( return new SkGlyphCacheSharedStrike(1); )
+DEF_BENCH( return new SkGlyphCacheSharedStrike(4); )
+DEF_BENCH( return new SkGlyphCacheSharedStrike(16); )
+DEF_BENCH( return new SkGlyphCacheFirstFrame(false); )
+DEF_BENCH( return new SkGlyphCacheFirstFrame(true); )
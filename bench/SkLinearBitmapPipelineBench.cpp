@@ -13,6 +13,8 @@
 #include "Benchmark.h"
 #include "SkShader.h"
 #include "SkImage.h"
+#include "SkHalf.h"
+#include "SkNx.h"
 
 struct CommonBitmapFPBenchmark : public Benchmark {
     CommonBitmapFPBenchmark(
@@ -343,3 +345,107 @@ DEF_BENCH(return new SkBitmapFPGeneral(
 DEF_BENCH(return new SkBitmapFPOrigShader(
     srcSize, kLinear_SkColorProfileType, mR, true,
     SkShader::kRepeat_TileMode, SkShader::kRepeat_TileMode);)
+
+// The pipeline over each kind of source, each filter and each tile mode.
+struct SkBitmapFPSource final : public Benchmark {
+    SkBitmapFPSource(SkColorType colorType, SkColorProfileType colorProfile,
+                     SkFilterQuality filterQuality, SkShader::TileMode tile)
+        : fColorType{colorType}
+        , fColorProfile{colorProfile}
+        , fFilterQuality{filterQuality}
+        , fTile{tile} { }
+
+    const char* onGetName() override {
+        static const char* kFilterNames[] = { "Nearest", "Bilerp", "Bilerp", "Bicubic" };
+        fName.set("SkBitmapFPSource");
+        switch (fColorType) {
+            case kRGB_565_SkColorType:    fName.append("565");  break;
+            case kGray_8_SkColorType:     fName.append("Gray8"); break;
+            case kRGBA_F16_SkColorType:   fName.append("F16");  break;
+            default:                      fName.append("8888"); break;
+        }
+        fName.append(kSRGB_SkColorProfileType == fColorProfile ? "sRGB" : "Linr");
+        fName.append(kFilterNames[fFilterQuality]);
+        fName.append(CommonBitmapFPBenchmark::tileName("", fTile));
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        const int kSize = 120;
+        SkAlphaType alphaType = kRGBA_F16_SkColorType == fColorType ||
+                                kN32_SkColorType == fColorType ? kPremul_SkAlphaType
+                                                               : kOpaque_SkAlphaType;
+        fBitmap.allocPixels(SkImageInfo::Make(kSize, kSize, fColorType, alphaType,
+                                              fColorProfile));
+        for (int y = 0; y < kSize; y++) {
+            for (int x = 0; x < kSize; x++) {
+                switch (fColorType) {
+                    case kRGB_565_SkColorType:
+                        *fBitmap.getAddr16(x, y) = SkPackRGB16(x & 31, y & 63, (x + y) & 31);
+                        break;
+                    case kGray_8_SkColorType:
+                        *fBitmap.getAddr8(x, y) = SkToU8(x + y);
+                        break;
+                    case kRGBA_F16_SkColorType:
+                        ((uint64_t*)fBitmap.getPixels())[y * kSize + x] =
+                            SkFloatToHalf_01(Sk4f{x / 128.0f, y / 128.0f, 0.25f, 0.5f} * 0.5f);
+                        break;
+                    default:
+                        *fBitmap.getAddr32(x, y) = SkPackARGB32(128, x, y, 0);
+                        break;
+                }
+            }
+        }
+        // Scale up and rotate a little, so that every filter samples between pixels and the
+        // tiling shows.
+        SkMatrix m;
+        m.setRotate(10);
+        m.postScale(2.7f, 2.7f);
+        m.postTranslate(-40, -40);
+        bool trash = m.invert(&fInvert);
+        sk_ignore_unused_variable(trash);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPixmap srcPixmap;
+        fBitmap.peekPixels(&srcPixmap);
+        SkLinearBitmapPipeline pipeline{fInvert, fFilterQuality, fTile, fTile, 1.0f, srcPixmap};
+
+        const int kCount = 100;
+        SkPM4f buffer[kCount];
+        for (int n = 0; n < 100 * loops; n++) {
+            pipeline.shadeSpan4f(3, n % 200, buffer, kCount);
+        }
+    }
+
+    SkString fName;
+    SkColorType fColorType;
+    SkColorProfileType fColorProfile;
+    SkFilterQuality fFilterQuality;
+    SkShader::TileMode fTile;
+    SkMatrix fInvert;
+    SkBitmap fBitmap;
+};
+
+#define DEF_SOURCE_BENCHES(colorType, profile)                                                 \
+    DEF_BENCH(return new SkBitmapFPSource(colorType, profile, kNone_SkFilterQuality,          \
+                                          SkShader::kClamp_TileMode);)                        \
+    DEF_BENCH(return new SkBitmapFPSource(colorType, profile, kLow_SkFilterQuality,           \
+                                          SkShader::kClamp_TileMode);)                        \
+    DEF_BENCH(return new SkBitmapFPSource(colorType, profile, kHigh_SkFilterQuality,          \
+                                          SkShader::kClamp_TileMode);)                        \
+    DEF_BENCH(return new SkBitmapFPSource(colorType, profile, kLow_SkFilterQuality,           \
+                                          SkShader::kRepeat_TileMode);)                       \
+    DEF_BENCH(return new SkBitmapFPSource(colorType, profile, kHigh_SkFilterQuality,          \
+                                          SkShader::kMirror_TileMode);)
+
+DEF_SOURCE_BENCHES(kN32_SkColorType,      kLinear_SkColorProfileType)
+DEF_SOURCE_BENCHES(kN32_SkColorType,      kSRGB_SkColorProfileType)
+DEF_SOURCE_BENCHES(kRGB_565_SkColorType,  kLinear_SkColorProfileType)
+DEF_SOURCE_BENCHES(kGray_8_SkColorType,   kLinear_SkColorProfileType)
+DEF_SOURCE_BENCHES(kGray_8_SkColorType,   kSRGB_SkColorProfileType)
+DEF_SOURCE_BENCHES(kRGBA_F16_SkColorType, kLinear_SkColorProfileType)
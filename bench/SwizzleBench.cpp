@@ -6,11 +6,18 @@
  */
 
 #include "Benchmark.h"
+#include "OptsTierBench.h"
 #include "SkOpts.h"
+#include "SkRandom.h"
+#include "SkString.h"
+#include "SkSwizzler.h"
+#include "SkTemplates.h"
 
 class SwizzleBench : public Benchmark {
 public:
-    SwizzleBench(const char* name, SkOpts::Swizzle_8888 fn) : fName(name), fFn(fn) {}
+    // We hold on to the address of the SkOpts function pointer, not its current value,
+    // so that OptsTierBench can swap in each tier's version underneath us.
+    SwizzleBench(const char* name, SkOpts::Swizzle_8888* fn) : fName(name), fFn(fn) {}
 
     bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
     const char* onGetName() override { return fName; }
@@ -18,22 +25,139 @@ public:
         static const int K = 1023; // Arbitrary, but nice to be a non-power-of-two to trip up SIMD.
         uint32_t dst[K], src[K];
         while (loops --> 0) {
-            fFn(dst, src, K);
+            (*fFn)(dst, src, K);
         }
     }
 private:
     const char* fName;
-    SkOpts::Swizzle_8888 fFn;
+    SkOpts::Swizzle_8888* fFn;
 };
 
+class PMColorTo565Bench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return "SkOpts::PMColor_to_565"; }
+    void onDraw(int loops, SkCanvas*) override {
+        static const int K = 1023;
+        uint16_t dst[K];
+        uint32_t src[K];
+        while (loops --> 0) {
+            SkOpts::PMColor_to_565(dst, src, K);
+        }
+    }
+};
+
+// Swizzles a row with the RowProc SkSwizzler picks for this source config and destination,
+// as a codec would.  sampleX > 1 swizzles every sampleX'th pixel.
+class SwizzlerBench : public Benchmark {
+public:
+    SwizzlerBench(SkSwizzler::SrcConfig config, const char* configName, SkColorType colorType,
+                  int sampleX = 1)
+        : fConfig(config)
+        , fColorType(colorType)
+        , fSampleX(sampleX) {
+        fName.printf("Swizzler_%s_to_%s", configName,
+                     kRGB_565_SkColorType == colorType ? "565" : "n32");
+        if (sampleX > 1) {
+            fName.appendf("_sample%d", sampleX);
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        static const int K = 1023;
+        SkRandom rand;
+        fSrc.reset(K * 4);
+        for (int i = 0; i < K * 4; i++) {
+            fSrc[i] = rand.nextU();
+        }
+        for (SkPMColor& c : fColorTable) {
+            c = rand.nextU() | 0xFF000000;
+        }
+        fDst.reset(K);
+
+        const SkImageInfo info = SkImageInfo::Make(K, 1, fColorType, kPremul_SkAlphaType);
+        fSwizzler.reset(SkSwizzler::CreateSwizzler(fConfig, fColorTable, info,
+                                                   SkCodec::Options()));
+        SkASSERT(fSwizzler);
+        fSwizzler->setSampleX(fSampleX);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops --> 0) {
+            fSwizzler->swizzle(fDst.get(), fSrc.get());
+        }
+    }
+
+private:
+    SkSwizzler::SrcConfig     fConfig;
+    SkColorType               fColorType;
+    int                       fSampleX;
+    SkString                  fName;
+    SkAutoTMalloc<uint8_t>    fSrc;
+    SkAutoTMalloc<uint32_t>   fDst;
+    SkPMColor                 fColorTable[256];
+    SkAutoTDelete<SkSwizzler> fSwizzler;
+};
+
+class HalfToFloatBench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return "SkOpts::half_to_float"; }
+    void onDraw(int loops, SkCanvas*) override {
+        static const int K = 1023;
+        uint16_t src[K];
+        float dst[K];
+        for (int i = 0; i < K; i++) {
+            src[i] = (uint16_t)(0x3c00 + i);  // 1.0, and a bunch of numbers just above it.
+        }
+        while (loops --> 0) {
+            SkOpts::half_to_float(dst, src, K);
+        }
+    }
+};
+
+
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA_to_rgbA", &SkOpts::RGBA_to_rgbA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA_to_bgrA", &SkOpts::RGBA_to_bgrA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA_to_BGRA", &SkOpts::RGBA_to_BGRA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB_to_RGB1",  &SkOpts::RGB_to_RGB1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB_to_BGR1",  &SkOpts::RGB_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::gray_to_RGB1", &SkOpts::gray_to_RGB1));
+DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_RGBA", &SkOpts::grayA_to_RGBA));
+DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_rgbA", &SkOpts::grayA_to_rgbA));
+DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_RGB1", &SkOpts::inverted_CMYK_to_RGB1));
+DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_BGR1", &SkOpts::inverted_CMYK_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBX_to_RGB1", &SkOpts::RGBX_to_RGB1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBX_to_BGR1", &SkOpts::RGBX_to_BGR1));
+DEF_BENCH(return new PMColorTo565Bench);
+
+#define SWIZZLER_BENCHES(config, colorType)                                                 \
+    DEF_BENCH(return new SwizzlerBench(SkSwizzler::k##config, #config, colorType));        \
+    DEF_BENCH(return new SwizzlerBench(SkSwizzler::k##config, #config, colorType, 2));
+SWIZZLER_BENCHES(Gray,       kN32_SkColorType)
+SWIZZLER_BENCHES(Gray,       kRGB_565_SkColorType)
+SWIZZLER_BENCHES(GrayAlpha,  kN32_SkColorType)
+SWIZZLER_BENCHES(Index,      kN32_SkColorType)
+SWIZZLER_BENCHES(Index,      kRGB_565_SkColorType)
+SWIZZLER_BENCHES(RGB,        kN32_SkColorType)
+SWIZZLER_BENCHES(RGB,        kRGB_565_SkColorType)
+SWIZZLER_BENCHES(BGR,        kN32_SkColorType)
+SWIZZLER_BENCHES(BGRX,       kN32_SkColorType)
+SWIZZLER_BENCHES(BGRX,       kRGB_565_SkColorType)
+SWIZZLER_BENCHES(RGBA,       kN32_SkColorType)
+SWIZZLER_BENCHES(BGRA,       kN32_SkColorType)
+SWIZZLER_BENCHES(CMYK,       kN32_SkColorType)
+SWIZZLER_BENCHES(CMYK,       kRGB_565_SkColorType)
+#undef SWIZZLER_BENCHES
 
-DEF_BENCH(return new SwizzleBench("SkOpts::RGBA_to_rgbA", SkOpts::RGBA_to_rgbA));
-DEF_BENCH(return new SwizzleBench("SkOpts::RGBA_to_bgrA", SkOpts::RGBA_to_bgrA));
-DEF_BENCH(return new SwizzleBench("SkOpts::RGBA_to_BGRA", SkOpts::RGBA_to_BGRA));
-DEF_BENCH(return new SwizzleBench("SkOpts::RGB_to_RGB1",  SkOpts::RGB_to_RGB1));
-DEF_BENCH(return new SwizzleBench("SkOpts::RGB_to_BGR1",  SkOpts::RGB_to_BGR1));
-DEF_BENCH(return new SwizzleBench("SkOpts::gray_to_RGB1", SkOpts::gray_to_RGB1));
-DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_RGBA", SkOpts::grayA_to_RGBA));
-DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_rgbA", SkOpts::grayA_to_rgbA));
-DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_RGB1", SkOpts::inverted_CMYK_to_RGB1));
-DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_BGR1", SkOpts::inverted_CMYK_to_BGR1));
+DEF_OPTS_TIER_BENCHES(return new SwizzleBench("SkOpts::RGBA_to_rgbA", &SkOpts::RGBA_to_rgbA))
+DEF_OPTS_TIER_BENCHES(return new SwizzleBench("SkOpts::RGBA_to_bgrA", &SkOpts::RGBA_to_bgrA))
+DEF_OPTS_TIER_BENCHES(return new SwizzleBench("SkOpts::RGBA_to_BGRA", &SkOpts::RGBA_to_BGRA))
+DEF_OPTS_TIER_BENCHES(return new SwizzleBench("SkOpts::RGB_to_RGB1",  &SkOpts::RGB_to_RGB1))
+DEF_OPTS_TIER_BENCHES(return new SwizzleBench("SkOpts::gray_to_RGB1", &SkOpts::gray_to_RGB1))
+DEF_OPTS_TIER_BENCHES(return new SwizzleBench("SkOpts::RGBX_to_RGB1", &SkOpts::RGBX_to_RGB1))
+DEF_OPTS_TIER_BENCHES(return new PMColorTo565Bench)
+DEF_OPTS_TIER_BENCHES(return new HalfToFloatBench)
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkAtomics.h"
+#include "SkString.h"
+#include "SkTaskGroup.h"
+
+// These measure scheduling overhead, so every task does almost nothing.
+// Run nanobench with --threads N (1 to 64) to compare scaling across pool sizes.
+
+static const int kTasks = 10000;
+
+static void spin(SkAtomic<int32_t>* counter) {
+    counter->fetch_add(1, sk_memory_order_relaxed);
+}
+
+class TaskGroupAddBench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+protected:
+    const char* onGetName() override { return "taskgroup_add"; }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkAtomic<int32_t> counter(0);
+        for (int i = 0; i < loops; i++) {
+            SkTaskGroup tg;
+            for (int j = 0; j < kTasks; j++) {
+                tg.add([&] { spin(&counter); });
+            }
+            tg.wait();
+        }
+    }
+};
+
+class TaskGroupBatchBench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+protected:
+    const char* onGetName() override { return "taskgroup_batch"; }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkAtomic<int32_t> counter(0);
+        for (int i = 0; i < loops; i++) {
+            SkTaskGroup().batch(kTasks, [&](int) { spin(&counter); });
+        }
+    }
+};
+
+// Each outer task spawns and waits on its own inner group, exercising nested wait() helping.
+class TaskGroupNestedBench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+protected:
+    const char* onGetName() override { return "taskgroup_nested"; }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkAtomic<int32_t> counter(0);
+        for (int i = 0; i < loops; i++) {
+            SkTaskGroup().batch(100, [&](int) {
+                SkTaskGroup().batch(kTasks / 100, [&](int) { spin(&counter); });
+            });
+        }
+    }
+};
+
+class ParallelForBench : public Benchmark {
+public:
+    explicit ParallelForBench(int grain) : fGrain(grain) {
+        fName.printf("taskgroup_parallel_for_grain_%d", grain);
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkAtomic<int32_t> counter(0);
+        for (int i = 0; i < loops; i++) {
+            sk_parallel_for(kTasks, fGrain, [&](int) { spin(&counter); });
+        }
+    }
+
+private:
+    int      fGrain;
+    SkString fName;
+};
+
+DEF_BENCH( return new TaskGroupAddBench; )
+DEF_BENCH( return new TaskGroupBatchBench; )
+DEF_BENCH( return new TaskGroupNestedBench; )
+DEF_BENCH( return new ParallelForBench(1); )
+DEF_BENCH( return new ParallelForBench(16); )
+DEF_BENCH( return new ParallelForBench(256); )
+DEF_BENCH( return new ParallelForBench(0); )
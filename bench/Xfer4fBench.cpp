@@ -6,7 +6,10 @@
  */
 
 #include "Benchmark.h"
+#include "OptsTierBench.h"
+#include "SkOpts.h"
 #include "SkPM4f.h"
+#include "SkRandom.h"
 #include "SkString.h"
 #include "SkXfermode.h"
 
@@ -102,3 +105,65 @@ DEF_BENCH( return new XferD32Bench(SkXfermode::kSrcOver_Mode, "srcover", true,
 DEF_BENCH( return new XferD32Bench(SkXfermode::kSrcOver_Mode, "srcover", true,  F00 | USE_AA); )
 DEF_BENCH( return new XferD32Bench(SkXfermode::kSrcOver_Mode, "srcover", true,  F11 | USE_AA); )
 DEF_BENCH( return new XferD32Bench(SkXfermode::kSrcOver_Mode, "srcover", true,  F01 | USE_AA); )
+
+// The 8888 SrcOver procs the raster blitters use come from SkOpts rather than SkXfermode's
+// D32Procs above; these bench them directly, once per CPU tier.
+class XferOptsBench : public Benchmark {
+public:
+    enum Proc { kRowS32AOpaque, kRowColor32, kMaskD32A8 };
+
+    explicit XferOptsBench(Proc proc) : fProc(proc) {
+        static const char* kNames[] = {
+            "blit_row_s32a_opaque", "blit_row_color32", "blit_mask_d32_a8",
+        };
+        fName.printf("xfer4f_srcover_opts_%s", kNames[proc]);
+
+        SkRandom rand;
+        for (int i = 0; i < N; ++i) {
+            // Mix transparent, opaque, and translucent sources so every branch gets exercised.
+            SkAlpha a = (i % 3 == 0) ? 0x00 : (i % 3 == 1) ? 0xFF : rand.nextU() & 0xFF;
+            fSrc[i] = SkPreMultiplyARGB(a, rand.nextU() & 0xFF, rand.nextU() & 0xFF,
+                                           rand.nextU() & 0xFF);
+            fDst[i] = 0xFF808080;
+            fAA[i]  = i * 255 / (N - 1);
+        }
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops * INNER_LOOPS; ++i) {
+            switch (fProc) {
+                case kRowS32AOpaque:
+                    SkOpts::blit_row_s32a_opaque(fDst, fSrc, N, 0xFF);
+                    break;
+                case kRowColor32:
+                    SkOpts::blit_row_color32(fDst, fDst, N, 0x80402010);
+                    break;
+                case kMaskD32A8:
+                    SkOpts::blit_mask_d32_a8(fDst, sizeof(fDst), fAA, sizeof(fAA),
+                                             0x80204080, N, 1);
+                    break;
+            }
+        }
+    }
+
+private:
+    enum {
+        N = 1000,
+    };
+    Proc       fProc;
+    SkString   fName;
+    SkPMColor  fSrc[N];
+    SkPMColor  fDst[N];
+    SkAlpha    fAA[N];
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_OPTS_TIER_BENCHES( return new XferOptsBench(XferOptsBench::kRowS32AOpaque) )
+DEF_OPTS_TIER_BENCHES( return new XferOptsBench(XferOptsBench::kRowColor32)    )
+DEF_OPTS_TIER_BENCHES( return new XferOptsBench(XferOptsBench::kMaskD32A8)     )
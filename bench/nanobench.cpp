@@ -112,6 +112,7 @@ DEFINE_string(zoom, "1.0,0", "Comma-separated zoomMax,zoomPeriodMs factors for a
 DEFINE_bool(bbh, true, "Build a BBH for SKPs?");
 DEFINE_bool(mpd, true, "Use MultiPictureDraw for the SKPs?");
 DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
+DEFINE_bool(mmapSKPs, false, "Play SKPs back in place from mapped files, rather than parse them?");
 DEFINE_int32(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 DEFINE_bool(resetGpuContext, true, "Reset the GrContext before running each test.");
 DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
@@ -562,6 +563,7 @@ public:
                       , fCurrentSKP(0)
                       , fCurrentUseMPD(0)
                       , fCurrentCodec(0)
+                      , fCurrentThreadedCodec(0)
                       , fCurrentAndroidCodec(0)
                       , fCurrentBRDImage(0)
                       , fCurrentColorType(0)
@@ -569,6 +571,7 @@ public:
                       , fCurrentSubsetType(0)
                       , fCurrentBRDStrategy(0)
                       , fCurrentSampleSize(0)
+                      , fCurrentThreadCount(0)
                       , fCurrentAnimSKP(0) {
         for (int i = 0; i < FLAGS_skps.count(); i++) {
             if (SkStrEndsWith(FLAGS_skps[i], ".skp")) {
@@ -627,6 +630,15 @@ public:
             return nullptr;
         }
 
+        if (FLAGS_mmapSKPs) {
+            sk_sp<SkData> data(SkData::MakeFromFileName(path));
+            if (!data) {
+                SkDebugf("Could not read %s.\n", path);
+                return nullptr;
+            }
+            return SkPicture::MakeFromData(std::move(data));
+        }
+
         SkAutoTDelete<SkStream> stream(SkStream::NewFromFile(path));
         if (stream.get() == nullptr) {
             SkDebugf("Could not read %s.\n", path);
@@ -670,6 +682,7 @@ public:
         // First add all .skps as RecordingBenches.
         while (fCurrentRecording < fSKPs.count()) {
             const SkString& path = fSKPs[fCurrentRecording++];
+            const double loadStart = now_ms();
             sk_sp<SkPicture> pic = ReadPicture(path.c_str());
             if (!pic) {
                 continue;
@@ -677,6 +690,8 @@ public:
             SkString name = SkOSPath::Basename(path.c_str());
             fSourceType = "skp";
             fBenchType  = "recording";
+            fSKPLoadMs  = now_ms() - loadStart;
+            fSKPLoadRSS = sk_tools::getMaxResidentSetSizeMB();
             fSKPBytes = static_cast<double>(SkPictureUtils::ApproximateBytesUsed(pic.get()));
             fSKPOps   = pic->approximateOpCount();
             return new RecordingBench(name.c_str(), pic.get(), FLAGS_bbh);
@@ -809,6 +824,33 @@ public:
             fCurrentColorType = 0;
         }
 
+        // Run CodecBenches that decode with SkCodec::Options::fMaxThreads, for the formats that
+        // can use it.  Compare each to its threads1 run for the speedup.
+        const int threadCounts[] = { 1, 2, 4, 8 };
+        for (; fCurrentThreadedCodec < fImages.count(); fCurrentThreadedCodec++) {
+            fSourceType = "image";
+            fBenchType = "skcodec";
+            const SkString& path = fImages[fCurrentThreadedCodec];
+            if (SkCommandLineFlags::ShouldSkip(FLAGS_match, path.c_str())) {
+                continue;
+            }
+            SkAutoTUnref<SkData> encoded(SkData::NewFromFileName(path.c_str()));
+            SkAutoTDelete<SkCodec> codec(SkCodec::NewFromData(encoded));
+            if (!codec || (kJPEG_SkEncodedFormat != codec->getEncodedFormat() &&
+                           kPNG_SkEncodedFormat != codec->getEncodedFormat())) {
+                continue;
+            }
+
+            if (fCurrentThreadCount < (int) SK_ARRAY_COUNT(threadCounts)) {
+                const SkAlphaType alphaType = kOpaque_SkAlphaType == codec->getInfo().alphaType()
+                                            ? kOpaque_SkAlphaType : kPremul_SkAlphaType;
+                return new CodecBench(SkOSPath::Basename(path.c_str()), encoded,
+                                      kN32_SkColorType, alphaType,
+                                      threadCounts[fCurrentThreadCount++]);
+            }
+            fCurrentThreadCount = 0;
+        }
+
         // Run AndroidCodecBenches
         const int sampleSizes[] = { 2, 4, 8 };
         for (; fCurrentAndroidCodec < fImages.count(); fCurrentAndroidCodec++) {
@@ -959,6 +1001,8 @@ public:
         if (0 == strcmp(fBenchType, "recording")) {
             log->metric("bytes", fSKPBytes);
             log->metric("ops",   fSKPOps);
+            log->metric("load_ms", fSKPLoadMs);
+            log->metric("load_max_rss_mb", fSKPLoadRSS);
         }
     }
 
@@ -986,7 +1030,8 @@ private:
     SkScalar           fZoomMax;
     double             fZoomPeriodMs;
 
-    double fSKPBytes, fSKPOps;
+    double fSKPBytes, fSKPOps, fSKPLoadMs;
+    int fSKPLoadRSS;
 
     const char* fSourceType;  // What we're benching: bench, GM, SKP, ...
     const char* fBenchType;   // How we bench it: micro, recording, playback, ...
@@ -995,6 +1040,7 @@ private:
     int fCurrentSKP;
     int fCurrentUseMPD;
     int fCurrentCodec;
+    int fCurrentThreadedCodec;
     int fCurrentAndroidCodec;
     int fCurrentBRDImage;
     int fCurrentColorType;
@@ -1002,6 +1048,7 @@ private:
     int fCurrentSubsetType;
     int fCurrentBRDStrategy;
     int fCurrentSampleSize;
+    int fCurrentThreadCount;
     int fCurrentAnimSKP;
 };
 
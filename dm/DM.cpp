@@ -25,6 +25,7 @@
 #include "SkMutex.h"
 #include "SkOSFile.h"
 #include "SkPM4fPriv.h"
+#include "SkScan.h"
 #include "SkSpinlock.h"
 #include "SkTHash.h"
 #include "SkTaskGroup.h"
@@ -70,6 +71,8 @@ DEFINE_string(uninterestingHashesFile, "",
 DEFINE_int32(shards, 1, "We're splitting source data into this many shards.");
 DEFINE_int32(shard,  0, "Which shard do I run?");
 DEFINE_bool(simpleCodec, false, "Only decode images to native scale");
+DEFINE_bool(analyticAA, false, "Fill all anti-aliased paths with analytic AA "
+                               "instead of supersampling?");
 
 using namespace DM;
 using sk_gpu_test::GrContextFactory;
@@ -1277,6 +1280,7 @@ int dm_main() {
     SkAutoGraphics ag;
     SkTaskGroup::Enabler enabled(FLAGS_threads);
     gCreateTypefaceDelegate = &create_from_name;
+    gSkForceAnalyticAA = FLAGS_analyticAA;
 
     {
         SkString testResourcePath = GetResourcePath("color_wheel.png");
@@ -34,7 +34,8 @@
       'conditions': [
         [ '"x86" in skia_arch_type and skia_os != "ios"', {
           'cflags': [ '-msse2' ],
-          'dependencies': [ 'opts_ssse3', 'opts_sse41', 'opts_sse42', 'opts_avx', 'opts_avx2' ],
+          'dependencies': [ 'opts_ssse3', 'opts_sse41', 'opts_sse42', 'opts_avx', 'opts_avx2',
+                            'opts_avx512' ],
           'sources': [ '<@(sse2_sources)' ],
         }],
 
@@ -167,9 +168,30 @@
       ],
       'sources': [ '<@(avx2_sources)' ],
       'msvs_settings': { 'VCCLCompilerTool': { 'EnableEnhancedInstructionSet': '5' } },
-      'xcode_settings': { 'OTHER_CPLUSPLUSFLAGS': [ '-mavx2' ] },
+      'xcode_settings': { 'OTHER_CPLUSPLUSFLAGS': [ '-mavx2', '-mf16c' ] },
       'conditions': [
-        [ 'not skia_android_framework', { 'cflags': [ '-mavx2' ] }],
+        [ 'not skia_android_framework', { 'cflags': [ '-mavx2', '-mf16c' ] }],
+      ],
+    },
+    {
+      'target_name': 'opts_avx512',
+      'product_name': 'skia_opts_avx512',
+      'type': 'static_library',
+      'standalone_static_library': 1,
+      'dependencies': [ 'core.gyp:*' ],
+      'include_dirs': [
+          '../include/private',
+          '../src/core',
+          '../src/utils',
+      ],
+      'sources': [ '<@(avx512_sources)' ],
+      'xcode_settings': {
+        'OTHER_CPLUSPLUSFLAGS': [ '-mavx512f', '-mavx512bw', '-mavx512vl' ],
+      },
+      'conditions': [
+        [ 'not skia_android_framework', {
+          'cflags': [ '-mavx512f', '-mavx512bw', '-mavx512vl' ],
+        }],
       ],
     },
     {
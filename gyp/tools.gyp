@@ -232,6 +232,7 @@
       ],
       'dependencies': [
         'flags.gyp:flags',
+        'proc_stats',
         'skia_lib.gyp:skia_lib',
       ],
     },
@@ -241,6 +241,7 @@ public:
         Options()
             : fZeroInitialized(kNo_ZeroInitialized)
             , fSubset(NULL)
+            , fMaxThreads(1)
         {}
 
         ZeroInitialized fZeroInitialized;
@@ -262,6 +263,17 @@ public:
          *  to getScanlines().
          */
         SkIRect*        fSubset;
+
+        /**
+         *  The most threads getPixels() may decode with, counting the calling thread.  The
+         *  default, 1, decodes on the calling thread alone.
+         *
+         *  With more, codecs whose encoding allows it split the decode across SkTaskGroup's
+         *  threads: JPEGs with restart markers decode in strips of rows, and PNGs unfilter rows
+         *  while the rows before them are swizzled.  The pixels are the same either way.  The
+         *  threads only run in parallel if an SkTaskGroup::Enabler is alive.
+         */
+        int             fMaxThreads;
     };
 
     /**
@@ -79,6 +79,14 @@ public:
      */
     static void PurgeFontCache();
 
+    /**
+     *  Specify a directory in which to save the glyphs the font cache makes, so that later
+     *  processes can load them rather than rasterize them again. Entries are saved when they are
+     *  purged from the cache, e.g. by PurgeFontCache(). Any number of processes may share the
+     *  directory. Pass nullptr (the default) to keep the font cache in memory only.
+     */
+    static void SetFontCacheDirectory(const char dir[]);
+
     /**
      *  Scaling bitmaps with the kHigh_SkFilterQuality setting is
      *  expensive, so the result is saved in the global Scaled Image
@@ -54,20 +54,30 @@ public:
 
     class Context {
     public:
-        Context(const SkMatrix& ctm, const SkIRect& clipBounds, Cache* cache)
+        /**
+         *  maxThreads is the most threads filterImage() may use, counting the calling thread.
+         *  With more than one, raster filter DAGs are evaluated in bands of rows on
+         *  SkTaskGroup's threads, and distinct inputs of merge-like filters are filtered in
+         *  parallel.  The result is the same either way.
+         */
+        Context(const SkMatrix& ctm, const SkIRect& clipBounds, Cache* cache,
+                int maxThreads = 1)
             : fCTM(ctm)
             , fClipBounds(clipBounds)
             , fCache(cache)
+            , fMaxThreads(maxThreads)
         {}
 
         const SkMatrix& ctm() const { return fCTM; }
         const SkIRect& clipBounds() const { return fClipBounds; }
         Cache* cache() const { return fCache; }
+        int maxThreads() const { return fMaxThreads; }
 
     private:
         SkMatrix        fCTM;
         SkIRect         fClipBounds;
         Cache*          fCache;
+        int             fMaxThreads;
     };
 
     class CropRect {
@@ -396,6 +406,24 @@ protected:
     sk_sp<SkSpecialImage> applyCropRect(const Context&, SkSpecialImage* src, SkIPoint* srcOffset,
                                         SkIRect* bounds) const;
 
+    /**
+     *  Filters all of this filter's inputs, as filterInput() would, into inputs[] and offsets[],
+     *  which must each have countInputs() entries.  An input filter used more than once is
+     *  only filtered once, and if the context allows more than one thread, distinct input
+     *  filters are filtered in parallel.
+     */
+    void filterInputs(SkSpecialImage* src, const Context&, sk_sp<SkSpecialImage> inputs[],
+                      SkIPoint offsets[]) const;
+
+    /**
+     *  Return true if this filter, given inputs that are correct over some rect, produces
+     *  correct pixels over the rect onFilterNodeBounds() maps that to in the forward
+     *  direction, however the clip bounds cut it.  i.e. its result at a pixel does not depend
+     *  on where the clip or its inputs' bounds end.  DAGs of such filters may be filtered in
+     *  bands, each with its own clip bounds.
+     */
+    virtual bool onCanFilterInTiles() const { return false; }
+
     /**
      *  Creates a modified Context for use when recursing up the image filter DAG.
      *  The clip bounds are adjusted to accommodate any margins that this
@@ -412,6 +440,15 @@ private:
     bool filterImageDeprecated(Proxy*, const SkBitmap& src, const Context&,
                                SkBitmap* result, SkIPoint* offset) const;
 
+    // Can every filter in this DAG be filtered in bands?
+    bool canFilterInTiles() const;
+
+    // Filters src in horizontal bands on SkTaskGroup's threads, each band filtered as if the
+    // clip bounds were just that band, and stitches the bands' results together.  Returns false
+    // without a result if the DAG is not worth splitting up this way.
+    bool filterImageInTiles(SkSpecialImage* src, const Context&, sk_sp<SkSpecialImage>* result,
+                            SkIPoint* offset) const;
+
     bool usesSrcInput() const { return fUsesSrcInput; }
     virtual bool affectsTransparentBlack() const { return false; }
 
@@ -18,6 +18,8 @@
 #include "SkRefCnt.h"
 #include <stddef.h> // ptrdiff_t
 
+class SkData;
+
 class SkRBuffer;
 class SkWBuffer;
 
@@ -305,6 +307,7 @@ private:
         fVerbs = NULL;
         fPoints = NULL;
         fFreeSpace = 0;
+        fSharedStorage = nullptr;
         fGenerationID = kEmptyGenID;
         fSegmentMask = 0;
         fIsOval = false;
@@ -351,6 +354,7 @@ private:
     void resetToSize(int verbCount, int pointCount, int conicCount,
                      int reserveVerbs = 0, int reservePoints = 0) {
         SkDEBUGCODE(this->validate();)
+        SkASSERT(!fSharedStorage);
         fBoundsIsDirty = true;      // this also invalidates fIsFinite
         fGenerationID = 0;
 
@@ -405,6 +409,7 @@ private:
      */
     void makeSpace(size_t size) {
         SkDEBUGCODE(this->validate();)
+        SkASSERT(!fSharedStorage);
         ptrdiff_t growSize = size - fFreeSpace;
         if (growSize <= 0) {
             return;
@@ -443,7 +448,8 @@ private:
     }
 
     /**
-     * Gets the total amount of space allocated for verbs, points, and reserve.
+     * Gets the total amount of space allocated for verbs, points, and reserve. Meaningless when
+     * they are in shared storage, where points and verbs lie apart.
      */
     size_t currSize() const {
         return reinterpret_cast<intptr_t>(fVerbs) - reinterpret_cast<intptr_t>(fPoints);
@@ -484,6 +490,7 @@ private:
     int                 fVerbCnt;
     int                 fPointCnt;
     size_t              fFreeSpace; // redundant but saves computation
+    SkData*             fSharedStorage; // if set, owns fPoints and fVerbs, shared and never edited
     SkTDArray<SkScalar> fConicWeights;
 
     enum {
@@ -501,6 +508,7 @@ private:
     SkBool8  fIsRRect;
     uint8_t  fSegmentMask;
 
+    friend class SkPathRefArena;
     friend class PathRefTest_Private;
     friend class ForceIsRRect_Private; // unit test isRRect
     typedef SkRefCnt INHERITED;
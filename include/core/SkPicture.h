@@ -16,6 +16,7 @@ class GrContext;
 class SkBigPicture;
 class SkBitmap;
 class SkCanvas;
+class SkData;
 class SkPath;
 class SkPictureData;
 class SkPixelSerializer;
@@ -71,6 +72,25 @@ public:
      */
     static sk_sp<SkPicture> MakeFromStream(SkStream*);
 
+    /**
+     *  Recreate a picture that was serialized into data, typically a file mapped with
+     *  SkData::MakeFromFD().  Rather than parsing all its drawing commands up front, the picture
+     *  keeps a ref on the data and plays the commands back from it in place, so loading is quick
+     *  and the commands take no heap memory of their own.  Serialized images are decoded lazily,
+     *  only when a command that draws them is not clipped out.
+     *
+     *  The trade-off is that there is no bounding box hierarchy: every playback reads every
+     *  command, and leaves it to the canvas to reject what falls outside the clip.  A picture
+     *  played back many times in small tiles may be faster loaded with MakeFromStream().
+     *
+     *  @param data Serialized picture data.
+     *  @param proc Function pointer for installing pixelrefs on SkBitmaps representing the
+     *              encoded bitmap data, or NULL to pass them to SkImageGenerator::NewFromEncoded.
+     *  @return A new SkPicture representing the serialized data, or NULL if the data is
+     *          invalid.
+     */
+    static sk_sp<SkPicture> MakeFromData(sk_sp<SkData> data, InstallPixelRefProc proc = NULL);
+
     /**
      *  Recreate a picture that was serialized into a buffer. If the creation requires bitmap
      *  decoding, the decoder must be set on the SkReadBuffer parameter by calling
@@ -187,6 +207,7 @@ private:
     SkPicture();
     friend class SkBigPicture;
     friend class SkEmptyPicture;
+    friend class SkMappedPicture;
     template <typename> friend class SkMiniPicture;
 
     void serialize(SkWStream*, SkPixelSerializer*, SkRefCntSet* typefaces) const;
@@ -207,10 +228,11 @@ private:
     // V43: Added DRAW_IMAGE and DRAW_IMAGE_RECT opt codes to serialized data
     // V44: Move annotations from paint to drawAnnotation
     // V45: Add invNormRotation to SkLightingShader.
+    // V46: Pad the header to 4 bytes, so the ops of a top-level picture can be read in place.
 
     // Only SKPs within the min/current picture version range (inclusive) can be read.
     static const uint32_t     MIN_PICTURE_VERSION = 35;     // Produced by Chrome M39.
-    static const uint32_t CURRENT_PICTURE_VERSION = 45;
+    static const uint32_t CURRENT_PICTURE_VERSION = 46;
 
     static_assert(MIN_PICTURE_VERSION <= 41,
                   "Remove kFontFileName and related code from SkFontDescriptor.cpp.");
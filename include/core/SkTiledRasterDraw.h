@@ -0,0 +1,82 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTiledRasterDraw_DEFINED
+#define SkTiledRasterDraw_DEFINED
+
+#include "../private/SkTDArray.h"
+#include "SkBBHFactory.h"
+#include "SkBitmap.h"
+#include "SkPictureRecorder.h"
+
+class SkCanvas;
+
+/** \class SkTiledRasterDraw
+
+    The TiledRasterDraw object renders into a single raster destination using
+    all available cores.  Draws issued to its recording canvas are captured
+    into an SkRecord with an R-tree, and draw() then plays that recording back
+    one tile at a time in parallel (via SkTaskGroup).  Every tile draws into
+    the same pixel buffer, clipped to its own bounds, with the unmodified CTM,
+    so the result is bit-identical to playing the recording back serially.
+
+    Where SkMultiPictureDraw parallelizes across several canvases, this
+    parallelizes within one.
+*/
+class SK_API SkTiledRasterDraw : SkNoncopyable {
+public:
+    /**
+     *  Create an object that draws into dst's pixels.
+     *  @param dst        the destination; must have pixels allocated and a color
+     *                    type that SkCanvas can draw into.  Its pixels are shared,
+     *                    not copied, and must remain valid until draw() returns.
+     *  @param tileWidth  width of each tile in pixels, clamped to [1, dst width]
+     *  @param tileHeight height of each tile in pixels, clamped to [1, dst height]
+     */
+    SkTiledRasterDraw(const SkBitmap& dst, int tileWidth = 256, int tileHeight = 256);
+    ~SkTiledRasterDraw();
+
+    /**
+     *  Returns the canvas that records draws for the next call to draw().
+     *  The canvas is owned by this object and is invalidated by draw().
+     */
+    SkCanvas* getRecordingCanvas();
+
+    /**
+     *  Play back everything recorded since the last draw() into the destination,
+     *  rendering tiles in parallel.  Returns once every tile is complete.
+     */
+    void draw();
+
+    /**
+     *  Abandon any draws recorded since the last draw().
+     */
+    void reset();
+
+    int tileCount() const { return fTilesX * fTilesY; }
+
+    /** Returns the device-space bounds of tile i, in [0, tileCount()). */
+    SkIRect tileBounds(int i) const;
+
+    /**
+     *  Returns the wall time in milliseconds each tile took during the most
+     *  recent draw(), indexed as tileBounds().  Empty before the first draw().
+     */
+    const SkTDArray<double>& tileTimesMS() const { return fTileTimesMS; }
+
+private:
+    SkBitmap           fDst;
+    int                fTileWidth;
+    int                fTileHeight;
+    int                fTilesX;
+    int                fTilesY;
+    SkRTreeFactory     fFactory;
+    SkPictureRecorder  fRecorder;
+    SkTDArray<double>  fTileTimesMS;
+};
+
+#endif
@@ -35,6 +35,7 @@ protected:
     void flatten(SkWriteBuffer&) const override;
     sk_sp<SkSpecialImage> onFilterImage(SkSpecialImage* source, const Context&,
                                         SkIPoint* offset) const override;
+    bool onCanFilterInTiles() const override { return true; }
     bool onIsColorFilterNode(SkColorFilter**) const override;
     bool affectsTransparentBlack() const override;
 
@@ -42,6 +42,7 @@ protected:
     sk_sp<SkSpecialImage> onFilterImage(SkSpecialImage* source,
                                         const Context&,
                                         SkIPoint* offset) const override;
+    bool onCanFilterInTiles() const override { return true; }
     void flatten(SkWriteBuffer&) const override;
 
     SkISize radius() const { return fRadius; }
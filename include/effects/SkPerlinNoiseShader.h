@@ -88,13 +88,6 @@ public:
         void shadeSpan(int x, int y, SkPMColor[], int count) override;
 
     private:
-        SkPMColor shade(const SkPoint& point, StitchData& stitchData) const;
-        SkScalar calculateTurbulenceValueForPoint(
-            int channel,
-            StitchData& stitchData, const SkPoint& point) const;
-        SkScalar noise2D(int channel,
-                         const StitchData& stitchData, const SkPoint& noiseVector) const;
-
         SkMatrix fMatrix;
         PaintingData* fPaintingData;
 
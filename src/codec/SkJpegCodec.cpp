@@ -12,6 +12,9 @@
 #include "SkCodecPriv.h"
 #include "SkColorPriv.h"
 #include "SkStream.h"
+#include "SkTArray.h"
+#include "SkTaskGroup.h"
+#include "SkTDArray.h"
 #include "SkTemplates.h"
 #include "SkTypes.h"
 
@@ -430,6 +433,236 @@ bool SkJpegCodec::onDimensionsSupported(const SkISize& size) {
     return true;
 }
 
+static int gcd(int a, int b) {
+    while (b) {
+        int r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+namespace {
+// Where the restart intervals of a single scan JPEG are, found by SkJpegCodec::decodeInStrips.
+struct JpegIntervals {
+    size_t            fScanStart;       // Where the entropy coded data starts, after SOS.
+    int               fScanComponents;  // How many components the scan interleaves.
+    size_t            fHeightOffset;    // Where the SOF segment stores the image height.
+    SkTDArray<size_t> fStarts;          // Where each restart interval starts...
+    SkTDArray<size_t> fEnds;            // ...and ends, before its RSTn or EOI marker.
+};
+
+// One strip of rows to decode: a JPEG made of the image's header, patched to the strip's
+// height, then the restart intervals that cover the strip and the rows around it that fancy
+// upsampling looks at.
+struct JpegStrip {
+    sk_sp<SkData> fData;
+    int           fSkipRows;  // Output rows decoded only to get to the strip.
+    int           fDstY;      // The first row of the strip in the destination.
+    int           fRowCount;
+};
+}  // namespace
+
+// Finds the restart intervals of a baseline JPEG with a single scan.  Returns false if the data
+// is anything else, or is cut short.
+static bool find_intervals(const uint8_t* data, size_t size, JpegIntervals* intervals) {
+    intervals->fScanStart = 0;
+    intervals->fHeightOffset = 0;
+    size_t pos = 2;  // Skip SOI.
+    while (!intervals->fScanStart) {
+        if (pos + 4 > size || 0xFF != data[pos]) {
+            return false;
+        }
+        const uint8_t marker = data[pos + 1];
+        if (0xFF == marker) {
+            pos++;  // Fill byte.
+            continue;
+        }
+        const size_t length = (data[pos + 2] << 8) | data[pos + 3];
+        if (0xC0 <= marker && marker <= 0xCF && 0xC4 != marker && 0xC8 != marker &&
+            0xCC != marker) {
+            // Only sequential Huffman coded images can be split at restart markers.
+            if (0xC0 != marker && 0xC1 != marker) {
+                return false;
+            }
+            intervals->fHeightOffset = pos + 5;
+        } else if (0xDA == marker) {  // SOS
+            intervals->fScanStart = pos + 2 + length;
+            intervals->fScanComponents = pos + 4 < size ? data[pos + 4] : 0;
+        }
+        pos += 2 + length;
+    }
+    if (!intervals->fHeightOffset || intervals->fScanStart > size) {
+        return false;
+    }
+
+    *intervals->fStarts.append() = intervals->fScanStart;
+    for (size_t i = intervals->fScanStart; i + 1 < size; i++) {
+        if (0xFF != data[i]) {
+            continue;
+        }
+        const uint8_t marker = data[i + 1];
+        if (0x00 == marker || 0xFF == marker) {
+            continue;  // A stuffed zero or a fill byte.
+        }
+        if (JPEG_RST0 <= marker && marker <= JPEG_RST0 + 7) {
+            *intervals->fEnds.append() = i;
+            *intervals->fStarts.append() = i + 2;
+            i++;
+            continue;
+        }
+        if (JPEG_EOI == marker) {
+            *intervals->fEnds.append() = i;
+            return true;
+        }
+        // Another scan, or a DNL marker.
+        return false;
+    }
+    return false;
+}
+
+// Decodes a strip into dst, and through the swizzler if there is one.  It has its own
+// decompress struct, so strips may be decoded in parallel.
+static bool decode_strip(const JpegStrip& strip, const jpeg_decompress_struct& settings,
+                         SkSwizzler* swizzler, void* dst, size_t dstRowBytes) {
+    SkMemoryStream stream(strip.fData);
+    JpegDecoderMgr decoderMgr(&stream);
+    if (setjmp(decoderMgr.getJmpBuf())) {
+        return decoderMgr.returnFalse("decode_strip/setjmp");
+    }
+    decoderMgr.init();
+    jpeg_decompress_struct* dinfo = decoderMgr.dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, true)) {
+        return false;
+    }
+    dinfo->out_color_space     = settings.out_color_space;
+    dinfo->scale_num           = settings.scale_num;
+    dinfo->scale_denom         = settings.scale_denom;
+    dinfo->dither_mode         = settings.dither_mode;
+    dinfo->dct_method          = settings.dct_method;
+    dinfo->do_fancy_upsampling = settings.do_fancy_upsampling;
+    if (!jpeg_start_decompress(dinfo) || dinfo->output_width != settings.output_width ||
+        (int) dinfo->output_height < strip.fSkipRows + strip.fRowCount) {
+        return false;
+    }
+
+    SkAutoTMalloc<JSAMPLE> storage(get_row_bytes(dinfo));
+    dst = SkTAddOffset<void>(dst, strip.fDstY * dstRowBytes);
+    for (int y = 0; y < strip.fSkipRows + strip.fRowCount; y++) {
+        const bool skip = y < strip.fSkipRows;
+        JSAMPLE* row = (skip || swizzler) ? storage.get() : (JSAMPLE*) dst;
+        if (1 != jpeg_read_scanlines(dinfo, &row, 1)) {
+            return false;
+        }
+        if (skip) {
+            continue;
+        }
+        if (swizzler) {
+            swizzler->swizzle(dst, row);
+        }
+        dst = SkTAddOffset<void>(dst, dstRowBytes);
+    }
+    return true;
+}
+
+bool SkJpegCodec::decodeInStrips(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes,
+                                 int maxThreads) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    const uint8_t* data = (const uint8_t*) this->stream()->getMemoryBase();
+    const size_t size = this->stream()->getLength();
+    if (!data || dinfo->progressive_mode || 0 == dinfo->restart_interval) {
+        return false;
+    }
+
+    JpegIntervals intervals;
+    if (!find_intervals(data, size, &intervals) ||
+        intervals.fScanComponents != dinfo->num_components) {
+        return false;
+    }
+
+    // The scan's MCUs, in source rows.  A single component scan's MCU is a single block.
+    const int width = this->getInfo().width();
+    const int height = this->getInfo().height();
+    const int mcuWidth = 1 == dinfo->num_components ? DCTSIZE :
+                                                      dinfo->max_h_samp_factor * DCTSIZE;
+    const int mcuHeight = 1 == dinfo->num_components ? DCTSIZE :
+                                                       dinfo->max_v_samp_factor * DCTSIZE;
+    const int mcusPerRow = (width + mcuWidth - 1) / mcuWidth;
+    const int mcuRows = (height + mcuHeight - 1) / mcuHeight;
+    const int restartInterval = dinfo->restart_interval;
+    const int intervalCount = (int) intervals.fStarts.count();
+    if (intervalCount != (mcusPerRow * mcuRows + restartInterval - 1) / restartInterval) {
+        return false;
+    }
+
+    // Strips must start on an MCU row that starts a restart interval.  Each strip decodes
+    // from the aligned row before it, and on to the row after it, so fancy upsampling sees
+    // the same rows around the strip's edges as it would in one piece.
+    const int step = restartInterval / gcd(restartInterval, mcusPerRow);
+    const int stripCount = SkTMin(maxThreads, mcuRows / step);
+    if (stripCount < 2) {
+        return false;
+    }
+
+    // Output rows per MCU row; the scale is always n/8, so this is exact.
+    const int outRowsPerMCURow = mcuHeight * dinfo->scale_num / dinfo->scale_denom;
+    SkTArray<JpegStrip> strips;
+    int r0 = 0;
+    for (int i = 1; i <= stripCount; i++) {
+        const int r1 = (i == stripCount) ? mcuRows :
+                SkTMin(mcuRows, SkTMax(r0 + step, mcuRows * i / stripCount / step * step));
+        const int decodeStart = r0 ? r0 - step : 0;
+        const int decodeEnd = SkTMin(r1 + 1, mcuRows);
+        const int firstInterval = decodeStart * mcusPerRow / restartInterval;
+        const int endInterval = SkTMin(intervalCount,
+                (decodeEnd * mcusPerRow + restartInterval - 1) / restartInterval);
+        const int stripHeight = SkTMin(decodeEnd * mcuHeight, height) - decodeStart * mcuHeight;
+
+        // The headers, then each interval followed by its two byte marker, the last one EOI.
+        size_t stripSize = intervals.fScanStart;
+        for (int j = firstInterval; j < endInterval; j++) {
+            stripSize += intervals.fEnds[j] - intervals.fStarts[j] + 2;
+        }
+        sk_sp<SkData> stripData = SkData::MakeUninitialized(stripSize);
+        uint8_t* out = (uint8_t*) stripData->writable_data();
+        memcpy(out, data, intervals.fScanStart);
+        out[intervals.fHeightOffset]     = (uint8_t) (stripHeight >> 8);
+        out[intervals.fHeightOffset + 1] = (uint8_t) stripHeight;
+        out += intervals.fScanStart;
+        for (int j = firstInterval; j < endInterval; j++) {
+            const size_t length = intervals.fEnds[j] - intervals.fStarts[j];
+            memcpy(out, data + intervals.fStarts[j], length);
+            out += length;
+            // Renumber the restart markers to count from RST0 again.
+            *out++ = 0xFF;
+            *out++ = j + 1 < endInterval ? JPEG_RST0 + (j - firstInterval) % 8 : JPEG_EOI;
+        }
+        SkASSERT(out == stripData->bytes() + stripSize);
+
+        JpegStrip& strip = strips.push_back();
+        strip.fData     = std::move(stripData);
+        strip.fSkipRows = (r0 - decodeStart) * outRowsPerMCURow;
+        strip.fDstY     = r0 * outRowsPerMCURow;
+        strip.fRowCount = (r1 == mcuRows ? dstInfo.height() : r1 * outRowsPerMCURow) -
+                          strip.fDstY;
+        r0 = r1;
+        if (r0 == mcuRows) {
+            break;
+        }
+    }
+
+    SkAutoTArray<bool> succeeded(strips.count());
+    SkTaskGroup().batch(strips.count(), [&](int i) {
+        succeeded[i] = decode_strip(strips[i], *dinfo, fSwizzler, dst, dstRowBytes);
+    });
+    for (int i = 0; i < strips.count(); i++) {
+        if (!succeeded[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /*
  * Performs the jpeg decode
  */
@@ -455,6 +688,18 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return fDecoderMgr->returnFailure("conversion_possible", kInvalidConversion);
     }
 
+    // The swizzler needs the output dimensions.
+    jpeg_calc_output_dimensions(dinfo);
+    J_COLOR_SPACE colorSpace = dinfo->out_color_space;
+    if (JCS_CMYK == colorSpace || JCS_RGB == colorSpace) {
+        this->initializeSwizzler(dstInfo, options);
+    }
+
+    if (options.fMaxThreads > 1 &&
+        this->decodeInStrips(dstInfo, dst, dstRowBytes, options.fMaxThreads)) {
+        return kSuccess;
+    }
+
     // Now, given valid output dimensions, we can start the decompress
     if (!jpeg_start_decompress(dinfo)) {
         return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
@@ -464,11 +709,6 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
     // If it's not, we want to know because it means our strategy is not optimal.
     SkASSERT(1 == dinfo->rec_outbuf_height);
 
-    J_COLOR_SPACE colorSpace = dinfo->out_color_space;
-    if (JCS_CMYK == colorSpace || JCS_RGB == colorSpace) {
-        this->initializeSwizzler(dstInfo, options);
-    }
-
     // Perform the decode a single row at a time
     uint32_t dstHeight = dstInfo.height();
 
@@ -101,6 +101,16 @@ private:
      */
     bool setOutputColorSpace(const SkImageInfo& dst);
 
+    /*
+     * Decodes strips of rows in parallel, each from its own copy of the header followed by the
+     * restart intervals that cover it.  Returns false, having written nothing or having to be
+     * written over, if the image can't be decoded this way, so the caller must decode it in one
+     * piece instead.  Assumes the output color space and scale are set, and that fSwizzler is
+     * initialized if the output needs one.
+     */
+    bool decodeInStrips(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes,
+                        int maxThreads);
+
     // scanline decoding
     void initializeSwizzler(const SkImageInfo& dstInfo, const Options& options);
     SkSampler* getSampler(bool createIfNecessary) override;
@@ -16,6 +16,7 @@
 #include "SkSize.h"
 #include "SkStream.h"
 #include "SkSwizzler.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkUtils.h"
 
@@ -547,6 +548,19 @@ bool SkPngCodec::onRewind() {
     return true;
 }
 
+// When decoding with threads, rows are read (inflated and unfiltered) a band at a time, and each
+// band is swizzled on another thread while the next is read.
+static const int kPipelineBandRows = 16;
+
+static void swizzle_rows(SkSwizzler* swizzler, void* dst, size_t dstRowBytes,
+                         const uint8_t* src, size_t srcRowBytes, int count) {
+    for (int y = 0; y < count; y++) {
+        swizzler->swizzle(dst, src);
+        dst = SkTAddOffset<void>(dst, dstRowBytes);
+        src += srcRowBytes;
+    }
+}
+
 SkCodec::Result SkPngCodec::onGetPixels(const SkImageInfo& requestedInfo, void* dst,
                                         size_t dstRowBytes, const Options& options,
                                         SkPMColor ctable[], int* ctableCount,
@@ -575,12 +589,23 @@ SkCodec::Result SkPngCodec::onGetPixels(const SkImageInfo& requestedInfo, void*
     int row = 0;
     // This must be declared above the call to setjmp to avoid memory leaks on incomplete images.
     SkAutoTMalloc<uint8_t> storage;
+    const bool pipelined = fNumberPasses == 1 && options.fMaxThreads > 1;
+    SkTaskGroup swizzleTasks;
     if (setjmp(png_jmpbuf(fPng_ptr))) {
         // Assume that any error that occurs while reading rows is caused by an incomplete input.
         if (fNumberPasses > 1) {
             // FIXME (msarett): Handle incomplete interlaced pngs.
             return (row == height) ? kSuccess : kInvalidInput;
         }
+        if (pipelined) {
+            // Finish the bands before this one, then swizzle what we read of this one.
+            swizzleTasks.wait();
+            const int bandStart = row / kPipelineBandRows * kPipelineBandRows;
+            const uint8_t* band = storage.get() +
+                    (bandStart / kPipelineBandRows & 1) * kPipelineBandRows * srcRowBytes;
+            swizzle_rows(fSwizzler, SkTAddOffset<void>(dst, bandStart * dstRowBytes),
+                         dstRowBytes, band, srcRowBytes, row - bandStart);
+        }
         // FIXME: We do a poor job on incomplete pngs compared to other decoders (ex: Chromium,
         // Ubuntu Image Viewer).  This is because we use the default buffer size in libpng (8192
         // bytes), and if we can't fill the buffer, we immediately fail.
@@ -617,6 +642,28 @@ SkCodec::Result SkPngCodec::onGetPixels(const SkImageInfo& requestedInfo, void*
             dstRow = SkTAddOffset<void>(dstRow, dstRowBytes);
             srcRow += srcRowBytes;
         }
+    } else if (pipelined) {
+        // Two bands: one being read into, and one being swizzled from.
+        storage.reset(2 * kPipelineBandRows * srcRowBytes);
+        while (row < height) {
+            const int bandStart = row;
+            const int bandEnd = SkTMin(height, bandStart + kPipelineBandRows);
+            uint8_t* band = storage.get() +
+                    (bandStart / kPipelineBandRows & 1) * kPipelineBandRows * srcRowBytes;
+            for (; row < bandEnd; row++) {
+                png_read_row(fPng_ptr, band + (row - bandStart) * srcRowBytes, nullptr);
+            }
+
+            // Once the band before is swizzled, its storage is free for the band after.
+            swizzleTasks.wait();
+            SkSwizzler* swizzler = fSwizzler;
+            void* bandDst = SkTAddOffset<void>(dst, bandStart * dstRowBytes);
+            swizzleTasks.add([=] {
+                swizzle_rows(swizzler, bandDst, dstRowBytes, band, srcRowBytes,
+                             bandEnd - bandStart);
+            });
+        }
+        swizzleTasks.wait();
     } else {
         storage.reset(srcRowBytes);
         uint8_t* srcRow = storage.get();
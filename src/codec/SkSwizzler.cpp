@@ -11,15 +11,6 @@
 #include "SkSwizzler.h"
 #include "SkTemplates.h"
 
-static void copy(void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
-        const SkPMColor ctable[]) {
-    // This function must not be called if we are sampling.  If we are not
-    // sampling, deltaSrc should equal bpp.
-    SkASSERT(deltaSrc == bpp);
-
-    memcpy(dst, src + offset, width * bpp);
-}
-
 static void sample1(void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
         const SkPMColor ctable[]) {
     src += offset;
@@ -50,6 +41,63 @@ static void sample4(void* dst, const uint8_t* src, int width, int bpp, int delta
     }
 }
 
+static void copy(void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+    if (deltaSrc != bpp) {
+        switch (bpp) {
+            case 1:
+                return sample1(dst, src, width, bpp, deltaSrc, offset, ctable);
+            case 2:
+                return sample2(dst, src, width, bpp, deltaSrc, offset, ctable);
+            default:
+                SkASSERT(4 == bpp);
+                return sample4(dst, src, width, bpp, deltaSrc, offset, ctable);
+        }
+    }
+
+    memcpy(dst, src + offset, width * bpp);
+}
+
+// The SkOpts swizzles only read tightly packed pixels.  When we are sampling, we gather
+// the pixels we want into a small buffer, a chunk at a time, and swizzle that instead.
+static const int kSwizzleChunk = 128;
+
+template <int kBpp>
+static void opts_swizzle(SkOpts::Swizzle_8888 fn, uint32_t* dst, const uint8_t* src, int width,
+                         int deltaSrc) {
+    if (kBpp == deltaSrc) {
+        fn(dst, src, width);
+        return;
+    }
+
+    uint8_t packed[kSwizzleChunk * kBpp];
+    while (width > 0) {
+        const int n = SkTMin(width, kSwizzleChunk);
+        for (int x = 0; x < n; x++) {
+            memcpy(packed + x * kBpp, src, kBpp);
+            src += deltaSrc;
+        }
+        fn(dst, packed, n);
+        dst += n;
+        width -= n;
+    }
+}
+
+// fn must swizzle to SkPMColor order.  We swizzle a chunk at a time, then pack it to 565.
+template <int kBpp>
+static void opts_swizzle_to_565(SkOpts::Swizzle_8888 fn, uint16_t* dst, const uint8_t* src,
+                                int width, int deltaSrc) {
+    uint32_t pixels[kSwizzleChunk];
+    while (width > 0) {
+        const int n = SkTMin(width, kSwizzleChunk);
+        opts_swizzle<kBpp>(fn, pixels, src, n, deltaSrc);
+        SkOpts::PMColor_to_565(dst, pixels, n);
+        src += n * deltaSrc;
+        dst += n;
+        width -= n;
+    }
+}
+
 // kBit
 // These routines exclusively choose between white and black
 
@@ -256,6 +304,26 @@ static void swizzle_index_to_565(
     }
 }
 
+static void fast_swizzle_index_to_565(
+        void* dstRow, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // The lookups stay scalar, but we can pack the colors we look up to 565 together.
+    src += offset;
+    uint16_t* dst = (uint16_t*) dstRow;
+    SkPMColor colors[kSwizzleChunk];
+    while (width > 0) {
+        const int n = SkTMin(width, kSwizzleChunk);
+        for (int x = 0; x < n; x++) {
+            colors[x] = ctable[*src];
+            src += deltaSrc;
+        }
+        SkOpts::PMColor_to_565(dst, colors, n);
+        dst += n;
+        width -= n;
+    }
+}
+
 // kGray
 
 static void swizzle_gray_to_n32(
@@ -274,9 +342,10 @@ static void fast_swizzle_gray_to_n32(
         void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
         const SkPMColor ctable[]) {
 
-    // This function must not be called if we are sampling.  If we are not
-    // sampling, deltaSrc should equal bpp.
-    SkASSERT(deltaSrc == bpp);
+    // Gathering sampled grays costs about as much as expanding them one at a time.
+    if (deltaSrc != bpp) {
+        return swizzle_gray_to_n32(dst, src, width, bpp, deltaSrc, offset, ctable);
+    }
 
     // Note that there is no need to distinguish between RGB and BGR.
     // Each color channel will get the same value.
@@ -295,6 +364,13 @@ static void swizzle_gray_to_565(
     }
 }
 
+static void fast_swizzle_gray_to_565(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    opts_swizzle_to_565<1>(SkOpts::gray_to_RGB1, (uint16_t*) dst, src + offset, width, deltaSrc);
+}
+
 // kGrayAlpha
 
 static void swizzle_grayalpha_to_n32_unpremul(
@@ -313,13 +389,9 @@ static void fast_swizzle_grayalpha_to_n32_unpremul(
         void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
         const SkPMColor ctable[]) {
 
-    // This function must not be called if we are sampling.  If we are not
-    // sampling, deltaSrc should equal bpp.
-    SkASSERT(deltaSrc == bpp);
-
     // Note that there is no need to distinguish between RGB and BGR.
     // Each color channel will get the same value.
-    SkOpts::grayA_to_RGBA((uint32_t*) dst, src + offset, width);
+    opts_swizzle<2>(SkOpts::grayA_to_RGBA, (uint32_t*) dst, src + offset, width, deltaSrc);
 }
 
 static void swizzle_grayalpha_to_n32_premul(
@@ -339,13 +411,9 @@ static void fast_swizzle_grayalpha_to_n32_premul(
         void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
         const SkPMColor ctable[]) {
 
-    // This function must not be called if we are sampling.  If we are not
-    // sampling, deltaSrc should equal bpp.
-    SkASSERT(deltaSrc == bpp);
-
     // Note that there is no need to distinguish between rgb and bgr.
     // Each color channel will get the same value.
-    SkOpts::grayA_to_rgbA((uint32_t*) dst, src + offset, width);
+    opts_swizzle<2>(SkOpts::grayA_to_rgbA, (uint32_t*) dst, src + offset, width, deltaSrc);
 }
 
 // kBGRX
@@ -362,6 +430,33 @@ static void swizzle_bgrx_to_n32(
     }
 }
 
+static void fast_swizzle_bgrx_to_n32(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+#ifdef SK_PMCOLOR_IS_RGBA
+    opts_swizzle<4>(SkOpts::RGBX_to_BGR1, (uint32_t*) dst, src + offset, width, deltaSrc);
+#else
+    opts_swizzle<4>(SkOpts::RGBX_to_RGB1, (uint32_t*) dst, src + offset, width, deltaSrc);
+#endif
+}
+
+static void fast_swizzle_bgr_to_n32(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // Gathering sampled 3-byte pixels costs about as much as swizzling them one at a time.
+    if (deltaSrc != bpp) {
+        return swizzle_bgrx_to_n32(dst, src, width, bpp, deltaSrc, offset, ctable);
+    }
+
+#ifdef SK_PMCOLOR_IS_RGBA
+    SkOpts::RGB_to_BGR1((uint32_t*) dst, src + offset, width);
+#else
+    SkOpts::RGB_to_RGB1((uint32_t*) dst, src + offset, width);
+#endif
+}
+
 static void swizzle_bgrx_to_565(
         void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int dstWidth,
         int bpp, int deltaSrc, int offset, const SkPMColor ctable[]) {
@@ -374,6 +469,28 @@ static void swizzle_bgrx_to_565(
     }
 }
 
+static void fast_swizzle_bgrx_to_565(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+#ifdef SK_PMCOLOR_IS_RGBA
+    opts_swizzle_to_565<4>(SkOpts::RGBX_to_BGR1, (uint16_t*) dst, src + offset, width, deltaSrc);
+#else
+    opts_swizzle_to_565<4>(SkOpts::RGBX_to_RGB1, (uint16_t*) dst, src + offset, width, deltaSrc);
+#endif
+}
+
+static void fast_swizzle_bgr_to_565(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+#ifdef SK_PMCOLOR_IS_RGBA
+    opts_swizzle_to_565<3>(SkOpts::RGB_to_BGR1, (uint16_t*) dst, src + offset, width, deltaSrc);
+#else
+    opts_swizzle_to_565<3>(SkOpts::RGB_to_RGB1, (uint16_t*) dst, src + offset, width, deltaSrc);
+#endif
+}
+
 // kBGRA
 
 static void swizzle_bgra_to_n32_unpremul(
@@ -393,14 +510,10 @@ static void fast_swizzle_bgra_to_n32_unpremul(
         void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
         const SkPMColor ctable[]) {
 
-    // This function must not be called if we are sampling.  If we are not
-    // sampling, deltaSrc should equal bpp.
-    SkASSERT(deltaSrc == bpp);
-
 #ifdef SK_PMCOLOR_IS_RGBA
-    SkOpts::RGBA_to_BGRA((uint32_t*) dst, src + offset, width);
+    opts_swizzle<4>(SkOpts::RGBA_to_BGRA, (uint32_t*) dst, src + offset, width, deltaSrc);
 #else
-    memcpy(dst, src + offset, width * bpp);
+    copy(dst, src, width, bpp, deltaSrc, offset, ctable);
 #endif
 }
 
@@ -421,14 +534,10 @@ static void fast_swizzle_bgra_to_n32_premul(
         void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
         const SkPMColor ctable[]) {
 
-    // This function must not be called if we are sampling.  If we are not
-    // sampling, deltaSrc should equal bpp.
-    SkASSERT(deltaSrc == bpp);
-
 #ifdef SK_PMCOLOR_IS_RGBA
-    SkOpts::RGBA_to_bgrA((uint32_t*) dst, src + offset, width);
+    opts_swizzle<4>(SkOpts::RGBA_to_bgrA, (uint32_t*) dst, src + offset, width, deltaSrc);
 #else
-    SkOpts::RGBA_to_rgbA((uint32_t*) dst, src + offset, width);
+    opts_swizzle<4>(SkOpts::RGBA_to_rgbA, (uint32_t*) dst, src + offset, width, deltaSrc);
 #endif
 }
 
@@ -450,9 +559,10 @@ static void fast_swizzle_rgb_to_n32(
         void* dst, const uint8_t* src, int width, int bpp, int deltaSrc,
         int offset, const SkPMColor ctable[]) {
 
-    // This function must not be called if we are sampling.  If we are not
-    // sampling, deltaSrc should equal bpp.
-    SkASSERT(deltaSrc == bpp);
+    // Gathering sampled 3-byte pixels costs about as much as swizzling them one at a time.
+    if (deltaSrc != bpp) {
+        return swizzle_rgb_to_n32(dst, src, width, bpp, deltaSrc, offset, ctable);
+    }
 
 #ifdef SK_PMCOLOR_IS_RGBA
     SkOpts::RGB_to_RGB1((uint32_t*) dst, src + offset, width);
@@ -473,6 +583,17 @@ static void swizzle_rgb_to_565(
     }
 }
 
+static void fast_swizzle_rgb_to_565(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+#ifdef SK_PMCOLOR_IS_RGBA
+    opts_swizzle_to_565<3>(SkOpts::RGB_to_RGB1, (uint16_t*) dst, src + offset, width, deltaSrc);
+#else
+    opts_swizzle_to_565<3>(SkOpts::RGB_to_BGR1, (uint16_t*) dst, src + offset, width, deltaSrc);
+#endif
+}
+
 // kRGBA
 
 static void swizzle_rgba_to_n32_premul(
@@ -492,14 +613,10 @@ static void fast_swizzle_rgba_to_n32_premul(
         void* dst, const uint8_t* src, int width, int bpp, int deltaSrc,
         int offset, const SkPMColor ctable[]) {
 
-    // This function must not be called if we are sampling.  If we are not
-    // sampling, deltaSrc should equal bpp.
-    SkASSERT(deltaSrc == bpp);
-
 #ifdef SK_PMCOLOR_IS_RGBA
-    SkOpts::RGBA_to_rgbA((uint32_t*) dst, src + offset, width);
+    opts_swizzle<4>(SkOpts::RGBA_to_rgbA, (uint32_t*) dst, src + offset, width, deltaSrc);
 #else
-    SkOpts::RGBA_to_bgrA((uint32_t*) dst, src + offset, width);
+    opts_swizzle<4>(SkOpts::RGBA_to_bgrA, (uint32_t*) dst, src + offset, width, deltaSrc);
 #endif
 }
 
@@ -520,14 +637,10 @@ static void fast_swizzle_rgba_to_n32_unpremul(
         void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
         const SkPMColor ctable[]) {
 
-    // This function must not be called if we are sampling.  If we are not
-    // sampling, deltaSrc should equal bpp.
-    SkASSERT(deltaSrc == bpp);
-
 #ifdef SK_PMCOLOR_IS_RGBA
-    memcpy(dst, src + offset, width * bpp);
+    copy(dst, src, width, bpp, deltaSrc, offset, ctable);
 #else
-    SkOpts::RGBA_to_BGRA((uint32_t*) dst, src + offset, width);
+    opts_swizzle<4>(SkOpts::RGBA_to_BGRA, (uint32_t*) dst, src + offset, width, deltaSrc);
 #endif
 }
 
@@ -596,14 +709,10 @@ static void fast_swizzle_cmyk_to_n32(
         void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
         const SkPMColor ctable[]) {
 
-    // This function must not be called if we are sampling.  If we are not
-    // sampling, deltaSrc should equal bpp.
-    SkASSERT(deltaSrc == bpp);
-
 #ifdef SK_PMCOLOR_IS_RGBA
-    SkOpts::inverted_CMYK_to_RGB1((uint32_t*) dst, src + offset, width);
+    opts_swizzle<4>(SkOpts::inverted_CMYK_to_RGB1, (uint32_t*) dst, src + offset, width, deltaSrc);
 #else
-    SkOpts::inverted_CMYK_to_BGR1((uint32_t*) dst, src + offset, width);
+    opts_swizzle<4>(SkOpts::inverted_CMYK_to_BGR1, (uint32_t*) dst, src + offset, width, deltaSrc);
 #endif
 }
 
@@ -623,6 +732,26 @@ static void swizzle_cmyk_to_565(
     }
 }
 
+static void fast_swizzle_cmyk_to_565(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+#ifdef SK_PMCOLOR_IS_RGBA
+    opts_swizzle_to_565<4>(SkOpts::inverted_CMYK_to_RGB1, (uint16_t*) dst, src + offset, width,
+                           deltaSrc);
+#else
+    opts_swizzle_to_565<4>(SkOpts::inverted_CMYK_to_BGR1, (uint16_t*) dst, src + offset, width,
+                           deltaSrc);
+#endif
+}
+
+// Returns true if the 8 bytes at p are all zero.
+static bool zero8(const void* p) {
+    uint64_t bytes;
+    memcpy(&bytes, p, sizeof(bytes));
+    return 0 == bytes;
+}
+
 template <SkSwizzler::RowProc proc>
 void SkSwizzler::SkipLeadingGrayAlphaZerosThen(
         void* dst, const uint8_t* src, int width,
@@ -634,6 +763,14 @@ void SkSwizzler::SkipLeadingGrayAlphaZerosThen(
 
     // This may miss opportunities to skip when the output is premultiplied,
     // e.g. for a src pixel 0x00FF which is not zero but becomes zero after premultiplication.
+    if (deltaSrc == bpp) {
+        // Unsampled rows are contiguous, so we can test 4 pixels at a time.
+        while (width >= 4 && zero8(src16)) {
+            width -= 4;
+            dst32 += 4;
+            src16 += 4;
+        }
+    }
     while (width > 0 && *src16 == 0x0000) {
         width--;
         dst32++;
@@ -653,6 +790,14 @@ void SkSwizzler::SkipLeading8888ZerosThen(
 
     // This may miss opportunities to skip when the output is premultiplied,
     // e.g. for a src pixel 0x00FFFFFF which is not zero but becomes zero after premultiplication.
+    if (deltaSrc == bpp) {
+        // Unsampled rows are contiguous, so we can test 2 pixels at a time.
+        while (dstWidth >= 2 && zero8(src32)) {
+            dstWidth -= 2;
+            dst32 += 2;
+            src32 += 2;
+        }
+    }
     while (dstWidth > 0 && *src32 == 0x00000000) {
         dstWidth--;
         dst32++;
@@ -726,6 +871,7 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
                     break;
                 case kRGB_565_SkColorType:
                     proc = &swizzle_index_to_565;
+                    fastProc = &fast_swizzle_index_to_565;
                     break;
                 case kIndex_8_SkColorType:
                     proc = &sample1;
@@ -747,6 +893,7 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
                     break;
                 case kRGB_565_SkColorType:
                     proc = &swizzle_gray_to_565;
+                    fastProc = &fast_swizzle_gray_to_565;
                     break;
                 default:
                     break;
@@ -785,9 +932,11 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
             switch (dstInfo.colorType()) {
                 case kN32_SkColorType:
                     proc = &swizzle_bgrx_to_n32;
+                    fastProc = kBGR == sc ? &fast_swizzle_bgr_to_n32 : &fast_swizzle_bgrx_to_n32;
                     break;
                 case kRGB_565_SkColorType:
                     proc = &swizzle_bgrx_to_565;
+                    fastProc = kBGR == sc ? &fast_swizzle_bgr_to_565 : &fast_swizzle_bgrx_to_565;
                     break;
                 default:
                     break;
@@ -826,6 +975,7 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
                     break;
                 case kRGB_565_SkColorType:
                     proc = &swizzle_rgb_to_565;
+                    fastProc = &fast_swizzle_rgb_to_565;
                     break;
                 default:
                     break;
@@ -864,6 +1014,7 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
                     break;
                 case kRGB_565_SkColorType:
                     proc = &swizzle_cmyk_to_565;
+                    fastProc = &fast_swizzle_cmyk_to_565;
                     break;
                 default:
                     break;
@@ -937,14 +1088,9 @@ int SkSwizzler::onSetSampleX(int sampleX) {
     fSwizzleWidth = get_scaled_dimension(fSrcWidth, sampleX);
     fAllocatedWidth = get_scaled_dimension(fDstWidth, sampleX);
 
-    // The optimized swizzler functions do not support sampling.  Sampled swizzles
-    // are already fast because they skip pixels.  We haven't seen a situation
-    // where speeding up sampling has a significant impact on total decode time.
-    if (1 == fSampleX && fFastProc) {
-        fActualProc = fFastProc;
-    } else {
-        fActualProc = fSlowProc;
-    }
+    // The optimized swizzler functions support sampling too, by gathering the pixels
+    // they need before swizzling them.
+    fActualProc = fFastProc ? fFastProc : fSlowProc;
 
     return fAllocatedWidth;
 }
@@ -169,11 +169,11 @@ private:
                                               int deltaSrc, int offset, const SkPMColor ctable[]);
 
     // May be NULL.  We have not implemented optimized functions for all supported transforms.
+    // Supports sampling.
     const RowProc       fFastProc;
     // Always non-NULL.  Supports sampling.
     const RowProc       fSlowProc;
-    // The actual RowProc we are using.  This depends on if fFastProc is non-NULL and
-    // whether or not we are sampling.
+    // The actual RowProc we are using: fFastProc if it is non-NULL, otherwise fSlowProc.
     RowProc             fActualProc;
 
     const SkPMColor*    fColorTable;      // Unowned pointer
@@ -5,12 +5,14 @@
  * found in the LICENSE file.
  */
 
+#include "Sk4px.h"
 #include "SkAAClip.h"
 #include "SkAtomics.h"
 #include "SkBlitter.h"
 #include "SkColorPriv.h"
 #include "SkPath.h"
 #include "SkScan.h"
+#include "SkTemplates.h"
 #include "SkUtils.h"
 
 class AutoAAClipValidate {
@@ -723,6 +725,14 @@ bool SkAAClip::setRect(const SkIRect& bounds) {
 #endif
 }
 
+size_t SkAAClip::bytesUsed() const {
+    size_t bytes = sizeof(SkAAClip);
+    if (fRunHead) {
+        bytes += sizeof(RunHead) + fRunHead->fRowCount * sizeof(YOffset) + fRunHead->fDataSize;
+    }
+    return bytes;
+}
+
 bool SkAAClip::isRect() const {
     if (this->isEmpty()) {
         return false;
@@ -1011,6 +1021,36 @@ public:
         SkASSERT(row->fWidth <= fBounds.width());
     }
 
+    // Adds the whole row y, run-length encoding its alphas, one per pixel across the bounds.
+    void addRowAlphas(int y, const uint8_t* SK_RESTRICT alphas) {
+        SkASSERT(fBounds.contains(fBounds.fLeft, y));
+
+        y -= fBounds.top();
+        SkASSERT(y > fPrevY);
+        fPrevY = y;
+        Row* row = this->flushRow(true);
+        row->fY = y;
+        row->fWidth = fWidth;
+        fCurrRow = row;
+
+        // At worst every pixel is its own run.
+        SkTDArray<uint8_t>& data = *row->fData;
+        uint8_t* SK_RESTRICT dst = data.append(2 * fWidth);
+        int x = 0;
+        while (x < fWidth) {
+            const uint8_t alpha = alphas[x];
+            int n = 1;
+            while (x + n < fWidth && alphas[x + n] == alpha && n < 255) {
+                n += 1;
+            }
+            dst[0] = n;
+            dst[1] = alpha;
+            dst += 2;
+            x += n;
+        }
+        data.setCount(SkToInt(dst - data.begin()));
+    }
+
     void addColumn(int x, int y, U8CPU alpha, int height) {
         SkASSERT(fBounds.contains(x, y + height - 1));
 
@@ -1582,6 +1622,88 @@ static void operatorX(SkAAClip::Builder& builder, int lastY,
     }
 }
 
+// Returns the number of runs in a row of the given width.
+static int count_row_runs(const uint8_t* row, int width) {
+    int runs = 0;
+    while (width > 0) {
+        width -= row[0];
+        row += 2;
+        runs += 1;
+    }
+    return runs;
+}
+
+// Expands width alphas of the row into dst, starting skip pixels into the row.  Short runs are
+// written 8 alphas at a time, so dst must have room for 8 past width.
+static void expand_row_span(uint8_t* SK_RESTRICT dst, const uint8_t* SK_RESTRICT row,
+                            int skip, int width) {
+    while (skip >= row[0]) {
+        skip -= row[0];
+        row += 2;
+    }
+    int n = SkMin32(row[0] - skip, width);
+    for (;;) {
+        if (n <= 8) {
+            const uint64_t alphas = row[1] * 0x0101010101010101ULL;
+            memcpy(dst, &alphas, 8);
+        } else {
+            memset(dst, row[1], n);
+        }
+        dst += n;
+        width -= n;
+        if (width <= 0) {
+            break;
+        }
+        row += 2;
+        n = SkMin32(row[0], width);
+    }
+}
+
+/*
+ *  Intersecting rows with a run every few pixels spends its time stepping the two RowIters.  For
+ *  those we expand both rows across the bounds, multiply them 16 alphas at a time, and encode
+ *  the product back into runs, merging equal neighbours.  The result matches operatorX's, as
+ *  Sk4px's div255() rounds just as SkMulDiv255Round() does.
+ */
+class RowIntersector {
+public:
+    explicit RowIntersector(const SkIRect& bounds)
+        : fBounds(bounds)
+        , fScratchWidth(SkAlign16(bounds.width() + 8)) {}
+
+    // Worth it only when the rows average fewer than 4 pixels a run.
+    bool wants(const uint8_t* rowA, const SkIRect& boundsA,
+               const uint8_t* rowB, const SkIRect& boundsB) const {
+        return 4 * (count_row_runs(rowA, boundsA.width()) +
+                    count_row_runs(rowB, boundsB.width())) > fBounds.width();
+    }
+
+    void intersect(SkAAClip::Builder& builder, int lastY,
+                   const uint8_t* rowA, const SkIRect& boundsA,
+                   const uint8_t* rowB, const SkIRect& boundsB) {
+        const int width = fBounds.width();
+        if (!fScratch.get()) {
+            fScratch.reset(2 * fScratchWidth);
+            sk_bzero(fScratch.get(), 2 * fScratchWidth);
+        }
+        uint8_t* a = fScratch.get();
+        uint8_t* b = a + fScratchWidth;
+        expand_row_span(a, rowA, fBounds.fLeft - boundsA.fLeft, width);
+        expand_row_span(b, rowB, fBounds.fLeft - boundsB.fLeft, width);
+        // Past width the scratch holds leftovers, which are multiplied but never read back.
+        for (int x = 0; x < width; x += 16) {
+            Sk4px(Sk16b::Load(a + x)).mulWiden(Sk16b::Load(b + x)).div255().store(a + x);
+        }
+
+        builder.addRowAlphas(lastY, a);
+    }
+
+private:
+    const SkIRect          fBounds;
+    const int              fScratchWidth;
+    SkAutoTMalloc<uint8_t> fScratch;
+};
+
 static void adjust_iter(SkAAClip::Iter& iter, int& topA, int& botA, int bot) {
     if (bot == botA) {
         iter.next();
@@ -1595,6 +1717,7 @@ static void operateY(SkAAClip::Builder& builder, const SkAAClip& A,
                      const SkAAClip& B, SkRegion::Op op) {
     AlphaProc proc = find_alpha_proc(op);
     const SkIRect& bounds = builder.getBounds();
+    RowIntersector intersector(bounds);
 
     SkAAClip::Iter iterA(A);
     SkAAClip::Iter iterB(B);
@@ -1648,9 +1771,14 @@ static void operateY(SkAAClip::Builder& builder, const SkAAClip& A,
             builder.addRun(bounds.fLeft, bot - 1, 0, bounds.width());
         } else if (top >= bounds.fTop) {
             SkASSERT(bot <= bounds.fBottom);
-            RowIter rowIterA(rowA, rowA ? A.getBounds() : bounds);
-            RowIter rowIterB(rowB, rowB ? B.getBounds() : bounds);
-            operatorX(builder, bot - 1, rowIterA, rowIterB, proc, bounds);
+            if (SkRegion::kIntersect_Op == op && rowA && rowB &&
+                    intersector.wants(rowA, A.getBounds(), rowB, B.getBounds())) {
+                intersector.intersect(builder, bot - 1, rowA, A.getBounds(), rowB, B.getBounds());
+            } else {
+                RowIter rowIterA(rowA, rowA ? A.getBounds() : bounds);
+                RowIter rowIterB(rowB, rowB ? B.getBounds() : bounds);
+                operatorX(builder, bot - 1, rowIterA, rowIterB, proc, bounds);
+            }
         }
 
         adjust_iter(iterA, topA, botA, bot);
@@ -1772,6 +1900,10 @@ bool SkAAClip::op(const SkRect& rOrig, SkRegion::Op op, bool doAA) {
     switch (op) {
         case SkRegion::kIntersect_Op:
         case SkRegion::kDifference_Op:
+            if (SkRegion::kIntersect_Op == op && rOrig.contains(boundsStorage)) {
+                // we were wholly inside the rect, no change
+                return !this->isEmpty();
+            }
             if (!rStorage.intersect(rOrig, boundsStorage)) {
                 if (SkRegion::kIntersect_Op == op) {
                     return this->setEmpty();
@@ -32,6 +32,9 @@ public:
     // If true, getBounds() can be used in place of this clip.
     bool isRect() const;
 
+    // Returns the bytes used by the clip and its runs, which it may share with other clips.
+    size_t bytesUsed() const;
+
     bool setEmpty();
     bool setRect(const SkIRect&);
     bool setRect(const SkRect&, bool doAA = true);
@@ -7,6 +7,7 @@
 
 #include "SkBBoxHierarchy.h"
 #include "SkBigPicture.h"
+#include "SkPathRefArena.h"
 #include "SkPictureCommon.h"
 #include "SkRecord.h"
 #include "SkRecordDraw.h"
@@ -20,6 +21,7 @@ SkBigPicture::SkBigPicture(const SkRect& cull,
                            size_t approxBytesUsedBySubPictures)
     : fCullRect(cull)
     , fApproxBytesUsedBySubPictures(approxBytesUsedBySubPictures)
+    , fPathBytes(0)
     , fRecord(record)               // Take ownership of caller's ref.
     , fDrawablePicts(drawablePicts) // Take ownership.
     , fBBH(bbh)                     // Take ownership of caller's ref.
@@ -66,8 +68,37 @@ bool   SkBigPicture::hasText()             const { return this->analysis().fHasT
 bool   SkBigPicture::willPlayBackBitmaps() const { return this->analysis().fWillPlaybackBitmaps; }
 int    SkBigPicture::numSlowPaths() const { return this->analysis().fNumSlowPathsAndDashEffects; }
 int    SkBigPicture::approximateOpCount()   const { return fRecord->count(); }
+
+namespace {
+// Sums the bytes held by the record's paths, counting each path ref and packed block once.
+struct PathBytes {
+    template <typename T> void operator()(const T&) {}
+    void operator()(const SkRecords::ClipPath& op)       { this->add(op.path); }
+    void operator()(const SkRecords::DrawPath& op)       { this->add(op.path); }
+    void operator()(const SkRecords::DrawTextOnPath& op) { this->add(op.path); }
+
+    void add(const SkPath& path) { fBytes += SkPathRefArena::ApproximateBytesUsed(path, &fSeen); }
+
+    SkTHashSet<const void*> fSeen;
+    size_t                  fBytes = 0;
+};
+}  // namespace
+
+// The record never changes, so we walk it for its paths only once, the first time we're asked.
+size_t SkBigPicture::pathBytes() const {
+    fPathBytesOnce([this] {
+        PathBytes paths;
+        for (int i = 0; i < fRecord->count(); i++) {
+            fRecord->visit(i, paths);
+        }
+        fPathBytes = paths.fBytes;
+    });
+    return fPathBytes;
+}
+
 size_t SkBigPicture::approximateBytesUsed() const {
-    size_t bytes = sizeof(*this) + fRecord->bytesUsed() + fApproxBytesUsedBySubPictures;
+    size_t bytes = sizeof(*this) + fRecord->bytesUsed() + this->pathBytes() +
+                   fApproxBytesUsedBySubPictures;
     if (fBBH) { bytes += fBBH->bytesUsed(); }
     return bytes;
 }
@@ -8,6 +8,7 @@
 #ifndef SkBigPicture_DEFINED
 #define SkBigPicture_DEFINED
 
+#include "SkOnce.h"
 #include "SkOncePtr.h"
 #include "SkPicture.h"
 #include "SkRect.h"
@@ -78,10 +79,13 @@ private:
     const Analysis& analysis() const;
     int drawableCount() const;
     SkPicture const* const* drawablePicts() const;
+    size_t pathBytes() const;
 
     const SkRect                          fCullRect;
     const size_t                          fApproxBytesUsedBySubPictures;
     SkOncePtr<const Analysis>             fAnalysis;
+    mutable SkOnce                        fPathBytesOnce;
+    mutable size_t                        fPathBytes;
     SkAutoTUnref<const SkRecord>          fRecord;
     SkAutoTDelete<const SnapshotArray>    fDrawablePicts;
     SkAutoTUnref<const SkBBoxHierarchy>   fBBH;
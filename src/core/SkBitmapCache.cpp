@@ -296,7 +296,8 @@ static SkResourceCache::DiscardableFactory get_fact(SkResourceCache* localCache)
 }
 
 const SkMipMap* SkMipMapCache::AddAndRef(const SkBitmap& src, SkResourceCache* localCache) {
-    SkMipMap* mipmap = SkMipMap::Build(src, get_fact(localCache));
+    // Draws often need only the first level or two, so build the rest as they're asked for.
+    SkMipMap* mipmap = SkMipMap::Build(src, get_fact(localCache), true);
     if (mipmap) {
         MipMapRec* rec = new MipMapRec(src, mipmap);
         CHECK_LOCAL(localCache, add, Add, rec);
@@ -137,10 +137,13 @@ public:
                                                info->fPixmap);
 
         // To implement the old shadeSpan entry-point, we need to efficiently convert our native
-        // floats into SkPMColor. The SkXfermode::D32Procs do exactly that.
+        // floats into SkPMColor. The SkXfermode::D32Procs do exactly that. The pipeline works in
+        // linear space, so sRGB sources are encoded back to sRGB: the legacy entry-point is not
+        // color managed, but the filtering in between still is.
         //
         sk_sp<SkXfermode> xfer(SkXfermode::Make(SkXfermode::kSrc_Mode));
-        fXferProc = SkXfermode::GetD32Proc(xfer.get(), 0);
+        fXferProc = SkXfermode::GetD32Proc(xfer.get(), info->fPixmap.info().isSRGB()
+                                                       ? SkXfermode::kDstIsSRGB_D32Flag : 0);
     }
 
     ~LinearPipelineContext() override {
@@ -222,26 +225,37 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+static bool linear_pipeline_supports(SkColorType colorType) {
+    switch (colorType) {
+        case kRGBA_8888_SkColorType:
+        case kBGRA_8888_SkColorType:
+        case kIndex_8_SkColorType:
+        case kRGB_565_SkColorType:
+        case kGray_8_SkColorType:
+        case kRGBA_F16_SkColorType:
+            return true;
+        default:
+            return false;
+    }
+}
+
 static bool choose_linear_pipeline(const SkShader::ContextRec& rec, const SkImageInfo& srcInfo) {
     // These src attributes are not supported in the new 4f context (yet)
     //
-    if (srcInfo.colorType() != kRGBA_8888_SkColorType
-        && srcInfo.colorType() != kBGRA_8888_SkColorType
-        && srcInfo.colorType() != kIndex_8_SkColorType
-        && srcInfo.colorType() != kRGBA_F16_SkColorType) {
+    if (!linear_pipeline_supports(srcInfo.colorType())) {
         return false;
     }
 
-#if 0   // later we may opt-in to the new code even if the client hasn't requested it...
-    // These src attributes are only supported in the new 4f context
+    // These src attributes are only supported in the new 4f context, so use it even if the
+    // client hasn't requested it.
     //
     if (srcInfo.isSRGB() ||
         kUnpremul_SkAlphaType == srcInfo.alphaType() ||
+        kRGBA_F16_SkColorType == srcInfo.colorType() ||
         (4 == srcInfo.bytesPerPixel() && kN32_SkColorType != srcInfo.colorType()))
     {
         return true;
     }
-#endif
 
     // If we get here, we can reasonably use either context, respect the caller's preference
     //
@@ -279,10 +293,7 @@ SkShader::Context* SkBitmapProcShader::MakeContext(const SkShader& shader,
             info->~SkBitmapProcInfo();
             return nullptr;
         }
-        if (info->fPixmap.colorType() != kRGBA_8888_SkColorType
-            && info->fPixmap.colorType() != kBGRA_8888_SkColorType
-            && info->fPixmap.colorType() != kIndex_8_SkColorType
-            && info->fPixmap.colorType() != kRGBA_F16_SkColorType) {
+        if (!linear_pipeline_supports(info->fPixmap.colorType())) {
             return nullptr;
         }
         return new (storage) LinearPipelineContext(shader, rec, info);
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "Sk4px.h"
 #include "SkBlitMask.h"
 #include "SkColor.h"
 #include "SkColorPriv.h"
@@ -134,48 +135,28 @@ static void BW_RowProc_Opaque(
     }
 }
 
+// These blend four or eight pixels at a time, like SkOpts::blit_mask_d32_a8.  approxMulDiv255()
+// may be off by one, but is exact when the mask is 0 or 255, so those pixels are left or replaced.
 static void A8_RowProc_Blend(
         SkPMColor* SK_RESTRICT dst, const void* maskIn, const SkPMColor* SK_RESTRICT src, int count) {
     const uint8_t* SK_RESTRICT mask = static_cast<const uint8_t*>(maskIn);
-    for (int i = 0; i < count; ++i) {
-        if (mask[i]) {
-            dst[i] = SkBlendARGB32(src[i], dst[i], mask[i]);
-        }
-    }
+    Sk4px::MapDstSrcAlpha(count, dst, src, mask, [](const Sk4px& d, const Sk4px& s,
+                                                   const Sk4px& aa) {
+        //  = s*aa + d(1-sa*aa)
+        auto left  = s.approxMulDiv255(aa),
+             right = d.approxMulDiv255(left.alphas().inv());
+        return left + right;  // This does not overflow (exhaustively checked).
+    });
 }
 
-// expand the steps that SkAlphaMulQ performs, but this way we can
-//  exand.. add.. combine
-// instead of
-// expand..combine add expand..combine
-//
-#define EXPAND0(v, m, s)    ((v) & (m)) * (s)
-#define EXPAND1(v, m, s)    (((v) >> 8) & (m)) * (s)
-#define COMBINE(e0, e1, m)  ((((e0) >> 8) & (m)) | ((e1) & ~(m)))
-
 static void A8_RowProc_Opaque(
         SkPMColor* SK_RESTRICT dst, const void* maskIn, const SkPMColor* SK_RESTRICT src, int count) {
     const uint8_t* SK_RESTRICT mask = static_cast<const uint8_t*>(maskIn);
-    for (int i = 0; i < count; ++i) {
-        int m = mask[i];
-        if (m) {
-            m += (m >> 7);
-#if 1
-            // this is slightly slower than the expand/combine version, but it
-            // is much closer to the old results, so we use it for now to reduce
-            // rebaselining.
-            dst[i] = SkAlphaMulQ(src[i], m) + SkAlphaMulQ(dst[i], 256 - m);
-#else
-            uint32_t v = src[i];
-            uint32_t s0 = EXPAND0(v, rbmask, m);
-            uint32_t s1 = EXPAND1(v, rbmask, m);
-            v = dst[i];
-            uint32_t d0 = EXPAND0(v, rbmask, m);
-            uint32_t d1 = EXPAND1(v, rbmask, m);
-            dst[i] = COMBINE(s0 + d0, s1 + d1, rbmask);
-#endif
-        }
-    }
+    Sk4px::MapDstSrcAlpha(count, dst, src, mask, [](const Sk4px& d, const Sk4px& s,
+                                                   const Sk4px& aa) {
+        //  = s*aa + d(1-aa)
+        return s.approxMulDiv255(aa) + d.approxMulDiv255(aa.inv());
+    });
 }
 
 static int upscale31To255(int value) {
@@ -7,6 +7,7 @@
 
 #include "SkCoreBlitters.h"
 #include "SkColorPriv.h"
+#include "SkOpts.h"
 #include "SkShader.h"
 #include "SkUtils.h"
 #include "SkXfermode.h"
@@ -38,6 +39,72 @@ static void SkARGB32_Blit32(const SkPixmap& device, const SkMask& mask,
     } while (--height != 0);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Runs at least this long are blended one at a time.  Shorter runs, the anti-aliased edges of a
+// shape, are gathered into a row of coverage and blended together in one vectorized pass.
+static const int kMinSoloRun = 8;
+static const int kMaxCoverageSpan = 256;
+
+// Calls run(offset, count, aa) for each long run and each lone short run with coverage, and
+// span(offset, count, coverage) for each stretch of neighbouring short runs, where offset is
+// from the start of the row.  Zero coverage is skipped, except between the short runs of a
+// stretch, where blending it leaves the device as it is.
+template <typename RunProc, typename SpanProc>
+static void blit_aa_runs(const SkAlpha antialias[], const int16_t runs[],
+                         const RunProc& run, const SpanProc& span) {
+    SkAlpha coverage[kMaxCoverageSpan];
+    int     offset = 0;
+    int     spanOffset = 0;
+    int     spanCount = 0;  // through the last run with coverage
+    int     spanFill = 0;   // including any zero runs after it
+    int     spanRuns = 0;
+
+    auto flush = [&]() {
+        if (1 == spanRuns) {
+            run(spanOffset, spanCount, coverage[0]);
+        } else if (spanRuns > 1) {
+            span(spanOffset, spanCount, coverage);
+        }
+        spanCount = spanFill = spanRuns = 0;
+    };
+
+    for (;;) {
+        int count = runs[0];
+        SkASSERT(count >= 0);
+        if (count <= 0) {
+            break;
+        }
+        unsigned aa = antialias[0];
+        if (count >= kMinSoloRun) {
+            flush();
+            if (aa) {
+                run(offset, count, aa);
+            }
+        } else {
+            if (spanFill + count > kMaxCoverageSpan) {
+                flush();
+            }
+            // A stretch never starts with zero coverage.
+            if (aa || spanRuns > 0) {
+                if (0 == spanFill) {
+                    spanOffset = offset;
+                }
+                memset(coverage + spanFill, aa, count);
+                spanFill += count;
+                if (aa) {
+                    spanCount = spanFill;
+                    spanRuns += 1;
+                }
+            }
+        }
+        runs += count;
+        antialias += count;
+        offset += count;
+    }
+    flush();
+}
+
 //////////////////////////////////////////////////////////////////////////////////////
 
 SkARGB32_Blitter::SkARGB32_Blitter(const SkPixmap& device, const SkPaint& paint)
@@ -84,25 +151,17 @@ void SkARGB32_Blitter::blitAntiH(int x, int y, const SkAlpha antialias[],
     uint32_t*   device = fDevice.writable_addr32(x, y);
     unsigned    opaqueMask = fSrcA; // if fSrcA is 0xFF, then we will catch the fast opaque case
 
-    for (;;) {
-        int count = runs[0];
-        SkASSERT(count >= 0);
-        if (count <= 0) {
-            return;
-        }
-        unsigned aa = antialias[0];
-        if (aa) {
-            if ((opaqueMask & aa) == 255) {
-                sk_memset32(device, color, count);
-            } else {
-                uint32_t sc = SkAlphaMulQ(color, SkAlpha255To256(aa));
-                SkBlitRow::Color32(device, device, count, sc);
-            }
+    blit_aa_runs(antialias, runs, [&](int offset, int count, unsigned aa) {
+        if ((opaqueMask & aa) == 255) {
+            sk_memset32(device + offset, color, count);
+        } else {
+            uint32_t sc = SkAlphaMulQ(color, SkAlpha255To256(aa));
+            SkBlitRow::Color32(device + offset, device + offset, count, sc);
         }
-        runs += count;
-        antialias += count;
-        device += count;
-    }
+    }, [&](int offset, int count, const SkAlpha coverage[]) {
+        SkOpts::blit_mask_d32_a8(device + offset, fDevice.rowBytes(), coverage, count,
+                                 fColor, count, 1);
+    });
 }
 
 void SkARGB32_Blitter::blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) {
@@ -263,30 +322,23 @@ void SkARGB32_Black_Blitter::blitAntiH(int x, int y, const SkAlpha antialias[],
     uint32_t*   device = fDevice.writable_addr32(x, y);
     SkPMColor   black = (SkPMColor)(SK_A32_MASK << SK_A32_SHIFT);
 
-    for (;;) {
-        int count = runs[0];
-        SkASSERT(count >= 0);
-        if (count <= 0) {
-            return;
-        }
-        unsigned aa = antialias[0];
-        if (aa) {
-            if (aa == 255) {
-                sk_memset32(device, black, count);
-            } else {
-                SkPMColor src = aa << SK_A32_SHIFT;
-                unsigned dst_scale = 256 - aa;
-                int n = count;
-                do {
-                    --n;
-                    device[n] = src + SkAlphaMulQ(device[n], dst_scale);
-                } while (n > 0);
-            }
+    blit_aa_runs(antialias, runs, [&](int offset, int count, unsigned aa) {
+        uint32_t* dst = device + offset;
+        if (aa == 255) {
+            sk_memset32(dst, black, count);
+        } else {
+            SkPMColor src = aa << SK_A32_SHIFT;
+            unsigned dst_scale = 256 - aa;
+            int n = count;
+            do {
+                --n;
+                dst[n] = src + SkAlphaMulQ(dst[n], dst_scale);
+            } while (n > 0);
         }
-        runs += count;
-        antialias += count;
-        device += count;
-    }
+    }, [&](int offset, int count, const SkAlpha coverage[]) {
+        SkOpts::blit_mask_d32_a8(device + offset, fDevice.rowBytes(), coverage, count,
+                                 SK_ColorBLACK, count, 1);
+    });
 }
 
 void SkARGB32_Black_Blitter::blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) {
@@ -461,71 +513,52 @@ void SkARGB32_Shader_Blitter::blitAntiH(int x, int y, const SkAlpha antialias[],
     SkShader::Context* shaderContext = fShaderContext;
 
     if (fXfermode && !fShadeDirectlyIntoDevice) {
-        for (;;) {
-            SkXfermode* xfer = fXfermode;
-
-            int count = *runs;
-            if (count <= 0)
-                break;
-            int aa = *antialias;
-            if (aa) {
-                shaderContext->shadeSpan(x, y, span, count);
-                if (aa == 255) {
-                    xfer->xfer32(device, span, count, nullptr);
-                } else {
-                    // count is almost always 1
-                    for (int i = count - 1; i >= 0; --i) {
-                        xfer->xfer32(&device[i], &span[i], 1, antialias);
-                    }
+        SkXfermode* xfer = fXfermode;
+        blit_aa_runs(antialias, runs, [&](int offset, int count, unsigned aa) {
+            shaderContext->shadeSpan(x + offset, y, span, count);
+            if (aa == 255) {
+                xfer->xfer32(device + offset, span, count, nullptr);
+            } else {
+                // count is almost always 1
+                for (int i = count - 1; i >= 0; --i) {
+                    xfer->xfer32(&device[offset + i], &span[i], 1, antialias + offset);
                 }
             }
-            device += count;
-            runs += count;
-            antialias += count;
-            x += count;
-        }
+        }, [&](int offset, int count, const SkAlpha coverage[]) {
+            shaderContext->shadeSpan(x + offset, y, span, count);
+            xfer->xfer32(device + offset, span, count, coverage);
+        });
     } else if (fShadeDirectlyIntoDevice ||
                (shaderContext->getFlags() & SkShader::kOpaqueAlpha_Flag)) {
-        for (;;) {
-            int count = *runs;
-            if (count <= 0) {
-                break;
-            }
-            int aa = *antialias;
-            if (aa) {
-                if (aa == 255) {
-                    // cool, have the shader draw right into the device
-                    shaderContext->shadeSpan(x, y, device, count);
-                } else {
-                    shaderContext->shadeSpan(x, y, span, count);
-                    fProc32Blend(device, span, count, aa);
-                }
+        // Opaque sources, and kSrc_Mode, just lerp from the device to the source by coverage.
+        SkBlitMask::RowProc proc = SkBlitMask::RowFactory(kN32_SkColorType, SkMask::kA8_Format,
+                                                          SkBlitMask::kSrcIsOpaque_RowFlag);
+        blit_aa_runs(antialias, runs, [&](int offset, int count, unsigned aa) {
+            if (aa == 255) {
+                // cool, have the shader draw right into the device
+                shaderContext->shadeSpan(x + offset, y, device + offset, count);
+            } else {
+                shaderContext->shadeSpan(x + offset, y, span, count);
+                fProc32Blend(device + offset, span, count, aa);
             }
-            device += count;
-            runs += count;
-            antialias += count;
-            x += count;
-        }
+        }, [&](int offset, int count, const SkAlpha coverage[]) {
+            shaderContext->shadeSpan(x + offset, y, span, count);
+            proc(device + offset, coverage, span, count);
+        });
     } else {
-        for (;;) {
-            int count = *runs;
-            if (count <= 0) {
-                break;
-            }
-            int aa = *antialias;
-            if (aa) {
-                shaderContext->shadeSpan(x, y, span, count);
-                if (aa == 255) {
-                    fProc32(device, span, count, 255);
-                } else {
-                    fProc32Blend(device, span, count, aa);
-                }
+        SkBlitMask::RowProc proc = SkBlitMask::RowFactory(kN32_SkColorType, SkMask::kA8_Format,
+                                                          (SkBlitMask::RowFlags)0);
+        blit_aa_runs(antialias, runs, [&](int offset, int count, unsigned aa) {
+            shaderContext->shadeSpan(x + offset, y, span, count);
+            if (aa == 255) {
+                fProc32(device + offset, span, count, 255);
+            } else {
+                fProc32Blend(device + offset, span, count, aa);
             }
-            device += count;
-            runs += count;
-            antialias += count;
-            x += count;
-        }
+        }, [&](int offset, int count, const SkAlpha coverage[]) {
+            shaderContext->shadeSpan(x + offset, y, span, count);
+            proc(device + offset, coverage, span, count);
+        });
     }
 }
 
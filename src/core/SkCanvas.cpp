@@ -1680,9 +1680,12 @@ void SkCanvas::onClipPath(const SkPath& path, SkRegion::Op op, ClipEdgeStyle edg
         }
 
         op = SkRegion::kReplace_Op;
+        fMCRec->fRasterClip.op(devPath, this->getTopLayerBounds(), op, edgeStyle);
+        return;
     }
 
-    fMCRec->fRasterClip.op(devPath, this->getTopLayerBounds(), op, edgeStyle);
+    fMCRec->fRasterClip.op(path, fMCRec->fMatrix, devPath, this->getTopLayerBounds(), op,
+                           edgeStyle);
 }
 
 void SkCanvas::clipRegion(const SkRegion& rgn, SkRegion::Op op) {
@@ -681,6 +681,14 @@ void SkClipStack::pushElement(const Element& element) {
     Element* prior = (Element*) iter.prev();
 
     if (prior) {
+        if (SkRegion::kIntersect_Op == element.getOp() &&
+            Element::kRect_Type == element.getType() &&
+            kNormal_BoundsType == prior->fFiniteBoundType &&
+            element.getRect().contains(SkRect::Make(prior->fFiniteBound.roundOut()))) {
+            // The rect covers every pixel the clip reaches, AA or not, so it changes nothing.
+            // Dropping it keeps the stack short and its gen ID, so cached clip masks stay valid.
+            return;
+        }
         if (prior->canBeIntersectedInPlace(fSaveCount, element.getOp())) {
             switch (prior->fType) {
                 case Element::kEmpty_Type:
@@ -4,9 +4,14 @@
 
 #include "SkConvolver.h"
 #include "SkTArray.h"
+#include "SkTaskGroup.h"
 
 namespace {
 
+    // The fewest output rows, and filter spans of input rows, that a band convolves.
+    const int kMinBandOutputRows  = 16;
+    const int kMinBandFilterSpans = 8;
+
     // Converts the argument to an 8-bit unsigned value by clamping to the range
     // 0-255.
     inline unsigned char ClampTo8(int a) {
@@ -352,16 +357,6 @@ bool BGRAConvolve2D(const unsigned char* sourceData,
 
     int maxYFilterSize = filterY.maxFilter();
 
-    // The next row in the input that we will generate a horizontally
-    // convolved row for. If the filter doesn't start at the beginning of the
-    // image (this is the case when we are only resizing a subset), then we
-    // don't want to generate any output rows before that. Compute the starting
-    // row for convolution as the first pixel for the first vertical filter.
-    int filterOffset, filterLength;
-    const SkConvolutionFilter1D::ConvolutionFixed* filterValues =
-        filterY.FilterForValue(0, &filterOffset, &filterLength);
-    int nextXRow = filterOffset;
-
     // We loop over each row in the input doing a horizontal convolution. This
     // will result in a horizontally convolved image. We write the results into
     // a circular buffer of convolved rows and do vertical convolution as rows
@@ -389,12 +384,6 @@ bool BGRAConvolve2D(const unsigned char* sourceData,
         }
     }
 
-    CircularRowBuffer rowBuffer(rowBufferWidth,
-                                rowBufferHeight,
-                                filterOffset);
-
-    // Loop over every possible output row, processing just enough horizontal
-    // convolutions to run each subsequent vertical convolution.
     SkASSERT(outputByteRowStride >= filterX.numValues() * 4);
     int numOutputRows = filterY.numValues();
 
@@ -417,70 +406,116 @@ bool BGRAConvolve2D(const unsigned char* sourceData,
     filterY.FilterForValue(numOutputRows - 1, &lastFilterOffset,
                            &lastFilterLength);
 
-    for (int outY = 0; outY < numOutputRows; outY++) {
-        filterValues = filterY.FilterForValue(outY,
-                                              &filterOffset, &filterLength);
-
-        // Generate output rows until we have enough to run the current filter.
-        while (nextXRow < filterOffset + filterLength) {
-            if (convolveProcs.fConvolve4RowsHorizontally &&
-                nextXRow + 3 < lastFilterOffset + lastFilterLength -
-                avoidSimdRows) {
-                const unsigned char* src[4];
-                unsigned char* outRow[4];
-                for (int i = 0; i < 4; ++i) {
-                    src[i] = &sourceData[(uint64_t)(nextXRow + i) * sourceByteRowStride];
-                    outRow[i] = rowBuffer.advanceRow();
-                }
-                convolveProcs.fConvolve4RowsHorizontally(src, filterX, outRow, 4*rowBufferWidth);
-                nextXRow += 4;
-            } else {
-                // Check if we need to avoid SSE2 for this row.
-                if (convolveProcs.fConvolveHorizontally &&
-                    nextXRow < lastFilterOffset + lastFilterLength -
+    // Convolves output rows [firstOutY, stopOutY), with a circular buffer of its own.
+    auto convolveBand = [&](int firstOutY, int stopOutY) {
+        // The next row in the input that we will generate a horizontally
+        // convolved row for. If the filter doesn't start at the beginning of the
+        // image (this is the case when we are only resizing a subset), then we
+        // don't want to generate any output rows before that. Compute the starting
+        // row for convolution as the first pixel the band's vertical filters read.
+        int filterOffset, filterLength;
+        int nextXRow = SK_MaxS32;
+        for (int outY = firstOutY; outY < stopOutY; outY++) {
+            if (filterY.FilterForValue(outY, &filterOffset, &filterLength)) {
+                nextXRow = SkTMin(nextXRow, filterOffset);
+            }
+        }
+        if (SK_MaxS32 == nextXRow) {
+            filterY.FilterForValue(firstOutY, &nextXRow, &filterLength);
+        }
+
+        CircularRowBuffer rowBuffer(rowBufferWidth,
+                                    rowBufferHeight,
+                                    nextXRow);
+
+        // Loop over every output row of the band, processing just enough horizontal
+        // convolutions to run each subsequent vertical convolution.
+        for (int outY = firstOutY; outY < stopOutY; outY++) {
+            const SkConvolutionFilter1D::ConvolutionFixed* filterValues =
+                filterY.FilterForValue(outY, &filterOffset, &filterLength);
+
+            // Generate output rows until we have enough to run the current filter.
+            while (nextXRow < filterOffset + filterLength) {
+                if (convolveProcs.fConvolve4RowsHorizontally &&
+                    nextXRow + 3 < lastFilterOffset + lastFilterLength -
                     avoidSimdRows) {
-                    convolveProcs.fConvolveHorizontally(
-                        &sourceData[(uint64_t)nextXRow * sourceByteRowStride],
-                        filterX, rowBuffer.advanceRow(), sourceHasAlpha);
+                    const unsigned char* src[4];
+                    unsigned char* outRow[4];
+                    for (int i = 0; i < 4; ++i) {
+                        src[i] = &sourceData[(uint64_t)(nextXRow + i) * sourceByteRowStride];
+                        outRow[i] = rowBuffer.advanceRow();
+                    }
+                    convolveProcs.fConvolve4RowsHorizontally(src, filterX, outRow,
+                                                             4*rowBufferWidth);
+                    nextXRow += 4;
                 } else {
-                    if (sourceHasAlpha) {
-                        ConvolveHorizontallyAlpha(
+                    // Check if we need to avoid SSE2 for this row.
+                    if (convolveProcs.fConvolveHorizontally &&
+                        nextXRow < lastFilterOffset + lastFilterLength -
+                        avoidSimdRows) {
+                        convolveProcs.fConvolveHorizontally(
                             &sourceData[(uint64_t)nextXRow * sourceByteRowStride],
-                            filterX, rowBuffer.advanceRow());
+                            filterX, rowBuffer.advanceRow(), sourceHasAlpha);
                     } else {
-                        ConvolveHorizontallyNoAlpha(
-                            &sourceData[(uint64_t)nextXRow * sourceByteRowStride],
-                            filterX, rowBuffer.advanceRow());
+                        if (sourceHasAlpha) {
+                            ConvolveHorizontallyAlpha(
+                                &sourceData[(uint64_t)nextXRow * sourceByteRowStride],
+                                filterX, rowBuffer.advanceRow());
+                        } else {
+                            ConvolveHorizontallyNoAlpha(
+                                &sourceData[(uint64_t)nextXRow * sourceByteRowStride],
+                                filterX, rowBuffer.advanceRow());
+                        }
                     }
+                    nextXRow++;
                 }
-                nextXRow++;
             }
-        }
 
-        // Compute where in the output image this row of final data will go.
-        unsigned char* curOutputRow = &output[(uint64_t)outY * outputByteRowStride];
+            // Compute where in the output image this row of final data will go.
+            unsigned char* curOutputRow = &output[(uint64_t)outY * outputByteRowStride];
 
-        // Get the list of rows that the circular buffer has, in order.
-        int firstRowInCircularBuffer;
-        unsigned char* const* rowsToConvolve =
-            rowBuffer.GetRowAddresses(&firstRowInCircularBuffer);
+            // Get the list of rows that the circular buffer has, in order.
+            int firstRowInCircularBuffer;
+            unsigned char* const* rowsToConvolve =
+                rowBuffer.GetRowAddresses(&firstRowInCircularBuffer);
 
-        // Now compute the start of the subset of those rows that the filter
-        // needs.
-        unsigned char* const* firstRowForFilter =
-            &rowsToConvolve[filterOffset - firstRowInCircularBuffer];
+            // Now compute the start of the subset of those rows that the filter
+            // needs.
+            unsigned char* const* firstRowForFilter =
+                &rowsToConvolve[filterOffset - firstRowInCircularBuffer];
 
-        if (convolveProcs.fConvolveVertically) {
-            convolveProcs.fConvolveVertically(filterValues, filterLength,
-                                               firstRowForFilter,
-                                               filterX.numValues(), curOutputRow,
-                                               sourceHasAlpha);
-        } else {
-            ConvolveVertically(filterValues, filterLength,
-                               firstRowForFilter,
-                               filterX.numValues(), curOutputRow,
-                               sourceHasAlpha);
+            if (convolveProcs.fConvolveVertically) {
+                convolveProcs.fConvolveVertically(filterValues, filterLength,
+                                                   firstRowForFilter,
+                                                   filterX.numValues(), curOutputRow,
+                                                   sourceHasAlpha);
+            } else {
+                ConvolveVertically(filterValues, filterLength,
+                                   firstRowForFilter,
+                                   filterX.numValues(), curOutputRow,
+                                   sourceHasAlpha);
+            }
         }
+    };
+
+    // Split the output into bands of rows, convolved in parallel.  Each band horizontally
+    // convolves the input rows its first filter shares with the band above all over again,
+    // so only split as far as the cores we have, and while bands still span many times more
+    // input rows than a filter does.
+    int firstFilterOffset, firstFilterLength;
+    filterY.FilterForValue(0, &firstFilterOffset, &firstFilterLength);
+    const int inputRows = lastFilterOffset + lastFilterLength - firstFilterOffset;
+    const int bandCount = SkTMax(1, SkTMin(sk_num_cores(),
+                                           SkTMin(numOutputRows / kMinBandOutputRows,
+                                                  inputRows / (kMinBandFilterSpans *
+                                                               SkTMax(1, maxYFilterSize)))));
+    if (1 == bandCount) {
+        convolveBand(0, numOutputRows);
+    } else {
+        sk_parallel_for(bandCount, 1, [&](int band) {
+            convolveBand(numOutputRows *  band      / bandCount,
+                         numOutputRows * (band + 1) / bandCount);
+        });
     }
     return true;
 }
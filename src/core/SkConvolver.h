@@ -190,6 +190,9 @@ struct SkConvolutionProcs {
 //
 // The layout in memory is assumed to be 4-bytes per pixel in B-G-R-A order
 // (this is ARGB when loaded into 32-bit words on a little-endian machine).
+//
+// Large outputs are split into bands of rows that are convolved in parallel on
+// SkTaskGroup's threads, each with its own buffer of horizontally convolved rows.
 /**
  *  Returns false if it was unable to perform the convolution/rescale. in which case the output
  *  buffer is assumed to be undefined.
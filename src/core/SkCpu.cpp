@@ -52,6 +52,12 @@
 
             cpuid7(abcd);
             if (abcd[1] & (1<<5)) { features |= SkCpu::AVX2; }
+
+            if ((xgetbv(0) & 0xe0) == 0xe0) {  // The OS saves opmask and all 512-bit registers.
+                if (abcd[1] & (1u<<16)) { features |= SkCpu::AVX512F ; }
+                if (abcd[1] & (1u<<30)) { features |= SkCpu::AVX512BW; }
+                if (abcd[1] & (1u<<31)) { features |= SkCpu::AVX512VL; }
+            }
         }
         return features;
     }
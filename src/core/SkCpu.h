@@ -22,6 +22,10 @@ struct SkCpu {
         F16C  = 1 << 7,
         FMA   = 1 << 8,
         AVX2  = 1 << 9,
+
+        AVX512F  = 1 << 10,
+        AVX512BW = 1 << 11,
+        AVX512VL = 1 << 12,
     };
     enum {
         NEON     = 1 << 0,
@@ -7,6 +7,7 @@
 
 #include "SkGlyphCache.h"
 #include "SkGlyphCache_Globals.h"
+#include "SkGlyphDiskCache.h"
 #include "SkGraphics.h"
 #include "SkOncePtr.h"
 #include "SkPath.h"
@@ -35,44 +36,69 @@ static SkGlyphCache_Globals& get_globals() {
 #define kMinGlyphImageSize  (16*2)
 #define kMinAllocAmount     ((sizeof(SkGlyph) + kMinGlyphImageSize) * kMinGlyphCount)
 
+// The glyph table starts with room for this many glyphs, and doubles when 3/4 full.
+#define kMinGlyphTableCapacity  64
+
+SkGlyphCache::GlyphTable::GlyphTable(int capacity, GlyphTable* older)
+    : fCapacity(capacity)
+    , fCount(0)
+    , fSlots(new std::atomic<SkGlyph*>[capacity]())
+    , fOlder(older) {
+    SkASSERT(SkIsPow2(capacity));
+}
+
 SkGlyphCache::SkGlyphCache(SkTypeface* typeface, const SkDescriptor* desc, SkScalerContext* ctx)
     : fDesc(desc->copy())
     , fScalerContext(ctx)
-    , fGlyphAlloc(kMinAllocAmount) {
+    , fGlyphTable(new GlyphTable(kMinGlyphTableCapacity, nullptr))
+    , fGlyphAlloc(kMinAllocAmount)
+    , fMemoryUsed(sizeof(*this) + kMinGlyphTableCapacity * sizeof(SkGlyph*))
+    , fDiskCache(SkGlyphDiskCache::Open(*desc))
+    , fSaveToDisk(SkGlyphDiskCache::GetDirectory(nullptr))
+    , fDiskDirty(false) {
     SkASSERT(typeface);
     SkASSERT(desc);
     SkASSERT(ctx);
 
     fPrev = fNext = nullptr;
+    fUsers = 0;
+    fPurged = false;
+    fAccountedMemory = 0;
 
     fScalerContext->getFontMetrics(&fFontMetrics);
 
-    fMemoryUsed = sizeof(*this);
-
     fAuxProcList = nullptr;
 }
 
 SkGlyphCache::~SkGlyphCache() {
-    fGlyphMap.foreach ([](SkGlyph* g) {
-        if (g->fPathData) {
+    if (fDiskDirty) {
+        this->saveToDisk();
+    }
+    GlyphTable* table = fGlyphTable.load(std::memory_order_relaxed);
+    for (int i = 0; i < table->fCapacity; i++) {
+        SkGlyph* g = table->fSlots[i].load(std::memory_order_relaxed);
+        if (g && g->fPathData) {
             delete g->fPathData->fPath;
-        } } );
+        }
+    }
+    delete table;
     SkDescriptor::Free(fDesc);
     delete fScalerContext;
     this->invokeAndRemoveAuxProcs();
 }
 
 SkGlyphCache::CharGlyphRec* SkGlyphCache::getCharGlyphRec(PackedUnicharID packedUnicharID) {
-    if (nullptr == fPackedUnicharIDToPackedGlyphID.get()) {
+    fCharGlyphRecsOnce([this] {
         // Allocate the array.
-        fPackedUnicharIDToPackedGlyphID.reset(kHashCount);
+        fPackedUnicharIDToPackedGlyphID.reset(new CharGlyphRec[kHashCount]);
         // Initialize array to map character and position with the impossible glyph ID. This
         // represents no mapping.
         for (int i = 0; i <kHashCount; ++i) {
-            fPackedUnicharIDToPackedGlyphID[i].fPackedUnicharID = SkGlyph::kImpossibleID;
-            fPackedUnicharIDToPackedGlyphID[i].fPackedGlyphID = 0;
+            fPackedUnicharIDToPackedGlyphID[i].store((uint64_t)SkGlyph::kImpossibleID << 32,
+                                                     std::memory_order_relaxed);
         }
-    }
+        this->addMemoryUsed(kHashCount * sizeof(CharGlyphRec));
+    });
 
     return &fPackedUnicharIDToPackedGlyphID[SkChecksum::CheapMix(packedUnicharID) & kHashMask];
 }
@@ -88,25 +114,28 @@ SkGlyphCache::CharGlyphRec* SkGlyphCache::getCharGlyphRec(PackedUnicharID packed
 uint16_t SkGlyphCache::unicharToGlyph(SkUnichar charCode) {
     VALIDATE();
     PackedUnicharID packedUnicharID = SkGlyph::MakeID(charCode);
-    const CharGlyphRec& rec = *this->getCharGlyphRec(packedUnicharID);
+    uint64_t rec = this->getCharGlyphRec(packedUnicharID)->load(std::memory_order_relaxed);
 
-    if (rec.fPackedUnicharID == packedUnicharID) {
-        return SkGlyph::ID2Code(rec.fPackedGlyphID);
+    if ((PackedUnicharID)(rec >> 32) == packedUnicharID) {
+        return SkGlyph::ID2Code((PackedGlyphID)rec);
     } else {
+        SkAutoMutexAcquire lock(fMutex);
         return fScalerContext->charToGlyphID(charCode);
     }
 }
 
 SkUnichar SkGlyphCache::glyphToUnichar(uint16_t glyphID) {
+    SkAutoMutexAcquire lock(fMutex);
     return fScalerContext->glyphIDToChar(glyphID);
 }
 
 unsigned SkGlyphCache::getGlyphCount() const {
+    SkAutoMutexAcquire lock(fMutex);
     return fScalerContext->getGlyphCount();
 }
 
 int SkGlyphCache::countCachedGlyphs() const {
-    return fGlyphMap.count();
+    return fGlyphTable.load(std::memory_order_acquire)->fCount.load(std::memory_order_relaxed);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -149,85 +178,183 @@ const SkGlyph& SkGlyphCache::getGlyphIDMetrics(uint16_t glyphID, SkFixed x, SkFi
 SkGlyph* SkGlyphCache::lookupByChar(SkUnichar charCode, MetricsType type, SkFixed x, SkFixed y) {
     PackedUnicharID id = SkGlyph::MakeID(charCode, x, y);
     CharGlyphRec* rec = this->getCharGlyphRec(id);
-    if (rec->fPackedUnicharID != id) {
-        // this ID is based on the UniChar
-        rec->fPackedUnicharID = id;
+    uint64_t packed = rec->load(std::memory_order_relaxed);
+    if ((PackedUnicharID)(packed >> 32) != id) {
         // this ID is based on the glyph index
-        PackedGlyphID combinedID = SkGlyph::MakeID(fScalerContext->charToGlyphID(charCode), x, y);
-        rec->fPackedGlyphID = combinedID;
+        PackedGlyphID combinedID;
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            combinedID = SkGlyph::MakeID(fScalerContext->charToGlyphID(charCode), x, y);
+        }
+        // The UniChar-based ID goes in the top half, so both are always updated together.
+        rec->store(((uint64_t)id << 32) | combinedID, std::memory_order_relaxed);
         return this->lookupByPackedGlyphID(combinedID, type);
     } else {
-        return this->lookupByPackedGlyphID(rec->fPackedGlyphID, type);
+        return this->lookupByPackedGlyphID((PackedGlyphID)packed, type);
     }
 }
 
+static bool has_metrics(const SkGlyph* glyph, int type) {
+    return glyph && (!glyph->isJustAdvance() || 0 == type);
+}
+
 SkGlyph* SkGlyphCache::lookupByPackedGlyphID(PackedGlyphID packedGlyphID, MetricsType type) {
-    SkGlyph* glyph = fGlyphMap.find(packedGlyphID);
+    static_assert(kJustAdvance_MetricsType == 0, "");
 
-    if (nullptr == glyph) {
-        glyph = this->allocateNewGlyph(packedGlyphID, type);
-    } else {
-        if (type == kFull_MetricsType && glyph->isJustAdvance()) {
-           fScalerContext->getMetrics(glyph);
+    SkGlyph* glyph = this->findGlyph(packedGlyphID);
+    if (has_metrics(glyph, type)) {
+        return glyph;
+    }
+
+    SkAutoMutexAcquire lock(fMutex);
+    // Another thread may have made this glyph while we waited for the lock.
+    glyph = this->findGlyph(packedGlyphID);
+    if (has_metrics(glyph, type)) {
+        return glyph;
+    }
+    return this->allocateNewGlyph(packedGlyphID, type);
+}
+
+SkGlyph* SkGlyphCache::findGlyph(PackedGlyphID packedGlyphID) const {
+    const GlyphTable* table = fGlyphTable.load(std::memory_order_acquire);
+    const int mask = table->fCapacity - 1;
+    for (int i = SkGlyph::HashTraits::Hash(packedGlyphID) & mask; ; i = (i + 1) & mask) {
+        SkGlyph* glyph = table->fSlots[i].load(std::memory_order_acquire);
+        if (nullptr == glyph || glyph->fID == packedGlyphID) {
+            return glyph;
+        }
+    }
+}
+
+// Put glyph in the slot for its ID, replacing any glyph already there with that ID.
+// Returns true if it took an empty slot.
+static bool publish_glyph(std::atomic<SkGlyph*> slots[], int capacity, SkGlyph* glyph) {
+    typedef SkGlyph::HashTraits Traits;
+    const uint32_t id = Traits::GetKey(*glyph);
+    const int mask = capacity - 1;
+    for (int i = Traits::Hash(id) & mask; ; i = (i + 1) & mask) {
+        SkGlyph* existing = slots[i].load(std::memory_order_relaxed);
+        if (nullptr == existing || Traits::GetKey(*existing) == id) {
+            slots[i].store(glyph, std::memory_order_release);
+            return nullptr == existing;
         }
     }
-    return glyph;
 }
 
 SkGlyph* SkGlyphCache::allocateNewGlyph(PackedGlyphID packedGlyphID, MetricsType mtype) {
-    fMemoryUsed += sizeof(SkGlyph);
+    fMutex.assertHeld();
+    this->addMemoryUsed(sizeof(SkGlyph));
 
-    SkGlyph* glyphPtr;
-    {
-        SkGlyph glyph;
-        glyph.initGlyphFromCombinedID(packedGlyphID);
-        glyphPtr = fGlyphMap.set(glyph);
-    }
+    // Glyphs never move once made, so other threads can keep using them without a lock.
+    SkGlyph* glyphPtr = new (fGlyphAlloc.allocThrow(sizeof(SkGlyph))) SkGlyph;
+    glyphPtr->initGlyphFromCombinedID(packedGlyphID);
 
-    if (kJustAdvance_MetricsType == mtype) {
+    if (fDiskCache && fDiskCache->findMetrics(glyphPtr)) {
+        // Saved glyphs have full metrics, whatever mtype asks for.
+    } else if (kJustAdvance_MetricsType == mtype) {
         fScalerContext->getAdvance(glyphPtr);
     } else {
         SkASSERT(kFull_MetricsType == mtype);
         fScalerContext->getMetrics(glyphPtr);
+        fDiskDirty = fSaveToDisk;
     }
-
     SkASSERT(glyphPtr->fID != SkGlyph::kImpossibleID);
+
+    GlyphTable* table = fGlyphTable.load(std::memory_order_relaxed);
+    if (4 * (table->fCount.load(std::memory_order_relaxed) + 1) > 3 * table->fCapacity) {
+        GlyphTable* bigger = new GlyphTable(2 * table->fCapacity, table);
+        for (int i = 0; i < table->fCapacity; i++) {
+            if (SkGlyph* glyph = table->fSlots[i].load(std::memory_order_relaxed)) {
+                publish_glyph(bigger->fSlots.get(), bigger->fCapacity, glyph);
+            }
+        }
+        bigger->fCount.store(table->fCount.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+        this->addMemoryUsed(bigger->fCapacity * sizeof(SkGlyph*));
+        fGlyphTable.store(bigger, std::memory_order_release);
+        table = bigger;
+    }
+
+    // If we're filling in the full metrics of a glyph we only had the advance for, this
+    // replaces that glyph.  Threads that already found it can keep using it.
+    if (publish_glyph(table->fSlots.get(), table->fCapacity, glyphPtr)) {
+        table->fCount.fetch_add(1, std::memory_order_relaxed);
+    }
     return glyphPtr;
 }
 
 const void* SkGlyphCache::findImage(const SkGlyph& glyph) {
     if (glyph.fWidth > 0 && glyph.fWidth < kMaxGlyphWidth) {
-        if (nullptr == glyph.fImage) {
-            size_t  size = glyph.computeImageSize();
-            const_cast<SkGlyph&>(glyph).fImage = fGlyphAlloc.alloc(size,
-                                        SkChunkAlloc::kReturnNil_AllocFailType);
-            // check that alloc() actually succeeded
-            if (glyph.fImage) {
-                fScalerContext->getImage(glyph);
-                // TODO: the scaler may have changed the maskformat during
-                // getImage (e.g. from AA or LCD to BW) which means we may have
-                // overallocated the buffer. Check if the new computedImageSize
-                // is smaller, and if so, strink the alloc size in fImageAlloc.
-                fMemoryUsed += size;
+        void* image = sk_atomic_load(&glyph.fImage, sk_memory_order_acquire);
+        if (nullptr == image) {
+            SkAutoMutexAcquire lock(fMutex);
+            image = glyph.fImage;
+            if (nullptr == image && fDiskCache) {
+                // Saved images are mapped read-only, which is fine: nobody writes to an image
+                // once it's made.
+                image = const_cast<void*>(fDiskCache->findImage(glyph));
+                sk_atomic_store(&const_cast<SkGlyph&>(glyph).fImage, image,
+                                sk_memory_order_release);
+            }
+            if (nullptr == image) {
+                size_t  size = glyph.computeImageSize();
+                image = fGlyphAlloc.alloc(size, SkChunkAlloc::kReturnNil_AllocFailType);
+                // check that alloc() actually succeeded
+                if (image) {
+                    // Draw into a copy, so no other thread sees the image until it's done.
+                    SkGlyph tmp = glyph;
+                    tmp.fImage = image;
+                    fScalerContext->getImage(tmp);
+                    // The scaler may have changed the mask format (e.g. from AA or LCD to BW),
+                    // and the image must be read in that format, so publish it along with
+                    // the image.
+                    // TODO: then we may have overallocated the buffer. Check if the new
+                    // computedImageSize is smaller, and if so, shrink the alloc size in
+                    // fImageAlloc.
+                    const_cast<SkGlyph&>(glyph).fMaskFormat = tmp.fMaskFormat;
+                    sk_atomic_store(&const_cast<SkGlyph&>(glyph).fImage, image,
+                                    sk_memory_order_release);
+                    this->addMemoryUsed(size);
+                    fDiskDirty = fSaveToDisk;
+                }
             }
         }
+        return image;
     }
     return glyph.fImage;
 }
 
 const SkPath* SkGlyphCache::findPath(const SkGlyph& glyph) {
-    if (glyph.fWidth) {
-        if (glyph.fPathData == nullptr) {
-            SkGlyph::PathData* pathData =
-                    (SkGlyph::PathData* ) fGlyphAlloc.allocThrow(sizeof(SkGlyph::PathData));
-            const_cast<SkGlyph&>(glyph).fPathData = pathData;
+    SkGlyph::PathData* pathData = sk_atomic_load(&glyph.fPathData, sk_memory_order_acquire);
+    if (glyph.fWidth && nullptr == pathData) {
+        SkAutoMutexAcquire lock(fMutex);
+        pathData = glyph.fPathData;
+        if (nullptr == pathData) {
+            pathData = (SkGlyph::PathData* ) fGlyphAlloc.allocThrow(sizeof(SkGlyph::PathData));
             pathData->fIntercept = nullptr;
             SkPath* path = pathData->fPath = new SkPath;
-            fScalerContext->getPath(glyph, path);
-            fMemoryUsed += sizeof(SkPath) + path->countPoints() * sizeof(SkPoint);
+            if (!fDiskCache || !fDiskCache->findPath(glyph, path)) {
+                fScalerContext->getPath(glyph, path);
+                fDiskDirty = fSaveToDisk;
+            }
+            sk_atomic_store(&const_cast<SkGlyph&>(glyph).fPathData, pathData,
+                            sk_memory_order_release);
+            this->addMemoryUsed(sizeof(SkPath) + path->countPoints() * sizeof(SkPoint));
+        }
+    }
+    return pathData ? pathData->fPath : nullptr;
+}
+
+void SkGlyphCache::saveToDisk() const {
+    const GlyphTable* table = fGlyphTable.load(std::memory_order_acquire);
+    SkTDArray<const SkGlyph*> glyphs;
+    for (int i = 0; i < table->fCapacity; i++) {
+        const SkGlyph* glyph = table->fSlots[i].load(std::memory_order_relaxed);
+        if (glyph && glyph->isFullMetrics()) {
+            *glyphs.append() = glyph;
         }
     }
-    return glyph.fPathData ? glyph.fPathData->fPath : nullptr;
+    SkGlyphDiskCache::Save(*fDesc, fDiskCache.get(), glyphs.begin(), glyphs.count());
 }
 
 #include "../pathops/SkPathOpsCubic.h"
@@ -330,6 +457,7 @@ const SkGlyph::Intercept* SkGlyphCache::MatchBounds(const SkGlyph* glyph,
 
 void SkGlyphCache::findIntercepts(const SkScalar bounds[2], SkScalar scale, SkScalar xPos,
         bool yAxis, SkGlyph* glyph, SkScalar* array, int* count) {
+    SkAutoMutexAcquire lock(fMutex);
     const SkGlyph::Intercept* match = MatchBounds(glyph, bounds);
 
     if (match) {
@@ -413,13 +541,14 @@ void SkGlyphCache::dump() const {
                matrix[SkMatrix::kMScaleX], matrix[SkMatrix::kMSkewX],
                matrix[SkMatrix::kMSkewY], matrix[SkMatrix::kMScaleY],
                rec.fLumBits & 0xFF, rec.fDeviceGamma, rec.fPaintGamma, rec.fContrast,
-               fGlyphMap.count());
+               this->countCachedGlyphs());
     SkDebugf("%s\n", msg.c_str());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 bool SkGlyphCache::getAuxProcData(void (*proc)(void*), void** dataPtr) const {
+    SkAutoMutexAcquire lock(fMutex);
     const AuxProcRec* rec = fAuxProcList;
     while (rec) {
         if (rec->fProc == proc) {
@@ -438,6 +567,7 @@ void SkGlyphCache::setAuxProc(void (*proc)(void*), void* data) {
         return;
     }
 
+    SkAutoMutexAcquire lock(fMutex);
     AuxProcRec* rec = fAuxProcList;
     while (rec) {
         if (rec->fProc == proc) {
@@ -475,11 +605,15 @@ size_t SkGlyphCache_Globals::setCacheSizeLimit(size_t newLimit) {
         newLimit = minLimit;
     }
 
-    Exclusive ac(fLock);
+    size_t prevLimit;
+    {
+        Exclusive ac(fLock);
 
-    size_t prevLimit = fCacheSizeLimit;
-    fCacheSizeLimit = newLimit;
-    this->internalPurge();
+        prevLimit = fCacheSizeLimit;
+        fCacheSizeLimit = newLimit;
+        this->internalPurge();
+    }
+    this->deletePurged();
     return prevLimit;
 }
 
@@ -488,17 +622,34 @@ int SkGlyphCache_Globals::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    Exclusive ac(fLock);
+    int prevCount;
+    {
+        Exclusive ac(fLock);
 
-    int prevCount = fCacheCountLimit;
-    fCacheCountLimit = newCount;
-    this->internalPurge();
+        prevCount = fCacheCountLimit;
+        fCacheCountLimit = newCount;
+        this->internalPurge();
+    }
+    this->deletePurged();
     return prevCount;
 }
 
 void SkGlyphCache_Globals::purgeAll() {
-    Exclusive ac(fLock);
-    this->internalPurge(fTotalMemoryUsed);
+    {
+        Exclusive ac(fLock);
+        this->internalPurge(fTotalMemoryUsed);
+    }
+    this->deletePurged();
+}
+
+void SkGlyphCache_Globals::deletePurged() {
+    SkGlyphCache* purged;
+    {
+        Exclusive ac(fLock);
+        purged = fPurgedHead;
+        fPurgedHead = nullptr;
+    }
+    DeleteList(purged);
 }
 
 /*  This guy calls the visitor from within the mutext lock, so the visitor
@@ -518,28 +669,21 @@ SkGlyphCache* SkGlyphCache::VisitCache(SkTypeface* typeface,
     SkASSERT(desc);
 
     SkGlyphCache_Globals& globals = get_globals();
-    SkGlyphCache*         cache;
 
     {
         Exclusive ac(globals.fLock);
 
         globals.validate();
 
-        for (cache = globals.internalGetHead(); cache != nullptr; cache = cache->fNext) {
-            if (cache->fDesc->equals(*desc)) {
-                globals.internalDetachCache(cache);
-                if (!proc(cache, context)) {
-                    globals.internalAttachCacheToHead(cache);
-                    cache = nullptr;
-                }
-                return cache;
-            }
+        if (SkGlyphCache* cache = globals.internalFindCache(*desc)) {
+            return globals.internalVisitCache(cache, proc, context);
         }
     }
 
     // Check if we can create a scaler-context before creating the glyphcache.
     // If not, we may have exhausted OS/font resources, so try purging the
     // cache once and try again.
+    SkGlyphCache* created;
     {
         // pass true the first time, to notice if the scalercontext failed,
         // so we can try the purge.
@@ -549,23 +693,33 @@ SkGlyphCache* SkGlyphCache::VisitCache(SkTypeface* typeface,
             ctx = typeface->createScalerContext(effects, desc, false);
             SkASSERT(ctx);
         }
-        cache = new SkGlyphCache(typeface, desc, ctx);
+        created = new SkGlyphCache(typeface, desc, ctx);
     }
 
-    AutoValidate av(cache);
+    SkGlyphCache* cache;
+    {
+        Exclusive ac(globals.fLock);
 
-    if (!proc(cache, context)) {   // need to reattach
-        globals.attachCacheToHead(cache);
-        cache = nullptr;
+        // Another thread may have made the same strike while we made ours.  Use theirs.
+        SkGlyphCache* existing = globals.internalFindCache(*desc);
+        if (!existing) {
+            AutoValidate av(created);
+            globals.internalAttachCacheToHead(created);
+            existing = created;
+            created = nullptr;
+        }
+        cache = globals.internalVisitCache(existing, proc, context);
+        globals.internalPurge();
     }
+    globals.deletePurged();
+    delete created;
     return cache;
 }
 
 void SkGlyphCache::AttachCache(SkGlyphCache* cache) {
     SkASSERT(cache);
-    SkASSERT(cache->fNext == nullptr);
 
-    get_globals().attachCacheToHead(cache);
+    get_globals().attachCache(cache);
 }
 
 static void dump_visitor(const SkGlyphCache& cache, void* context) {
@@ -646,14 +800,51 @@ void SkGlyphCache::VisitAll(Visitor visitor, void* context) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void SkGlyphCache_Globals::attachCacheToHead(SkGlyphCache* cache) {
-    Exclusive ac(fLock);
+void SkGlyphCache_Globals::attachCache(SkGlyphCache* cache) {
+    SkGlyphCache* purged = nullptr;
+    {
+        Exclusive ac(fLock);
 
-    this->validate();
-    cache->validate();
+        this->validate();
+        cache->validate();
 
+        SkASSERT(cache->fUsers > 0);
+        cache->fUsers -= 1;
+        if (cache->fPurged) {
+            // We purged this strike while it was in use; it's ours to delete once it's not.
+            if (0 == cache->fUsers) {
+                purged = cache;
+            }
+        } else {
+            this->internalAccountMemory(cache);
+            this->internalPurge();
+        }
+    }
+    this->deletePurged();
+    delete purged;
+}
+
+SkGlyphCache* SkGlyphCache_Globals::internalFindCache(const SkDescriptor& desc) const {
+    for (SkGlyphCache* cache = fHead; cache != nullptr; cache = cache->fNext) {
+        if (cache->fDesc->equals(desc)) {
+            return cache;
+        }
+    }
+    return nullptr;
+}
+
+SkGlyphCache* SkGlyphCache_Globals::internalVisitCache(SkGlyphCache* cache,
+                                                       bool (*proc)(const SkGlyphCache*, void*),
+                                                       void* context) {
+    // Move the strike to the head of the list, as it's now the most recently used.
+    this->internalDetachCache(cache);
     this->internalAttachCacheToHead(cache);
-    this->internalPurge();
+
+    if (!proc(cache, context)) {
+        return nullptr;
+    }
+    cache->fUsers += 1;
+    return cache;
 }
 
 SkGlyphCache* SkGlyphCache_Globals::internalGetTail() const {
@@ -700,11 +891,16 @@ size_t SkGlyphCache_Globals::internalPurge(size_t minBytesNeeded) {
     while (cache != nullptr &&
            (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
         SkGlyphCache* prev = cache->fPrev;
-        bytesFreed += cache->fMemoryUsed;
+        bytesFreed += cache->fAccountedMemory;
         countFreed += 1;
 
         this->internalDetachCache(cache);
-        delete cache;
+        cache->fPurged = true;
+        if (0 == cache->fUsers) {
+            // Deleting may save the strike to disk, which we won't do holding the lock.
+            cache->fNext = fPurgedHead;
+            fPurgedHead = cache;
+        }  // Otherwise the last attachCache() will delete it.
         cache = prev;
     }
 
@@ -729,13 +925,20 @@ void SkGlyphCache_Globals::internalAttachCacheToHead(SkGlyphCache* cache) {
     fHead = cache;
 
     fCacheCount += 1;
-    fTotalMemoryUsed += cache->fMemoryUsed;
+    this->internalAccountMemory(cache);
+}
+
+void SkGlyphCache_Globals::internalAccountMemory(SkGlyphCache* cache) {
+    size_t used = cache->getMemoryUsed();
+    fTotalMemoryUsed += used - cache->fAccountedMemory;
+    cache->fAccountedMemory = used;
 }
 
 void SkGlyphCache_Globals::internalDetachCache(SkGlyphCache* cache) {
     SkASSERT(fCacheCount > 0);
     fCacheCount -= 1;
-    fTotalMemoryUsed -= cache->fMemoryUsed;
+    fTotalMemoryUsed -= cache->fAccountedMemory;
+    cache->fAccountedMemory = 0;
 
     if (cache->fPrev) {
         cache->fPrev->fNext = cache->fNext;
@@ -771,7 +974,7 @@ void SkGlyphCache_Globals::validate() const {
 
     const SkGlyphCache* head = fHead;
     while (head != nullptr) {
-        computedBytes += head->fMemoryUsed;
+        computedBytes += head->fAccountedMemory;
         computedCount += 1;
         head = head->fNext;
     }
@@ -813,6 +1016,10 @@ int SkGraphics::GetFontCacheCountUsed() {
     return get_globals().getCacheCountUsed();
 }
 
+void SkGraphics::SetFontCacheDirectory(const char dir[]) {
+    SkGlyphDiskCache::SetDirectory(dir);
+}
+
 void SkGraphics::PurgeFontCache() {
     get_globals().purgeAll();
     SkTypefaceCache::PurgeAll();
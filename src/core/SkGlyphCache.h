@@ -11,12 +11,17 @@
 #include "SkChunkAlloc.h"
 #include "SkDescriptor.h"
 #include "SkGlyph.h"
+#include "SkMutex.h"
+#include "SkOnce.h"
 #include "SkPaint.h"
-#include "SkTHash.h"
 #include "SkScalerContext.h"
 #include "SkTemplates.h"
 #include "SkTDArray.h"
 
+#include <atomic>
+#include <memory>
+
+class SkGlyphDiskCache;
 class SkTraceMemoryDump;
 
 class SkGlyphCache_Globals;
@@ -30,6 +35,13 @@ class SkGlyphCache_Globals;
 
     The strikes are held in a global list, available to all threads. To interact with one, call
     either VisitCache() or DetachCache().
+
+    A strike may be used by many threads at once. Looking up a glyph that is already cached
+    (its metrics, image or path) takes no locks. Generating a new one, which needs the scaler
+    context, takes a lock that belongs to the strike.
+
+    If SkGraphics::SetFontCacheDirectory() was called, a strike first looks for its glyphs in the
+    copy of it saved to disk (see SkGlyphDiskCache), and saves any new ones when it is deleted.
 */
 class SkGlyphCache {
 public:
@@ -105,7 +117,7 @@ public:
     }
 
     /** Return the approx RAM usage for this cache. */
-    size_t getMemoryUsed() const { return fMemoryUsed; }
+    size_t getMemoryUsed() const { return fMemoryUsed.load(std::memory_order_relaxed); }
 
     void dump() const;
 
@@ -139,12 +151,12 @@ public:
     static void AttachCache(SkGlyphCache*);
     using AttachCacheFunctor = SkFunctionWrapper<void, SkGlyphCache, AttachCache>;
 
-    /** Detach a strike from the global cache matching the specified descriptor. Once detached,
-        it can be queried/modified by the current thread, and when finished, be reattached to the
-        global cache with AttachCache(). While detached, if another request is made with the same
-        descriptor, a different strike will be generated. This is fine. It does mean we can have
-        more than 1 strike for the same descriptor, but that will eventually get purged, and the
-        win is that different thread will never block each other while a strike is being used.
+    /** Detach a strike from the global cache matching the specified descriptor, creating it if
+        needed. Once detached, it can be used by the current thread, and when finished, must be
+        handed back with AttachCache(). Other threads asking for the same descriptor in the
+        meantime get the same strike, so there is only ever one strike per descriptor. A strike
+        that is detached by anyone is never deleted; if the cache is purged while it is in use,
+        the last AttachCache() deletes it.
     */
     static SkGlyphCache* DetachCache(SkTypeface* typeface, const SkScalerContextEffects& effects,
                                      const SkDescriptor* desc) {
@@ -203,9 +215,21 @@ private:
     typedef uint32_t PackedGlyphID;    // glyph-index + subpixel-pos
     typedef uint32_t PackedUnicharID;  // unichar + subpixel-pos
 
-    struct CharGlyphRec {
-        PackedUnicharID    fPackedUnicharID;
-        PackedGlyphID      fPackedGlyphID;
+    // A PackedUnicharID in the top 32 bits and the PackedGlyphID it maps to in the bottom 32,
+    // so that threads can read and write the pair without a lock.
+    typedef std::atomic<uint64_t> CharGlyphRec;
+
+    // An open-addressed hash of the strike's glyphs, which threads may read without a lock.
+    // Slots are only filled (or replaced by a glyph with more complete metrics) under fMutex.
+    // When a table fills up we publish a bigger one, but readers may still be in the old one,
+    // so it stays alive until the strike is deleted.
+    struct GlyphTable {
+        GlyphTable(int capacity, GlyphTable* older);
+
+        const int                                fCapacity;  // A power of 2.
+        std::atomic<int>                         fCount;
+        std::unique_ptr<std::atomic<SkGlyph*>[]> fSlots;
+        std::unique_ptr<GlyphTable>              fOlder;
     };
 
     struct AuxProcRec {
@@ -226,11 +250,18 @@ private:
     // Return a SkGlyph* associated with unicode id and position x and y.
     SkGlyph* lookupByChar(SkUnichar id, MetricsType type, SkFixed x = 0, SkFixed y = 0);
 
-    // Return a new SkGlyph for the glyph ID and subpixel position id. Limit the amount
-    // of work
-    // using type.
+    // Return the published glyph for the packed ID, or nullptr. Takes no locks.
+    SkGlyph* findGlyph(PackedGlyphID packedGlyphID) const;
+
+    // Return a new SkGlyph for the glyph ID and subpixel position id, with at least the metrics
+    // type asks for, and publish it in place of any we had. Must hold fMutex.
     SkGlyph* allocateNewGlyph(PackedGlyphID packedGlyphID, MetricsType type);
 
+    void addMemoryUsed(size_t bytes) { fMemoryUsed.fetch_add(bytes, std::memory_order_relaxed); }
+
+    // Write every glyph with full metrics to disk, along with any saved glyphs we didn't use.
+    void saveToDisk() const;
+
     static bool DetachProc(const SkGlyphCache*, void*) { return true; }
 
     // The id arg is a combined id generated by MakeID.
@@ -254,23 +285,38 @@ private:
     static const SkGlyph::Intercept* MatchBounds(const SkGlyph* glyph,
                                                  const SkScalar bounds[2]);
 
+    // These are guarded by SkGlyphCache_Globals::fLock.
     SkGlyphCache*          fNext;
     SkGlyphCache*          fPrev;
+    int                    fUsers;            // How many DetachCache()es are outstanding.
+    bool                   fPurged;           // No longer in the global list.
+    size_t                 fAccountedMemory;  // Our part of the global list's memory total.
+
     SkDescriptor* const    fDesc;
     SkScalerContext* const fScalerContext;
     SkPaint::FontMetrics   fFontMetrics;
 
-    // Map from a combined GlyphID and sub-pixel position to a SkGlyph.
-    SkTHashTable<SkGlyph, PackedGlyphID, SkGlyph::HashTraits> fGlyphMap;
+    // Held while using fScalerContext or fGlyphAlloc, publishing glyphs, or touching the
+    // intercepts or aux procs.
+    mutable SkMutex        fMutex;
+
+    // Map from a combined GlyphID and sub-pixel position to a SkGlyph in fGlyphAlloc.
+    std::atomic<GlyphTable*> fGlyphTable;
 
     SkChunkAlloc           fGlyphAlloc;
 
-    SkAutoTArray<CharGlyphRec> fPackedUnicharIDToPackedGlyphID;
+    SkOnce                          fCharGlyphRecsOnce;
+    std::unique_ptr<CharGlyphRec[]> fPackedUnicharIDToPackedGlyphID;
 
     // used to track (approx) how much ram is tied-up in this cache
-    size_t                 fMemoryUsed;
+    std::atomic<size_t>    fMemoryUsed;
 
     AuxProcRec*            fAuxProcList;
+
+    // The strike as it was saved to disk when we were made, or nullptr.
+    std::unique_ptr<SkGlyphDiskCache> fDiskCache;
+    const bool             fSaveToDisk;
+    bool                   fDiskDirty;  // We made glyphs not saved yet. Guarded by fMutex.
 };
 
 class SkAutoGlyphCache : public std::unique_ptr<SkGlyphCache, SkGlyphCache::AttachCacheFunctor> {
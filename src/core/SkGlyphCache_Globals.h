@@ -27,6 +27,7 @@ class SkGlyphCache_Globals {
 public:
     SkGlyphCache_Globals() {
         fHead = nullptr;
+        fPurgedHead = nullptr;
         fTotalMemoryUsed = 0;
         fCacheSizeLimit = SK_DEFAULT_FONT_CACHE_LIMIT;
         fCacheCount = 0;
@@ -34,12 +35,8 @@ public:
     }
 
     ~SkGlyphCache_Globals() {
-        SkGlyphCache* cache = fHead;
-        while (cache) {
-            SkGlyphCache* next = cache->fNext;
-            delete cache;
-            cache = next;
-        }
+        DeleteList(fHead);
+        DeleteList(fPurgedHead);
     }
 
     SkSpinlock     fLock;
@@ -71,24 +68,43 @@ public:
 
     void purgeAll(); // does not change budget
 
-    // call when a glyphcache is available for caching (i.e. not in use)
-    void attachCacheToHead(SkGlyphCache*);
+    // call when a thread is done with a glyphcache it detached
+    void attachCache(SkGlyphCache*);
 
     // can only be called when the mutex is already held
+    SkGlyphCache* internalFindCache(const SkDescriptor&) const;
+    SkGlyphCache* internalVisitCache(SkGlyphCache*, bool (*proc)(const SkGlyphCache*, void*),
+                                     void* context);
     void internalDetachCache(SkGlyphCache*);
     void internalAttachCacheToHead(SkGlyphCache*);
+    // Strikes grow while they're in use; bring our total up to date with this one.
+    void internalAccountMemory(SkGlyphCache*);
+
+    // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
+    // and attempt to purge caches to match.  Strikes in use are taken out of the
+    // list, but deleted by the last attachCache() instead.  The rest are set aside
+    // for deletePurged(), as deleting a strike may save it to disk.
+    // Returns number of bytes freed.
+    size_t internalPurge(size_t minBytesNeeded = 0);
+
+    // Deletes the strikes internalPurge() set aside.  Call with the lock not held.
+    void deletePurged();
 
 private:
+    static void DeleteList(SkGlyphCache* cache) {
+        while (cache) {
+            SkGlyphCache* next = cache->fNext;
+            delete cache;
+            cache = next;
+        }
+    }
+
     SkGlyphCache* fHead;
+    SkGlyphCache* fPurgedHead;  // Purged, unused strikes waiting for deletePurged().
     size_t  fTotalMemoryUsed;
     size_t  fCacheSizeLimit;
     int32_t fCacheCountLimit;
     int32_t fCacheCount;
-
-    // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
-    // and attempt to purge caches to match.
-    // Returns number of bytes freed.
-    size_t internalPurge(size_t minBytesNeeded = 0);
 };
 
 #endif
@@ -0,0 +1,305 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkGlyphDiskCache.h"
+
+#include "SkDescriptor.h"
+#include "SkGlyph.h"
+#include "SkMutex.h"
+#include "SkOSFile.h"
+#include "SkPath.h"
+#include "SkStream.h"
+#include "SkString.h"
+#include "SkTDArray.h"
+#include "SkTemplates.h"
+#include "SkTSearch.h"
+#include "SkTSort.h"
+#include "SkTime.h"
+
+#include <cstdio>
+
+// The file is a Header, the descriptor, fCount Records sorted by fID, then the images and
+// paths the Records point to.  Everything is 4-byte aligned, and offsets are from the start.
+namespace {
+struct Header {
+    uint32_t fMagic;
+    uint32_t fVersion;
+    uint32_t fDescLength;
+    uint32_t fCount;
+};
+}  // namespace
+
+struct SkGlyphDiskCache::Record {
+    uint32_t fID;
+    float    fAdvanceX, fAdvanceY;
+    uint16_t fWidth, fHeight;
+    int16_t  fTop, fLeft;
+    uint8_t  fMaskFormat;
+    int8_t   fRsbDelta, fLsbDelta;
+    int8_t   fForceBW;
+    uint32_t fImageOffset, fImageSize;  // fImageSize is 0 if there is no image.
+    uint32_t fPathOffset, fPathSize;    // fPathSize is 0 if there is no path.
+
+    bool operator<(const Record& other) const { return fID < other.fID; }
+};
+
+static const uint32_t kMagic   = SkSetFourByteTag('s', 'k', 'g', 'c');
+static const uint32_t kVersion = 1;
+
+static_assert(sizeof(Header) % 4 == 0, "");
+static_assert(sizeof(SkGlyphDiskCache::Record) % 4 == 0, "");
+
+SK_DECLARE_STATIC_MUTEX(gDirectoryMutex);
+static SkString* gDirectory = nullptr;  // Guarded by gDirectoryMutex.
+
+void SkGlyphDiskCache::SetDirectory(const char dir[]) {
+    SkAutoMutexAcquire lock(gDirectoryMutex);
+    delete gDirectory;
+    gDirectory = dir ? new SkString(dir) : nullptr;
+}
+
+bool SkGlyphDiskCache::GetDirectory(SkString* dir) {
+    SkAutoMutexAcquire lock(gDirectoryMutex);
+    if (!gDirectory) {
+        return false;
+    }
+    if (dir) {
+        *dir = *gDirectory;
+    }
+    return true;
+}
+
+static SkString strike_path(const char dir[], const SkDescriptor& desc) {
+    SkString name;
+    name.printf("%08x.skglyphs", desc.getChecksum());
+    return SkOSPath::Join(dir, name.c_str());
+}
+
+static bool in_file(uint32_t offset, uint32_t size, size_t fileSize) {
+    return SkIsAlign4(offset) && offset <= fileSize && size <= fileSize - offset;
+}
+
+std::unique_ptr<SkGlyphDiskCache> SkGlyphDiskCache::Open(const SkDescriptor& desc) {
+    SkString dir;
+    if (!GetDirectory(&dir)) {
+        return nullptr;
+    }
+    return Open(dir.c_str(), desc);
+}
+
+std::unique_ptr<SkGlyphDiskCache> SkGlyphDiskCache::Open(const char dir[],
+                                                         const SkDescriptor& desc) {
+    SkString path = strike_path(dir, desc);
+    if (!sk_exists(path.c_str(), kRead_SkFILE_Flag)) {
+        return nullptr;
+    }
+    sk_sp<SkData> data = SkData::MakeFromFileName(path.c_str());
+    if (!data || data->size() < sizeof(Header)) {
+        return nullptr;
+    }
+
+    // Trust nothing in the file until we've checked it: another version of us may have written
+    // it, or it may be truncated.
+    const size_t size = data->size();
+    const uint8_t* bytes = data->bytes();
+    const Header* header = (const Header*)bytes;
+    if (header->fMagic != kMagic || header->fVersion != kVersion ||
+        header->fDescLength != desc.getLength() ||
+        !in_file(sizeof(Header), header->fDescLength, size) ||
+        memcmp(bytes + sizeof(Header), &desc, desc.getLength())) {
+        return nullptr;
+    }
+    const size_t recordsOffset = sizeof(Header) + SkAlign4(header->fDescLength);
+    if (recordsOffset > size ||
+        header->fCount > (size - recordsOffset) / sizeof(Record)) {
+        return nullptr;
+    }
+    const Record* records = (const Record*)(bytes + recordsOffset);
+    for (uint32_t i = 0; i < header->fCount; i++) {
+        const Record& rec = records[i];
+        if ((i > 0 && !(records[i - 1] < rec)) ||
+            rec.fMaskFormat >= SkMask::kCountMaskFormats ||
+            !in_file(rec.fImageOffset, rec.fImageSize, size) ||
+            !in_file(rec.fPathOffset, rec.fPathSize, size)) {
+            return nullptr;
+        }
+    }
+
+    return std::unique_ptr<SkGlyphDiskCache>(
+            new SkGlyphDiskCache(std::move(data), records, header->fCount));
+}
+
+SkGlyphDiskCache::SkGlyphDiskCache(sk_sp<SkData> data, const Record* records, int count)
+    : fData(std::move(data))
+    , fRecords(records)
+    , fCount(count) {}
+
+const SkGlyphDiskCache::Record* SkGlyphDiskCache::find(const SkGlyph& glyph) const {
+    Record key;
+    key.fID = SkGlyph::HashTraits::GetKey(glyph);
+    int index = SkTSearch<Record>(fRecords, fCount, key, sizeof(Record));
+    return index >= 0 ? &fRecords[index] : nullptr;
+}
+
+bool SkGlyphDiskCache::findMetrics(SkGlyph* glyph) const {
+    const Record* rec = this->find(*glyph);
+    if (!rec) {
+        return false;
+    }
+    glyph->fAdvanceX   = rec->fAdvanceX;
+    glyph->fAdvanceY   = rec->fAdvanceY;
+    glyph->fWidth      = rec->fWidth;
+    glyph->fHeight     = rec->fHeight;
+    glyph->fTop        = rec->fTop;
+    glyph->fLeft       = rec->fLeft;
+    glyph->fMaskFormat = rec->fMaskFormat;
+    glyph->fRsbDelta   = rec->fRsbDelta;
+    glyph->fLsbDelta   = rec->fLsbDelta;
+    glyph->fForceBW    = rec->fForceBW;
+    return true;
+}
+
+const void* SkGlyphDiskCache::findImage(const SkGlyph& glyph) const {
+    const Record* rec = this->find(glyph);
+    if (!rec || 0 == rec->fImageSize || rec->fImageSize != glyph.computeImageSize()) {
+        return nullptr;
+    }
+    return fData->bytes() + rec->fImageOffset;
+}
+
+bool SkGlyphDiskCache::findPath(const SkGlyph& glyph, SkPath* path) const {
+    const Record* rec = this->find(glyph);
+    return rec && rec->fPathSize &&
+           path->readFromMemory(fData->bytes() + rec->fPathOffset, rec->fPathSize);
+}
+
+bool SkGlyphDiskCache::Save(const SkDescriptor& desc, const SkGlyphDiskCache* previous,
+                            const SkGlyph* const glyphs[], int count) {
+    SkString dir;
+    if (!GetDirectory(&dir)) {
+        return false;
+    }
+    return Save(dir.c_str(), desc, previous, glyphs, count);
+}
+
+bool SkGlyphDiskCache::Save(const char dir[], const SkDescriptor& desc,
+                            const SkGlyphDiskCache* previous,
+                            const SkGlyph* const glyphs[], int count) {
+    SkString path = strike_path(dir, desc);
+
+    // Offsets are relative to the start of data until we know where it goes in the file.
+    SkTDArray<Record> records;
+    SkDynamicMemoryWStream data;
+    for (int i = 0; i < count; i++) {
+        const SkGlyph& glyph = *glyphs[i];
+        SkASSERT(glyph.isFullMetrics());
+
+        Record* rec = records.append();
+        memset(rec, 0, sizeof(Record));
+        rec->fID         = SkGlyph::HashTraits::GetKey(glyph);
+        rec->fAdvanceX   = glyph.fAdvanceX;
+        rec->fAdvanceY   = glyph.fAdvanceY;
+        rec->fWidth      = glyph.fWidth;
+        rec->fHeight     = glyph.fHeight;
+        rec->fTop        = glyph.fTop;
+        rec->fLeft       = glyph.fLeft;
+        rec->fMaskFormat = glyph.fMaskFormat;
+        rec->fRsbDelta   = glyph.fRsbDelta;
+        rec->fLsbDelta   = glyph.fLsbDelta;
+        rec->fForceBW    = glyph.fForceBW;
+        if (glyph.fImage) {
+            rec->fImageOffset = SkToU32(data.bytesWritten());
+            rec->fImageSize   = SkToU32(glyph.computeImageSize());
+            data.write(glyph.fImage, rec->fImageSize);
+            data.padToAlign4();
+        }
+        if (glyph.fPathData && glyph.fPathData->fPath) {
+            const SkPath& glyphPath = *glyph.fPathData->fPath;
+            SkAutoSMalloc<1024> storage(glyphPath.writeToMemory(nullptr));
+            rec->fPathOffset = SkToU32(data.bytesWritten());
+            rec->fPathSize   = SkToU32(glyphPath.writeToMemory(storage.get()));
+            data.write(storage.get(), rec->fPathSize);
+            data.padToAlign4();
+        }
+    }
+
+    // Keep the glyphs we loaded last time but didn't use this time.
+    if (previous) {
+        SkTDArray<uint32_t> ids;
+        for (const Record& rec : records) {
+            *ids.append() = rec.fID;
+        }
+        if (!ids.isEmpty()) {
+            SkTQSort(ids.begin(), ids.end() - 1);
+        }
+        for (int i = 0; i < previous->fCount; i++) {
+            Record rec = previous->fRecords[i];
+            if (SkTSearch<uint32_t>(ids.begin(), ids.count(), rec.fID, sizeof(uint32_t)) >= 0) {
+                continue;
+            }
+            const uint8_t* bytes = previous->fData->bytes();
+            if (rec.fImageSize) {
+                data.write(bytes + rec.fImageOffset, rec.fImageSize);
+                rec.fImageOffset = SkToU32(data.bytesWritten() - rec.fImageSize);
+                data.padToAlign4();
+            }
+            if (rec.fPathSize) {
+                data.write(bytes + rec.fPathOffset, rec.fPathSize);
+                rec.fPathOffset = SkToU32(data.bytesWritten() - rec.fPathSize);
+                data.padToAlign4();
+            }
+            *records.append() = rec;
+        }
+    }
+    if (records.isEmpty()) {
+        return false;
+    }
+    SkTQSort(records.begin(), records.end() - 1);
+
+    Header header;
+    header.fMagic      = kMagic;
+    header.fVersion    = kVersion;
+    header.fDescLength = desc.getLength();
+    header.fCount      = records.count();
+    const size_t dataOffset = sizeof(Header) + SkAlign4(header.fDescLength) +
+                              records.count() * sizeof(Record);
+    if (dataOffset + data.bytesWritten() > UINT32_MAX) {
+        return false;
+    }
+    for (Record& rec : records) {
+        rec.fImageOffset += rec.fImageSize ? SkToU32(dataOffset) : 0;
+        rec.fPathOffset  += rec.fPathSize  ? SkToU32(dataOffset) : 0;
+    }
+
+    // Write a new file to the side, then rename it over the old one.  Readers of the old one
+    // keep their mapping, and nobody ever sees a partly written file.
+    SkString tmpPath;
+    tmpPath.printf("%s.%llx-%p.tmp", path.c_str(),
+                   (unsigned long long)SkTime::GetNSecs(), (const void*)records.begin());
+    {
+        SkFILEWStream file(tmpPath.c_str());
+        static const uint32_t kZero = 0;
+        if (!file.isValid() ||
+            !file.write(&header, sizeof(header)) ||
+            !file.write(&desc, desc.getLength()) ||
+            !file.write(&kZero, SkAlign4(desc.getLength()) - desc.getLength()) ||
+            !file.write(records.begin(), records.count() * sizeof(Record))) {
+            remove(tmpPath.c_str());
+            return false;
+        }
+        data.writeToStream(&file);
+        file.flush();
+    }
+#ifdef SK_BUILD_FOR_WIN
+    remove(path.c_str());  // rename() won't replace a file on Windows.
+#endif
+    if (0 != rename(tmpPath.c_str(), path.c_str())) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
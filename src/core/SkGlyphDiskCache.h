@@ -0,0 +1,83 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphDiskCache_DEFINED
+#define SkGlyphDiskCache_DEFINED
+
+#include "SkData.h"
+#include "SkRefCnt.h"
+
+#include <memory>
+
+class SkDescriptor;
+class SkGlyph;
+class SkPath;
+class SkString;
+
+/** \class SkGlyphDiskCache
+
+    A strike saved to disk: the metrics, images and paths of the glyphs a SkGlyphCache made,
+    so a later process can map them rather than ask the scaler context again.
+
+    Each strike is one file in the directory set by SkGraphics::SetFontCacheDirectory(), named
+    by its descriptor's checksum.  The file holds the whole descriptor too, so strikes whose
+    checksums collide just miss.  Files are only ever replaced whole by renaming a new one over
+    them, never written in place, so any number of processes may map one read-only at once.
+*/
+class SkGlyphDiskCache {
+public:
+    /** Sets the directory strikes are saved to and loaded from.  nullptr (the default) turns
+        the disk cache off.
+    */
+    static void SetDirectory(const char dir[]);
+
+    /** Returns true if the disk cache is on, and if dir is not nullptr sets it to the directory. */
+    static bool GetDirectory(SkString* dir);
+
+    /** Maps the saved strike for this descriptor.  Returns nullptr if the disk cache is off,
+        or the strike was never saved, or its file is not one we can use.
+    */
+    static std::unique_ptr<SkGlyphDiskCache> Open(const SkDescriptor&);
+
+    /** As Open(), but from the given directory rather than the one set by SetDirectory(). */
+    static std::unique_ptr<SkGlyphDiskCache> Open(const char dir[], const SkDescriptor&);
+
+    /** If the glyph with this glyph's packed ID is saved, sets its metrics and returns true. */
+    bool findMetrics(SkGlyph*) const;
+
+    /** Returns the saved image of this glyph, or nullptr.  The memory is read-only and lives
+        as long as this object does.
+    */
+    const void* findImage(const SkGlyph&) const;
+
+    /** If the glyph has a saved path, sets path to it and returns true. */
+    bool findPath(const SkGlyph&, SkPath* path) const;
+
+    /** Saves a strike for this descriptor with the given glyphs, and any glyphs in previous
+        that are not among them.  The glyphs must have full metrics, and their images and paths
+        are saved if they have them.  Does nothing if the disk cache is off.
+    */
+    static bool Save(const SkDescriptor&, const SkGlyphDiskCache* previous,
+                     const SkGlyph* const glyphs[], int count);
+
+    /** As Save(), but to the given directory rather than the one set by SetDirectory(). */
+    static bool Save(const char dir[], const SkDescriptor&, const SkGlyphDiskCache* previous,
+                     const SkGlyph* const glyphs[], int count);
+
+    struct Record;
+
+private:
+    SkGlyphDiskCache(sk_sp<SkData>, const Record* records, int count);
+
+    const Record* find(const SkGlyph&) const;
+
+    const sk_sp<SkData> fData;
+    const Record* const fRecords;  // Sorted by packed glyph ID.
+    const int           fCount;
+};
+
+#endif
@@ -19,6 +19,7 @@
 #include "SkRect.h"
 #include "SkSpecialImage.h"
 #include "SkSpecialSurface.h"
+#include "SkTaskGroup.h"
 #include "SkTDynamicHash.h"
 #include "SkTInternalLList.h"
 #include "SkValidationUtils.h"
@@ -222,7 +223,10 @@ sk_sp<SkSpecialImage> SkImageFilter::filterImage(SkSpecialImage* src, const Cont
         }
     }
 
-    sk_sp<SkSpecialImage> result(this->onFilterImage(src, context, offset));
+    sk_sp<SkSpecialImage> result;
+    if (!this->filterImageInTiles(src, context, &result, offset)) {
+        result = this->onFilterImage(src, context, offset);
+    }
 
 #if SK_SUPPORT_GPU
     if (src->isTextureBacked() && result && !result->isTextureBacked()) {
@@ -242,6 +246,103 @@ sk_sp<SkSpecialImage> SkImageFilter::filterImage(SkSpecialImage* src, const Cont
     return result;
 }
 
+bool SkImageFilter::canFilterInTiles() const {
+    if (!this->onCanFilterInTiles()) {
+        return false;
+    }
+    for (int i = 0; i < this->countInputs(); i++) {
+        SkImageFilter* input = this->getInput(i);
+        if (input && !input->canFilterInTiles()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Bands are never shorter than this, nor than 4x the rows each band must add above and below
+// itself to feed the DAG, so the extra work those rows cost stays small.
+static const int kMinBandHeight = 64;
+// Results smaller than this many pixels are not worth splitting up.
+static const int kMinTiledArea = 256 * 256;
+
+bool SkImageFilter::filterImageInTiles(SkSpecialImage* src, const Context& ctx,
+                                       sk_sp<SkSpecialImage>* result, SkIPoint* offset) const {
+    if (ctx.maxThreads() < 2 || src->isTextureBacked() || !this->canFilterInTiles()) {
+        return false;
+    }
+
+    SkIRect bounds = ctx.clipBounds();
+    if (this->canComputeFastBounds()) {
+        const SkIRect srcBounds = SkIRect::MakeWH(src->width(), src->height());
+        if (!bounds.intersect(this->filterBounds(srcBounds, ctx.ctm(), kForward_MapDirection))) {
+            return false;
+        }
+    }
+    if (bounds.isEmpty() || (int64_t)bounds.width() * bounds.height() < kMinTiledArea) {
+        return false;
+    }
+
+    const SkIRect needed = this->filterBounds(bounds, ctx.ctm(), kReverse_MapDirection);
+    const int margin = SkTMax(SkTMax(bounds.top() - needed.top(),
+                                     needed.bottom() - bounds.bottom()), 0);
+    const int minBandHeight = SkTMax(kMinBandHeight, 4 * margin);
+    const int bands = SkTMin(ctx.maxThreads(), bounds.height() / minBandHeight);
+    if (bands < 2) {
+        return false;
+    }
+
+    SkBitmap dst;
+    if (!dst.tryAllocPixels(SkImageInfo::MakeN32Premul(bounds.width(), bounds.height()))) {
+        return false;
+    }
+    SkAutoLockPixels dstLock(dst);
+
+    SkAtomic<bool> failed(false);
+    SkTaskGroup().batch(bands, [&](int i) {
+        const SkIRect band = SkIRect::MakeLTRB(bounds.left(),
+                                               bounds.top() + bounds.height() *  i      / bands,
+                                               bounds.right(),
+                                               bounds.top() + bounds.height() * (i + 1) / bands);
+        for (int y = band.top(); y < band.bottom(); y++) {
+            sk_bzero(dst.getAddr32(0, y - bounds.top()), dst.width() * sizeof(SkPMColor));
+        }
+
+        // Shared nodes inside the band are still only filtered once, through the cache.
+        const Context bandCtx(ctx.ctm(), band, ctx.cache());
+        SkIPoint bandOffset = SkIPoint::Make(0, 0);
+        sk_sp<SkSpecialImage> bandResult(this->onFilterImage(src, bandCtx, &bandOffset));
+        if (!bandResult) {
+            return;
+        }
+
+        SkBitmap bandBM;
+        if (!bandResult->getROPixels(&bandBM) || kN32_SkColorType != bandBM.colorType()) {
+            failed.store(true);
+            return;
+        }
+        SkIRect copy = SkIRect::MakeXYWH(bandOffset.x(), bandOffset.y(),
+                                         bandBM.width(), bandBM.height());
+        if (!copy.intersect(band)) {
+            return;
+        }
+        SkAutoLockPixels bandLock(bandBM);
+        for (int y = copy.top(); y < copy.bottom(); y++) {
+            memcpy(dst.getAddr32(copy.left() - bounds.left(), y - bounds.top()),
+                   bandBM.getAddr32(copy.left() - bandOffset.x(), y - bandOffset.y()),
+                   copy.width() * sizeof(SkPMColor));
+        }
+    });
+    if (failed.load()) {
+        return false;
+    }
+
+    *result = SkSpecialImage::MakeFromRaster(src->internal_getProxy(),
+                                             SkIRect::MakeWH(bounds.width(), bounds.height()),
+                                             dst, &src->props());
+    *offset = SkIPoint::Make(bounds.left(), bounds.top());
+    return true;
+}
+
 bool SkImageFilter::filterImageDeprecated(Proxy* proxy, const SkBitmap& src,
                                           const Context& context,
                                           SkBitmap* result, SkIPoint* offset) const {
@@ -496,7 +597,7 @@ SkIRect SkImageFilter::onFilterNodeBounds(const SkIRect& src, const SkMatrix&, M
 SkImageFilter::Context SkImageFilter::mapContext(const Context& ctx) const {
     SkIRect clipBounds = this->onFilterNodeBounds(ctx.clipBounds(), ctx.ctm(),
                                                   MapDirection::kReverse_MapDirection);
-    return Context(ctx.ctm(), clipBounds, ctx.cache());
+    return Context(ctx.ctm(), clipBounds, ctx.cache(), ctx.maxThreads());
 }
 
 sk_sp<SkImageFilter> SkImageFilter::MakeMatrixFilter(const SkMatrix& matrix,
@@ -529,6 +630,56 @@ sk_sp<SkSpecialImage> SkImageFilter::filterInput(int index,
     return result;
 }
 
+void SkImageFilter::filterInputs(SkSpecialImage* src, const Context& ctx,
+                                 sk_sp<SkSpecialImage> inputs[], SkIPoint offsets[]) const {
+    const int count = this->countInputs();
+
+    // first[i] is the lowest index whose input filter is the same as input i's.
+    SkAutoSTArray<8, int> first(count);
+    int distinct = 0;
+    for (int i = 0; i < count; ++i) {
+        offsets[i].setZero();
+        first[i] = i;
+        SkImageFilter* input = this->getInput(i);
+        if (!input) {
+            inputs[i] = this->filterInput(i, src, ctx, &offsets[i]);
+            continue;
+        }
+        for (int j = 0; j < i; ++j) {
+            if (this->getInput(j) == input) {
+                first[i] = j;
+                break;
+            }
+        }
+        if (first[i] == i) {
+            distinct++;
+        }
+    }
+
+    auto filter = [&](int i, const Context& inputCtx) {
+        if (this->getInput(i) && first[i] == i) {
+            inputs[i] = this->filterInput(i, src, inputCtx, &offsets[i]);
+        }
+    };
+    if (ctx.maxThreads() > 1 && distinct > 1 && !src->isTextureBacked()) {
+        // Split the threads between the branches, so they don't each try to use them all.
+        const Context branchCtx(ctx.ctm(), ctx.clipBounds(), ctx.cache(),
+                                SkTMax(1, ctx.maxThreads() / distinct));
+        SkTaskGroup().batch(count, [&](int i) { filter(i, branchCtx); });
+    } else {
+        for (int i = 0; i < count; ++i) {
+            filter(i, ctx);
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (first[i] != i) {
+            inputs[i] = inputs[first[i]];
+            offsets[i] = offsets[first[i]];
+        }
+    }
+}
+
 namespace {
 
 class CacheImpl : public SkImageFilter::Cache {
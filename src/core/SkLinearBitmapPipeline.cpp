@@ -60,6 +60,11 @@ public:
     // resulting Y values my be off the tile. When y +/- 0.5 are more than 1 apart because of
     // tiling, the second Y is used to denote the retiled Y value.
     virtual void bilerpSpan(Span span, SkScalar y) = 0;
+
+    // Used for bicubic filtering. The sixteen pixels around the sample point are the columns xs
+    // crossed with the rows ys, both already tiled, in order from left to right and top to bottom.
+    // The sample point lies fx to the right of the center of column 1, and fy below that of row 1.
+    virtual void VECTORCALL bicubicEdge(Sk4s xs, Sk4s ys, SkScalar fx, SkScalar fy) = 0;
 };
 
 class SkLinearBitmapPipeline::DestinationInterface {
@@ -407,12 +412,66 @@ private:
     YStrategy fYStrategy;
 };
 
+// Every bicubic sample reads a 4x4 block of pixels, so spans are not worth special casing; each
+// point tiles the centers of its four columns and four rows, and passes them on with its offsets.
+template<typename XStrategy, typename YStrategy, typename Next>
+class BicubicTileStage final : public SkLinearBitmapPipeline::PointProcessorInterface {
+public:
+    BicubicTileStage(Next* next, SkISize dimensions)
+        : fNext{next}
+        , fXStrategy{dimensions.width()}
+        , fYStrategy{dimensions.height()} { }
+
+    BicubicTileStage(Next* next, const BicubicTileStage& stage)
+        : fNext{next}
+        , fXStrategy{stage.fXStrategy}
+        , fYStrategy{stage.fYStrategy} { }
+
+    void VECTORCALL pointListFew(int n, Sk4s xs, Sk4s ys) override {
+        if (n >= 1) this->bicubicPoint(xs[0], ys[0]);
+        if (n >= 2) this->bicubicPoint(xs[1], ys[1]);
+        if (n >= 3) this->bicubicPoint(xs[2], ys[2]);
+    }
+
+    void VECTORCALL pointList4(Sk4s xs, Sk4s ys) override {
+        this->bicubicPoint(xs[0], ys[0]);
+        this->bicubicPoint(xs[1], ys[1]);
+        this->bicubicPoint(xs[2], ys[2]);
+        this->bicubicPoint(xs[3], ys[3]);
+    }
+
+    // The span you pass must not be empty.
+    void pointSpan(Span span) override {
+        SkASSERT(!span.isEmpty());
+        span_fallback(span, this);
+    }
+
+private:
+    void bicubicPoint(SkScalar x, SkScalar y) {
+        // Pixel centers are at half integers; the sample lies between those of columns ix and
+        // ix + 1, and rows iy and iy + 1.
+        SkScalar ix = SkScalarFloorToScalar(x - 0.5f);
+        SkScalar iy = SkScalarFloorToScalar(y - 0.5f);
+        Sk4s xs = Sk4s{ix} + Sk4s{-0.5f, 0.5f, 1.5f, 2.5f};
+        Sk4s ys = Sk4s{iy} + Sk4s{-0.5f, 0.5f, 1.5f, 2.5f};
+        fXStrategy.tileXPoints(&xs);
+        fYStrategy.tileYPoints(&ys);
+        fNext->bicubicEdge(xs, ys, x - 0.5f - ix, y - 0.5f - iy);
+    }
+
+    Next* const fNext;
+    XStrategy fXStrategy;
+    YStrategy fYStrategy;
+};
+
 template <typename XStrategy, typename YStrategy, typename Next>
 void make_tile_stage(
     SkFilterQuality filterQuality, SkISize dimensions,
     Next* next, SkLinearBitmapPipeline::TileStage* tileStage) {
     if (filterQuality == kNone_SkFilterQuality) {
         tileStage->initStage<NearestTileStage<XStrategy, YStrategy, Next>>(next, dimensions);
+    } else if (filterQuality == kHigh_SkFilterQuality) {
+        tileStage->initStage<BicubicTileStage<XStrategy, YStrategy, Next>>(next, dimensions);
     } else {
         tileStage->initStage<BilerpTileStage<XStrategy, YStrategy, Next>>(next, dimensions);
     }
@@ -504,6 +563,10 @@ public:
         SkFAIL("Using nearest neighbor sampler, but calling a bilerpSpan.");
     }
 
+    void VECTORCALL bicubicEdge(Sk4s xs, Sk4s ys, SkScalar fx, SkScalar fy) override {
+        SkFAIL("Using nearest neighbor sampler, but calling a bicubicEdge.");
+    }
+
 private:
     GeneralSampler<SourceStrategy, Next> fSampler;
 };
@@ -545,8 +608,59 @@ public:
         fSampler.bilerpSpanWithY(span, y);
     }
 
+    void VECTORCALL bicubicEdge(Sk4s xs, Sk4s ys, SkScalar fx, SkScalar fy) override {
+        SkFAIL("Using bilerp sampler, but calling a bicubicEdge.");
+    }
+
+private:
+    GeneralSampler<SourceStrategy, Next> fSampler;
+};
+
+// The BicubicTileStage hands every sample point over as a bicubicEdge.
+template <typename SourceStrategy, typename Next>
+class BicubicSampler final : public SkLinearBitmapPipeline::SampleProcessorInterface {
+public:
+    BicubicSampler(Next* next, const SkPixmap& srcPixmap)
+        : fSampler{next, srcPixmap}
+        , fIsPremul{srcPixmap.alphaType() != kUnpremul_SkAlphaType
+                    && srcPixmap.colorType() != kIndex_8_SkColorType} { }
+
+    BicubicSampler(Next* next, const BicubicSampler& sampler)
+        : fSampler{next, sampler.fSampler}
+        , fIsPremul{sampler.fIsPremul} { }
+
+    void VECTORCALL pointListFew(int n, Sk4s xs, Sk4s ys) override {
+        SkFAIL("Using bicubic sampler, but calling a pointListFew.");
+    }
+
+    void VECTORCALL pointList4(Sk4s xs, Sk4s ys) override {
+        SkFAIL("Using bicubic sampler, but calling a pointList4.");
+    }
+
+    void pointSpan(Span span) override {
+        SkFAIL("Using bicubic sampler, but calling a pointSpan.");
+    }
+
+    void repeatSpan(Span span, int32_t repeatCount) override {
+        SkFAIL("Using bicubic sampler, but calling a repeatSpan.");
+    }
+
+    void VECTORCALL bilerpEdge(Sk4s xs, Sk4s ys) override {
+        SkFAIL("Using bicubic sampler, but calling a bilerpEdge.");
+    }
+
+    void bilerpSpan(Span span, SkScalar y) override {
+        SkFAIL("Using bicubic sampler, but calling a bilerpSpan.");
+    }
+
+    void VECTORCALL bicubicEdge(Sk4s xs, Sk4s ys, SkScalar fx, SkScalar fy) override {
+        fSampler.bicubicEdge(xs, ys, fx, fy, fIsPremul);
+    }
+
 private:
     GeneralSampler<SourceStrategy, Next> fSampler;
+    // Index8 sources are sampled unpremultiplied; see the pipeline's constructor.
+    const bool fIsPremul;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -609,6 +723,10 @@ public:
 
     void bilerpSpan(Span span, SkScalar y) override { SkFAIL("Not Implemented"); }
 
+    void VECTORCALL bicubicEdge(Sk4s xs, Sk4s ys, SkScalar fx, SkScalar fy) override {
+        SkFAIL("Not Implemented");
+    }
+
     void setDestination(void* dst, int count) override  {
         fDest = static_cast<uint32_t*>(dst);
         fEnd = fDest + count;
@@ -654,6 +772,20 @@ static SkLinearBitmapPipeline::SampleProcessorInterface* choose_pixel_sampler_ba
                 sampleStage->initStage<Sampler<PixelIndex8LRGB, Blender>>(next, srcPixmap);
             }
             break;
+        case kRGB_565_SkColorType:
+            if (imageInfo.profileType() == kSRGB_SkColorProfileType) {
+                sampleStage->initStage<Sampler<Pixel565SRGB, Blender>>(next, srcPixmap);
+            } else {
+                sampleStage->initStage<Sampler<Pixel565LRGB, Blender>>(next, srcPixmap);
+            }
+            break;
+        case kGray_8_SkColorType:
+            if (imageInfo.profileType() == kSRGB_SkColorProfileType) {
+                sampleStage->initStage<Sampler<PixelGray8SRGB, Blender>>(next, srcPixmap);
+            } else {
+                sampleStage->initStage<Sampler<PixelGray8LRGB, Blender>>(next, srcPixmap);
+            }
+            break;
         case kRGBA_F16_SkColorType:
             sampleStage->initStage<Sampler<PixelHalfLinear, Blender>>(next, srcPixmap);
             break;
@@ -672,6 +804,8 @@ SkLinearBitmapPipeline::SampleProcessorInterface* choose_pixel_sampler(
 {
     if (filterQuality == kNone_SkFilterQuality) {
         return choose_pixel_sampler_base<NearestNeighborSampler>(next, srcPixmap, sampleStage);
+    } else if (filterQuality == kHigh_SkFilterQuality) {
+        return choose_pixel_sampler_base<BicubicSampler>(next, srcPixmap, sampleStage);
     } else {
         return choose_pixel_sampler_base<BilerpSampler>(next, srcPixmap, sampleStage);
     }
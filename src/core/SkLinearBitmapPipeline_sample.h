@@ -8,6 +8,7 @@
 #ifndef SkLinearBitmapPipeline_sampler_DEFINED
 #define SkLinearBitmapPipeline_sampler_DEFINED
 
+#include "SkColorPriv.h"
 #include "SkFixed.h"
 #include "SkHalf.h"
 #include "SkLinearBitmapPipeline_core.h"
@@ -48,6 +49,15 @@ static Sk4s VECTORCALL bilerp4(Sk4s xs, Sk4s ys, Sk4f px00, Sk4f px10,
     return sum;
 }
 
+// The weights of Mitchell and Netravali's cubic with B = C = 1/3, the filter SkMitchellFilter
+// uses, for the four pixels around a sample point that lies t past the center of the second.
+static Sk4s VECTORCALL bicubic_weights(SkScalar t) {
+    Sk4s d = Sk4s{1.0f + t, t, 1.0f - t, 2.0f - t};
+    Sk4s near = (Sk4s{7.0f / 6.0f} * d - 2.0f) * d * d + 8.0f / 9.0f;
+    Sk4s far  = ((Sk4s{-7.0f / 18.0f} * d + 2.0f) * d - 10.0f / 3.0f) * d + 16.0f / 9.0f;
+    return (d < 1.0f).thenElse(near, far);
+}
+
 // The GeneralSampler class
 template<typename SourceStrategy, typename Next>
 class GeneralSampler {
@@ -132,6 +142,27 @@ public:
         this->bilerpSpanWithY(span, span.startY());
     }
 
+    // The sixteen pixels around a bicubic sample point are the columns xs crossed with the rows
+    // ys, both already tiled. The point lies fx past the center of column xs[1] and fy past the
+    // center of row ys[1]. The filter's negative lobes can ring past the range of a color, so the
+    // result is clamped, and for premultiplied sources its color is also kept below its alpha.
+    void VECTORCALL bicubicEdge(Sk4s xs, Sk4s ys, SkScalar fx, SkScalar fy, bool isPremul) {
+        Sk4f wxs = bicubic_weights(fx);
+        Sk4f wys = bicubic_weights(fy);
+        Sk4f sum{0.0f};
+        for (int i = 0; i < 4; i++) {
+            Sk4f px0, px1, px2, px3;
+            fStrategy.get4Pixels(xs, Sk4s{ys[i]}, &px0, &px1, &px2, &px3);
+            Sk4f row = px0 * wxs[0] + px1 * wxs[1] + px2 * wxs[2] + px3 * wxs[3];
+            sum = sum + row * wys[i];
+        }
+        sum = Sk4f::Min(Sk4f::Max(sum, 0.0f), 1.0f);
+        if (isPremul) {
+            sum = Sk4f::Min(sum, Sk4f{sum[3], sum[3], sum[3], 1.0f});
+        }
+        fNext->blendPixel(sum);
+    }
+
     void bilerpSpanWithY(Span span, SkScalar y) {
         SkASSERT(!span.isEmpty());
         SkPoint start;
@@ -788,6 +819,94 @@ private:
     const Sk4i            fWidth;
 };
 
+// Opaque sources whose pixels each fit in one Converter::Element, which Converter::ToLinear turns
+// into a float pixel.
+template <typename Converter>
+class PixelConverter {
+public:
+    using Element = typename Converter::Element;
+    PixelConverter(const SkPixmap& srcPixmap)
+        : fSrc{static_cast<const Element*>(srcPixmap.addr())}
+        , fWidth{static_cast<int>(srcPixmap.rowBytes() / sizeof(Element))} { }
+
+    void VECTORCALL getFewPixels(int n, Sk4s xs, Sk4s ys, Sk4f* px0, Sk4f* px1, Sk4f* px2) {
+        Sk4i XIs = SkNx_cast<int, SkScalar>(xs);
+        Sk4i YIs = SkNx_cast<int, SkScalar>(ys);
+        Sk4i bufferLoc = YIs * fWidth + XIs;
+        switch (n) {
+            case 3:
+                *px2 = this->getPixelAt(fSrc, bufferLoc[2]);
+            case 2:
+                *px1 = this->getPixelAt(fSrc, bufferLoc[1]);
+            case 1:
+                *px0 = this->getPixelAt(fSrc, bufferLoc[0]);
+            default:
+                break;
+        }
+    }
+
+    void VECTORCALL get4Pixels(Sk4s xs, Sk4s ys, Sk4f* px0, Sk4f* px1, Sk4f* px2, Sk4f* px3) {
+        Sk4i XIs = SkNx_cast<int, SkScalar>(xs);
+        Sk4i YIs = SkNx_cast<int, SkScalar>(ys);
+        Sk4i bufferLoc = YIs * fWidth + XIs;
+        *px0 = this->getPixelAt(fSrc, bufferLoc[0]);
+        *px1 = this->getPixelAt(fSrc, bufferLoc[1]);
+        *px2 = this->getPixelAt(fSrc, bufferLoc[2]);
+        *px3 = this->getPixelAt(fSrc, bufferLoc[3]);
+    }
+
+    void get4Pixels(const void* vsrc, int index, Sk4f* px0, Sk4f* px1, Sk4f* px2, Sk4f* px3) {
+        *px0 = this->getPixelAt(vsrc, index + 0);
+        *px1 = this->getPixelAt(vsrc, index + 1);
+        *px2 = this->getPixelAt(vsrc, index + 2);
+        *px3 = this->getPixelAt(vsrc, index + 3);
+    }
+
+    Sk4f getPixelAt(const void* vsrc, int index) {
+        const Element* src = static_cast<const Element*>(vsrc);
+        return Converter::ToLinear(src[index]);
+    }
+
+    const void* row(int y) { return fSrc + y * fWidth[0]; }
+
+private:
+    const Element* const fSrc;
+    const Sk4i           fWidth;
+};
+
+template <SkColorProfileType colorProfile>
+struct Convert565 {
+    using Element = uint16_t;
+    static Sk4f ToLinear(uint16_t pixel) {
+        Sk4f result = Sk4f{SkScalar(SkGetPackedR16(pixel)),
+                           SkScalar(SkGetPackedG16(pixel)),
+                           SkScalar(SkGetPackedB16(pixel)),
+                           1.0f};
+        result = result * Sk4f{1.0f / SK_R16_MASK, 1.0f / SK_G16_MASK, 1.0f / SK_B16_MASK, 1.0f};
+        if (colorProfile == kSRGB_SkColorProfileType) {
+            result = sRGBFast::sRGBToLinear(result);
+        }
+        return result;
+    }
+};
+
+template <SkColorProfileType colorProfile>
+struct ConvertGray8 {
+    using Element = uint8_t;
+    static Sk4f ToLinear(uint8_t pixel) {
+        SkScalar gray = pixel * (1.0f / 255.0f);
+        if (colorProfile == kSRGB_SkColorProfileType) {
+            gray = gray * gray;
+        }
+        return Sk4f{gray, gray, gray, 1.0f};
+    }
+};
+
+using Pixel565SRGB   = PixelConverter<Convert565<kSRGB_SkColorProfileType>>;
+using Pixel565LRGB   = PixelConverter<Convert565<kLinear_SkColorProfileType>>;
+using PixelGray8SRGB = PixelConverter<ConvertGray8<kSRGB_SkColorProfileType>>;
+using PixelGray8LRGB = PixelConverter<ConvertGray8<kLinear_SkColorProfileType>>;
+
 }  // namespace
 
 #endif  // SkLinearBitmapPipeline_sampler_DEFINED
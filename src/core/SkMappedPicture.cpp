@@ -0,0 +1,84 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkMappedPicture.h"
+#include "SkPicturePlayback.h"
+#include "SkPictureRecord.h"
+#include "SkReader32.h"
+
+SkMappedPicture::SkMappedPicture(const SkRect& cull, SkPictureData* data)
+    : fCullRect(cull)
+    , fData(data)
+    , fOpCount(0)
+    , fNumSlowPaths(0)
+    , fHasText(false) {
+    // Skim the ops for what SkBigPicture would learn by analyzing its record, reading only as far
+    // into each op as needed.  Slow paths are counted more roughly than SkPathCounter does.
+    const sk_sp<SkData>& ops = data->opData();
+    SkReader32 reader(ops->data(), ops->size());
+    while (!reader.eof()) {
+        const size_t start = reader.offset();
+        uint32_t packed = reader.readInt(), op, size;
+        UNPACK_8_24(packed, op, size);
+        if (MASK_24 == size) {
+            size = reader.readInt();
+        }
+        if (size < sizeof(uint32_t) || size > ops->size() - start) {
+            break;  // Sizeless ops from very old pictures, or a corrupt one.
+        }
+        fOpCount++;
+
+        const SkPicture* picture = nullptr;
+        switch ((DrawType)op) {
+            case DRAW_POS_TEXT:
+            case DRAW_POS_TEXT_TOP_BOTTOM:
+            case DRAW_POS_TEXT_H:
+            case DRAW_POS_TEXT_H_TOP_BOTTOM:
+            case DRAW_TEXT:
+            case DRAW_TEXT_ON_PATH:
+            case DRAW_TEXT_TOP_BOTTOM:
+            case DRAW_TEXT_BLOB:
+                fHasText = true;
+                break;
+            case DRAW_PATH: {
+                const SkPaint* paint = data->getPaint(&reader);
+                const SkPath& path = data->getPath(&reader);
+                if (paint && paint->isAntiAlias() && !path.isConvex()) {
+                    fNumSlowPaths++;
+                }
+            } break;
+            case DRAW_PICTURE:
+                picture = data->getPicture(&reader);
+                break;
+            case DRAW_PICTURE_MATRIX_PAINT: {
+                data->getPaint(&reader);
+                SkMatrix matrix;
+                reader.readMatrix(&matrix);
+                picture = data->getPicture(&reader);
+            } break;
+            default:
+                break;
+        }
+        if (picture) {
+            fOpCount      += picture->approximateOpCount();
+            fNumSlowPaths += picture->numSlowPaths();
+            fHasText       = fHasText || picture->hasText();
+        }
+        reader.setOffset(start + size);
+    }
+}
+
+void SkMappedPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
+    SkPicturePlayback playback(fData);
+    playback.draw(canvas, callback);
+}
+
+size_t SkMappedPicture::approximateBytesUsed() const {
+    // The ops themselves are usually mapped, not allocated, but they're read at each playback.
+    return sizeof(*this) + sizeof(SkPictureData) + fData->opData()->size() +
+           fData->pathBytesUsed();
+}
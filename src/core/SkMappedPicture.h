@@ -0,0 +1,41 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMappedPicture_DEFINED
+#define SkMappedPicture_DEFINED
+
+#include "SkPicture.h"
+#include "SkPictureData.h"
+#include "SkTemplates.h"
+
+// An SkPicture that plays back serialized ops in place, typically from a mapped SKP file.
+// Each op is decoded only as it is played back, and an op the canvas clips out draws nothing,
+// so the images it draws are never decoded.  There is no BBH to skip ops outside the clip, so
+// each playback still reads them all: we trade some tiled playback speed for quick loading.
+class SkMappedPicture final : public SkPicture {
+public:
+    SkMappedPicture(const SkRect& cull, SkPictureData*);  // We take ownership of the data.
+
+// SkPicture overrides
+    void playback(SkCanvas*, AbortCallback*) const override;
+    SkRect cullRect() const override { return fCullRect; }
+    bool hasText() const override { return fHasText; }
+    bool willPlayBackBitmaps() const override { return fData->containsBitmaps(); }
+    int approximateOpCount() const override { return fOpCount; }
+    size_t approximateBytesUsed() const override;
+
+private:
+    int numSlowPaths() const override { return fNumSlowPaths; }
+
+    const SkRect                        fCullRect;
+    SkAutoTDelete<const SkPictureData>  fData;
+    int                                 fOpCount;
+    int                                 fNumSlowPaths;
+    bool                                fHasText;
+};
+
+#endif
@@ -11,6 +11,8 @@
 #include "SkHalf.h"
 #include "SkMath.h"
 #include "SkNx.h"
+#include "SkPM4fPriv.h"
+#include "SkTaskGroup.h"
 #include "SkTypes.h"
 
 //
@@ -41,6 +43,17 @@ struct ColorTypeFilter_8888 {
 #endif
 };
 
+// sRGB-encoded 8888 is averaged in linear space, or levels would darken as they shrink.
+struct ColorTypeFilter_S32 {
+    typedef uint32_t Type;
+    static Sk4f Expand(uint32_t x) {
+        return Sk4f_fromS32(x);
+    }
+    static uint32_t Compact(const Sk4f& x) {
+        return Sk4f_toS32(x);
+    }
+};
+
 struct ColorTypeFilter_565 {
     typedef uint16_t Type;
     static uint32_t Expand(uint16_t x) {
@@ -282,6 +295,116 @@ template <typename F> void downsample_3_3(void* dst, const void* src, size_t src
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Levels at least this large are downsampled in bands of rows on SkTaskGroup's threads.
+static const int kMinParallelPixels = 64 * 1024;
+
+namespace {
+
+typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
+
+struct FilterProcs {
+    FilterProc* f_1_2;
+    FilterProc* f_1_3;
+    FilterProc* f_2_1;
+    FilterProc* f_2_2;
+    FilterProc* f_2_3;
+    FilterProc* f_3_1;
+    FilterProc* f_3_2;
+    FilterProc* f_3_3;
+
+    template <typename F> void set() {
+        f_1_2 = downsample_1_2<F>;
+        f_1_3 = downsample_1_3<F>;
+        f_2_1 = downsample_2_1<F>;
+        f_2_2 = downsample_2_2<F>;
+        f_2_3 = downsample_2_3<F>;
+        f_3_1 = downsample_3_1<F>;
+        f_3_2 = downsample_3_2<F>;
+        f_3_3 = downsample_3_3<F>;
+    }
+
+    // Returns false if we can't build levels for this info.
+    bool choose(const SkImageInfo& info) {
+        switch (info.colorType()) {
+            case kRGBA_8888_SkColorType:
+            case kBGRA_8888_SkColorType:
+                if (info.isSRGB()) {
+                    this->set<ColorTypeFilter_S32>();
+                } else {
+                    this->set<ColorTypeFilter_8888>();
+                }
+                return true;
+            case kRGB_565_SkColorType:
+                this->set<ColorTypeFilter_565>();
+                return true;
+            case kARGB_4444_SkColorType:
+                this->set<ColorTypeFilter_4444>();
+                return true;
+            case kAlpha_8_SkColorType:
+            case kGray_8_SkColorType:
+                this->set<ColorTypeFilter_8>();
+                return true;
+            case kRGBA_F16_SkColorType:
+                this->set<ColorTypeFilter_F16>();
+                return true;
+            default:
+                // TODO: We could build miplevels for kIndex8 if the levels were in 8888.
+                //       Means using more ram, but the quality would be fine.
+                return false;
+        }
+    }
+
+    // Downsamples src into dst, which must be the next level down.
+    void downsample(const SkPixmap& src, const SkPixmap& dst, bool parallel) const {
+        const int width  = src.width(),
+                  height = src.height();
+        FilterProc* proc;
+        if (height & 1) {
+            if (height == 1) {        // src-height is 1
+                if (width & 1) {      // src-width is 3
+                    proc = f_3_1;
+                } else {              // src-width is 2
+                    proc = f_2_1;
+                }
+            } else {                  // src-height is 3
+                if (width & 1) {
+                    if (width == 1) { // src-width is 1
+                        proc = f_1_3;
+                    } else {          // src-width is 3
+                        proc = f_3_3;
+                    }
+                } else {              // src-width is 2
+                    proc = f_2_3;
+                }
+            }
+        } else {                      // src-height is 2
+            if (width & 1) {
+                if (width == 1) {     // src-width is 1
+                    proc = f_1_2;
+                } else {              // src-width is 3
+                    proc = f_3_2;
+                }
+            } else {                  // src-width is 2
+                proc = f_2_2;
+            }
+        }
+
+        const size_t srcRB = src.rowBytes();
+        auto row = [&](int y) {
+            proc(dst.writable_addr(0, y), src.addr(0, 2 * y), srcRB, dst.width());
+        };
+        if (parallel && dst.width() * dst.height() >= kMinParallelPixels) {
+            sk_parallel_for(dst.height(), SkTMax(1, kMinParallelPixels / (4 * dst.width())), row);
+        } else {
+            for (int y = 0; y < dst.height(); y++) {
+                row(y);
+            }
+        }
+    }
+};
+
+}  // namespace
+
 size_t SkMipMap::AllocLevelsSize(int levelCount, size_t pixelSize) {
     if (levelCount < 0) {
         return 0;
@@ -293,78 +416,12 @@ size_t SkMipMap::AllocLevelsSize(int levelCount, size_t pixelSize) {
     return sk_64_asS32(size);
 }
 
-SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
-    typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
-
-    FilterProc* proc_1_2 = nullptr;
-    FilterProc* proc_1_3 = nullptr;
-    FilterProc* proc_2_1 = nullptr;
-    FilterProc* proc_2_2 = nullptr;
-    FilterProc* proc_2_3 = nullptr;
-    FilterProc* proc_3_1 = nullptr;
-    FilterProc* proc_3_2 = nullptr;
-    FilterProc* proc_3_3 = nullptr;
-
-    const SkColorType ct = src.colorType();
-    const SkAlphaType at = src.alphaType();
-    switch (ct) {
-        case kRGBA_8888_SkColorType:
-        case kBGRA_8888_SkColorType:
-            proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
-            proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
-            proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8888>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
-            proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_8888>;
-            break;
-        case kRGB_565_SkColorType:
-            proc_1_2 = downsample_1_2<ColorTypeFilter_565>;
-            proc_1_3 = downsample_1_3<ColorTypeFilter_565>;
-            proc_2_1 = downsample_2_1<ColorTypeFilter_565>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_565>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_565>;
-            proc_3_1 = downsample_3_1<ColorTypeFilter_565>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_565>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_565>;
-            break;
-        case kARGB_4444_SkColorType:
-            proc_1_2 = downsample_1_2<ColorTypeFilter_4444>;
-            proc_1_3 = downsample_1_3<ColorTypeFilter_4444>;
-            proc_2_1 = downsample_2_1<ColorTypeFilter_4444>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_4444>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_4444>;
-            proc_3_1 = downsample_3_1<ColorTypeFilter_4444>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_4444>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_4444>;
-            break;
-        case kAlpha_8_SkColorType:
-        case kGray_8_SkColorType:
-            proc_1_2 = downsample_1_2<ColorTypeFilter_8>;
-            proc_1_3 = downsample_1_3<ColorTypeFilter_8>;
-            proc_2_1 = downsample_2_1<ColorTypeFilter_8>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_8>;
-            proc_3_1 = downsample_3_1<ColorTypeFilter_8>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_8>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_8>;
-            break;
-        case kRGBA_F16_SkColorType:
-            proc_1_2 = downsample_1_2<ColorTypeFilter_F16>;
-            proc_1_3 = downsample_1_3<ColorTypeFilter_F16>;
-            proc_2_1 = downsample_2_1<ColorTypeFilter_F16>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_F16>;
-            proc_2_3 = downsample_2_3<ColorTypeFilter_F16>;
-            proc_3_1 = downsample_3_1<ColorTypeFilter_F16>;
-            proc_3_2 = downsample_3_2<ColorTypeFilter_F16>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_F16>;
-            break;
-        default:
-            // TODO: We could build miplevels for kIndex8 if the levels were in 8888.
-            //       Means using more ram, but the quality would be fine.
-            return nullptr;
+SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact, bool buildLazily) {
+    FilterProcs procs;
+    if (!procs.choose(src.info())) {
+        return nullptr;
     }
+    const SkColorType ct = src.colorType();
 
     if (src.width() <= 1 && src.height() <= 1) {
         return nullptr;
@@ -414,65 +471,53 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
     int         width = src.width();
     int         height = src.height();
     uint32_t    rowBytes;
-    SkPixmap    srcPM(src);
 
+    // Lay out every level, but only fill in the pixels of those we build now.
     for (int i = 0; i < countLevels; ++i) {
-        FilterProc* proc;
-        if (height & 1) {
-            if (height == 1) {        // src-height is 1
-                if (width & 1) {      // src-width is 3
-                    proc = proc_3_1;
-                } else {              // src-width is 2
-                    proc = proc_2_1;
-                }
-            } else {                  // src-height is 3
-                if (width & 1) {
-                    if (width == 1) { // src-width is 1
-                        proc = proc_1_3;
-                    } else {          // src-width is 3
-                        proc = proc_3_3;
-                    }
-                } else {              // src-width is 2
-                    proc = proc_2_3;
-                }
-            }
-        } else {                      // src-height is 2
-            if (width & 1) {
-                if (width == 1) {     // src-width is 1
-                    proc = proc_1_2;
-                } else {              // src-width is 3
-                    proc = proc_3_2;
-                }
-            } else {                  // src-width is 2
-                proc = proc_2_2;
-            }
-        }
         width = SkTMax(1, width >> 1);
         height = SkTMax(1, height >> 1);
         rowBytes = SkToU32(SkColorTypeMinRowBytes(ct, width));
 
-        levels[i].fPixmap = SkPixmap(SkImageInfo::Make(width, height, ct, at), addr, rowBytes);
+        levels[i].fPixmap = SkPixmap(src.info().makeWH(width, height), addr, rowBytes);
         levels[i].fScale  = SkSize::Make(SkIntToScalar(width)  / src.width(),
                                          SkIntToScalar(height) / src.height());
-
-        const SkPixmap& dstPM = levels[i].fPixmap;
-        const void* srcBasePtr = srcPM.addr();
-        void* dstBasePtr = dstPM.writable_addr();
-
-        const size_t srcRB = srcPM.rowBytes();
-        for (int y = 0; y < height; y++) {
-            proc(dstBasePtr, srcBasePtr, srcRB, width);
-            srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
-            dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
-        }
-        srcPM = dstPM;
         addr += height * rowBytes;
     }
     SkASSERT(addr == baseAddr + size);
 
+    // The first level is the only one built from src, so we always build it here, and src need
+    // not outlive the mipmap.
+    const int builtCount = buildLazily ? 1 : countLevels;
+    procs.downsample(src, levels[0].fPixmap, true);
+    for (int i = 1; i < builtCount; ++i) {
+        procs.downsample(levels[i - 1].fPixmap, levels[i].fPixmap, true);
+    }
+    mipmap->fBuiltCount.store(builtCount, sk_memory_order_relaxed);
+
     return mipmap;
 }
 
+void SkMipMap::buildLevelsThrough(int index) const {
+    SkASSERT(index < fCount);
+    if (fBuiltCount.load(sk_memory_order_acquire) > index) {
+        return;
+    }
+
+    SkAutoMutexAcquire lock(fBuildMutex);
+    int built = fBuiltCount.load(sk_memory_order_relaxed);
+    if (built > index) {
+        return;
+    }
+    FilterProcs procs;
+    SkAssertResult(procs.choose(fLevels[0].fPixmap.info()));
+    // We may be asked for a level from a task on SkTaskGroup's threads, so we don't wait on
+    // them while we hold the lock.  The levels past the first are small anyway.
+    for (; built <= index; built++) {
+        procs.downsample(fLevels[built - 1].fPixmap, fLevels[built].fPixmap, false);
+    }
+    fBuiltCount.store(built, sk_memory_order_release);
+}
+
 int SkMipMap::ComputeLevelCount(int baseWidth, int baseHeight) {
     if (baseWidth < 1 || baseHeight < 1) {
         return 0;
@@ -548,6 +593,7 @@ bool SkMipMap::extractLevel(const SkSize& scaleSize, Level* levelPtr) const {
         level = fCount;
     }
     if (levelPtr) {
+        this->buildLevelsThrough(level - 1);
         *levelPtr = fLevels[level - 1];
     }
     return true;
@@ -555,7 +601,7 @@ bool SkMipMap::extractLevel(const SkSize& scaleSize, Level* levelPtr) const {
 
 // Helper which extracts a pixmap from the src bitmap
 //
-SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact) {
+SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact, bool buildLazily) {
     SkAutoPixmapUnlock srcUnlocker;
     if (!src.requestLock(&srcUnlocker)) {
         return nullptr;
@@ -565,7 +611,7 @@ SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact) {
     if (nullptr == srcPixmap.addr()) {
         sk_throw();
     }
-    return Build(srcPixmap, fact);
+    return Build(srcPixmap, fact, buildLazily);
 }
 
 int SkMipMap::countLevels() const {
@@ -583,6 +629,7 @@ bool SkMipMap::getLevel(int index, Level* levelPtr) const {
         return false;
     }
     if (levelPtr) {
+        this->buildLevelsThrough(index);
         *levelPtr = fLevels[index];
     }
     return true;
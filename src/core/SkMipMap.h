@@ -8,7 +8,9 @@
 #ifndef SkMipMap_DEFINED
 #define SkMipMap_DEFINED
 
+#include "SkAtomics.h"
 #include "SkCachedData.h"
+#include "SkMutex.h"
 #include "SkPixmap.h"
 #include "SkScalar.h"
 #include "SkSize.h"
@@ -20,8 +22,16 @@ typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
 
 class SkMipMap : public SkCachedData {
 public:
-    static SkMipMap* Build(const SkPixmap& src, SkDiscardableFactoryProc);
-    static SkMipMap* Build(const SkBitmap& src, SkDiscardableFactoryProc);
+    /**
+     *  Builds the levels below src.  Large levels are built in bands on SkTaskGroup's threads.
+     *  If buildLazily is true, only the first level is built here, and each level below it the
+     *  first time it's extracted or gotten, so a source drawn only a little smaller never pays
+     *  for the whole chain.  The storage for every level is allocated up front either way.
+     */
+    static SkMipMap* Build(const SkPixmap& src, SkDiscardableFactoryProc,
+                           bool buildLazily = false);
+    static SkMipMap* Build(const SkBitmap& src, SkDiscardableFactoryProc,
+                           bool buildLazily = false);
 
     // This function lets you determine how many levels a SkMipMap will have without
     // creating that mipmap.
@@ -45,6 +55,12 @@ private:
     Level*  fLevels;
     int     fCount;
 
+    // Levels [0, fBuiltCount) hold their pixels.  fBuildMutex guards building the rest.
+    mutable SkAtomic<int>   fBuiltCount;
+    mutable SkMutex         fBuildMutex;
+
+    void buildLevelsThrough(int index) const;
+
     // we take ownership of levels, and will free it with sk_free()
     SkMipMap(void* malloc, size_t size) : INHERITED(malloc, size) {}
     SkMipMap(size_t size, SkDiscardableMemory* dm) : INHERITED(size, dm) {}
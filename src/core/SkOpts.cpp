@@ -69,6 +69,9 @@ namespace SkOpts {
     decltype(grayA_to_rgbA)         grayA_to_rgbA         = sk_default::grayA_to_rgbA;
     decltype(inverted_CMYK_to_RGB1) inverted_CMYK_to_RGB1 = sk_default::inverted_CMYK_to_RGB1;
     decltype(inverted_CMYK_to_BGR1) inverted_CMYK_to_BGR1 = sk_default::inverted_CMYK_to_BGR1;
+    decltype(RGBX_to_RGB1)          RGBX_to_RGB1          = sk_default::RGBX_to_RGB1;
+    decltype(RGBX_to_BGR1)          RGBX_to_BGR1          = sk_default::RGBX_to_BGR1;
+    decltype(PMColor_to_565)        PMColor_to_565        = sk_default::PMColor_to_565;
 
     decltype(half_to_float) half_to_float = sk_default::half_to_float;
     decltype(float_to_half) float_to_half = sk_default::float_to_half;
@@ -76,29 +79,98 @@ namespace SkOpts {
     // Each Init_foo() is defined in src/opts/SkOpts_foo.cpp.
     void Init_ssse3();
     void Init_sse41();
-    void Init_sse42() {}
-    void Init_avx() {}
-    void Init_avx2() {}
+    void Init_avx2();
+    void Init_avx512();
     void Init_neon();
 
-    static void init() {
+    bool SupportsTier(Tier tier) {
+        switch (tier) {
+            case kPortable_Tier: return true;
         // TODO: Chrome's not linking _sse* opts on iOS simulator builds.  Bug or feature?
-    #if defined(SK_CPU_X86) && !defined(SK_BUILD_FOR_IOS)
-        if (SkCpu::Supports(SkCpu::SSSE3)) { Init_ssse3(); }
-        if (SkCpu::Supports(SkCpu::SSE41)) { Init_sse41(); }
-        if (SkCpu::Supports(SkCpu::SSE42)) { Init_sse42(); }
-        if (SkCpu::Supports(SkCpu::AVX  )) { Init_avx();   }
-        if (SkCpu::Supports(SkCpu::AVX2 )) { Init_avx2();  }
+        #if defined(SK_CPU_X86) && !defined(SK_BUILD_FOR_IOS)
+            case kSSSE3_Tier:  return SkCpu::Supports(SkCpu::SSSE3);
+            case kSSE41_Tier:  return SkCpu::Supports(SkCpu::SSE41);
+            case kAVX2_Tier:   return SkCpu::Supports(SkCpu::AVX2 | SkCpu::F16C);
+        #if !defined(_MSC_VER)  // The MSVC versions we support can't target AVX-512.
+            case kAVX512_Tier: return SkCpu::Supports(SkCpu::AVX512F  |
+                                                      SkCpu::AVX512BW |
+                                                      SkCpu::AVX512VL);
+        #endif
+        #elif defined(SK_CPU_ARM32)         && \
+              defined(SK_BUILD_FOR_ANDROID) && \
+             !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK)
+            case kNEON_Tier:   return SkCpu::Supports(SkCpu::NEON);
+        #endif
+            default:           return false;
+        }
+    }
 
+    static void install_tiers(Tier maxTier) {
+        auto install = [maxTier](Tier tier, void (*init)()) {
+            if (tier <= maxTier && SupportsTier(tier)) { init(); }
+        };
+    #if defined(SK_CPU_X86) && !defined(SK_BUILD_FOR_IOS)
+        install(kSSSE3_Tier,  Init_ssse3);
+        install(kSSE41_Tier,  Init_sse41);
+        install(kAVX2_Tier,   Init_avx2);
+    #if !defined(_MSC_VER)
+        install(kAVX512_Tier, Init_avx512);
+    #endif
     #elif defined(SK_CPU_ARM32)         && \
           defined(SK_BUILD_FOR_ANDROID) && \
          !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK)
-        if (SkCpu::Supports(SkCpu::NEON)) { Init_neon(); }
+        install(kNEON_Tier,   Init_neon);
     #endif
     }
 
+    static void init() {
+        install_tiers(kBest_Tier);
+    }
+
     void Init() {
         static SkOnce once;
         once(init);
     }
+
+    void InitUpToTierForTesting(Tier maxTier) {
+        Init();  // Make sure a racing Init() can't stomp on us later.
+
+        create_xfermode        = sk_default::create_xfermode;
+        color_cube_filter_span = sk_default::color_cube_filter_span;
+
+        box_blur_xx = sk_default::box_blur_xx;
+        box_blur_xy = sk_default::box_blur_xy;
+        box_blur_yx = sk_default::box_blur_yx;
+
+        dilate_x = sk_default::dilate_x;
+        dilate_y = sk_default::dilate_y;
+         erode_x = sk_default::erode_x;
+         erode_y = sk_default::erode_y;
+
+        texture_compressor    = sk_default::texture_compressor;
+        fill_block_dimensions = sk_default::fill_block_dimensions;
+
+        blit_mask_d32_a8     = sk_default::blit_mask_d32_a8;
+        blit_row_color32     = sk_default::blit_row_color32;
+        blit_row_s32a_opaque = sk_default::blit_row_s32a_opaque;
+
+        RGBA_to_BGRA          = sk_default::RGBA_to_BGRA;
+        RGBA_to_rgbA          = sk_default::RGBA_to_rgbA;
+        RGBA_to_bgrA          = sk_default::RGBA_to_bgrA;
+        RGB_to_RGB1           = sk_default::RGB_to_RGB1;
+        RGB_to_BGR1           = sk_default::RGB_to_BGR1;
+        gray_to_RGB1          = sk_default::gray_to_RGB1;
+        grayA_to_RGBA         = sk_default::grayA_to_RGBA;
+        grayA_to_rgbA         = sk_default::grayA_to_rgbA;
+        inverted_CMYK_to_RGB1 = sk_default::inverted_CMYK_to_RGB1;
+        inverted_CMYK_to_BGR1 = sk_default::inverted_CMYK_to_BGR1;
+        RGBX_to_RGB1          = sk_default::RGBX_to_RGB1;
+        RGBX_to_BGR1          = sk_default::RGBX_to_BGR1;
+        PMColor_to_565        = sk_default::PMColor_to_565;
+
+        half_to_float = sk_default::half_to_float;
+        float_to_half = sk_default::float_to_half;
+
+        install_tiers(maxTier);
+    }
 }  // namespace SkOpts
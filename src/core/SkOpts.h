@@ -20,6 +20,26 @@ namespace SkOpts {
     // Called by SkGraphics::Init().
     void Init();
 
+    // The tiers of CPU-specific code Init() may install, each on top of those before it.
+    enum Tier {
+        kPortable_Tier,
+        kSSSE3_Tier,
+        kSSE41_Tier,
+        kAVX2_Tier,     // AVX2 and F16C.
+        kAVX512_Tier,   // AVX-512 F, BW, and VL.
+        kNEON_Tier,
+
+        kBest_Tier = kNEON_Tier,
+    };
+
+    // Returns true if this CPU can run the code of the given tier.
+    bool SupportsTier(Tier);
+
+    // Point every function back at its portable default, then install each supported tier
+    // up to and including maxTier.  InitUpToTierForTesting(kBest_Tier) is equivalent to Init().
+    // Not thread-safe: this is only for tools like nanobench that compare tiers side by side.
+    void InitUpToTierForTesting(Tier maxTier);
+
     // Declare function pointers here...
 
     // May return nullptr if we haven't specialized the given Mode.
@@ -60,7 +80,12 @@ namespace SkOpts {
                         grayA_to_RGBA,         // i.e. expand to color channels
                         grayA_to_rgbA,         // i.e. expand to color channels and premultiply
                         inverted_CMYK_to_RGB1, // i.e. convert color space
-                        inverted_CMYK_to_BGR1; // i.e. convert color space
+                        inverted_CMYK_to_BGR1, // i.e. convert color space
+                        RGBX_to_RGB1,          // i.e. force an opaque alpha
+                        RGBX_to_BGR1;          // i.e. swap RB and force an opaque alpha
+
+    // Pack SkPMColors into 565, dropping alpha.
+    extern void (*PMColor_to_565)(uint16_t[], const uint32_t[], int);
 
     extern void (*half_to_float)(float[], const uint16_t[], int);
     extern void (*float_to_half)(uint16_t[], const float[], int);
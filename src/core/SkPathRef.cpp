@@ -6,6 +6,7 @@
  */
 
 #include "SkBuffer.h"
+#include "SkData.h"
 #include "SkOncePtr.h"
 #include "SkPath.h"
 #include "SkPathRef.h"
@@ -16,7 +17,7 @@ SkPathRef::Editor::Editor(SkAutoTUnref<SkPathRef>* pathRef,
                           int incReserveVerbs,
                           int incReservePoints)
 {
-    if ((*pathRef)->unique()) {
+    if ((*pathRef)->unique() && !(*pathRef)->fSharedStorage) {
         (*pathRef)->incReserve(incReserveVerbs, incReservePoints);
     } else {
         SkPathRef* copy = new SkPathRef;
@@ -34,7 +35,11 @@ SkPathRef::Editor::Editor(SkAutoTUnref<SkPathRef>* pathRef,
 SkPathRef::~SkPathRef() {
     this->callGenIDChangeListeners();
     SkDEBUGCODE(this->validate();)
-    sk_free(fPoints);
+    if (fSharedStorage) {
+        fSharedStorage->unref();
+    } else {
+        sk_free(fPoints);
+    }
 
     SkDEBUGCODE(fPoints = nullptr;)
     SkDEBUGCODE(fVerbs = nullptr;)
@@ -67,7 +72,12 @@ void SkPathRef::CreateTransformedCopy(SkAutoTUnref<SkPathRef>* dst,
         return;
     }
 
-    if (!(*dst)->unique()) {
+    // Shared storage can't be transformed in place. If that's src's, keep src alive to read.
+    SkAutoTUnref<const SkPathRef> keepSrc;
+    if (!(*dst)->unique() || (*dst)->fSharedStorage) {
+        if (*dst == &src) {
+            keepSrc.reset(SkRef(&src));
+        }
         dst->reset(new SkPathRef);
     }
 
@@ -175,7 +185,7 @@ SkPathRef* SkPathRef::CreateFromBuffer(SkRBuffer* buffer) {
 }
 
 void SkPathRef::Rewind(SkAutoTUnref<SkPathRef>* pathRef) {
-    if ((*pathRef)->unique()) {
+    if ((*pathRef)->unique() && !(*pathRef)->fSharedStorage) {
         SkDEBUGCODE((*pathRef)->validate();)
         (*pathRef)->callGenIDChangeListeners();
         (*pathRef)->fBoundsIsDirty = true;  // this also invalidates fIsFinite
@@ -611,7 +621,8 @@ void SkPathRef::validate() const {
     SkASSERT(!(nullptr == fPoints && 0 != fFreeSpace));
     SkASSERT(!(nullptr == fPoints && fPointCnt));
     SkASSERT(!(nullptr == fVerbs && fVerbCnt));
-    SkASSERT(this->currSize() ==
+    SkASSERT(!(fSharedStorage && 0 != fFreeSpace));
+    SkASSERT(fSharedStorage || this->currSize() ==
                 fFreeSpace + sizeof(SkPoint) * fPointCnt + sizeof(uint8_t) * fVerbCnt);
 
     if (!fBoundsIsDirty && !fBounds.isEmpty()) {
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkChecksum.h"
+#include "SkData.h"
+#include "SkPathRefArena.h"
+#include "SkMath.h"
+#include "SkTDArray.h"
+#include "SkTemplates.h"
+
+namespace {
+
+// A run of points or verbs, found by its contents.
+struct Run {
+    const void* fData;
+    uint32_t    fBytes;
+    uint32_t    fHash;
+
+    bool operator==(const Run& that) const {
+        return fHash == that.fHash && fBytes == that.fBytes &&
+               0 == memcmp(fData, that.fData, fBytes);
+    }
+};
+
+// Gives each distinct run an offset in its section of the block, in the order first seen.  There
+// is at most one run per path, so the table is sized once, open-addressed with linear probing.
+class RunIndex {
+public:
+    explicit RunIndex(int maxRuns)
+        : fMask(SkNextPow2(2 * SkTMax(maxRuns, 1)) - 1)
+        , fSlots(fMask + 1)
+        , fSize(0) {
+        sk_bzero(fSlots.get(), (fMask + 1) * sizeof(int));
+        fRuns.setReserve(maxRuns);
+        fOffsets.setReserve(maxRuns);
+    }
+
+    uint32_t size() const { return fSize; }
+
+    // Returns the offset of the run, or UINT32_MAX if it's new and won't fit in maxSize.
+    uint32_t find(const void* data, size_t bytes, uint32_t maxSize) {
+        const Run run = { data, SkToU32(bytes), SkChecksum::Murmur3(data, bytes) };
+        uint32_t slot = run.fHash & fMask;
+        for (; fSlots[slot]; slot = (slot + 1) & fMask) {
+            const int index = fSlots[slot] - 1;
+            if (fRuns[index] == run) {
+                return fOffsets[index];
+            }
+        }
+        if (bytes > maxSize - fSize) {
+            return UINT32_MAX;
+        }
+        *fRuns.append() = run;
+        *fOffsets.append() = fSize;
+        fSlots[slot] = fRuns.count();
+        fSize += run.fBytes;
+        return fOffsets.top();
+    }
+
+    // Copies the distinct runs to dst, at their offsets.
+    void copyTo(char* dst) const {
+        for (const Run& run : fRuns) {
+            memcpy(dst, run.fData, run.fBytes);
+            dst += run.fBytes;
+        }
+    }
+
+private:
+    const uint32_t        fMask;
+    SkAutoTMalloc<int>    fSlots;    // 1 + index of the run in fRuns, or 0 if empty
+    SkTDArray<Run>        fRuns;
+    SkTDArray<uint32_t>   fOffsets;
+    uint32_t              fSize;
+};
+
+}  // namespace
+
+size_t SkPathRefArena::Pack(SkPath* const paths[], int count) {
+    // Offsets are 32-bit, and the two sections together mustn't overflow the pointer arithmetic.
+    static const uint32_t kMaxSectionSize = SK_MaxS32 / 2;
+
+    struct Entry {
+        SkPath*  fPath;
+        uint32_t fPoints, fVerbs;
+    };
+    SkTDArray<Entry> entries;
+    RunIndex points(count), verbs(count);
+    for (int i = 0; i < count; i++) {
+        const SkPathRef* ref = paths[i]->fPathRef.get();
+        if (!ref->unique() || ref->fSharedStorage || 0 == ref->fVerbCnt || 0 == ref->fPointCnt) {
+            continue;
+        }
+        const uint32_t pointOffset = points.find(ref->fPoints, ref->fPointCnt * sizeof(SkPoint),
+                                                 kMaxSectionSize),
+                       verbOffset  = verbs.find(ref->verbsMemBegin(), ref->fVerbCnt,
+                                                kMaxSectionSize);
+        if (UINT32_MAX == pointOffset || UINT32_MAX == verbOffset) {
+            // Leave the rest as they are.  The runs already indexed stay in, but are just unused.
+            break;
+        }
+        *entries.append() = { paths[i], pointOffset, verbOffset };
+    }
+    if (entries.isEmpty()) {
+        return 0;
+    }
+
+    // Points go first, keeping them aligned, then verbs.
+    const size_t size = points.size() + verbs.size();
+    char* block = (char*)sk_malloc_throw(size);
+    points.copyTo(block);
+    verbs.copyTo(block + points.size());
+    sk_sp<SkData> storage = SkData::MakeFromMalloc(block, size);
+
+    // Each ref is only ours, so it can move to the block in place, keeping its ID and listeners.
+    for (const Entry& entry : entries) {
+        SkPathRef* ref = entry.fPath->fPathRef.get();
+        sk_free(ref->fPoints);
+        ref->fPoints = reinterpret_cast<SkPoint*>(block + entry.fPoints);
+        ref->fVerbs = reinterpret_cast<uint8_t*>(block + points.size() + entry.fVerbs) +
+                      ref->fVerbCnt;
+        ref->fFreeSpace = 0;
+        ref->fSharedStorage = SkRef(storage.get());
+        SkDEBUGCODE(ref->validate();)
+    }
+    return size;
+}
+
+size_t SkPathRefArena::ApproximateBytesUsed(const SkPath& path, SkTHashSet<const void*>* seen) {
+    const SkPathRef* ref = path.fPathRef.get();
+    if (seen->contains(ref)) {
+        return 0;
+    }
+    seen->add(ref);
+
+    size_t bytes = sizeof(SkPathRef) + ref->fConicWeights.reserved() * sizeof(SkScalar);
+    if (!ref->fSharedStorage) {
+        bytes += ref->currSize();
+    } else if (!seen->contains(ref->fSharedStorage)) {
+        seen->add(ref->fSharedStorage);
+        bytes += ref->fSharedStorage->size();
+    }
+    return bytes;
+}
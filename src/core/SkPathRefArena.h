@@ -0,0 +1,37 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPathRefArena_DEFINED
+#define SkPathRefArena_DEFINED
+
+#include "SkPath.h"
+#include "SkTHash.h"
+
+/**
+ *  Paths kept for playback by pictures and records are never edited again, yet each SkPathRef
+ *  holds its own allocation of points and verbs, at least 256 bytes however small the path.
+ *  SkPathRefArena moves them all into one block, storing identical runs of points or of verbs
+ *  once, each at a 32-bit offset into the block.  Editing a packed path copies it out, just as
+ *  editing a path sharing its SkPathRef does.
+ */
+class SkPathRefArena {
+public:
+    /**
+     *  Packs the points and verbs of these paths into one block they share.  Paths sharing their
+     *  SkPathRef with others, and empty or packed ones, are left alone.  The contents, bounds and
+     *  generation IDs of all are unchanged.  Returns the size of the block, 0 if none was made.
+     */
+    static size_t Pack(SkPath* const paths[], int count);
+
+    /**
+     *  Returns the bytes used by the path's SkPathRef, and by its block if packed, counting
+     *  neither if already in seen.  Adds both to seen.
+     */
+    static size_t ApproximateBytesUsed(const SkPath&, SkTHashSet<const void*>* seen);
+};
+
+#endif
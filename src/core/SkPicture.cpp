@@ -6,13 +6,16 @@
  */
 
 #include "SkAtomics.h"
+#include "SkData.h"
 #include "SkImageGenerator.h"
+#include "SkMappedPicture.h"
 #include "SkMessageBus.h"
 #include "SkPicture.h"
 #include "SkPictureData.h"
 #include "SkPicturePlayback.h"
 #include "SkPictureRecord.h"
 #include "SkPictureRecorder.h"
+#include "SkStream.h"
 
 #if defined(SK_DISALLOW_CROSSPROCESS_PICTUREIMAGEFILTERS) || \
     defined(SK_ENABLE_PICTURE_IO_SECURITY_PRECAUTIONS)
@@ -153,10 +156,20 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, InstallPixelRefProc
     return MakeFromStream(stream, proc, nullptr);
 }
 
+// Since V46 the has-data bool is padded out to 4 bytes.
+static const size_t kHasDataPadding = 3;
+
+static bool read_has_data(SkStream* stream, const SkPictInfo& info) {
+    if (!stream->readBool()) {
+        return false;
+    }
+    return info.fVersion < 46 || stream->skip(kHasDataPadding) == kHasDataPadding;
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, InstallPixelRefProc proc,
                                            SkTypefacePlayback* typefaces) {
     SkPictInfo info;
-    if (!InternalOnly_StreamIsSKP(stream, &info) || !stream->readBool()) {
+    if (!InternalOnly_StreamIsSKP(stream, &info) || !read_has_data(stream, info)) {
         return nullptr;
     }
     SkAutoTDelete<SkPictureData> data(
@@ -164,6 +177,23 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, InstallPixelRefProc
     return Forwardport(info, data);
 }
 
+sk_sp<SkPicture> SkPicture::MakeFromData(sk_sp<SkData> data, InstallPixelRefProc proc) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data);
+    SkPictInfo info;
+    if (!InternalOnly_StreamIsSKP(&stream, &info) || !read_has_data(&stream, info)) {
+        return nullptr;
+    }
+    SkPictureData* pictureData = SkPictureData::CreateFromStream(
+            &stream, info, proc ? proc : &default_install, nullptr, data.get());
+    if (!pictureData) {
+        return nullptr;
+    }
+    return sk_make_sp<SkMappedPicture>(info.fCullRect, pictureData);
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromBuffer(SkReadBuffer& buffer) {
     SkPictInfo info;
     if (!InternalOnly_BufferIsSKP(&buffer, &info) || !buffer.readBool()) {
@@ -192,12 +222,16 @@ void SkPicture::serialize(SkWStream* stream,
     SkPictInfo info = this->createHeader();
     SkAutoTDelete<SkPictureData> data(this->backport());
 
+    static const uint8_t kPadding[kHasDataPadding] = { 0, 0, 0 };
+
     stream->write(&info, sizeof(info));
     if (data) {
         stream->writeBool(true);
+        stream->write(kPadding, kHasDataPadding);
         data->serialize(stream, pixelSerializer, typefaceSet);
     } else {
         stream->writeBool(false);
+        stream->write(kPadding, kHasDataPadding);
     }
 }
 
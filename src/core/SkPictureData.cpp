@@ -6,6 +6,7 @@
  */
 #include <new>
 #include "SkImageGenerator.h"
+#include "SkPathRefArena.h"
 #include "SkPictureData.h"
 #include "SkPictureRecord.h"
 #include "SkReadBuffer.h"
@@ -33,6 +34,23 @@ void SkPictureData::initForPlayback() const {
     }
 }
 
+void SkPictureData::packPaths() {
+    SkAutoSTMalloc<64, SkPath*> paths(fPaths.count());
+    for (int i = 0; i < fPaths.count(); i++) {
+        paths[i] = &fPaths[i];
+    }
+    SkPathRefArena::Pack(paths.get(), fPaths.count());
+}
+
+size_t SkPictureData::pathBytesUsed() const {
+    SkTHashSet<const void*> seen;
+    size_t bytes = 0;
+    for (int i = 0; i < fPaths.count(); i++) {
+        bytes += SkPathRefArena::ApproximateBytesUsed(fPaths[i], &seen);
+    }
+    return bytes;
+}
+
 SkPictureData::SkPictureData(const SkPictureRecord& record,
                              const SkPictInfo& info,
                              bool deepCopyOps)
@@ -340,7 +358,8 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
                                    SkPicture::InstallPixelRefProc proc,
-                                   SkTypefacePlayback* topLevelTFPlayback) {
+                                   SkTypefacePlayback* topLevelTFPlayback,
+                                   const SkData* backing) {
     /*
      *  By the time we encounter BUFFER_SIZE_TAG, we need to have already seen
      *  its dependents: FACTORY_TAG and TYPEFACE_TAG. These two are not required
@@ -355,7 +374,16 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            // The ops are read 4 bytes at a time, so they can only be used in place if aligned.
+            if (backing && stream->getMemoryBase() == backing->data() && stream->hasPosition() &&
+                SkIsAlign4((uintptr_t)backing->bytes() + stream->getPosition())) {
+                fOpData = SkData::MakeSubset(backing, stream->getPosition(), size);
+                if (!fOpData || fOpData->size() != size || stream->skip(size) != size) {
+                    return false;
+                }
+            } else {
+                fOpData = SkData::MakeFromStream(stream, size);
+            }
             if (!fOpData) {
                 return false;
             }
@@ -400,13 +428,26 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             }
         } break;
         case SK_PICT_BUFFER_SIZE_TAG: {
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
-                return false;
+            // Everything read from the buffer is copied out of it, so if the stream is in memory
+            // we can parse the buffer where it is, rather than copy it first.
+            SkAutoMalloc storage;
+            const void* memory = stream->getMemoryBase();
+            if (memory && stream->hasPosition() && stream->hasLength() &&
+                SkIsAlign4((uintptr_t)memory + stream->getPosition()) &&
+                size <= stream->getLength() - stream->getPosition()) {
+                memory = (const char*)memory + stream->getPosition();
+                if (stream->skip(size) != size) {
+                    return false;
+                }
+            } else {
+                memory = storage.reset(size);
+                if (stream->read(storage.get(), size) != size) {
+                    return false;
+                }
             }
 
             /* Should we use SkValidatingReadBuffer instead? */
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(memory, size);
             buffer.setFlags(pictInfoFlagsToReadBufferFlags(fInfo.fFlags));
             buffer.setVersion(fInfo.fVersion);
 
@@ -512,6 +553,7 @@ bool SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
                 for (int i = 0; i < count; i++) {
                     buffer.readPath(&fPaths[i]);
                 }
+                this->packPaths();
             } break;
         case SK_PICT_TEXTBLOB_BUFFER_TAG:
             if (!new_array_from_buffer(buffer, size, &fTextBlobRefs, &fTextBlobCount,
@@ -550,13 +592,14 @@ bool SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
 SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                const SkPictInfo& info,
                                                SkPicture::InstallPixelRefProc proc,
-                                               SkTypefacePlayback* topLevelTFPlayback) {
+                                               SkTypefacePlayback* topLevelTFPlayback,
+                                               const SkData* backing) {
     SkAutoTDelete<SkPictureData> data(new SkPictureData(info));
     if (!topLevelTFPlayback) {
         topLevelTFPlayback = &data->fTFPlayback;
     }
 
-    if (!data->parseStream(stream, proc, topLevelTFPlayback)) {
+    if (!data->parseStream(stream, proc, topLevelTFPlayback, backing)) {
         return nullptr;
     }
     return data.release();
@@ -575,7 +618,8 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
 
 bool SkPictureData::parseStream(SkStream* stream,
                                 SkPicture::InstallPixelRefProc proc,
-                                SkTypefacePlayback* topLevelTFPlayback) {
+                                SkTypefacePlayback* topLevelTFPlayback,
+                                const SkData* backing) {
     for (;;) {
         uint32_t tag = stream->readU32();
         if (SK_PICT_EOF_TAG == tag) {
@@ -583,7 +627,7 @@ bool SkPictureData::parseStream(SkStream* stream,
         }
 
         uint32_t size = stream->readU32();
-        if (!this->parseStreamTag(stream, tag, size, proc, topLevelTFPlayback)) {
+        if (!this->parseStreamTag(stream, tag, size, proc, topLevelTFPlayback, backing)) {
             return false; // we're invalid
         }
     }
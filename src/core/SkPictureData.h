@@ -59,11 +59,13 @@ struct SkPictInfo {
 class SkPictureData {
 public:
     SkPictureData(const SkPictureRecord& record, const SkPictInfo&, bool deepCopyOps);
-    // Does not affect ownership of SkStream.
+    // Does not affect ownership of SkStream.  If the stream reads from backing, the op data
+    // refers to it in place rather than being copied.
     static SkPictureData* CreateFromStream(SkStream*,
                                            const SkPictInfo&,
                                            SkPicture::InstallPixelRefProc,
-                                           SkTypefacePlayback*);
+                                           SkTypefacePlayback*,
+                                           const SkData* backing = nullptr);
     static SkPictureData* CreateFromBuffer(SkReadBuffer&, const SkPictInfo&);
 
     virtual ~SkPictureData();
@@ -79,11 +81,15 @@ public:
 
     const sk_sp<SkData>& opData() const { return fOpData; }
 
+    // Approximately how many bytes the paths' points and verbs use.
+    size_t pathBytesUsed() const;
+
 protected:
     explicit SkPictureData(const SkPictInfo& info);
 
     // Does not affect ownership of SkStream.
-    bool parseStream(SkStream*, SkPicture::InstallPixelRefProc, SkTypefacePlayback*);
+    bool parseStream(SkStream*, SkPicture::InstallPixelRefProc, SkTypefacePlayback*,
+                     const SkData* backing);
     bool parseBuffer(SkReadBuffer& buffer);
 
 public:
@@ -146,7 +152,8 @@ private:
     // these help us with reading/writing
     // Does not affect ownership of SkStream.
     bool parseStreamTag(SkStream*, uint32_t tag, uint32_t size,
-                        SkPicture::InstallPixelRefProc, SkTypefacePlayback*);
+                        SkPicture::InstallPixelRefProc, SkTypefacePlayback*,
+                        const SkData* backing);
     bool parseBufferTag(SkReadBuffer&, uint32_t tag, uint32_t size);
     void flattenToBuffer(SkWriteBuffer&) const;
 
@@ -178,6 +185,9 @@ private:
     static void WriteTypefaces(SkWStream* stream, const SkRefCntSet& rec);
 
     void initForPlayback() const;
+
+    // Moves the paths' points and verbs, read never to be edited, into one block they share.
+    void packPaths();
 };
 
 #endif
@@ -6,10 +6,26 @@
  */
 
 #include "SkRTree.h"
+#include "SkNx.h"
+#include "SkTaskGroup.h"
+#include "SkTSort.h"
 
-SkRTree::SkRTree(SkScalar aspectRatio) : fCount(0), fAspectRatio(aspectRatio) {}
+// Builds with at least this many rectangles key, sort and pack them across threads, in at most
+// kMaxPieces pieces.
+static const int kMinParallelCount = 1 << 14,
+                 kMaxPieces = 16;
+// How many leaves to look at to decide whether the rectangles need sorting.
+static const int kScatterSamples = 256;
 
-SkRect SkRTree::getRootBound() const {
+template <int kFanout>
+SkTRTree<kFanout>::SkTRTree(SkScalar aspectRatio)
+    : fCount(0)
+    , fSorted(false)
+    , fNodeCount(0)
+    , fNodes(nullptr) {}
+
+template <int kFanout>
+SkRect SkTRTree<kFanout>::getRootBound() const {
     if (fCount) {
         return fRoot.fBounds;
     } else {
@@ -17,172 +33,356 @@ SkRect SkRTree::getRootBound() const {
     }
 }
 
-void SkRTree::insert(const SkRect boundsArray[], int N) {
-    SkASSERT(0 == fCount);
+// Spreads the low 16 bits of x out to the even bits.
+static uint32_t interleave(uint32_t x) {
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+    return x;
+}
 
-    SkTDArray<Branch> branches;
-    branches.setReserve(N);
+// Returns the distance along a Hilbert curve through a 65536 x 65536 grid to cell (x, y).
+// This works on all the bits at once, rather than one level of the curve at a time; see
+// "2D Hilbert curves in O(1)", Fabian Giesen.
+static uint32_t hilbert_index(uint32_t x, uint32_t y) {
+    uint32_t a = x ^ y, b = 0xFFFF ^ a, c = 0xFFFF ^ (x | y), d = x & (y ^ 0xFFFF);
+    uint32_t A = a | (b >> 1), B = (a >> 1) ^ a,
+             C = ((c >> 1) ^ (b & (d >> 1))) ^ c, D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
 
-    for (int i = 0; i < N; i++) {
-        const SkRect& bounds = boundsArray[i];
-        if (bounds.isEmpty()) {
+    a = A; b = B; c = C; d = D;
+    A = (a & (a >> 2)) ^ (b & (b >> 2));
+    B = (a & (b >> 2)) ^ (b & ((a ^ b) >> 2));
+    C ^= (a & (c >> 2)) ^ (b & (d >> 2));
+    D ^= (b & (c >> 2)) ^ ((a ^ b) & (d >> 2));
+
+    a = A; b = B; c = C; d = D;
+    A = (a & (a >> 4)) ^ (b & (b >> 4));
+    B = (a & (b >> 4)) ^ (b & ((a ^ b) >> 4));
+    C ^= (a & (c >> 4)) ^ (b & (d >> 4));
+    D ^= (b & (c >> 4)) ^ ((a ^ b) & (d >> 4));
+
+    a = A; b = B; c = C; d = D;
+    C ^= (a & (c >> 8)) ^ (b & (d >> 8));
+    D ^= (b & (c >> 8)) ^ ((a ^ b) & (d >> 8));
+
+    a = C ^ (C >> 1);
+    b = D ^ (D >> 1);
+    const uint32_t i0 = x ^ y,
+                   i1 = b | (0xFFFF ^ (i0 | a));
+    return (interleave(i1) << 1) | interleave(i0);
+}
+
+// Calls fn(start, stop) for pieces of [0, count) no smaller than minPiece, each on its own thread.
+template <typename Fn>
+static void parallel_ranges(int count, int minPiece, const Fn& fn) {
+    const int pieces = SkTPin(count / minPiece, 1, kMaxPieces);
+    sk_parallel_for(pieces, 1, [&](int piece) {
+        fn((int)((int64_t)count * piece / pieces), (int)((int64_t)count * (piece + 1) / pieces));
+    });
+}
+
+// Sorts keys by their top keyBits bits, keeping keys that tie in order.  This is a radix sort of
+// up to 12 bits a pass, each pass counting and moving its share of the keys on its own thread.
+// The result ends up in keys; scratch must be as big.
+static void sort_keys(uint64_t keys[], uint64_t scratch[], int count, int keyBits) {
+    const int pieces = SkTPin(count / kMinParallelCount, 1, kMaxPieces);
+    auto piece_start = [=](int piece) { return (int)((int64_t)count * piece / pieces); };
+    const int passes = (keyBits + 11) / 12,
+              digitBits = (keyBits + passes - 1) / passes,
+              digits = 1 << digitBits;
+
+    SkAutoTMalloc<int> offsets(pieces * digits);
+    uint64_t* src = keys;
+    uint64_t* dst = scratch;
+    for (int shift = 64 - keyBits; shift < 64; shift += digitBits) {
+        sk_bzero(offsets.get(), pieces * digits * sizeof(int));
+        sk_parallel_for(pieces, 1, [&](int piece) {
+            int* counts = offsets.get() + piece * digits;
+            for (int i = piece_start(piece); i < piece_start(piece + 1); i++) {
+                counts[(src[i] >> shift) & (digits - 1)]++;
+            }
+        });
+
+        // Each piece's keys with a given digit follow those with smaller digits, and those with
+        // the same digit from earlier pieces.  If one digit covers every key, the pass would
+        // leave them where they are.
+        int total = 0;
+        bool moves = true;
+        for (int digit = 0; digit < digits && moves; digit++) {
+            int digitCount = 0;
+            for (int piece = 0; piece < pieces; piece++) {
+                int* offset = offsets.get() + piece * digits + digit;
+                const int n = *offset;
+                *offset = total;
+                total += n;
+                digitCount += n;
+            }
+            moves = digitCount < count;
+        }
+        if (!moves) {
             continue;
         }
 
-        Branch* b = branches.push();
-        b->fBounds = bounds;
-        b->fOpIndex = i;
+        sk_parallel_for(pieces, 1, [&](int piece) {
+            int* offset = offsets.get() + piece * digits;
+            for (int i = piece_start(piece); i < piece_start(piece + 1); i++) {
+                dst[offset[(src[i] >> shift) & (digits - 1)]++] = src[i];
+            }
+        });
+        SkTSwap(src, dst);
+    }
+    if (src != keys) {
+        memcpy(keys, src, count * sizeof(uint64_t));
     }
+}
 
-    fCount = branches.count();
-    if (fCount) {
-        if (1 == fCount) {
-            fNodes.setReserve(1);
-            Node* n = this->allocateNodeAtLevel(0);
-            n->fNumChildren = 1;
-            n->fChildren[0] = branches[0];
-            fRoot.fSubtree = n;
-            fRoot.fBounds  = branches[0].fBounds;
+// Sorts the indices of the rects in order by where their centers fall along a Hilbert curve
+// through them.  The curve need only be fine enough to tell apart about as many cells as there
+// are rects, so only that many of the top bits of its distance are sorted.
+static void hilbert_sort(const SkRect bounds[], int order[], int count) {
+    SkRect centers = SkRect::MakeEmpty();
+    bool first = true;
+    for (int i = 0; i < count; i++) {
+        const SkRect& r = bounds[order[i]];
+        const SkPoint center = { r.centerX(), r.centerY() };
+        if (!center.isFinite()) {
+            continue;
+        }
+        if (first) {
+            centers.setLTRB(center.fX, center.fY, center.fX, center.fY);
+            first = false;
         } else {
-            fNodes.setReserve(CountNodes(fCount, fAspectRatio));
-            fRoot = this->bulkLoad(&branches);
+            centers.growToInclude(center.fX, center.fY);
         }
     }
-}
 
-SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
-    SkDEBUGCODE(Node* p = fNodes.begin());
-    Node* out = fNodes.push();
-    SkASSERT(fNodes.begin() == p);  // If this fails, we didn't setReserve() enough.
-    out->fNumChildren = 0;
-    out->fLevel = level;
-    return out;
+    // Scale both axes alike, so the curve's cells are square.
+    const SkScalar extent = SkTMax(centers.width(), centers.height());
+    const SkScalar scale = extent > 0 ? 65535 / extent : 0;
+    SkAutoTMalloc<uint64_t> keys(count), scratch(count);
+    parallel_ranges(count, kMinParallelCount, [&](int start, int stop) {
+        for (int i = start; i < stop; i++) {
+            const SkRect& r = bounds[order[i]];
+            const SkScalar x = (r.centerX() - centers.fLeft) * scale,
+                           y = (r.centerY() - centers.fTop)  * scale;
+            uint32_t key = 0;
+            if (SkScalarIsFinite(x) && SkScalarIsFinite(y)) {
+                key = hilbert_index((uint32_t)SkTPin(x, 0.0f, 65535.0f),
+                                    (uint32_t)SkTPin(y, 0.0f, 65535.0f));
+            }
+            keys[i] = (uint64_t)key << 32 | (uint32_t)order[i];
+        }
+    });
+
+    const int keyBits = SkTMin(32, 2 * ((SkNextLog2(count) + 1) / 2 + 2));
+    sort_keys(keys.get(), scratch.get(), count, keyBits);
+    parallel_ranges(count, kMinParallelCount, [&](int start, int stop) {
+        for (int i = start; i < stop; i++) {
+            order[i] = (int)(uint32_t)keys[i];
+        }
+    });
 }
 
-// This function parallels bulkLoad, but just counts how many nodes bulkLoad would allocate.
-int SkRTree::CountNodes(int branches, SkScalar aspectRatio) {
-    if (branches == 1) {
-        return 1;
-    }
-    int numBranches = branches / kMaxChildren;
-    int remainder   = branches % kMaxChildren;
-    if (remainder > 0) {
-        numBranches++;
-        if (remainder >= kMinChildren) {
-            remainder = 0;
-        } else {
-            remainder = kMinChildren - remainder;
+// Would packing the rects in this order make leaves larger around than their children laid side
+// by side?  If so, they are scattered enough to be worth sorting.  This samples a few leaves.
+template <int kFanout>
+static bool is_scattered(const SkRect bounds[], const int order[], int count) {
+    const int leaves = (count - 1) / kFanout + 1,
+              samples = SkTMin(leaves, kScatterSamples);
+    SkScalar margins = 0;
+    for (int s = 0; s < samples; s++) {
+        const int leaf = (int)((int64_t)leaves * s / samples),
+                  start = (int)((int64_t)count * leaf / leaves),
+                  stop  = (int)((int64_t)count * (leaf + 1) / leaves);
+        SkRect leafBounds = bounds[order[start]];
+        for (int i = start; i < stop; i++) {
+            const SkRect& r = bounds[order[i]];
+            leafBounds.join(r);
+            margins -= r.width() + r.height();
         }
+        margins += leafBounds.width() + leafBounds.height();
     }
-    int numStrips = SkScalarCeilToInt(SkScalarSqrt(SkIntToScalar(numBranches) / aspectRatio));
-    int numTiles  = SkScalarCeilToInt(SkIntToScalar(numBranches) / SkIntToScalar(numStrips));
-    int currentBranch = 0;
-    int nodes = 0;
-    for (int i = 0; i < numStrips; ++i) {
-        for (int j = 0; j < numTiles && currentBranch < branches; ++j) {
-            int incrementBy = kMaxChildren;
-            if (remainder != 0) {
-                if (remainder <= kMaxChildren - kMinChildren) {
-                    incrementBy -= remainder;
-                    remainder = 0;
-                } else {
-                    incrementBy = kMinChildren;
-                    remainder -= kMaxChildren - kMinChildren;
-                }
-            }
-            nodes++;
-            currentBranch++;
-            for (int k = 1; k < incrementBy && currentBranch < branches; ++k) {
-                currentBranch++;
-            }
+    return margins > 0;
+}
+
+template <int kFanout>
+void SkTRTree<kFanout>::insert(const SkRect boundsArray[], int N) {
+    SkASSERT(0 == fCount);
+
+    SkAutoTMalloc<int> order(N);
+    int count = 0;
+    for (int i = 0; i < N; i++) {
+        if (!boundsArray[i].isEmpty()) {
+            order[count++] = i;
         }
     }
-    return nodes + CountNodes(nodes, aspectRatio);
-}
 
-SkRTree::Branch SkRTree::bulkLoad(SkTDArray<Branch>* branches, int level) {
-    if (branches->count() == 1) { // Only one branch.  It will be the root.
-        return (*branches)[0];
+    fCount = count;
+    if (0 == fCount) {
+        return;
     }
 
-    // We might sort our branches here, but we expect Blink gives us a reasonable x,y order.
-    // Skipping a call to sort (in Y) here resulted in a 17% win for recording with negligible
-    // difference in playback speed.
-    int numBranches = branches->count() / kMaxChildren;
-    int remainder   = branches->count() % kMaxChildren;
-    int newBranches = 0;
-
-    if (remainder > 0) {
-        ++numBranches;
-        // If the remainder isn't enough to fill a node, we'll add fewer nodes to other branches.
-        if (remainder >= kMinChildren) {
-            remainder = 0;
-        } else {
-            remainder = kMinChildren - remainder;
-        }
+    fNodeCount = CountNodes(count);
+    fStorage.reset(fNodeCount * sizeof(Node) + 63);
+    fNodes = reinterpret_cast<Node*>(((uintptr_t)fStorage.get() + 63) & ~(uintptr_t)63);
+
+    // Pack the leaves in the order given, unless that spreads them out.  Each level's nodes
+    // follow those of the level below, and the root comes last.
+    fSorted = count > kFanout && is_scattered<kFanout>(boundsArray, order.get(), count);
+    if (fSorted) {
+        hilbert_sort(boundsArray, order.get(), count);
     }
+    const int leaves = (count - 1) / kFanout + 1;
+    SkAutoTMalloc<Branch> storage(2 * leaves);
+    Branch* branches = storage.get();
+    Branch* parents  = storage.get() + leaves;
+    int nodes = this->packLevel(fNodes, count, 0, [&](int i, SkRect* bounds) {
+        *bounds = boundsArray[order[i]];
+        return order[i];
+    }, branches);
+
+    Node* levelNodes = fNodes;
+    for (int level = 1; nodes > 1; level++) {
+        levelNodes += nodes;
+        nodes = this->packLevel(levelNodes, nodes, level, [&](int i, SkRect* bounds) {
+            *bounds = branches[i].fBounds;
+            return branches[i].fIndex;
+        }, parents);
+        SkTSwap(branches, parents);
+    }
+    fRoot = branches[0];
+    SkASSERT(fRoot.fIndex == fNodeCount - 1);
+}
+
+template <int kFanout>
+template <typename Child>
+int SkTRTree<kFanout>::packLevel(Node levelNodes[], int count, int level, const Child& child,
+                                 Branch parents[]) {
+    const int nodes = (count - 1) / kFanout + 1;
+    parallel_ranges(nodes, kMinParallelCount / kFanout, [&](int startNode, int stopNode) {
+        for (int i = startNode; i < stopNode; i++) {
+            // Spread the children out evenly, so each node gets within one of the others.
+            const int start = (int)((int64_t)count * i / nodes),
+                      stop  = (int)((int64_t)count * (i + 1) / nodes);
+            Node* node = levelNodes + i;
+            node->fNumChildren = SkToU16(stop - start);
+            node->fLevel = SkToU16(level);
 
-    int numStrips = SkScalarCeilToInt(SkScalarSqrt(SkIntToScalar(numBranches) / fAspectRatio));
-    int numTiles  = SkScalarCeilToInt(SkIntToScalar(numBranches) / SkIntToScalar(numStrips));
-    int currentBranch = 0;
-
-    for (int i = 0; i < numStrips; ++i) {
-        // Might be worth sorting by X here too.
-        for (int j = 0; j < numTiles && currentBranch < branches->count(); ++j) {
-            int incrementBy = kMaxChildren;
-            if (remainder != 0) {
-                // if need be, omit some nodes to make up for remainder
-                if (remainder <= kMaxChildren - kMinChildren) {
-                    incrementBy -= remainder;
-                    remainder = 0;
+            SkRect bounds = SkRect::MakeEmpty();
+            for (int j = 0; j < kFanout; j++) {
+                if (j < stop - start) {
+                    SkRect b;
+                    node->fChildren[j] = child(start + j, &b);
+                    node->fLeft[j]   = b.fLeft;
+                    node->fTop[j]    = b.fTop;
+                    node->fRight[j]  = b.fRight;
+                    node->fBottom[j] = b.fBottom;
+                    if (0 == j) {
+                        bounds = b;
+                    } else {
+                        bounds.join(b);
+                    }
                 } else {
-                    incrementBy = kMinChildren;
-                    remainder -= kMaxChildren - kMinChildren;
+                    node->fLeft[j]     = node->fTop[j]    =  SK_ScalarInfinity;
+                    node->fRight[j]    = node->fBottom[j] = -SK_ScalarInfinity;
+                    node->fChildren[j] = -1;
                 }
             }
-            Node* n = allocateNodeAtLevel(level);
-            n->fNumChildren = 1;
-            n->fChildren[0] = (*branches)[currentBranch];
-            Branch b;
-            b.fBounds = (*branches)[currentBranch].fBounds;
-            b.fSubtree = n;
-            ++currentBranch;
-            for (int k = 1; k < incrementBy && currentBranch < branches->count(); ++k) {
-                b.fBounds.join((*branches)[currentBranch].fBounds);
-                n->fChildren[k] = (*branches)[currentBranch];
-                ++n->fNumChildren;
-                ++currentBranch;
-            }
-            (*branches)[newBranches] = b;
-            ++newBranches;
+            parents[i].fBounds = bounds;
+            parents[i].fIndex = SkToInt(node - fNodes);
         }
-    }
-    branches->setCount(newBranches);
-    return this->bulkLoad(branches, level + 1);
+    });
+    return nodes;
 }
 
-void SkRTree::search(const SkRect& query, SkTDArray<int>* results) const {
-    if (fCount > 0 && SkRect::Intersects(fRoot.fBounds, query)) {
-        this->search(fRoot.fSubtree, query, results);
-    }
+template <int kFanout>
+int SkTRTree<kFanout>::CountNodes(int branches) {
+    int nodes = 0;
+    do {
+        branches = (branches - 1) / kFanout + 1;
+        nodes += branches;
+    } while (branches > 1);
+    return nodes;
 }
 
-void SkRTree::search(Node* node, const SkRect& query, SkTDArray<int>* results) const {
-    for (int i = 0; i < node->fNumChildren; ++i) {
-        if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
-            if (0 == node->fLevel) {
-                results->push(node->fChildren[i].fOpIndex);
-            } else {
-                this->search(node->fChildren[i].fSubtree, query, results);
+static inline Sk4f both(const Sk4f& a, const Sk4f& b) {
+    return a.thenElse(b, Sk4f(0));
+}
+
+template <int kFanout>
+void SkTRTree<kFanout>::search(const SkRect& query, SkTDArray<int>* results) const {
+    if (0 == fCount || !SkRect::Intersects(fRoot.fBounds, query)) {
+        return;
+    }
+    const int start = results->count();
+
+    // Returns a bit for each child of node whose bounds intersect the query.
+    const Sk4f queryL(query.fLeft), queryT(query.fTop), queryR(query.fRight),
+               queryB(query.fBottom);
+    auto hits = [&](const Node& node) {
+        uint32_t mask = 0;
+        for (int i = 0; i < kFanout; i += 4) {
+            const Sk4f hit = both(both(Sk4f::Load(node.fLeft + i) < queryR,
+                                       queryL < Sk4f::Load(node.fRight + i)),
+                                  both(Sk4f::Load(node.fTop + i) < queryB,
+                                       queryT < Sk4f::Load(node.fBottom + i)));
+            if (hit.anyTrue()) {
+                uint32_t lanes[4];
+                hit.store(lanes);
+                mask |= ((lanes[0] & 1) | (lanes[1] & 2) | (lanes[2] & 4) | (lanes[3] & 8)) << i;
             }
         }
+        return mask;
+    };
+
+    // Walk down the tree, visiting the children hit at each level in order.  Every node
+    // below the root has at least two children, so a tree of 2^31 rects is under 32 deep.
+    struct Frame {
+        const Node* fNode;
+        uint32_t fHits;
+    };
+    Frame stack[32];
+    int depth = 0;
+    stack[0].fNode = fNodes + fRoot.fIndex;
+    stack[0].fHits = hits(*stack[0].fNode);
+    while (depth >= 0) {
+        Frame& frame = stack[depth];
+        if (0 == frame.fHits) {
+            depth--;
+        } else if (0 == frame.fNode->fLevel) {
+            int* ops = results->append(kFanout);
+            int found = 0;
+            for (uint32_t mask = frame.fHits; mask; mask &= mask - 1) {
+                ops[found++] = frame.fNode->fChildren[31 - SkCLZ(mask & (0 - mask))];
+            }
+            results->setCount(results->count() - kFanout + found);
+            depth--;
+        } else {
+            const uint32_t lowest = frame.fHits & (0 - frame.fHits);
+            frame.fHits ^= lowest;
+            const Node* child = fNodes + frame.fNode->fChildren[31 - SkCLZ(lowest)];
+            SkASSERT(depth + 1 < (int)SK_ARRAY_COUNT(stack));
+            stack[++depth].fNode = child;
+            stack[depth].fHits = hits(*child);
+        }
+    }
+
+    // The leaves hold ops in order unless they were sorted.
+    if (fSorted && results->count() - start > 1) {
+        SkTQSort(results->begin() + start, results->end() - 1);
     }
 }
 
-size_t SkRTree::bytesUsed() const {
-    size_t byteCount = sizeof(SkRTree);
+template <int kFanout>
+size_t SkTRTree<kFanout>::bytesUsed() const {
+    size_t byteCount = sizeof(*this);
 
-    byteCount += fNodes.reserved() * sizeof(Node);
+    byteCount += fStorage.get() ? fNodeCount * sizeof(Node) + 63 : 0;
 
     return byteCount;
 }
+
+template class SkTRTree<4>;
+template class SkTRTree<8>;
+template class SkTRTree<16>;
@@ -7,6 +7,7 @@
 
 #include "SkRasterClip.h"
 #include "SkPath.h"
+#include "SkResourceCache.h"
 
 SkRasterClip::SkRasterClip(const SkRasterClip& src) {
     AUTO_RASTERCLIP_VALIDATE(src);
@@ -222,6 +223,141 @@ bool SkRasterClip::op(const SkPath& path, const SkIRect& bounds, SkRegion::Op op
     }
 }
 
+namespace {
+static unsigned gPathClipKeyNamespaceLabel;
+
+// The path is identified by its gen ID and fill type (which the gen ID doesn't cover), and
+// placed by the matrix, less the whole pixels that moved it from near the origin, which are
+// added back to the cached clip when it's found.
+struct PathClipKey : public SkResourceCache::Key {
+public:
+    PathClipKey(const SkPath& path, const SkMatrix& matrix, bool doAA)
+        : fGenID(path.getGenerationID())
+        , fFillType(path.getFillType())
+        , fDoAA(doAA)
+    {
+        matrix.get9(fMatrix);
+        this->init(&gPathClipKeyNamespaceLabel, 0,
+                   sizeof(fGenID) + sizeof(fFillType) + sizeof(fDoAA) + sizeof(fMatrix));
+    }
+
+    uint32_t fGenID;
+    int32_t  fFillType;
+    int32_t  fDoAA;
+    SkScalar fMatrix[9];
+};
+
+// Either the whole clip, or just a note that the path was seen once, so the next sighting
+// knows it's worth scanning whole and caching.
+struct PathClipRec : public SkResourceCache::Rec {
+    explicit PathClipRec(const PathClipKey& key)
+        : fKey(key)
+        , fHasClip(false) {}
+    PathClipRec(const PathClipKey& key, const SkRasterClip& clip)
+        : fKey(key)
+        , fClip(clip)
+        , fHasClip(true) {}
+
+    PathClipKey  fKey;
+    SkRasterClip fClip;
+    bool         fHasClip;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + (fClip.isBW() ? fClip.bwRgn().writeToMemory(nullptr)
+                                             : fClip.aaRgn().bytesUsed());
+    }
+    const char* getCategory() const override { return "path-clip"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    struct Context {
+        SkRasterClip* fClip;
+        bool          fSeen;
+    };
+
+    // A note that the path was seen is used up by finding it.
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const PathClipRec& rec = static_cast<const PathClipRec&>(baseRec);
+        Context* context = (Context*)contextData;
+        context->fSeen = true;
+        if (rec.fHasClip) {
+            *context->fClip = rec.fClip;
+        }
+        return rec.fHasClip;
+    }
+};
+} // namespace
+
+bool SkRasterClip::op(const SkPath& path, const SkMatrix& matrix, const SkPath& devPath,
+                      const SkIRect& bounds, SkRegion::Op op, bool doAA) {
+    // Clips smaller than this scan too quickly to be worth a cache entry.
+    static const int64_t kMinCachedArea = 64 * 64;
+    // Paths may reach this far past the device in each direction, and still be cached whole.
+    static const int kMaxCachedScale = 4;
+    // The scan converters work in 16-bit supersampled coordinates.
+    static const int32_t kMaxCachedCoord = SK_MaxS16 >> 2;
+
+    if (fForceConservativeRects || path.isVolatile() || path.isInverseFillType() ||
+        devPath.isEmpty()) {
+        return this->op(devPath, bounds, op, doAA);
+    }
+
+    // The whole path is cached, so it's reused when clipped by other bounds or tiles.  Paths
+    // reaching far outside the device would cost far more to scan whole than just clipped here.
+    SkIRect devBounds = devPath.getBounds().roundOut();
+    devBounds.outset(1, 1);
+    const SkIRect& limit = (SkRegion::kIntersect_Op == op) ? this->getBounds() : bounds;
+    if (!SkIRect::Intersects(devBounds, limit) ||
+        devBounds.width() > bounds.width() * kMaxCachedScale ||
+        devBounds.height() > bounds.height() * kMaxCachedScale ||
+        sk_64_mul(devBounds.width(), devBounds.height()) < kMinCachedArea) {
+        return this->op(devPath, bounds, op, doAA);
+    }
+
+    // Moving the path's bounds to the origin keeps the key the same under whole pixel translations,
+    // and the path at the positive coordinates the scan converters round the same everywhere.
+    SkMatrix keyMatrix = matrix;
+    int dx = 0, dy = 0;
+    if (!matrix.hasPerspective()) {
+        dx = devBounds.fLeft;
+        dy = devBounds.fTop;
+        keyMatrix.postTranslate(-SkIntToScalar(dx), -SkIntToScalar(dy));
+    }
+    devBounds.offset(-dx, -dy);
+    if (!SkIRect::MakeLTRB(-kMaxCachedCoord, -kMaxCachedCoord,
+                           kMaxCachedCoord, kMaxCachedCoord).contains(devBounds)) {
+        return this->op(devPath, bounds, op, doAA);
+    }
+
+    const PathClipKey key(path, keyMatrix, doAA);
+    SkRasterClip clip;
+    PathClipRec::Context context = { &clip, false };
+    if (!SkResourceCache::Find(key, PathClipRec::Visitor, &context)) {
+        if (!context.fSeen) {
+            // Most paths are only clipped to once.  Until we see this one again, scan only what
+            // the bounds show of it, as if we didn't cache at all.
+            SkResourceCache::Add(new PathClipRec(key));
+            return this->op(devPath, bounds, op, doAA);
+        }
+        SkPath keyPath;
+        path.transform(keyMatrix, &keyPath);
+        SkIRect base = keyPath.getBounds().roundOut();
+        base.outset(1, 1);
+        clip.setPath(keyPath, base, doAA);
+        SkResourceCache::Add(new PathClipRec(key, clip));
+    }
+
+    clip.translate(dx, dy);
+    if (!bounds.contains(clip.getBounds())) {
+        clip.op(bounds, SkRegion::kIntersect_Op);
+    }
+    if (SkRegion::kReplace_Op == op) {
+        *this = clip;
+        return !this->isEmpty();
+    }
+    return this->op(clip, op);
+}
+
 bool SkRasterClip::setPath(const SkPath& path, const SkIRect& clip, bool doAA) {
     SkRegion tmp;
     tmp.setRect(clip);
@@ -11,6 +11,7 @@
 #include "SkRegion.h"
 #include "SkAAClip.h"
 
+class SkMatrix;
 class SkRRect;
 
 class SkRasterClip {
@@ -49,6 +50,14 @@ public:
     bool op(const SkRRect&, const SkIRect&, SkRegion::Op, bool doAA);
     bool op(const SkPath&, const SkIRect&, SkRegion::Op, bool doAA);
 
+    /**
+     *  Same as op() with the device path, but the clip made from it is cached by the generation ID
+     *  of the path and the matrix mapping it to the device, so it's not scanned again when the
+     *  path is clipped to again, or by a matrix differing only by whole pixels of translation.
+     */
+    bool op(const SkPath& path, const SkMatrix& matrix, const SkPath& devPath, const SkIRect&,
+            SkRegion::Op, bool doAA);
+
     void translate(int dx, int dy, SkRasterClip* dst) const;
     void translate(int dx, int dy) {
         this->translate(dx, dy, this);
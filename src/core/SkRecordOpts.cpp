@@ -7,6 +7,8 @@
 
 #include "SkRecordOpts.h"
 
+#include "SkPathRefArena.h"
+#include "SkRecordDraw.h"
 #include "SkRecordPattern.h"
 #include "SkRecords.h"
 #include "SkTDArray.h"
@@ -271,6 +273,196 @@ void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord* record) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// These draws put each of their glyphs, points or sprites down one at a time, in order, so a run
+// of them with the same paint draws just the same as one with all their contents.  A looper or
+// image filter works on the draw as a whole, so those paints can't be merged.
+static bool can_merge_paints(const SkPaint& a, const SkPaint& b) {
+    return a == b && !a.getLooper() && !a.getImageFilter();
+}
+
+static bool can_merge(const DrawPosText& into, const DrawPosText& from) {
+    return can_merge_paints(into.paint, from.paint);
+}
+
+static bool can_merge(const DrawPosTextH& into, const DrawPosTextH& from) {
+    return into.y == from.y && can_merge_paints(into.paint, from.paint);
+}
+
+static bool can_merge(const DrawPoints& into, const DrawPoints& from) {
+    // Polygons join their points up, and lines pair them, dashing each pair as a whole.
+    return into.mode == from.mode && can_merge_paints(into.paint, from.paint) &&
+           SkCanvas::kPolygon_PointMode != into.mode &&
+           (SkCanvas::kLines_PointMode != into.mode ||
+            (!(into.count & 1) && !(from.count & 1) && !into.paint.getPathEffect()));
+}
+
+static bool can_merge(const DrawAtlas& into, const DrawAtlas& from) {
+    return (const SkImage*)into.atlas == (const SkImage*)from.atlas && into.mode == from.mode &&
+           SkToBool(into.colors) == SkToBool(from.colors) &&
+           SkToBool(into.cull)   == SkToBool(from.cull)   &&
+           SkToBool(into.paint)  == SkToBool(from.paint)  &&
+           (!into.paint || can_merge_paints(*into.paint, *from.paint));
+}
+
+// Copies array(draw), count(draw) long, from each of the draws into one new array in the record.
+template <typename T, typename Draw, typename Array, typename Count>
+static T* gather(SkRecord* record, const SkTDArray<Draw*>& draws, Array array, Count count) {
+    size_t total = 0;
+    for (const Draw* draw : draws) {
+        total += count(*draw);
+    }
+    T* all = record->alloc<T>(total);
+    T* next = all;
+    for (const Draw* draw : draws) {
+        memcpy(next, (const T*)array(*draw), count(*draw) * sizeof(T));
+        next += count(*draw);
+    }
+    return all;
+}
+
+// Merges draws[1...] into draws[0], copying each of its arrays just once.
+static void merge_draws(SkRecord* record, const SkTDArray<DrawPosText*>& draws) {
+    auto glyphs = [](const DrawPosText& op) { return op.paint.countText(op.text, op.byteLength); };
+    auto bytes  = [](const DrawPosText& op) { return op.byteLength; };
+    DrawPosText* into = draws[0];
+    into->pos  = gather<SkPoint>(record, draws, [](const DrawPosText& op) { return op.pos; },
+                                 glyphs);
+    into->text = gather<char>(record, draws, [](const DrawPosText& op) { return op.text; }, bytes);
+    for (int i = 1; i < draws.count(); i++) {
+        into->byteLength += draws[i]->byteLength;
+    }
+}
+
+static void merge_draws(SkRecord* record, const SkTDArray<DrawPosTextH*>& draws) {
+    auto glyphs = [](const DrawPosTextH& op) { return op.paint.countText(op.text, op.byteLength); };
+    auto bytes  = [](const DrawPosTextH& op) { return op.byteLength; };
+    DrawPosTextH* into = draws[0];
+    into->xpos = gather<SkScalar>(record, draws, [](const DrawPosTextH& op) { return op.xpos; },
+                                  glyphs);
+    into->text = gather<char>(record, draws, [](const DrawPosTextH& op) { return op.text; },
+                              bytes);
+    for (int i = 1; i < draws.count(); i++) {
+        into->byteLength += draws[i]->byteLength;
+    }
+}
+
+static void merge_draws(SkRecord* record, const SkTDArray<DrawPoints*>& draws) {
+    auto count = [](const DrawPoints& op) { return op.count; };
+    DrawPoints* into = draws[0];
+    into->pts = gather<SkPoint>(record, draws, [](const DrawPoints& op) { return op.pts; }, count);
+    for (int i = 1; i < draws.count(); i++) {
+        into->count += draws[i]->count;
+    }
+}
+
+static void merge_draws(SkRecord* record, const SkTDArray<DrawAtlas*>& draws) {
+    auto count = [](const DrawAtlas& op) { return op.count; };
+    DrawAtlas* into = draws[0];
+    into->xforms = gather<SkRSXform>(record, draws, [](const DrawAtlas& op) { return op.xforms; },
+                                     count);
+    into->texs   = gather<SkRect>(record, draws, [](const DrawAtlas& op) { return op.texs; },
+                                  count);
+    if (into->colors) {
+        into->colors = gather<SkColor>(record, draws,
+                                       [](const DrawAtlas& op) { return op.colors; }, count);
+    }
+    for (int i = 1; i < draws.count(); i++) {
+        if (into->cull) {
+            into->cull->join(*draws[i]->cull);
+        }
+        into->count += draws[i]->count;
+    }
+}
+
+template <typename T>
+static T* get(SkRecord* record, int i) {
+    Is<T> op;
+    record->mutate(i, op);
+    return op.get();
+}
+
+struct TypeOf {
+    template <typename T> Type operator()(const T&) { return T::kType; }
+};
+
+// How much bigger than one draw a merged draw may grow.  Keeping merged draws small keeps them
+// cheap to cull against tiles and clips.
+static const SkScalar kMaxMergedGrowth = 256;
+
+// Merges the draws that follow record[into], with only NoOps between them, into it.  Returns the
+// index of the first draw after those merged.
+template <typename T>
+static int merge_following(SkRecord* record, const SkRect bounds[], int into) {
+    SkTDArray<T*> draws;
+    *draws.append() = get<T>(record, into);
+    SkRect merged = bounds[into];
+
+    int from = into + 1;
+    for (; from < record->count(); from++) {
+        const Type type = record->visit(from, TypeOf());
+        if (NoOp_Type == type) {
+            continue;
+        }
+        if (T::kType != type) {
+            break;
+        }
+        T* draw = get<T>(record, from);
+        SkRect grown = merged;
+        grown.join(bounds[from]);
+        if (grown.width()  > bounds[from].width()  + kMaxMergedGrowth ||
+            grown.height() > bounds[from].height() + kMaxMergedGrowth ||
+            !can_merge(*draws[0], *draw)) {
+            break;
+        }
+        *draws.append() = draw;
+        merged = grown;
+    }
+
+    if (draws.count() > 1) {
+        merge_draws(record, draws);
+        for (int i = into + 1; i < from; i++) {
+            record->replace<NoOp>(i);
+        }
+    }
+    return from;
+}
+
+void SkRecordMergeDraws(SkRecord* record) {
+    SkAutoTMalloc<SkRect> bounds(record->count());
+    SkRecordFillBounds(SkRect::MakeLargest(), *record, bounds.get());
+
+    for (int i = 0; i < record->count();) {
+        switch (record->visit(i, TypeOf())) {
+            case DrawPosText_Type:  i = merge_following<DrawPosText>(record, bounds, i);  break;
+            case DrawPosTextH_Type: i = merge_following<DrawPosTextH>(record, bounds, i); break;
+            case DrawPoints_Type:   i = merge_following<DrawPoints>(record, bounds, i);   break;
+            case DrawAtlas_Type:    i = merge_following<DrawAtlas>(record, bounds, i);    break;
+            default:                i++;                                                  break;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct PathGatherer {
+    template <typename T> void operator()(T*) {}
+    void operator()(ClipPath* r)       { *fPaths.append() = &r->path; }
+    void operator()(DrawPath* r)       { *fPaths.append() = &r->path; }
+    void operator()(DrawTextOnPath* r) { *fPaths.append() = &r->path; }
+
+    SkTDArray<SkPath*> fPaths;
+};
+
+void SkRecordPackPaths(SkRecord* record) {
+    PathGatherer gatherer;
+    for (int i = 0; i < record->count(); i++) {
+        record->mutate(i, gatherer);
+    }
+    SkPathRefArena::Pack(gatherer.fPaths.begin(), gatherer.fPaths.count());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 void SkRecordOptimize(SkRecord* record) {
     // This might be useful  as a first pass in the future if we want to weed
     // out junk for other optimization passes.  Right now, nothing needs it,
@@ -280,6 +472,8 @@ void SkRecordOptimize(SkRecord* record) {
 
     SkRecordNoopSaveLayerDrawRestores(record);
     SkRecordMergeSvgOpacityAndFilterLayers(record);
+    SkRecordMergeDraws(record);
+    SkRecordPackPaths(record);
 
     record->defrag();
 }
@@ -289,6 +483,8 @@ void SkRecordOptimize2(SkRecord* record) {
     SkRecordNoopSaveRestores(record);
     SkRecordNoopSaveLayerDrawRestores(record);
     SkRecordMergeSvgOpacityAndFilterLayers(record);
+    SkRecordMergeDraws(record);
+    SkRecordPackPaths(record);
 
     record->defrag();
 }
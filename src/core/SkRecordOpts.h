@@ -24,6 +24,15 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Merges runs of text drawn with explicit positions, points, and atlas sprites into one draw of
+// the same kind with the same paint.  Only draws with nothing but NoOps between them are merged,
+// so playback is unchanged at any scale.
+void SkRecordMergeDraws(SkRecord*);
+
+// Moves the points and verbs of the paths only the record holds into one block they share, storing
+// identical runs once.  See SkPathRefArena.
+void SkRecordPackPaths(SkRecord*);
+
 // Experimental optimizers
 void SkRecordOptimize2(SkRecord*);
 
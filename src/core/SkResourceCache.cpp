@@ -5,10 +5,12 @@
  * found in the LICENSE file.
  */
 
+#include "SkAtomics.h"
 #include "SkChecksum.h"
 #include "SkMessageBus.h"
 #include "SkMipMap.h"
 #include "SkMutex.h"
+#include "SkOnce.h"
 #include "SkPixelRef.h"
 #include "SkResourceCache.h"
 #include "SkTraceMemoryDump.h"
@@ -56,6 +58,12 @@ void SkResourceCache::Key::init(void* nameSpace, uint64_t sharedID, size_t dataS
 class SkResourceCache::Hash :
     public SkTDynamicHash<SkResourceCache::Rec, SkResourceCache::Key> {};
 
+// Totals across all the shards of the global cache.  They're only updated with each shard's
+// own lock held, so any one read of them may be a little stale; that's fine for a budget.
+struct SkResourceCache::SharedBudget {
+    SkAtomic<size_t,  sk_memory_order_relaxed> fBytesUsed{0};
+    SkAtomic<int32_t, sk_memory_order_relaxed> fCount{0};
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -67,6 +75,7 @@ void SkResourceCache::init() {
     fCount = 0;
     fSingleAllocationByteLimit = 0;
     fAllocator = nullptr;
+    fSharedBudget = nullptr;
 
     // One of these should be explicit set by the caller after we return.
     fTotalByteLimit = 0;
@@ -284,6 +293,10 @@ void SkResourceCache::remove(Rec* rec) {
 
     fTotalBytesUsed -= used;
     fCount -= 1;
+    if (fSharedBudget) {
+        fSharedBudget->fBytesUsed.fetch_sub(used);
+        fSharedBudget->fCount.fetch_sub(1);
+    }
 
     if (gDumpCacheTransactions) {
         SkString bytesStr, totalStr;
@@ -310,7 +323,11 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
 
     Rec* rec = fTail;
     while (rec) {
-        if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
+        // As a shard of the global cache, we purge our own LRU Recs until all shards together
+        // fit the budget.  Keys are spread evenly over the shards, so this evens out.
+        size_t bytesUsed = fSharedBudget ? fSharedBudget->fBytesUsed.load() : fTotalBytesUsed;
+        int    count     = fSharedBudget ? fSharedBudget->fCount.load()     : fCount;
+        if (!forcePurge && bytesUsed < byteLimit && count < countLimit) {
             break;
         }
 
@@ -320,6 +337,15 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
     }
 }
 
+void SkResourceCache::purgeDownTo(size_t bytes) {
+    Rec* rec = fTail;
+    while (rec && fTotalBytesUsed > bytes) {
+        Rec* prev = rec->fPrev;
+        this->remove(rec);
+        rec = prev;
+    }
+}
+
 //#define SK_TRACK_PURGE_SHAREDID_HITRATE
 
 #ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
@@ -448,6 +474,10 @@ void SkResourceCache::addToHead(Rec* rec) {
     }
     fTotalBytesUsed += rec->bytesUsed();
     fCount += 1;
+    if (fSharedBudget) {
+        fSharedBudget->fBytesUsed.fetch_add(rec->bytesUsed());
+        fSharedBudget->fCount.fetch_add(1);
+    }
 
     this->validate();
 }
@@ -542,101 +572,181 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SK_DECLARE_STATIC_MUTEX(gMutex);
-static SkResourceCache* gResourceCache = nullptr;
-static void cleanup_gResourceCache() {
-    // We'll clean this up in our own tests, but disable for clients.
-    // Chrome seems to have funky multi-process things going on in unit tests that
-    // makes this unsafe to delete when the main process atexit()s.
-    // SkLazyPtr does the same sort of thing.
-#if SK_DEVELOPER
-    delete gResourceCache;
-#endif
-}
+// The global cache is kShardCount SkResourceCaches, each behind its own lock, sharing one
+// SharedBudget.  A Key always goes to the same shard, picked by the top bits of its hash
+// (SkTDynamicHash uses the bottom bits).
+class SkResourceCache::Shards : SkNoncopyable {
+public:
+    static const int kShardBits  = 4;
+    static const int kShardCount = 1 << kShardBits;
 
-/** Must hold gMutex when calling. */
-static SkResourceCache* get_cache() {
-    // gMutex is always held when this is called, so we don't need to be fancy in here.
-    gMutex.assertHeld();
-    if (nullptr == gResourceCache) {
+    struct Shard {
+        SkMutex          fMutex;
+        SkResourceCache* fCache;
+    };
+
+    Shards() {
+        for (Shard& shard : fShards) {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+            shard.fCache = new SkResourceCache(SkDiscardableMemory::Create);
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+            shard.fCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
 #endif
-        atexit(cleanup_gResourceCache);
+            shard.fCache->fSharedBudget = &fBudget;
+        }
+    }
+
+    ~Shards() {
+        for (Shard& shard : fShards) {
+            delete shard.fCache;
+        }
     }
+
+    Shard& shardFor(const Key& key) { return fShards[key.hash() >> (32 - kShardBits)]; }
+
+    // Settings are the same for every shard, so we can read them from any one.
+    Shard& first() { return fShards[0]; }
+
+    // Calls fn(SkResourceCache*) on each shard in turn, holding that shard's lock.
+    template <typename Fn>
+    void forEach(Fn&& fn) {
+        for (Shard& shard : fShards) {
+            SkAutoMutexAcquire am(shard.fMutex);
+            fn(shard.fCache);
+        }
+    }
+
+    const SharedBudget& budget() const { return fBudget; }
+
+    static Shards* Get();
+
+private:
+    Shard        fShards[kShardCount];
+    SharedBudget fBudget;
+};
+
+SkResourceCache::Shards* SkResourceCache::Shards::Get() {
+    static Shards* gResourceCache = nullptr;
+    static SkOnce once;
+    once([] {
+        gResourceCache = new Shards;
+        atexit([] {
+            // We'll clean this up in our own tests, but disable for clients.
+            // Chrome seems to have funky multi-process things going on in unit tests that
+            // makes this unsafe to delete when the main process atexit()s.
+            // SkLazyPtr does the same sort of thing.
+#if SK_DEVELOPER
+            delete gResourceCache;
+#endif
+        });
+    });
     return gResourceCache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalBytesUsed();
+    return Shards::Get()->budget().fBytesUsed.load();
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalByteLimit();
+    Shards::Shard& shard = Shards::Get()->first();
+    SkAutoMutexAcquire am(shard.fMutex);
+    return shard.fCache->getTotalByteLimit();
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setTotalByteLimit(newLimit);
+    Shards* shards = Shards::Get();
+    size_t prevLimit = 0;
+    bool first = true;
+    shards->forEach([&](SkResourceCache* cache) {
+        if (first) {
+            prevLimit = cache->fTotalByteLimit;
+            first = false;
+        }
+        cache->fTotalByteLimit = newLimit;
+    });
+
+    // Purging shard by shard against the whole budget would empty the first shards before the
+    // last were touched.  Instead each shard gives up the same fraction of what it holds.
+    size_t bytesUsed = shards->budget().fBytesUsed.load();
+    if (newLimit < prevLimit && bytesUsed > newLimit) {
+        double keep = (double)newLimit / bytesUsed;
+        shards->forEach([&](SkResourceCache* cache) {
+            cache->purgeDownTo((size_t)(cache->fTotalBytesUsed * keep));
+        });
+    }
+    return prevLimit;
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->discardableFactory();
+    Shards::Shard& shard = Shards::Get()->first();
+    SkAutoMutexAcquire am(shard.fMutex);
+    return shard.fCache->discardableFactory();
 }
 
 SkBitmap::Allocator* SkResourceCache::GetAllocator() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->allocator();
+    Shards::Shard& shard = Shards::Get()->first();
+    SkAutoMutexAcquire am(shard.fMutex);
+    return shard.fCache->allocator();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->newCachedData(bytes);
+    Shards::Shard& shard = Shards::Get()->first();
+    SkAutoMutexAcquire am(shard.fMutex);
+    return shard.fCache->newCachedData(bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->dump();
+    int    count = 0;
+    size_t bytes = 0;
+    bool   discardable = false;
+    Shards::Get()->forEach([&](SkResourceCache* cache) {
+        cache->validate();
+        count += cache->fCount;
+        bytes += cache->fTotalBytesUsed;
+        discardable = cache->fDiscardableFactory != nullptr;
+    });
+    SkDebugf("SkResourceCache: count=%d bytes=%zu %s shards=%d\n",
+             count, bytes, discardable ? "discardable" : "malloc", Shards::kShardCount);
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setSingleAllocationByteLimit(size);
+    size_t prevLimit = 0;
+    Shards::Get()->forEach([&](SkResourceCache* cache) {
+        prevLimit = cache->setSingleAllocationByteLimit(size);
+    });
+    return prevLimit;
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getSingleAllocationByteLimit();
+    Shards::Shard& shard = Shards::Get()->first();
+    SkAutoMutexAcquire am(shard.fMutex);
+    return shard.fCache->getSingleAllocationByteLimit();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    Shards::Shard& shard = Shards::Get()->first();
+    SkAutoMutexAcquire am(shard.fMutex);
+    return shard.fCache->getEffectiveSingleAllocationByteLimit();
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->purgeAll();
+    Shards::Get()->forEach([](SkResourceCache* cache) { cache->purgeAll(); });
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->find(key, visitor, context);
+    Shards::Shard& shard = Shards::Get()->shardFor(key);
+    SkAutoMutexAcquire am(shard.fMutex);
+    return shard.fCache->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->add(rec);
+    Shards::Shard& shard = Shards::Get()->shardFor(rec->getKey());
+    SkAutoMutexAcquire am(shard.fMutex);
+    shard.fCache->add(rec);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->visitAll(visitor, context);
+    Shards::Get()->forEach([&](SkResourceCache* cache) { cache->visitAll(visitor, context); });
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
@@ -25,6 +25,9 @@ class SkTraceMemoryDump;
  *
  *  As a convenience, a global instance is also defined, which can be safely
  *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  It is split into shards by Key hash, each with its own lock and LRU list, so
+ *  threads working with different Keys rarely wait on each other.  The shards share
+ *  one budget, which each enforces by purging its own least recently used Recs.
  */
 class SkResourceCache {
 public:
@@ -268,10 +271,19 @@ private:
     size_t  fSingleAllocationByteLimit;
     int     fCount;
 
+    // When this cache is a shard of the global cache, the budget is shared by all the shards,
+    // and fTotalBytesUsed and fCount are just our part of it.  Otherwise this is nullptr.
+    struct SharedBudget;
+    SharedBudget* fSharedBudget;
+
     SkMessageBus<PurgeSharedIDMessage>::Inbox fPurgeSharedIDInbox;
 
+    class Shards;  // The global cache.
+
     void checkMessages();
     void purgeAsNeeded(bool forcePurge = false);
+    // Purges our own LRU Recs until we hold no more than bytes, whatever any shared budget says.
+    void purgeDownTo(size_t bytes);
 
     // linklist management
     void moveToHead(Rec*);
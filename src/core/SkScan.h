@@ -22,6 +22,13 @@ class SkPath;
 */
 typedef SkIRect SkXRect;
 
+/** Analytic anti-aliasing (see SkScan_AAAPath.cpp) computes exact pixel coverage rather
+    than supersampling.  When gSkUseAnalyticAA is set, AntiFillPath uses it for paths it
+    expects to draw faster that way; gSkForceAnalyticAA uses it for every path.
+*/
+extern bool gSkUseAnalyticAA;
+extern bool gSkForceAnalyticAA;
+
 class SkScan {
 public:
     /*
@@ -45,6 +52,7 @@ public:
     static void AntiFillXRect(const SkXRect&, const SkRasterClip&, SkBlitter*);
     static void FillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void AntiFillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
+    static void AAAFillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void FrameRect(const SkRect&, const SkPoint& strokeSize,
                           const SkRasterClip&, SkBlitter*);
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
@@ -73,6 +81,8 @@ private:
     static void FillPath(const SkPath&, const SkRegion& clip, SkBlitter*);
     static void AntiFillPath(const SkPath&, const SkRegion& clip, SkBlitter*,
                              bool forceRLE = false);
+    static void AAAFillPath(const SkPath&, const SkRegion& clip, SkBlitter*,
+                            bool forceRLE = false);
     static void FillTriangle(const SkPoint pts[], const SkRegion*, SkBlitter*);
 
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
@@ -0,0 +1,544 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkScanPriv.h"
+#include "SkBlitter.h"
+#include "SkGeometry.h"
+#include "SkMask.h"
+#include "SkPath.h"
+#include "SkRegion.h"
+#include "SkTArray.h"
+#include "SkTSort.h"
+#include "SkTemplates.h"
+
+/** @file
+    Analytic anti-aliasing.
+
+    SkScan_AntiPath.cpp finds coverage by walking SCALE sub-scanlines per pixel row and
+    counting how much of each one is inside the path.  Here we instead flatten the path
+    into lines and, one pixel row at a time, add up the exact signed area each line covers
+    in each pixel.  Summing those areas left to right along the row gives the winding
+    number integrated over each pixel, which we then turn into coverage with the path's
+    fill rule.
+
+    This is exact for pixels touched by a single edge (most of them).  Where several edges
+    cross the same pixel we only know the average winding, not how it is distributed, so
+    nonzero clamps it to 1 and even-odd folds it back into [0,1].  The supersampler has the
+    same problem at its own sub-scanline resolution, and we differ from it by no more than
+    its own quantization error on ordinary paths (see AnalyticAATest).
+ */
+
+bool gSkUseAnalyticAA   = false;
+bool gSkForceAnalyticAA = false;
+
+// How far (in pixels) our flattened curves may stray from the true curve.
+static const SkScalar kFlattenTolerance = SK_Scalar1 / 8;
+
+// Uniformly subdividing a curve into more pieces than this stops paying off.
+static const int kMaxCurveLines = 256;
+
+// Like MaskSuperBlitter, small paths are drawn into an A8 mask and blitted all at once.
+static const int kMaxMaskWidth   = 32;
+static const int kMaxMaskStorage = 1024;
+
+namespace {
+
+// A line segment with fY0 < fY1, pointing down if fWinding is +1 or up if -1.
+struct Line {
+    float fX0, fY0, fX1, fY1;
+    float fDXDY;
+    float fWinding;
+};
+
+// Flattens a path into Lines, dropping those that can't affect the rows [top, bottom)
+// or the columns left of right.
+class LineBuilder {
+public:
+    LineBuilder(int top, int bottom, int right) : fTop(top), fBottom(bottom), fRight(right) {}
+
+    void build(const SkPath& path) {
+        SkPath::Iter iter(path, true);
+        SkPoint pts[4];
+        SkPath::Verb verb;
+        while ((verb = iter.next(pts, false)) != SkPath::kDone_Verb) {
+            switch (verb) {
+                case SkPath::kLine_Verb:
+                    this->addLine(pts[0], pts[1]);
+                    break;
+                case SkPath::kQuad_Verb:
+                    this->addQuad(pts);
+                    break;
+                case SkPath::kConic_Verb: {
+                    SkAutoConicToQuads quadder;
+                    const SkPoint* quadPts = quadder.computeQuads(pts, iter.conicWeight(),
+                                                                  kFlattenTolerance);
+                    for (int i = 0; i < quadder.countQuads(); i++) {
+                        this->addQuad(quadPts + 2*i);
+                    }
+                } break;
+                case SkPath::kCubic_Verb:
+                    this->addCubic(pts);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    const SkTArray<Line, true>& lines() const { return fLines; }
+
+private:
+    void addLine(SkPoint p0, SkPoint p1) {
+        float winding = 1;
+        if (p0.fY > p1.fY) {
+            SkTSwap(p0, p1);
+            winding = -1;
+        }
+        if (p0.fY == p1.fY               // Horizontal lines don't change the winding.
+            || p1.fY <= fTop || p0.fY >= fBottom
+            || (p0.fX >= fRight && p1.fX >= fRight)) {
+            return;
+        }
+        Line& line = fLines.push_back();
+        line.fX0 = p0.fX;
+        line.fY0 = p0.fY;
+        line.fX1 = p1.fX;
+        line.fY1 = p1.fY;
+        line.fDXDY = (p1.fX - p0.fX) / (p1.fY - p0.fY);
+        line.fWinding = winding;
+    }
+
+    // Linear interpolation over n pieces is off by at most |f''| / (8n^2),
+    // so we pick n to keep that under kFlattenTolerance.
+    static int count_lines(SkScalar secondDerivative) {
+        SkScalar n = SkScalarSqrt(secondDerivative * (1 / (8 * kFlattenTolerance)));
+        return SkTPin((int)n + 1, 1, kMaxCurveLines);
+    }
+
+    // Both curves are stepped with forward differences, like SkQuadraticEdge and SkCubicEdge.
+    void addQuad(const SkPoint pts[3]) {
+        // A quad's second derivative is constant, 2(p0 - 2p1 + p2).
+        SkVector dd = pts[0] - pts[1] - pts[1] + pts[2];
+        const int n = count_lines(2 * dd.length());
+        const SkScalar dt = SK_Scalar1 / n;
+
+        // B(t) = p0 + 2(p1 - p0)t + (p0 - 2p1 + p2)t^2
+        SkVector d1 = (pts[1] - pts[0]) * (2 * dt) + dd * (dt * dt),
+                 d2 = dd * (2 * dt * dt);
+        SkPoint prev = pts[0];
+        for (int i = 1; i < n; i++) {
+            SkPoint next = prev + d1;
+            d1 += d2;
+            this->addLine(prev, next);
+            prev = next;
+        }
+        this->addLine(prev, pts[2]);
+    }
+
+    void addCubic(const SkPoint pts[4]) {
+        // A cubic's second derivative moves linearly between 6(p0 - 2p1 + p2) and
+        // 6(p1 - 2p2 + p3), so its largest magnitude is at one of the ends.
+        SkVector dd0 = pts[0] - pts[1] - pts[1] + pts[2],
+                 dd1 = pts[1] - pts[2] - pts[2] + pts[3];
+        const int n = count_lines(6 * SkTMax(dd0.length(), dd1.length()));
+        const SkScalar dt = SK_Scalar1 / n;
+
+        // B(t) = p0 + 3(p1 - p0)t + 3(p0 - 2p1 + p2)t^2 + (p3 - p0 + 3(p1 - p2))t^3
+        SkVector a = pts[1] - pts[0],
+                 c = pts[3] - pts[0] + (pts[1] - pts[2]) * 3;
+        SkVector d1 = a * (3 * dt) + dd0 * (3 * dt * dt) + c * (dt * dt * dt),
+                 d2 = dd0 * (6 * dt * dt) + c * (6 * dt * dt * dt),
+                 d3 = c * (6 * dt * dt * dt);
+        SkPoint prev = pts[0];
+        for (int i = 1; i < n; i++) {
+            SkPoint next = prev + d1;
+            d1 += d2;
+            d2 += d3;
+            this->addLine(prev, next);
+            prev = next;
+        }
+        this->addLine(prev, pts[3]);
+    }
+
+    int                       fTop, fBottom, fRight;
+    SkSTArray<64, Line, true> fLines;
+};
+
+static inline SkAlpha winding_to_alpha(float winding, bool evenOdd) {
+    float coverage = SkScalarAbs(winding);
+    if (evenOdd) {
+        // Fold the winding into [0,2), then into [0,1]: 0.3 and 1.7 are both 30% covered.
+        coverage -= 2 * (int)(coverage * 0.5f);
+        if (coverage > 1) {
+            coverage = 2 - coverage;
+        }
+    } else {
+        coverage = SkTMin(coverage, 1.0f);
+    }
+    return (SkAlpha)(coverage * 255 + 0.5f);
+}
+
+// Accumulates signed area coverage for one row of pixels [0, width).
+class RowAccumulator {
+public:
+    RowAccumulator(int width, bool evenOdd, bool inverse)
+        // One extra cell for lines on the right edge, and one more for their right neighbor.
+        : fWidth(width), fEvenOdd(evenOdd), fInverse(inverse), fAcc(width + 2) {
+        sk_bzero(fAcc.get(), (width + 2) * sizeof(float));
+    }
+
+    bool isEmpty() const { return fSpans.empty(); }
+
+    // Add the piece of a line from (x0, top of row) to (x1, bottom of row) whose height is
+    // |d|, with d's sign the line's winding.  Anything left of 0 acts as if it were at 0;
+    // anything right of fWidth can't affect our pixels.
+    void accumulate(float x0, float x1, float d) {
+        const float w = (float)fWidth;
+        // Split the piece where it crosses either side, so every bit lands in the right column.
+        if ((x0 < 0 && x1 > 0) || (x0 > 0 && x1 < 0)) {
+            float t = (0 - x0) / (x1 - x0);
+            this->accumulate(x0, 0, d*t);
+            this->accumulate(0, x1, d*(1 - t));
+            return;
+        }
+        if ((x0 < w && x1 > w) || (x0 > w && x1 < w)) {
+            float t = (w - x0) / (x1 - x0);
+            this->accumulate(x0, w, d*t);
+            this->accumulate(w, x1, d*(1 - t));
+            return;
+        }
+        this->accumulateInside(SkTPin(x0, 0.0f, w), SkTPin(x1, 0.0f, w), d);
+    }
+
+    // Sum the row left to right, calling emit(x, n, alpha) for each run of pixels in order,
+    // then reset for the next row.  Only the cells lines touched can change the winding, so
+    // we skip straight between them.  Uncovered pixels before the first touched cell (unless
+    // we're inverse) and after the last are not emitted at all.
+    template <typename EmitFn>
+    void flush(EmitFn&& emit) {
+        // There are usually only a couple spans, often already in order.
+        for (int i = 1; i < fSpans.count(); i++) {
+            if (fSpans[i].fLo < fSpans[i-1].fLo) {
+                SkTQSort(fSpans.begin(), fSpans.end() - 1);
+                break;
+            }
+        }
+
+        const float* acc = fAcc.get();
+        float winding = 0;
+        int x = fInverse ? 0 : fSpans[0].fLo;
+        for (const Span& span : fSpans) {
+            if (span.fLo > x) {
+                emit(x, span.fLo - x, this->toAlpha(winding));
+                x = span.fLo;
+            }
+            for (; x <= span.fHi; x++) {
+                winding += acc[x];
+                if (x < fWidth) {
+                    emit(x, 1, this->toAlpha(winding));
+                }
+            }
+        }
+        if (x < fWidth) {
+            // A closed path's areas sum to zero across a row, but we drop lines right of us.
+            SkAlpha a = this->toAlpha(winding);
+            if (a) {
+                emit(x, fWidth - x, a);
+            }
+        }
+
+        for (const Span& span : fSpans) {
+            sk_bzero(fAcc.get() + span.fLo, (span.fHi - span.fLo + 1) * sizeof(float));
+        }
+        fSpans.reset();
+    }
+
+private:
+    // The cells [fLo, fHi] touched by pieces of lines.
+    struct Span {
+        int fLo, fHi;
+        bool operator<(const Span& that) const { return fLo < that.fLo; }
+    };
+
+    SkAlpha toAlpha(float winding) const {
+        SkAlpha a = winding_to_alpha(winding, fEvenOdd);
+        return fInverse ? 255 - a : a;
+    }
+
+    void accumulateInside(float x0, float x1, float d) {
+        float* acc = fAcc.get();
+        float lo = SkTMin(x0, x1),
+              hi = SkTMax(x0, x1);
+        // lo and hi are >= 0, so truncating is floor(), and we can ceil() without calling out.
+        int loI = (int)lo,
+            hiI = (int)hi;
+        hiI += (hiI < hi);
+
+        if (hiI <= loI + 1) {
+            // The piece stays in one pixel column: the area to its right there is a trapezoid.
+            float mid = 0.5f*(x0 + x1) - loI;
+            acc[loI    ] += d - d*mid;
+            acc[loI + 1] += d*mid;
+            hiI = loI + 1;
+        } else {
+            // The piece crosses several columns.  The area to its right in the first is a
+            // triangle, each middle column gets an equal slice, and the last is 1 - the rest.
+            float s     = 1 / (hi - lo),
+                  loF   = lo - loI,
+                  first = 0.5f*s*(1 - loF)*(1 - loF),
+                  hiF   = hi - hiI + 1,
+                  last  = 0.5f*s*hiF*hiF;
+
+            acc[loI] += d*first;
+            if (hiI == loI + 2) {
+                acc[loI + 1] += d*(1 - first - last);
+            } else {
+                float next = s*(1.5f - loF);
+                acc[loI + 1] += d*(next - first);
+                for (int x = loI + 2; x < hiI - 1; x++) {
+                    acc[x] += d*s;
+                }
+                float rest = next + (hiI - loI - 3)*s;
+                acc[hiI - 1] += d*(1 - rest - last);
+            }
+            acc[hiI] += d*last;
+        }
+
+        // Both halves of a split piece, and consecutive lines of a flattened curve, tend to
+        // touch cells next to the last piece's, so merge with the last span when we can.
+        if (!fSpans.empty() && loI <= fSpans.back().fHi + 1 && hiI >= fSpans.back().fLo - 1) {
+            Span& last = fSpans.back();
+            last.fLo = SkTMin(last.fLo, loI);
+            last.fHi = SkTMax(last.fHi, hiI);
+        } else {
+            fSpans.push_back({ loI, hiI });
+        }
+    }
+
+    int                           fWidth;
+    bool                          fEvenOdd, fInverse;
+    SkAutoSTMalloc<1024, float>   fAcc;
+    SkSTArray<16, Span, true>     fSpans;
+};
+
+// Packs the runs RowAccumulator::flush() emits into the arrays blitAntiH() wants,
+// merging neighbors with the same alpha.  runs and alpha are indexed by x.
+class RunBuilder {
+public:
+    RunBuilder(int16_t runs[], SkAlpha alpha[]) : fRuns(runs), fAlpha(alpha) {}
+
+    void operator()(int x, int n, SkAlpha a) {
+        if (fStart < 0) {
+            fStart = x;
+        } else if (fAlpha[fLast] == a) {
+            fRuns[fLast] += n;
+            fEnd = x + n;
+            return;
+        }
+        fLast = x;
+        fRuns [x] = n;
+        fAlpha[x] = a;
+        fEnd = x + n;
+    }
+
+    // Terminate the runs, returning the x where they start, or -1 if there are none.
+    int finish() {
+        if (fStart >= 0) {
+            fRuns[fEnd] = 0;
+        }
+        return fStart;
+    }
+
+private:
+    int16_t* fRuns;
+    SkAlpha* fAlpha;
+    int      fStart = -1,
+             fLast  = 0,
+             fEnd   = 0;
+};
+
+}  // namespace
+
+static bool safe_round_out(const SkRect& src, SkIRect* dst) {
+    const SkScalar kMax = SkIntToScalar(SK_MaxS32 >> 1);
+    if (!src.isFinite() || src.fLeft < -kMax || src.fTop < -kMax ||
+                           src.fRight > kMax || src.fBottom > kMax) {
+        return false;
+    }
+    src.roundOut(dst);
+    return true;
+}
+
+void SkScan::AAAFillPath(const SkPath& path, const SkRegion& origClip, SkBlitter* blitter,
+                         bool forceRLE) {
+    if (origClip.isEmpty()) {
+        return;
+    }
+
+    const bool isInverse = path.isInverseFillType();
+    const bool isEvenOdd = path.getFillType() == SkPath::kEvenOdd_FillType ||
+                           path.getFillType() == SkPath::kInverseEvenOdd_FillType;
+    SkIRect ir;
+    if (!safe_round_out(path.getBounds(), &ir)) {
+        return;
+    }
+    if (ir.isEmpty()) {
+        if (isInverse) {
+            blitter->blitRegion(origClip);
+        }
+        return;
+    }
+
+    // Like SkScan::AntiFillPath, keep the clip within what int16_t runs can index.
+    SkRegion tmpClipStorage;
+    const SkRegion* clipRgn = &origClip;
+    {
+        static const int32_t kMaxClipCoord = 32767;
+        const SkIRect& bounds = origClip.getBounds();
+        if (bounds.fRight > kMaxClipCoord || bounds.fBottom > kMaxClipCoord) {
+            SkIRect limit = { 0, 0, kMaxClipCoord, kMaxClipCoord };
+            tmpClipStorage.op(origClip, limit, SkRegion::kIntersect_Op);
+            clipRgn = &tmpClipStorage;
+        }
+    }
+
+    SkScanClipper clipper(blitter, clipRgn, ir, isInverse);
+    if (clipper.getBlitter() == nullptr) { // clipped out
+        if (isInverse) {
+            blitter->blitRegion(*clipRgn);
+        }
+        return;
+    }
+    blitter = clipper.getBlitter();
+
+    // Inverse fills cover the whole clip, not just the path bounds.
+    SkIRect bounds;
+    if (isInverse) {
+        bounds = clipRgn->getBounds();
+        bounds.fTop    = SkTMax(bounds.fTop,    ir.fTop);
+        bounds.fBottom = SkTMin(bounds.fBottom, ir.fBottom);
+        sk_blit_above(blitter, ir, *clipRgn);
+    } else if (!bounds.intersect(ir, clipRgn->getBounds())) {
+        return;
+    }
+
+    if (!bounds.isEmpty()) {
+        const int left  = bounds.fLeft,
+                  width = bounds.width();
+
+        const int top    = bounds.fTop,
+                  height = bounds.height();
+
+        LineBuilder builder(top, bounds.fBottom, bounds.fRight);
+        builder.build(path);
+        const SkTArray<Line, true>& lines = builder.lines();
+
+        // Bucket the lines by the first row they touch (a counting sort), so that
+        // byRow[firstLine[r] ... firstLine[r+1]) are the lines that start in row top+r.
+        SkAutoSTMalloc<256, int>          firstLine(height + 1);
+        SkAutoSTMalloc<64, const Line*>   byRow(lines.count());
+        sk_bzero(firstLine.get(), (height + 1) * sizeof(int));
+        for (const Line& line : lines) {
+            firstLine[SkTMax(0, SkScalarFloorToInt(line.fY0) - top) + 1]++;
+        }
+        for (int r = 0; r < height; r++) {
+            firstLine[r + 1] += firstLine[r];
+        }
+        {
+            SkAutoSTMalloc<256, int> cursor(height);
+            memcpy(cursor.get(), firstLine.get(), height * sizeof(int));
+            for (const Line& line : lines) {
+                byRow[cursor[SkTMax(0, SkScalarFloorToInt(line.fY0) - top)]++] = &line;
+            }
+        }
+
+        // Small paths go into a mask (see MaskSuperBlitter::CanHandleRect()), everything else
+        // out through blitAntiH() one row at a time.
+        const bool useMask = !isInverse && !forceRLE &&
+                             width <= kMaxMaskWidth && width * height <= kMaxMaskStorage;
+        uint8_t maskStorage[kMaxMaskStorage];
+
+        // Like SuperBlitter, cycle through as many rows of runs as our blitter wants to keep.
+        int    rowsPreserved = 0;
+        size_t rowSize       = 0;
+        char*  runsStorage   = nullptr;
+        int    currentRow    = 0;
+        if (useMask) {
+            sk_bzero(maskStorage, width * height);
+        } else {
+            rowsPreserved = blitter->requestRowsPreserved();
+            rowSize       = (width + 1) * (sizeof(int16_t) + sizeof(SkAlpha));
+            runsStorage   = (char*)blitter->allocBlitMemory(rowsPreserved * rowSize);
+        }
+
+        RowAccumulator acc(width, isEvenOdd, isInverse);
+        SkSTArray<32, const Line*, true> active;
+
+        for (int y = top; y < bounds.fBottom; y++) {
+            const float rowTop    = (float)y,
+                        rowBottom = (float)(y + 1);
+
+            // Retire lines that ended above this row, and pick up any that start in it.
+            for (int i = active.count() - 1; i >= 0; i--) {
+                if (active[i]->fY1 <= rowTop) {
+                    active.removeShuffle(i);
+                }
+            }
+            for (int i = firstLine[y - top]; i < firstLine[y - top + 1]; i++) {
+                active.push_back(byRow[i]);
+            }
+
+            for (const Line* line : active) {
+                float y0 = SkTMax(rowTop,    line->fY0),
+                      y1 = SkTMin(rowBottom, line->fY1);
+                if (y0 >= y1) {
+                    continue;
+                }
+                float x0 = line->fX0 + (y0 - line->fY0) * line->fDXDY - left,
+                      x1 = line->fX0 + (y1 - line->fY0) * line->fDXDY - left;
+                acc.accumulate(x0, x1, (y1 - y0) * line->fWinding);
+            }
+
+            if (acc.isEmpty()) {
+                if (isInverse) {
+                    blitter->blitH(left, y, width);
+                }
+                continue;
+            }
+
+            if (useMask) {
+                uint8_t* row = maskStorage + (y - top) * width;
+                acc.flush([row](int x, int n, SkAlpha a) { memset(row + x, a, n); });
+                continue;
+            }
+
+            int16_t* runs  = (int16_t*)(runsStorage + currentRow * rowSize);
+            SkAlpha* alpha = (SkAlpha*)(runs + width + 1);
+            currentRow = (currentRow + 1) % rowsPreserved;
+
+            RunBuilder runBuilder(runs, alpha);
+            acc.flush(runBuilder);
+            int start = runBuilder.finish();
+            if (start >= 0) {
+                blitter->blitAntiH(left + start, y, alpha + start, runs + start);
+            }
+        }
+
+        if (useMask) {
+            SkMask mask;
+            mask.fImage    = maskStorage;
+            mask.fBounds   = bounds;
+            mask.fRowBytes = width;
+            mask.fFormat   = SkMask::kA8_Format;
+            blitter->blitMask(mask, bounds);
+        }
+    }
+
+    if (isInverse) {
+        sk_blit_below(blitter, ir, *clipRgn);
+    }
+}
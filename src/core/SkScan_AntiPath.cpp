@@ -622,12 +622,28 @@ static bool safeRoundOut(const SkRect& src, SkIRect* dst, int32_t maxInt) {
     return false;
 }
 
+// When gSkUseAnalyticAA is on, which paths should use it instead of supersampling?
+// Analytic AA only pulls ahead on small curved paths, where the supersampler spends
+// most of its time stepping curve edges through SCALE sub-scanlines per row.
+static bool prefer_analytic_aa(const SkPath& path) {
+    if (path.isInverseFillType() || !(path.getSegmentMasks() & ~SkPath::kLine_SegmentMask)) {
+        return false;
+    }
+    const SkRect& bounds = path.getBounds();
+    return bounds.width() <= 32 && bounds.width() * bounds.height() <= 1024;
+}
+
 void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
                           SkBlitter* blitter, bool forceRLE) {
     if (origClip.isEmpty()) {
         return;
     }
 
+    if (gSkForceAnalyticAA || (gSkUseAnalyticAA && prefer_analytic_aa(path))) {
+        SkScan::AAAFillPath(path, origClip, blitter, forceRLE);
+        return;
+    }
+
     const bool isInverse = path.isInverseFillType();
     SkIRect ir;
 
@@ -766,3 +782,20 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRasterClip& clip,
         SkScan::AntiFillPath(path, tmp, &aaBlitter, true);
     }
 }
+
+void SkScan::AAAFillPath(const SkPath& path, const SkRasterClip& clip, SkBlitter* blitter) {
+    if (clip.isEmpty()) {
+        return;
+    }
+
+    if (clip.isBW()) {
+        AAAFillPath(path, clip.bwRgn(), blitter);
+    } else {
+        SkRegion        tmp;
+        SkAAClipBlitter aaBlitter;
+
+        tmp.setRect(clip.getBounds());
+        aaBlitter.init(blitter, &clip.aaRgn());
+        SkScan::AAAFillPath(path, tmp, &aaBlitter, true);
+    }
+}
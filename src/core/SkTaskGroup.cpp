@@ -11,6 +11,7 @@
 #include "SkTArray.h"
 #include "SkTDArray.h"
 #include "SkTaskGroup.h"
+#include "SkThreadID.h"
 #include "SkThreadUtils.h"
 
 #if defined(SK_BUILD_FOR_WIN32)
@@ -37,6 +38,78 @@ int sk_num_cores() {
 
 namespace {
 
+// A fixed-capacity Chase-Lev work-stealing deque of T*.
+//
+// Only the owning thread may push() and pop(), working LIFO at the bottom;
+// any thread may steal(), working FIFO from the top.  We use seq_cst for the
+// top/bottom indices rather than hand-placed fences: it's simplest to reason
+// about and costs little next to the std::function call each item makes.
+//
+// See "Dynamic Circular Work-Stealing Deque" (Chase & Lev, SPAA 2005) and
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., PPoPP 2013).
+template <typename T, int kCapacity>
+class WorkDeque : SkNoncopyable {
+public:
+    WorkDeque() : fTop(0), fBottom(0) {}
+
+    // Returns false if the deque is full.  Owner only.
+    bool push(T* item) {
+        int64_t b = fBottom.load(sk_memory_order_relaxed),
+                t = fTop.load(sk_memory_order_acquire);
+        if (b - t >= kCapacity) {
+            return false;
+        }
+        fItems[b & kMask].store(item, sk_memory_order_relaxed);
+        fBottom.store(b + 1, sk_memory_order_seq_cst);  // Publishes item to steal().
+        return true;
+    }
+
+    // Returns nullptr if the deque is empty.  Owner only.
+    T* pop() {
+        int64_t b = fBottom.load(sk_memory_order_relaxed) - 1;
+        fBottom.store(b, sk_memory_order_seq_cst);
+        int64_t t = fTop.load(sk_memory_order_seq_cst);
+        if (t > b) {
+            fBottom.store(b + 1, sk_memory_order_relaxed);  // Was already empty.
+            return nullptr;
+        }
+        T* item = fItems[b & kMask].load(sk_memory_order_relaxed);
+        if (t == b) {
+            // That was the last item, so we race any thieves for it.
+            if (!fTop.compare_exchange(&t, t + 1,
+                                       sk_memory_order_seq_cst, sk_memory_order_relaxed)) {
+                item = nullptr;
+            }
+            fBottom.store(b + 1, sk_memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Returns nullptr if the deque is empty or if we lost a race for its top item,
+    // in which case *lostRace is set to true.  Any thread.
+    T* steal(bool* lostRace) {
+        int64_t t = fTop.load(sk_memory_order_seq_cst),
+                b = fBottom.load(sk_memory_order_seq_cst);
+        if (t >= b) {
+            return nullptr;
+        }
+        T* item = fItems[t & kMask].load(sk_memory_order_relaxed);
+        if (!fTop.compare_exchange(&t, t + 1, sk_memory_order_seq_cst, sk_memory_order_relaxed)) {
+            *lostRace = true;
+            return nullptr;
+        }
+        return item;
+    }
+
+private:
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "WorkDeque capacity must be a power of two.");
+    static const int kMask = kCapacity - 1;
+
+    SkAtomic<int64_t> fTop;
+    SkAtomic<int64_t> fBottom;
+    SkAtomic<T*>      fItems[kCapacity];
+};
+
 class ThreadPool : SkNoncopyable {
 public:
     static void Add(std::function<void(void)> fn, SkAtomic<int32_t>* pending) {
@@ -59,27 +132,21 @@ public:
             SkASSERT(pending->load(sk_memory_order_relaxed) == 0);
             return;
         }
-        // Acquire pairs with decrement release here or in Loop.
+        // If we're a worker thread ourselves (a nested wait()), we look in our own deque first.
+        // It's LIFO, so that's where the work we most recently added, i.e. our group's, lives.
+        const int me = gGlobal->currentWorker();
+
+        // Acquire pairs with decrement release in Run().
         while (pending->load(sk_memory_order_acquire) > 0) {
             // Lend a hand until our SkTaskGroup of interest is done.
-            Work work;
-            {
-                // We're stealing work opportunistically,
-                // so we never call fWorkAvailable.wait(), which could sleep us if there's no work.
-                // This means fWorkAvailable is only an upper bound on fWork.count().
-                AutoLock lock(&gGlobal->fWorkLock);
-                if (gGlobal->fWork.empty()) {
-                    // Someone has picked up all the work (including ours).  How nice of them!
-                    // (They may still be working on it, so we can't assert *pending == 0 here.)
-                    continue;
-                }
-                work = gGlobal->fWork.back();
-                gGlobal->fWork.pop_back();
+            // We're stealing work opportunistically,
+            // so we never call fWorkAvailable.wait(), which could sleep us if there's no work.
+            // This means fWorkAvailable is only an upper bound on the work available.
+            if (Work* work = gGlobal->find(me)) {
+                // This Work isn't necessarily part of our SkTaskGroup of interest, but that's fine.
+                // We threads gotta stick together.  We're always making forward progress.
+                Run(work);
             }
-            // This Work isn't necessarily part of our SkTaskGroup of interest, but that's fine.
-            // We threads gotta stick together.  We're always making forward progress.
-            work.fn();
-            work.pending->fetch_add(-1, sk_memory_order_release);  // Pairs with load above.
         }
     }
 
@@ -96,83 +163,153 @@ private:
         SkAtomic<int32_t>* pending;   // then decrement pending afterwards.
     };
 
-    explicit ThreadPool(int threads) {
+    // Each worker thread owns one of these.
+    struct Worker {
+        ThreadPool*            pool;
+        int                    index;
+        SkAtomic<SkThreadID>   id;
+        WorkDeque<Work, 4096>  deque;
+    };
+
+    explicit ThreadPool(int threads) : fShutdown(false) {
         if (threads == -1) {
             threads = sk_num_cores();
         }
+        fWorkers.reset(threads);
+        for (int i = 0; i < threads; i++) {
+            fWorkers[i].pool  = this;
+            fWorkers[i].index = i;
+            fWorkers[i].id.store(kIllegalThreadID, sk_memory_order_relaxed);
+        }
         for (int i = 0; i < threads; i++) {
-            fThreads.push(new SkThread(&ThreadPool::Loop, this));
+            fThreads.push(new SkThread(&ThreadPool::Loop, &fWorkers[i]));
             fThreads.top()->start();
         }
     }
 
     ~ThreadPool() {
-        SkASSERT(fWork.empty());  // All SkTaskGroups should be destroyed by now.
+        // All SkTaskGroups should be destroyed by now, so there should be no work left.
+        SkASSERT(fShared.empty());
 
-        // Send a poison pill to each thread.
-        SkAtomic<int> dummy(0);
-        for (int i = 0; i < fThreads.count(); i++) {
-            this->add(nullptr, &dummy);
-        }
-        // Wait for them all to swallow the pill and die.
+        // Wake each thread to find no work and the pool shutting down.
+        fShutdown.store(true, sk_memory_order_release);
+        fWorkAvailable.signal(fThreads.count());
+        // Wait for them all to notice and die.
         for (int i = 0; i < fThreads.count(); i++) {
             fThreads[i]->join();
         }
-        SkASSERT(fWork.empty());  // Can't hurt to double check.
+        SkASSERT(fShared.empty());  // Can't hurt to double check.
         fThreads.deleteAll();
     }
 
+    // Returns the index of the calling thread in fWorkers, or -1 if it's not one of our workers.
+    int currentWorker() const {
+        const SkThreadID id = SkGetThreadID();
+        for (int i = 0; i < fThreads.count(); i++) {
+            if (fWorkers[i].id.load(sk_memory_order_relaxed) == id) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Worker threads push onto their own deques, where they can pop without contention.
+    // Everyone else (and any worker whose deque is full) shares fShared.
+    void push(Work* work, int me) {
+        if (me < 0 || !fWorkers[me].deque.push(work)) {
+            AutoLock lock(&fSharedLock);
+            fShared.push_back(work);
+        }
+    }
+
     void add(std::function<void(void)> fn, SkAtomic<int32_t>* pending) {
-        Work work = { fn, pending };
         pending->fetch_add(+1, sk_memory_order_relaxed);  // No barrier needed.
-        {
-            AutoLock lock(&fWorkLock);
-            fWork.push_back(work);
-        }
+        this->push(new Work{ fn, pending }, this->currentWorker());
         fWorkAvailable.signal(1);
     }
 
     void batch(int N, std::function<void(int)> fn, SkAtomic<int32_t>* pending) {
         pending->fetch_add(+N, sk_memory_order_relaxed);  // No barrier needed.
-        {
-            AutoLock lock(&fWorkLock);
+        const int me = this->currentWorker();
+        if (me < 0) {
+            // Take the shared lock just once for the whole batch.
+            AutoLock lock(&fSharedLock);
+            for (int i = 0; i < N; i++) {
+                fShared.push_back(new Work{ [i, fn]() { fn(i); }, pending });
+            }
+        } else {
             for (int i = 0; i < N; i++) {
-                Work work = { [i, fn]() { fn(i); }, pending };
-                fWork.push_back(work);
+                this->push(new Work{ [i, fn]() { fn(i); }, pending }, me);
             }
         }
         fWorkAvailable.signal(N);
     }
 
-    static void Loop(void* arg) {
-        ThreadPool* pool = (ThreadPool*)arg;
-        Work work;
-        while (true) {
-            // Sleep until there's work available, and claim one unit of Work as we wake.
-            pool->fWorkAvailable.wait();
-            {
-                AutoLock lock(&pool->fWorkLock);
-                if (pool->fWork.empty()) {
-                    // Someone in Wait() stole our work (fWorkAvailable is an upper bound).
-                    // Well, that's fine, back to sleep for us.
+    // Find one unit of Work: first from our own deque, then the shared queue,
+    // then by stealing from the other workers.  Returns nullptr if there's none anywhere.
+    Work* find(int me) {
+        if (me >= 0) {
+            if (Work* work = fWorkers[me].deque.pop()) {
+                return work;
+            }
+        }
+        {
+            AutoLock lock(&fSharedLock);
+            if (!fShared.empty()) {
+                Work* work = fShared.back();
+                fShared.pop_back();
+                return work;
+            }
+        }
+        // Keep trying as long as we lose races: losing means some deque was non-empty.
+        const int count = fThreads.count();
+        bool lostRace;
+        do {
+            lostRace = false;
+            for (int i = 1; i <= count; i++) {
+                // Start with our neighbor so thieves spread out across victims.
+                int victim = (SkTMax(me, 0) + i) % count;
+                if (victim == me) {
                     continue;
                 }
-                work = pool->fWork.back();
-                pool->fWork.pop_back();
+                if (Work* work = fWorkers[victim].deque.steal(&lostRace)) {
+                    return work;
+                }
             }
-            if (!work.fn) {
-                return;  // Poison pill.  Time... to die.
+        } while (lostRace);
+        return nullptr;
+    }
+
+    static void Run(Work* work) {
+        work->fn();
+        work->pending->fetch_add(-1, sk_memory_order_release);  // Pairs with load in Wait().
+        delete work;
+    }
+
+    static void Loop(void* arg) {
+        Worker* worker = (Worker*)arg;
+        ThreadPool* pool = worker->pool;
+        worker->id.store(SkGetThreadID(), sk_memory_order_relaxed);
+        while (true) {
+            // Sleep until there's work available, and try to claim one unit of Work as we wake.
+            pool->fWorkAvailable.wait();
+            if (Work* work = pool->find(worker->index)) {
+                Run(work);
+            } else if (pool->fShutdown.load(sk_memory_order_acquire)) {
+                return;  // Time... to die.
             }
-            work.fn();
-            work.pending->fetch_add(-1, sk_memory_order_release);  // Pairs with load in Wait().
+            // Otherwise someone in Wait() stole our work (fWorkAvailable is an upper bound).
+            // Well, that's fine, back to sleep for us.
         }
     }
 
-    // fWorkLock must be held when reading or modifying fWork.
-    SkSpinlock      fWorkLock;
-    SkTArray<Work>  fWork;
+    SkAutoTArray<Worker> fWorkers;
 
-    // A thread-safe upper bound for fWork.count().
+    // fSharedLock must be held when reading or modifying fShared.
+    SkSpinlock      fSharedLock;
+    SkTArray<Work*> fShared;
+
+    // A thread-safe upper bound for the number of Work in fShared and all the deques.
     //
     // We'd have it be an exact count but for the loop in Wait():
     // we never want that to block, so it can't call fWorkAvailable.wait(),
@@ -181,6 +318,8 @@ private:
     // We make do, but this means some worker threads may wake spuriously.
     SkSemaphore fWorkAvailable;
 
+    SkAtomic<bool> fShutdown;
+
     // These are only changed in a single-threaded context.
     SkTDArray<SkThread*> fThreads;
     static ThreadPool* gGlobal;
@@ -207,3 +346,23 @@ void SkTaskGroup::add(std::function<void(void)> fn) { ThreadPool::Add(fn, &fPend
 void SkTaskGroup::batch(int N, std::function<void(int)> fn) {
     ThreadPool::Batch(N, fn, &fPending);
 }
+
+void sk_parallel_for(int N, int grain, std::function<void(int)> fn) {
+    if (N <= 0) {
+        return;
+    }
+    if (grain <= 0) {
+        // Aim for a few chunks per core, so stealing can even out uneven chunks.
+        grain = SkTMax(1, N / (4 * sk_num_cores()));
+    }
+    const int chunks = (N - 1) / grain + 1;
+    if (chunks == 1) {
+        for (int i = 0; i < N; i++) { fn(i); }
+        return;
+    }
+    SkTaskGroup().batch(chunks, [&](int chunk) {
+        const int start = chunk * grain,
+                  stop  = SkTMin(start + grain, N);
+        for (int i = start; i < stop; i++) { fn(i); }
+    });
+}
@@ -42,4 +42,9 @@ private:
 // Returns best estimate of number of CPU cores available to use.
 int sk_num_cores();
 
+// Call fn(i) for i in [0, N), running chunks of grain consecutive indices as tasks
+// of a temporary SkTaskGroup, and return once they're all done.
+// A grain <= 0 picks one that gives each core a few chunks.
+void sk_parallel_for(int N, int grain, std::function<void(int)> fn);
+
 #endif//SkTaskGroup_DEFINED
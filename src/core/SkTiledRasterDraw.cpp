@@ -0,0 +1,67 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCanvas.h"
+#include "SkPicture.h"
+#include "SkTaskGroup.h"
+#include "SkTiledRasterDraw.h"
+#include "SkTime.h"
+
+SkTiledRasterDraw::SkTiledRasterDraw(const SkBitmap& dst, int tileWidth, int tileHeight)
+    : fDst(dst) {
+    SkASSERT(!dst.drawsNothing());
+    fTileWidth  = SkTPin(tileWidth,  1, SkTMax(1, dst.width()));
+    fTileHeight = SkTPin(tileHeight, 1, SkTMax(1, dst.height()));
+    fTilesX = (dst.width()  + fTileWidth  - 1) / fTileWidth;
+    fTilesY = (dst.height() + fTileHeight - 1) / fTileHeight;
+}
+
+SkTiledRasterDraw::~SkTiledRasterDraw() { this->reset(); }
+
+SkCanvas* SkTiledRasterDraw::getRecordingCanvas() {
+    if (SkCanvas* canvas = fRecorder.getRecordingCanvas()) {
+        return canvas;
+    }
+    return fRecorder.beginRecording(SkRect::MakeIWH(fDst.width(), fDst.height()), &fFactory);
+}
+
+void SkTiledRasterDraw::reset() {
+    if (fRecorder.getRecordingCanvas()) {
+        (void)fRecorder.finishRecordingAsPicture();
+    }
+}
+
+SkIRect SkTiledRasterDraw::tileBounds(int i) const {
+    SkASSERT(i >= 0 && i < this->tileCount());
+    const int x = (i % fTilesX) * fTileWidth,
+              y = (i / fTilesX) * fTileHeight;
+    return SkIRect::MakeXYWH(x, y, SkTMin(fTileWidth,  fDst.width()  - x),
+                                   SkTMin(fTileHeight, fDst.height() - y));
+}
+
+void SkTiledRasterDraw::draw() {
+    if (!fRecorder.getRecordingCanvas()) {
+        return;
+    }
+    sk_sp<SkPicture> picture = fRecorder.finishRecordingAsPicture();
+
+    fTileTimesMS.setCount(this->tileCount());
+    sk_bzero(fTileTimesMS.begin(), fTileTimesMS.bytes());
+
+    // Each tile gets its own canvas over the shared pixels.  We clip rather than translate so
+    // every tile sees exactly the CTM the serial path would, keeping the output bit-identical.
+    // The picture's R-tree culls each tile's playback down to the ops that touch its clip.
+    SkTaskGroup().batch(this->tileCount(), [&](int i) {
+        const double start = SkTime::GetMSecs();
+
+        SkCanvas canvas(fDst);
+        canvas.clipRect(SkRect::Make(this->tileBounds(i)));
+        picture->playback(&canvas);
+
+        fTileTimesMS[i] = SkTime::GetMSecs() - start;
+    });
+}
@@ -9,6 +9,7 @@
 
 #include "SkAutoPixmapStorage.h"
 #include "SkColorPriv.h"
+#include "SkGaussianIIR.h"
 #include "SkGpuBlurUtils.h"
 #include "SkOpts.h"
 #include "SkReadBuffer.h"
@@ -208,7 +209,12 @@ sk_sp<SkSpecialImage> SkBlurImageFilter::onFilterImage(SkSpecialImage* source,
      * In this way, two of the y-blurs become x-blurs applied to transposed
      * images, and all memory reads are contiguous.
      */
-    if (kernelSizeX > 0 && kernelSizeY > 0) {
+    if (kernelSizeX > 0 && kernelSizeY > 0 &&
+        SkTMax(sigma.x(), sigma.y()) >= SkGaussianIIR::kMinSigmaN32) {
+        // Past this, a true Gaussian is cheaper than the box blurs approximating it.
+        SkGaussianIIR::BlurN32(s, inputBM.rowBytes(), inputBounds, d, t, w, h,
+                               sigma.x(), sigma.y());
+    } else if (kernelSizeX > 0 && kernelSizeY > 0) {
         SkOpts::box_blur_xx(s, sw,  inputBounds,  t, kernelSizeX,  lowOffsetX,  highOffsetX, w, h);
         SkOpts::box_blur_xx(t,  w,  dstBounds,    d, kernelSizeX,  highOffsetX, lowOffsetX,  w, h);
         SkOpts::box_blur_xy(d,  w,  dstBounds,    t, kernelSizeX3, highOffsetX, highOffsetX, w, h);
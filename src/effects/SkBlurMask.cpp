@@ -7,6 +7,7 @@
 
 
 #include "SkBlurMask.h"
+#include "SkGaussianIIR.h"
 #include "SkMath.h"
 #include "SkTemplates.h"
 #include "SkEndian.h"
@@ -548,7 +549,12 @@ bool SkBlurMask::BoxBlur(SkMask* dst, const SkMask& src,
         uint8_t*                tp = tmpBuffer.get();
         int w = sw, h = sh;
 
-        if (outerWeight == 255) {
+        if (kHigh_SkBlurQuality == quality && sigma >= SkGaussianIIR::kMinSigmaA8) {
+            // Past this, a true Gaussian is cheaper than the box blurs approximating it.
+            SkGaussianIIR::BlurA8(sp, src.fRowBytes, SkIRect::MakeXYWH(padx, pady, sw, sh),
+                                  dp, tp, dst->fBounds.width(), dst->fBounds.height(),
+                                  sigma, sigma);
+        } else if (outerWeight == 255) {
             int loRadius, hiRadius;
             get_adjusted_radii(passRadius, &loRadius, &hiRadius);
             if (kHigh_SkBlurQuality == quality) {
@@ -0,0 +1,283 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkGaussianIIR.h"
+
+#include "SkColorPriv.h"
+#include "SkNx.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
+
+#include <complex>
+
+// Four lanes of A8 rows step together where N32 steps one pixel, so A8 wins much sooner.
+const float SkGaussianIIR::kMinSigmaN32 = 48;
+const float SkGaussianIIR::kMinSigmaA8  = 8;
+
+namespace {
+
+// The causal half of the filter: a real pole p0, then a complex pair p, p* run as one complex
+// recursion s = t + p*s whose output is Re(A*s).  Written as a third-order difference equation,
+// the same filter loses all precision in float once sigma is much past 40.  The anti-causal half
+// is the same recursion run backwards, starting from the state the causal recursion ends a row in
+// mapped through fM, as if both had run on across the transparent pixels past its end.
+struct Coeffs {
+    float fP0, fA0;     // t = fA0*x + fP0*t
+    float fPr, fPi;     // s = t + p*s
+    float fAr, fAi;     // y = fAr*Re(s) - fAi*Im(s)
+    float fM[3][3];     // (t, Re(s), Im(s)) anti-causal = fM * (t, Re(s), Im(s)) causal
+};
+
+// The coefficients splatted to Values.
+template <typename Value>
+struct ValueCoeffs {
+    Value fP0, fA0, fPr, fPi, fAr, fAi;
+    Value fM[3][3];
+
+    explicit ValueCoeffs(const Coeffs& k)
+        : fP0(k.fP0), fA0(k.fA0), fPr(k.fPr), fPi(k.fPi), fAr(k.fAr), fAi(k.fAi) {
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                fM[i][j] = Value(k.fM[i][j]);
+            }
+        }
+    }
+};
+
+template <typename Value>
+struct Recursion {
+    Value fT, fSr, fSi;
+
+    Recursion() : fT(0), fSr(0), fSi(0) {}
+
+    // Runs one step of the recursion on x, updating its state and returning its output.
+    Value step(const Value& x, const ValueCoeffs<Value>& k) {
+        fT = k.fA0 * x + k.fP0 * fT;
+        const Value sr = k.fPr * fSr - k.fPi * fSi + fT;
+        fSi = k.fPr * fSi + k.fPi * fSr;
+        fSr = sr;
+        return k.fAr * fSr - k.fAi * fSi;
+    }
+
+    // The anti-causal recursion's state at the end of a row where the causal one ended as c.
+    static Recursion Reverse(const Recursion& c, const ValueCoeffs<Value>& k) {
+        Recursion a;
+        a.fT  = k.fM[0][0] * c.fT + k.fM[0][1] * c.fSr + k.fM[0][2] * c.fSi;
+        a.fSr = k.fM[1][0] * c.fT + k.fM[1][1] * c.fSr + k.fM[1][2] * c.fSi;
+        a.fSi = k.fM[2][0] * c.fT + k.fM[2][1] * c.fSr + k.fM[2][2] * c.fSi;
+        return a;
+    }
+};
+
+Coeffs make_coeffs(float sigma) {
+    Coeffs k;
+    memset(&k, 0, sizeof(k));
+    if (sigma < 0.5f) {
+        // Too narrow to blur anything; the recursion leaves its input alone.
+        k.fA0 = k.fAr = 1;
+        return k;
+    }
+    // The poles of van Vliet, Young and Verbeek, "Recursive Gaussian derivative filters" (1998),
+    // fit for sigma 2.  Raising them to 1/q scales the filter; find the q whose variance is sigma^2.
+    typedef std::complex<double> Complex;
+    const Complex d1(1.41650, 1.00829);
+    const double  d3 = 1.86543;
+    auto variance = [&](double q) {
+        const Complex p  = std::pow(d1, -1 / q);
+        const double  p0 = std::pow(d3, -1 / q);
+        return 2 * p0 / ((1 - p0) * (1 - p0)) + 4 * std::real(p / ((1.0 - p) * (1.0 - p)));
+    };
+    double lo = 0, hi = 2 * sigma + 2;
+    for (int i = 0; i < 50; i++) {
+        const double q = (lo + hi) / 2;
+        if (variance(q) < (double)sigma * sigma) {
+            lo = q;
+        } else {
+            hi = q;
+        }
+    }
+    const double  q  = (lo + hi) / 2;
+    const Complex p  = std::pow(d1, -1 / q);
+    const double  p0 = std::pow(d3, -1 / q);
+    // Residue of the pair so that 2*Re(A/(1 - p/z)) == (1 - p)(1 - p*)/((1 - p/z)(1 - p*/z)).
+    const Complex A = 2.0 * (1.0 - p) * (1.0 - std::conj(p)) / (1.0 - std::conj(p) / p);
+    k.fP0 = (float)p0;
+    k.fA0 = (float)(1 - p0);
+    k.fPr = (float)p.real();
+    k.fPi = (float)p.imag();
+    k.fAr = (float)A.real();
+    k.fAi = (float)A.imag();
+
+    // Find fM by running each component of the causal state out over transparent pixels, until
+    // it has decayed to nothing, and the anti-causal recursion back over what that produced.
+    const ValueCoeffs<double> kd(k);
+    const int n = SkScalarCeilToInt(16 * sigma) + 16;
+    SkAutoTMalloc<double> tail(n);
+    for (int j = 0; j < 3; j++) {
+        Recursion<double> c;
+        c.fT  = j == 0;
+        c.fSr = j == 1;
+        c.fSi = j == 2;
+        for (int x = 0; x < n; x++) {
+            tail[x] = c.step(0, kd);
+        }
+        Recursion<double> a;
+        for (int x = n - 1; x >= 0; x--) {
+            a.step(tail[x], kd);
+        }
+        k.fM[0][j] = (float)a.fT;
+        k.fM[1][j] = (float)a.fSr;
+        k.fM[2][j] = (float)a.fSi;
+    }
+    return k;
+}
+
+// Premultiplied 8888 pixels filter all four channels of one row at once.
+struct N32 {
+    typedef SkPMColor Pixel;
+    typedef Sk4f      Value;
+    static const int kLanes  = 1;   // Rows per Value.
+    static const int kValues = 8;   // Values per group of rows: 32 bytes of output per column.
+
+    static Value Load(const SkPMColor* s, size_t, int) {
+        return SkNx_cast<float>(Sk4b::Load(s));
+    }
+    static void Store(const Value& v, SkPMColor* d, int) {
+        Sk4f c = Sk4f::Min(Sk4f::Max(v, 0.0f), 255.0f);
+        // Keep the color channels from rounding above alpha.
+        c = Sk4f::Min(c, c[SK_A32_SHIFT / 8]);
+        SkNx_cast<uint8_t>(c + 0.5f).store(d);
+    }
+};
+
+// A8 pixels filter four rows at once.
+struct A8 {
+    typedef uint8_t Pixel;
+    typedef Sk4f    Value;
+    static const int kLanes  = 4;
+    static const int kValues = 4;
+
+    static Value Load(const uint8_t* s, size_t stride, int lanes) {
+        if (lanes == 4) {
+            return Sk4f(s[0], s[stride], s[2 * stride], s[3 * stride]);
+        }
+        float v[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < lanes; i++) {
+            v[i] = s[i * stride];
+        }
+        return Sk4f::Load(v);
+    }
+    static void Store(const Value& v, uint8_t* d, int lanes) {
+        const Sk4b a = SkNx_cast<uint8_t>(Sk4f::Min(Sk4f::Max(v, 0.0f), 255.0f) + 0.5f);
+        if (lanes == 4) {
+            a.store(d);
+        } else {
+            uint8_t bytes[4];
+            a.store(bytes);
+            memcpy(d, bytes, lanes);
+        }
+    }
+};
+
+/**
+ *  Blur `rows` rows along their length.  Row r reads src + r * srcStride, which holds pixels
+ *  [srcLeft, srcLeft + srcWidth) of a row `width` long that is otherwise transparent.  The result
+ *  for pixel x of row r is written transposed, to dst[x * dstStride + r].
+ */
+template <typename P>
+void blur_rows(const typename P::Pixel* src, size_t srcStride, int srcLeft, int srcWidth,
+               typename P::Pixel* dst, size_t dstStride, int rows, int width, const Coeffs& k) {
+    typedef typename P::Value Value;
+    const int kLanes  = P::kLanes,
+              kValues = P::kValues,
+              kGroup  = kLanes * kValues;
+    const ValueCoeffs<Value> kv(k);
+    const int srcRight = srcLeft + srcWidth;
+
+    const int groups = (rows + kGroup - 1) / kGroup;
+    sk_parallel_for(groups, 0, [&](int group) {
+        const int r0 = group * kGroup,
+                  n  = SkTMin(kGroup, rows - r0),
+                  m  = (n + kLanes - 1) / kLanes;
+        int lanes[kValues];
+        for (int v = 0; v < m; v++) {
+            lanes[v] = SkTMin(kLanes, n - v * kLanes);
+        }
+
+        // Both passes step all the rows of the group together, so that each has several
+        // independent recursions in flight, and so each column of output is written contiguously.
+        // This holds the causal pass's results from srcLeft on, column by column.
+        SkAutoTMalloc<Value> storage(kValues * (width - srcLeft));
+        Value* causal = storage.get() - srcLeft * kValues;
+
+        Recursion<Value> recs[kValues];
+        const typename P::Pixel* s = src + r0 * srcStride - srcLeft;
+        for (int x = srcLeft; x < srcRight; x++) {
+            for (int v = 0; v < m; v++) {
+                const Value in = P::Load(s + v * kLanes * srcStride + x, srcStride, lanes[v]);
+                causal[x * kValues + v] = recs[v].step(in, kv);
+            }
+        }
+        for (int x = srcRight; x < width; x++) {
+            for (int v = 0; v < m; v++) {
+                causal[x * kValues + v] = recs[v].step(Value(0), kv);
+            }
+        }
+
+        for (int v = 0; v < m; v++) {
+            recs[v] = Recursion<Value>::Reverse(recs[v], kv);
+        }
+        for (int x = width - 1; x >= srcLeft; x--) {
+            typename P::Pixel* d = dst + x * dstStride + r0;
+            for (int v = 0; v < m; v++) {
+                P::Store(recs[v].step(causal[x * kValues + v], kv), d + v * kLanes, lanes[v]);
+            }
+        }
+        // Left of srcLeft the causal pass is all zero.
+        for (int x = srcLeft - 1; x >= 0; x--) {
+            typename P::Pixel* d = dst + x * dstStride + r0;
+            for (int v = 0; v < m; v++) {
+                P::Store(recs[v].step(Value(0), kv), d + v * kLanes, lanes[v]);
+            }
+        }
+    });
+}
+
+template <typename P>
+void blur(const typename P::Pixel* src, size_t srcStride, const SkIRect& srcBounds,
+          typename P::Pixel* dst, typename P::Pixel* tmp, int width, int height,
+          float sigmaX, float sigmaY) {
+    SkASSERT(SkIRect::MakeWH(width, height).contains(srcBounds));
+    if (srcBounds.isEmpty()) {
+        sk_bzero(dst, width * height * sizeof(typename P::Pixel));
+        return;
+    }
+
+    // Blur the rows of src into the columns of tmp.  The rows of dst that src doesn't cover are
+    // transparent, so only the columns of tmp under src are written, and read back.
+    blur_rows<P>(src, srcStride, srcBounds.left(), srcBounds.width(),
+                 tmp + srcBounds.top(), height, srcBounds.height(), width, make_coeffs(sigmaX));
+    // Then blur the rows of tmp back into the columns of dst.
+    blur_rows<P>(tmp + srcBounds.top(), height, srcBounds.top(), srcBounds.height(),
+                 dst, width, width, height, make_coeffs(sigmaY));
+}
+
+}  // namespace
+
+void SkGaussianIIR::BlurN32(const SkPMColor* src, size_t srcRowBytes, const SkIRect& srcBounds,
+                            SkPMColor* dst, SkPMColor* tmp, int width, int height,
+                            float sigmaX, float sigmaY) {
+    SkASSERT(0 == srcRowBytes % sizeof(SkPMColor));
+    blur<N32>(src, srcRowBytes / sizeof(SkPMColor), srcBounds, dst, tmp, width, height,
+              sigmaX, sigmaY);
+}
+
+void SkGaussianIIR::BlurA8(const uint8_t* src, size_t srcRowBytes, const SkIRect& srcBounds,
+                           uint8_t* dst, uint8_t* tmp, int width, int height,
+                           float sigmaX, float sigmaY) {
+    blur<A8>(src, srcRowBytes, srcBounds, dst, tmp, width, height, sigmaX, sigmaY);
+}
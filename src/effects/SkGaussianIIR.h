@@ -0,0 +1,44 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGaussianIIR_DEFINED
+#define SkGaussianIIR_DEFINED
+
+#include "SkColor.h"
+#include "SkRect.h"
+
+/**
+ *  Gaussian blurs computed with a recursive (IIR) filter, after Young and van Vliet, "Recursive
+ *  implementation of the Gaussian filter" (1995).  Each axis is a causal and an anti-causal
+ *  third-order recursion, so the cost per pixel does not depend on sigma, and unlike the three
+ *  box blurs we otherwise use, the kernel is a close fit to a true Gaussian.
+ *
+ *  Both axes read rows and write their result transposed, so all reads are contiguous.  Rows are
+ *  blurred in groups on SkTaskGroup's threads.
+ */
+class SkGaussianIIR {
+public:
+    // Blurs with a sigma at least this large are cheaper here than as three box blurs.
+    static const float kMinSigmaN32;
+    static const float kMinSigmaA8;
+
+    /**
+     *  Blur the pixels of src into dst, which is width x height.  src covers srcBounds of dst
+     *  (which it must fit inside), and everything outside it is transparent.  srcRowBytes is
+     *  src's stride; dst and tmp, which must also hold width x height pixels, are tightly packed.
+     */
+    static void BlurN32(const SkPMColor* src, size_t srcRowBytes, const SkIRect& srcBounds,
+                        SkPMColor* dst, SkPMColor* tmp, int width, int height,
+                        float sigmaX, float sigmaY);
+
+    // The same, for A8 masks.
+    static void BlurA8(const uint8_t* src, size_t srcRowBytes, const SkIRect& srcBounds,
+                       uint8_t* dst, uint8_t* tmp, int width, int height,
+                       float sigmaX, float sigmaY);
+};
+
+#endif
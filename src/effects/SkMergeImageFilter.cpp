@@ -87,9 +87,8 @@ sk_sp<SkSpecialImage> SkMergeImageFilter::onFilterImage(SkSpecialImage* source,
     SkAutoTDeleteArray<SkIPoint> offsets(new SkIPoint[inputCount]);
 
     // Filter all of the inputs.
+    this->filterInputs(source, ctx, inputs.get(), offsets.get());
     for (int i = 0; i < inputCount; ++i) {
-        offsets[i].setZero();
-        inputs[i] = this->filterInput(i, source, ctx, &offsets[i]);
         if (!inputs[i]) {
             continue;
         }
@@ -85,11 +85,13 @@ SkIRect SkOffsetImageFilter::onFilterNodeBounds(const SkIRect& src, const SkMatr
                                                 MapDirection direction) const {
     SkVector vec;
     ctm.mapVectors(&vec, &fOffset, 1);
+    // Round the same way onFilterImage() does, so a half-pixel offset maps exactly.
+    SkIPoint offset = SkIPoint::Make(SkScalarRoundToInt(vec.fX), SkScalarRoundToInt(vec.fY));
     if (kReverse_MapDirection == direction) {
-        vec.negate();
+        offset.negate();
     }
 
-    return src.makeOffset(SkScalarCeilToInt(vec.fX), SkScalarCeilToInt(vec.fY));
+    return src.makeOffset(offset.x(), offset.y());
 }
 
 sk_sp<SkFlattenable> SkOffsetImageFilter::CreateProc(SkReadBuffer& buffer) {
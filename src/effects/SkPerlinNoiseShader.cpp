@@ -7,6 +7,7 @@
 
 #include "SkPerlinNoiseShader.h"
 #include "SkColorFilter.h"
+#include "SkNx.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkShader.h"
@@ -105,7 +106,10 @@ struct SkPerlinNoiseShader::PaintingData {
     int         fSeed;
     uint8_t     fLatticeSelector[kBlockSize];
     uint16_t    fNoise[4][kBlockSize][2];
-    SkPoint     fGradient[4][kBlockSize];
+    // The gradients at each lattice point, each holding all four channels' x (or y) components,
+    // so that one Sk4f load fetches what all four channels need.
+    float       fGradientX[kBlockSize][4];
+    float       fGradientY[kBlockSize][4];
     SkISize     fTileSize;
     SkVector    fBaseFrequency;
     StitchData  fStitchDataInit;
@@ -186,17 +190,19 @@ private:
         // Compute gradients from permutated noise data
         for (int channel = 0; channel < 4; ++channel) {
             for (int i = 0; i < kBlockSize; ++i) {
-                fGradient[channel][i] = SkPoint::Make(
+                SkPoint gradient = SkPoint::Make(
                     SkScalarMul(SkIntToScalar(fNoise[channel][i][0] - kBlockSize),
                                 gInvBlockSizef),
                     SkScalarMul(SkIntToScalar(fNoise[channel][i][1] - kBlockSize),
                                 gInvBlockSizef));
-                fGradient[channel][i].normalize();
+                gradient.normalize();
+                fGradientX[i][channel] = gradient.fX;
+                fGradientY[i][channel] = gradient.fY;
                 // Put the normalized gradient back into the noise data
                 fNoise[channel][i][0] = SkScalarRoundToInt(SkScalarMul(
-                    fGradient[channel][i].fX + SK_Scalar1, gHalfMax16bits));
+                    gradient.fX + SK_Scalar1, gHalfMax16bits));
                 fNoise[channel][i][1] = SkScalarRoundToInt(SkScalarMul(
-                    fGradient[channel][i].fY + SK_Scalar1, gHalfMax16bits));
+                    gradient.fY + SK_Scalar1, gHalfMax16bits));
             }
         }
     }
@@ -318,122 +324,6 @@ void SkPerlinNoiseShader::flatten(SkWriteBuffer& buffer) const {
     buffer.writeInt(fTileSize.fHeight);
 }
 
-SkScalar SkPerlinNoiseShader::PerlinNoiseShaderContext::noise2D(
-        int channel, const StitchData& stitchData, const SkPoint& noiseVector) const {
-    struct Noise {
-        int noisePositionIntegerValue;
-        int nextNoisePositionIntegerValue;
-        SkScalar noisePositionFractionValue;
-        Noise(SkScalar component)
-        {
-            SkScalar position = component + kPerlinNoise;
-            noisePositionIntegerValue = SkScalarFloorToInt(position);
-            noisePositionFractionValue = position - SkIntToScalar(noisePositionIntegerValue);
-            nextNoisePositionIntegerValue = noisePositionIntegerValue + 1;
-        }
-    };
-    Noise noiseX(noiseVector.x());
-    Noise noiseY(noiseVector.y());
-    SkScalar u, v;
-    const SkPerlinNoiseShader& perlinNoiseShader = static_cast<const SkPerlinNoiseShader&>(fShader);
-    // If stitching, adjust lattice points accordingly.
-    if (perlinNoiseShader.fStitchTiles) {
-        noiseX.noisePositionIntegerValue =
-            checkNoise(noiseX.noisePositionIntegerValue, stitchData.fWrapX, stitchData.fWidth);
-        noiseY.noisePositionIntegerValue =
-            checkNoise(noiseY.noisePositionIntegerValue, stitchData.fWrapY, stitchData.fHeight);
-        noiseX.nextNoisePositionIntegerValue =
-            checkNoise(noiseX.nextNoisePositionIntegerValue, stitchData.fWrapX, stitchData.fWidth);
-        noiseY.nextNoisePositionIntegerValue =
-            checkNoise(noiseY.nextNoisePositionIntegerValue, stitchData.fWrapY, stitchData.fHeight);
-    }
-    noiseX.noisePositionIntegerValue &= kBlockMask;
-    noiseY.noisePositionIntegerValue &= kBlockMask;
-    noiseX.nextNoisePositionIntegerValue &= kBlockMask;
-    noiseY.nextNoisePositionIntegerValue &= kBlockMask;
-    int i =
-        fPaintingData->fLatticeSelector[noiseX.noisePositionIntegerValue];
-    int j =
-        fPaintingData->fLatticeSelector[noiseX.nextNoisePositionIntegerValue];
-    int b00 = (i + noiseY.noisePositionIntegerValue) & kBlockMask;
-    int b10 = (j + noiseY.noisePositionIntegerValue) & kBlockMask;
-    int b01 = (i + noiseY.nextNoisePositionIntegerValue) & kBlockMask;
-    int b11 = (j + noiseY.nextNoisePositionIntegerValue) & kBlockMask;
-    SkScalar sx = smoothCurve(noiseX.noisePositionFractionValue);
-    SkScalar sy = smoothCurve(noiseY.noisePositionFractionValue);
-    // This is taken 1:1 from SVG spec: http://www.w3.org/TR/SVG11/filters.html#feTurbulenceElement
-    SkPoint fractionValue = SkPoint::Make(noiseX.noisePositionFractionValue,
-                                          noiseY.noisePositionFractionValue); // Offset (0,0)
-    u = fPaintingData->fGradient[channel][b00].dot(fractionValue);
-    fractionValue.fX -= SK_Scalar1; // Offset (-1,0)
-    v = fPaintingData->fGradient[channel][b10].dot(fractionValue);
-    SkScalar a = SkScalarInterp(u, v, sx);
-    fractionValue.fY -= SK_Scalar1; // Offset (-1,-1)
-    v = fPaintingData->fGradient[channel][b11].dot(fractionValue);
-    fractionValue.fX = noiseX.noisePositionFractionValue; // Offset (0,-1)
-    u = fPaintingData->fGradient[channel][b01].dot(fractionValue);
-    SkScalar b = SkScalarInterp(u, v, sx);
-    return SkScalarInterp(a, b, sy);
-}
-
-SkScalar SkPerlinNoiseShader::PerlinNoiseShaderContext::calculateTurbulenceValueForPoint(
-        int channel, StitchData& stitchData, const SkPoint& point) const {
-    const SkPerlinNoiseShader& perlinNoiseShader = static_cast<const SkPerlinNoiseShader&>(fShader);
-    if (perlinNoiseShader.fStitchTiles) {
-        // Set up TurbulenceInitial stitch values.
-        stitchData = fPaintingData->fStitchDataInit;
-    }
-    SkScalar turbulenceFunctionResult = 0;
-    SkPoint noiseVector(SkPoint::Make(SkScalarMul(point.x(), fPaintingData->fBaseFrequency.fX),
-                                      SkScalarMul(point.y(), fPaintingData->fBaseFrequency.fY)));
-    SkScalar ratio = SK_Scalar1;
-    for (int octave = 0; octave < perlinNoiseShader.fNumOctaves; ++octave) {
-        SkScalar noise = noise2D(channel, stitchData, noiseVector);
-        SkScalar numer = (perlinNoiseShader.fType == kFractalNoise_Type) ?
-                            noise : SkScalarAbs(noise);
-        turbulenceFunctionResult += numer / ratio;
-        noiseVector.fX *= 2;
-        noiseVector.fY *= 2;
-        ratio *= 2;
-        if (perlinNoiseShader.fStitchTiles) {
-            // Update stitch values
-            stitchData.fWidth  *= 2;
-            stitchData.fWrapX   = stitchData.fWidth + kPerlinNoise;
-            stitchData.fHeight *= 2;
-            stitchData.fWrapY   = stitchData.fHeight + kPerlinNoise;
-        }
-    }
-
-    // The value of turbulenceFunctionResult comes from ((turbulenceFunctionResult) + 1) / 2
-    // by fractalNoise and (turbulenceFunctionResult) by turbulence.
-    if (perlinNoiseShader.fType == kFractalNoise_Type) {
-        turbulenceFunctionResult =
-            SkScalarMul(turbulenceFunctionResult, SK_ScalarHalf) + SK_ScalarHalf;
-    }
-
-    if (channel == 3) { // Scale alpha by paint value
-        turbulenceFunctionResult *= SkIntToScalar(getPaintAlpha()) / 255;
-    }
-
-    // Clamp result
-    return SkScalarPin(turbulenceFunctionResult, 0, SK_Scalar1);
-}
-
-SkPMColor SkPerlinNoiseShader::PerlinNoiseShaderContext::shade(
-        const SkPoint& point, StitchData& stitchData) const {
-    SkPoint newPoint;
-    fMatrix.mapPoints(&newPoint, &point, 1);
-    newPoint.fX = SkScalarRoundToScalar(newPoint.fX);
-    newPoint.fY = SkScalarRoundToScalar(newPoint.fY);
-
-    U8CPU rgba[4];
-    for (int channel = 3; channel >= 0; --channel) {
-        rgba[channel] = SkScalarFloorToInt(255 *
-            calculateTurbulenceValueForPoint(channel, stitchData, newPoint));
-    }
-    return SkPreMultiplyARGB(rgba[3], rgba[0], rgba[1], rgba[2]);
-}
-
 SkShader::Context* SkPerlinNoiseShader::onCreateContext(const ContextRec& rec,
                                                         void* storage) const {
     return new (storage) PerlinNoiseShaderContext(*this, rec);
@@ -463,11 +353,120 @@ SkPerlinNoiseShader::PerlinNoiseShaderContext::~PerlinNoiseShaderContext() { del
 
 void SkPerlinNoiseShader::PerlinNoiseShaderContext::shadeSpan(
         int x, int y, SkPMColor result[], int count) {
-    SkPoint point = SkPoint::Make(SkIntToScalar(x), SkIntToScalar(y));
-    StitchData stitchData;
-    for (int i = 0; i < count; ++i) {
-        result[i] = shade(point, stitchData);
-        point.fX += SK_Scalar1;
+    // This follows the SVG spec, http://www.w3.org/TR/SVG11/filters.html#feTurbulenceElement,
+    // evaluating all four channels of a pixel at once: they share their lattice points, and differ
+    // only in the gradients there.  The octaves run outside the loop over pixels, so everything
+    // that depends only on y and the octave is worked out once per span.
+    const SkPerlinNoiseShader& perlinNoiseShader = static_cast<const SkPerlinNoiseShader&>(fShader);
+    const PaintingData& data = *fPaintingData;
+    const bool fractal = perlinNoiseShader.fType == kFractalNoise_Type;
+    const bool stitch = perlinNoiseShader.fStitchTiles;
+    // Scale alpha by paint value.
+    const Sk4f paintAlpha(1, 1, 1, SkIntToScalar(getPaintAlpha()) / 255);
+
+    // Noise is sampled at whole pixels (fMatrix is a translate).
+    const SkScalar py = SkScalarRoundToScalar(SkIntToScalar(y) + fMatrix.getTranslateY());
+    SkScalar px = SkIntToScalar(x);
+
+    static const int kMaxChunk = 64;
+    SkScalar noiseX[kMaxChunk];
+    Sk4f turbulence[kMaxChunk];
+    while (count > 0) {
+        const int n = SkTMin(count, kMaxChunk);
+        for (int k = 0; k < n; ++k) {
+            noiseX[k] = SkScalarMul(SkScalarRoundToScalar(px + fMatrix.getTranslateX()),
+                                    data.fBaseFrequency.fX);
+            turbulence[k] = 0;
+            px += SK_Scalar1;
+        }
+        SkScalar noiseY = SkScalarMul(py, data.fBaseFrequency.fY);
+        StitchData stitchData = data.fStitchDataInit;
+        SkScalar ratio = SK_Scalar1;
+
+        for (int octave = 0; octave < perlinNoiseShader.fNumOctaves; ++octave) {
+            SkScalar positionY = noiseY + kPerlinNoise;
+            int iy = SkScalarFloorToInt(positionY);
+            const SkScalar fy = positionY - SkIntToScalar(iy),
+                           sy = smoothCurve(fy);
+            int iy1 = iy + 1;
+            // If stitching, adjust lattice points accordingly.
+            if (stitch) {
+                iy  = checkNoise(iy,  stitchData.fWrapY, stitchData.fHeight);
+                iy1 = checkNoise(iy1, stitchData.fWrapY, stitchData.fHeight);
+            }
+            iy  &= kBlockMask;
+            iy1 &= kBlockMask;
+
+            // Neighbouring pixels usually fall in the same lattice cell, so keep its gradients.
+            bool haveCell = false;
+            int cellX = 0;
+            Sk4f g00x(0), g00y(0), g10x(0), g10y(0), g01x(0), g01y(0), g11x(0), g11y(0);
+            for (int k = 0; k < n; ++k) {
+                SkScalar positionX = noiseX[k] + kPerlinNoise;
+                int ix = SkScalarFloorToInt(positionX);
+                const SkScalar fx = positionX - SkIntToScalar(ix);
+                if (!haveCell || ix != cellX) {
+                    haveCell = true;
+                    cellX = ix;
+                    int ix1 = ix + 1;
+                    if (stitch) {
+                        ix  = checkNoise(ix,  stitchData.fWrapX, stitchData.fWidth);
+                        ix1 = checkNoise(ix1, stitchData.fWrapX, stitchData.fWidth);
+                    }
+                    const int i = data.fLatticeSelector[ix  & kBlockMask],
+                              j = data.fLatticeSelector[ix1 & kBlockMask];
+                    const int b00 = (i + iy)  & kBlockMask,
+                              b10 = (j + iy)  & kBlockMask,
+                              b01 = (i + iy1) & kBlockMask,
+                              b11 = (j + iy1) & kBlockMask;
+                    g00x = Sk4f::Load(data.fGradientX[b00]);
+                    g00y = Sk4f::Load(data.fGradientY[b00]);
+                    g10x = Sk4f::Load(data.fGradientX[b10]);
+                    g10y = Sk4f::Load(data.fGradientY[b10]);
+                    g01x = Sk4f::Load(data.fGradientX[b01]);
+                    g01y = Sk4f::Load(data.fGradientY[b01]);
+                    g11x = Sk4f::Load(data.fGradientX[b11]);
+                    g11y = Sk4f::Load(data.fGradientY[b11]);
+                }
+                const SkScalar sx = smoothCurve(fx);
+                // Offsets (0,0), (-1,0), (-1,-1) and (0,-1) from the lattice corners.
+                Sk4f u = g00x * fx + g00y * fy,
+                     v = g10x * (fx - SK_Scalar1) + g10y * fy;
+                const Sk4f a = u + (v - u) * sx;
+                v = g11x * (fx - SK_Scalar1) + g11y * (fy - SK_Scalar1);
+                u = g01x * fx + g01y * (fy - SK_Scalar1);
+                const Sk4f b = u + (v - u) * sx;
+                const Sk4f noise = a + (b - a) * sy;
+                turbulence[k] = turbulence[k] + (fractal ? noise : noise.abs()) / ratio;
+                noiseX[k] *= 2;
+            }
+
+            noiseY *= 2;
+            ratio *= 2;
+            if (stitch) {
+                // Update stitch values
+                stitchData.fWidth  *= 2;
+                stitchData.fWrapX   = stitchData.fWidth + kPerlinNoise;
+                stitchData.fHeight *= 2;
+                stitchData.fWrapY   = stitchData.fHeight + kPerlinNoise;
+            }
+        }
+
+        for (int k = 0; k < n; ++k) {
+            Sk4f t = turbulence[k];
+            // The value of turbulence comes from ((turbulence) + 1) / 2 by fractalNoise and
+            // (turbulence) by turbulence.
+            if (fractal) {
+                t = t * SK_ScalarHalf + SK_ScalarHalf;
+            }
+            t = Sk4f::Min(Sk4f::Max(t * paintAlpha, 0), SK_Scalar1);
+            // t is non-negative, so truncating is flooring.
+            int rgba[4];
+            SkNx_cast<int>(t * 255).store(rgba);
+            result[k] = SkPreMultiplyARGB(rgba[3], rgba[0], rgba[1], rgba[2]);
+        }
+        result += n;
+        count -= n;
     }
 }
 
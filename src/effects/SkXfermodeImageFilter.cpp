@@ -54,11 +54,15 @@ void SkXfermodeImageFilter::flatten(SkWriteBuffer& buffer) const {
 sk_sp<SkSpecialImage> SkXfermodeImageFilter::onFilterImage(SkSpecialImage* source,
                                                            const Context& ctx,
                                                            SkIPoint* offset) const {
-    SkIPoint backgroundOffset = SkIPoint::Make(0, 0);
-    sk_sp<SkSpecialImage> background(this->filterInput(0, source, ctx, &backgroundOffset));
+    sk_sp<SkSpecialImage> inputs[2];
+    SkIPoint offsets[2];
+    this->filterInputs(source, ctx, inputs, offsets);
 
-    SkIPoint foregroundOffset = SkIPoint::Make(0, 0);
-    sk_sp<SkSpecialImage> foreground(this->filterInput(1, source, ctx, &foregroundOffset));
+    sk_sp<SkSpecialImage> background(std::move(inputs[0]));
+    const SkIPoint& backgroundOffset = offsets[0];
+
+    sk_sp<SkSpecialImage> foreground(std::move(inputs[1]));
+    const SkIPoint& foregroundOffset = offsets[1];
 
     SkIRect foregroundBounds = SkIRect::EmptyIRect();
     if (foreground) {
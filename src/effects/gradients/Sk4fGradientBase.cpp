@@ -6,6 +6,7 @@
  */
 
 #include "Sk4fGradientBase.h"
+#include "SkXfermode.h"
 
 #include <functional>
 
@@ -323,13 +324,34 @@ GradientShaderBase4fContext::shadeSpanInternal(int x, int y,
     SkScalar ts[kBufSize];
     TSampler<dstType, tileMode> sampler(*this);
 
+    auto shade1 = [&sampler, &dst](SkScalar t) {
+        // Points a gradient doesn't cover (e.g. outside a two point conical's cone) map to NaN.
+        // No interval holds a non-finite t, so those are left transparent too.
+        const Sk4f c = SkScalarIsFinite(t) ? sampler.sample(t) : Sk4f(0);
+        DstTraits<dstType, premul>::store(c, dst++);
+    };
+
     SkASSERT(count > 0);
     do {
         const int n = SkTMin(kBufSize, count);
         this->mapTs(x, y, ts, n);
-        for (int i = 0; i < n; ++i) {
-            const Sk4f c = sampler.sample(ts[i]);
-            DstTraits<dstType, premul>::store(c, dst++);
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            if (SkScalarsAreFinite(ts + i, 4)) {
+                const Sk4f c0 = sampler.sample(ts[i + 0]),
+                           c1 = sampler.sample(ts[i + 1]),
+                           c2 = sampler.sample(ts[i + 2]),
+                           c3 = sampler.sample(ts[i + 3]);
+                DstTraits<dstType, premul>::store4x(c0, c1, c2, c3, dst);
+                dst += 4;
+            } else {
+                for (int j = 0; j < 4; ++j) {
+                    shade1(ts[i + j]);
+                }
+            }
+        }
+        for (; i < n; ++i) {
+            shade1(ts[i]);
         }
         x += n;
         count -= n;
@@ -395,6 +417,21 @@ private:
         SkASSERT(tiled_t < fInterval->fP0 || tiled_t >= fInterval->fP1);
         SkASSERT(tiled_t >= fFirstInterval->fP0 && tiled_t < fLastInterval->fP1);
 
+        // t usually moves on to a neighboring interval.  But with many stops it can skip
+        // over several per pixel (or wrap around, crossing a sweep's seam or a repeat), and a
+        // linear search then walks most of the list; past a few intervals, bisect instead.
+        if (fLastInterval - fFirstInterval >= kMinBinarySearchIntervals) {
+            const Interval* i = nullptr;
+            if (t >= fPrevT) {
+                i = fInterval < fLastInterval ? fInterval + 1 : nullptr;
+            } else {
+                i = fInterval > fFirstInterval ? fInterval - 1 : nullptr;
+            }
+            return (i && tiled_t >= i->fP0 && tiled_t < i->fP1)
+                ? i
+                : this->findFirstInterval(tiled_t);
+        }
+
         const Interval* i = fInterval;
 
         // Use the t vs. prev_t signal to figure which direction we should search for
@@ -418,6 +455,8 @@ private:
         return i;
     }
 
+    static const int kMinBinarySearchIntervals = 8;
+
     void loadIntervalData(const Interval* i) {
         fCc = DstTraits<dstType>::load(i->fC0);
         fDc = DstTraits<dstType>::load(i->fDc);
@@ -430,3 +469,69 @@ private:
     Sk4f            fCc;
     Sk4f            fDc;
 };
+
+bool SkGradientShaderBase::
+GradientShaderBase4fContext::onChooseBlitProcs(const SkImageInfo& info, BlitState* state) {
+    SkXfermode::Mode mode;
+    if (!SkXfermode::AsMode(state->fXfer, &mode)) {
+        return false;
+    }
+
+    if (mode != SkXfermode::kSrc_Mode &&
+        !(mode == SkXfermode::kSrcOver_Mode && (fFlags & kOpaqueAlpha_Flag))) {
+        return false;
+    }
+
+    switch (info.colorType()) {
+        case kN32_SkColorType:
+            state->fBlitBW = D32_BlitBW;
+            return true;
+        case kRGBA_F16_SkColorType:
+            state->fBlitBW = D64_BlitBW;
+            return true;
+        default:
+            return false;
+    }
+}
+
+void SkGradientShaderBase::
+GradientShaderBase4fContext::D32_BlitBW(BlitState* state, int x, int y, const SkPixmap& dst,
+                                        int count) {
+    // FIXME: ignoring coverage for now
+    const GradientShaderBase4fContext* ctx =
+        static_cast<const GradientShaderBase4fContext*>(state->fCtx);
+
+    if (dst.info().isLinear()) {
+        if (ctx->fColorsArePremul) {
+            ctx->shadePremulSpan<DstType::L32, ApplyPremul::False>(
+                x, y, dst.writable_addr32(x, y), count);
+        } else {
+            ctx->shadePremulSpan<DstType::L32, ApplyPremul::True>(
+                x, y, dst.writable_addr32(x, y), count);
+        }
+    } else {
+        if (ctx->fColorsArePremul) {
+            ctx->shadePremulSpan<DstType::S32, ApplyPremul::False>(
+                x, y, dst.writable_addr32(x, y), count);
+        } else {
+            ctx->shadePremulSpan<DstType::S32, ApplyPremul::True>(
+                x, y, dst.writable_addr32(x, y), count);
+        }
+    }
+}
+
+void SkGradientShaderBase::
+GradientShaderBase4fContext::D64_BlitBW(BlitState* state, int x, int y, const SkPixmap& dst,
+                                        int count) {
+    // FIXME: ignoring coverage for now
+    const GradientShaderBase4fContext* ctx =
+        static_cast<const GradientShaderBase4fContext*>(state->fCtx);
+
+    if (ctx->fColorsArePremul) {
+        ctx->shadePremulSpan<DstType::F16, ApplyPremul::False>(
+            x, y, dst.writable_addr64(x, y), count);
+    } else {
+        ctx->shadePremulSpan<DstType::F16, ApplyPremul::True>(
+            x, y, dst.writable_addr64(x, y), count);
+    }
+}
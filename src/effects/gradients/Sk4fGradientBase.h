@@ -40,8 +40,17 @@ protected:
         bool     fZeroRamp;
     };
 
+    // Maps the pixel centers (x + i + .5, y + .5) to gradient ts.  A NaN t leaves its pixel
+    // transparent.
     virtual void mapTs(int x, int y, SkScalar ts[], int count) const = 0;
 
+    // Helper for mapTs: maps the pixel centers to gradient space four at a time, and has
+    // proc(const Sk4f& xs, const Sk4f& ys) -> Sk4f turn each four points into their ts.
+    template <typename Proc>
+    void mapPointsToTs(int x, int y, SkScalar ts[], int count, const Proc& proc) const;
+
+    bool onChooseBlitProcs(const SkImageInfo&, BlitState*) override;
+
     void buildIntervals(const SkGradientShaderBase&, const ContextRec&, bool reverse);
 
     SkSTArray<8, Interval, true> fIntervals;
@@ -68,6 +77,59 @@ private:
     template <DstType dstType, ApplyPremul premul, SkShader::TileMode tileMode>
     void shadeSpanInternal(int x, int y, typename DstTraits<dstType, premul>::Type[],
                            int count) const;
+
+    static void D32_BlitBW(BlitState*, int x, int y, const SkPixmap& dst, int count);
+    static void D64_BlitBW(BlitState*, int x, int y, const SkPixmap& dst, int count);
 };
 
+template <typename Proc>
+void SkGradientShaderBase::
+GradientShaderBase4fContext::mapPointsToTs(int x, int y, SkScalar ts[], int count,
+                                           const Proc& proc) const {
+    SkASSERT(count > 0);
+
+    const SkScalar sx = x + SK_ScalarHalf;
+    const SkScalar sy = y + SK_ScalarHalf;
+    SkScalar tail[4];
+
+    if (fDstToPosClass != kPerspective_MatrixClass) {
+        // kLinear_MatrixClass, kFixedStepInX_MatrixClass => fixed step per scanline
+        const SkVector step = fDstToPos.fixedStepInX(sy);
+        SkPoint pt;
+        fDstToPosProc(fDstToPos, sx, sy, &pt);
+
+        const Sk4f iota = Sk4f(0, 1, 2, 3);
+        Sk4f xs = Sk4f(pt.x()) + iota * Sk4f(step.x()),
+             ys = Sk4f(pt.y()) + iota * Sk4f(step.y());
+        const Sk4f dx4 = Sk4f(4 * step.x()),
+                   dy4 = Sk4f(4 * step.y());
+
+        while (count >= 4) {
+            proc(xs, ys).store(ts);
+            xs = xs + dx4;
+            ys = ys + dy4;
+            ts += 4;
+            count -= 4;
+        }
+
+        if (count > 0) {
+            proc(xs, ys).store(tail);
+            memcpy(ts, tail, count * sizeof(SkScalar));
+        }
+    } else {
+        SkScalar px[4], py[4];
+        for (int i = 0; i < count; i += 4) {
+            const int n = SkTMin(4, count - i);
+            for (int j = 0; j < 4; ++j) {
+                SkPoint pt;
+                fDstToPosProc(fDstToPos, sx + SkTMin(i + j, count - 1), sy, &pt);
+                px[j] = pt.x();
+                py[j] = pt.y();
+            }
+            proc(Sk4f::Load(px), Sk4f::Load(py)).store(tail);
+            memcpy(ts + i, tail, n * sizeof(SkScalar));
+        }
+    }
+}
+
 #endif // Sk4fGradientBase_DEFINED
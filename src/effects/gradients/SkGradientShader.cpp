@@ -269,6 +269,15 @@ bool SkGradientShaderBase::isOpaque() const {
     return fColorsAreOpaque;
 }
 
+bool SkGradientShaderBase::use4fContext(const ContextRec& rec) const {
+#ifdef FORCE_4F_CONTEXT
+    return true;
+#else
+    return rec.fPreferredDstType == ContextRec::kPM4f_DstType
+        || SkToBool(fGradFlags & kForce4fContext_PrivateFlag);
+#endif
+}
+
 static unsigned rounded_divide(unsigned numer, unsigned denom) {
     return (numer + (denom >> 1)) / denom;
 }
@@ -110,6 +110,11 @@ public:
     };
 
 public:
+    enum {
+        // Temp flag for testing the 4f impl.
+        kForce4fContext_PrivateFlag     = 1 << 7,
+    };
+
     SkGradientShaderBase(const Descriptor& desc, const SkMatrix& ptsToUnit);
     virtual ~SkGradientShaderBase();
 
@@ -213,6 +218,10 @@ public:
 protected:
     class GradientShaderBase4fContext;
 
+    // True when contexts for rec should interpolate in float (GradientShaderBase4fContext)
+    // rather than through the 8-bit color cache.
+    bool use4fContext(const ContextRec&) const;
+
     SkGradientShaderBase(SkReadBuffer& );
     void flatten(SkWriteBuffer&) const override;
     SK_TO_STRING_OVERRIDE()
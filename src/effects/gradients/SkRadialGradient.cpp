@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "Sk4fGradientBase.h"
 #include "SkRadialGradient.h"
 #include "SkNx.h"
 
@@ -33,18 +34,42 @@ SkMatrix rad_to_unit_matrix(const SkPoint& center, SkScalar radius) {
 
 /////////////////////////////////////////////////////////////////////
 
+class SkRadialGradient::
+RadialGradient4fContext final : public GradientShaderBase4fContext {
+public:
+    RadialGradient4fContext(const SkRadialGradient& shader, const ContextRec& rec)
+        : INHERITED(shader, rec) {
+        this->buildIntervals(shader, rec, false);
+    }
+
+protected:
+    void mapTs(int x, int y, SkScalar ts[], int count) const override {
+        // fDstToPos maps the circle to the unit circle, so t is just the distance from its center.
+        this->mapPointsToTs(x, y, ts, count, [](const Sk4f& xs, const Sk4f& ys) {
+            return (xs * xs + ys * ys).sqrt();
+        });
+    }
+
+private:
+    using INHERITED = GradientShaderBase4fContext;
+};
+
 SkRadialGradient::SkRadialGradient(const SkPoint& center, SkScalar radius, const Descriptor& desc)
     : SkGradientShaderBase(desc, rad_to_unit_matrix(center, radius))
     , fCenter(center)
     , fRadius(radius) {
 }
 
-size_t SkRadialGradient::onContextSize(const ContextRec&) const {
-    return sizeof(RadialGradientContext);
+size_t SkRadialGradient::onContextSize(const ContextRec& rec) const {
+    return this->use4fContext(rec)
+        ? sizeof(RadialGradient4fContext)
+        : sizeof(RadialGradientContext);
 }
 
 SkShader::Context* SkRadialGradient::onCreateContext(const ContextRec& rec, void* storage) const {
-    return new (storage) RadialGradientContext(*this, rec);
+    return this->use4fContext(rec)
+        ? static_cast<SkShader::Context*>(new (storage) RadialGradient4fContext(*this, rec))
+        : static_cast<SkShader::Context*>(new (storage) RadialGradientContext(*this, rec));
 }
 
 SkRadialGradient::RadialGradientContext::RadialGradientContext(
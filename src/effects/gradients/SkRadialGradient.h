@@ -42,6 +42,8 @@ protected:
     Context* onCreateContext(const ContextRec&, void* storage) const override;
 
 private:
+    class RadialGradient4fContext;
+
     const SkPoint fCenter;
     const SkScalar fRadius;
 
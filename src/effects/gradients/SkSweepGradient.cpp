@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "Sk4fGradientBase.h"
 #include "SkSweepGradient.h"
 
 static SkMatrix translate(SkScalar dx, SkScalar dy) {
@@ -44,12 +45,54 @@ void SkSweepGradient::flatten(SkWriteBuffer& buffer) const {
     buffer.writePoint(fCenter);
 }
 
-size_t SkSweepGradient::onContextSize(const ContextRec&) const {
-    return sizeof(SweepGradientContext);
+// Returns atan2(ys, xs) / 2pi, in [0..1] (0 at the origin).
+static Sk4f sweep_ts(const Sk4f& xs, const Sk4f& ys) {
+    // A minimax polynomial for atan on [0..1] (max error ~1e-5 radians, far below what a color
+    // stop can resolve), reflected into the other octants.
+    const Sk4f ax = xs.abs(),
+               ay = ys.abs(),
+               lo = Sk4f::Min(ax, ay),
+               hi = Sk4f::Max(ax, ay),
+               r  = (hi > Sk4f(0)).thenElse(lo / hi, Sk4f(0)),
+               r2 = r * r;
+
+    Sk4f a = r * (Sk4f(0.99997726f) + r2 * (Sk4f(-0.33262347f) + r2 * (Sk4f(0.19354346f) +
+                  r2 * (Sk4f(-0.11643287f) + r2 * (Sk4f(0.05265332f) +
+                  r2 * Sk4f(-0.01172120f))))));
+    a = (ay > ax).thenElse(Sk4f(SK_ScalarPI / 2) - a, a);
+    a = (xs < Sk4f(0)).thenElse(Sk4f(SK_ScalarPI) - a, a);
+    a = (ys < Sk4f(0)).thenElse(Sk4f(2 * SK_ScalarPI) - a, a);
+
+    return a * Sk4f(1 / (2 * SK_ScalarPI));
+}
+
+class SkSweepGradient::
+SweepGradient4fContext final : public GradientShaderBase4fContext {
+public:
+    SweepGradient4fContext(const SkSweepGradient& shader, const ContextRec& rec)
+        : INHERITED(shader, rec) {
+        this->buildIntervals(shader, rec, false);
+    }
+
+protected:
+    void mapTs(int x, int y, SkScalar ts[], int count) const override {
+        this->mapPointsToTs(x, y, ts, count, sweep_ts);
+    }
+
+private:
+    using INHERITED = GradientShaderBase4fContext;
+};
+
+size_t SkSweepGradient::onContextSize(const ContextRec& rec) const {
+    return this->use4fContext(rec)
+        ? sizeof(SweepGradient4fContext)
+        : sizeof(SweepGradientContext);
 }
 
 SkShader::Context* SkSweepGradient::onCreateContext(const ContextRec& rec, void* storage) const {
-    return new (storage) SweepGradientContext(*this, rec);
+    return this->use4fContext(rec)
+        ? static_cast<SkShader::Context*>(new (storage) SweepGradient4fContext(*this, rec))
+        : static_cast<SkShader::Context*>(new (storage) SweepGradientContext(*this, rec));
 }
 
 SkSweepGradient::SweepGradientContext::SweepGradientContext(
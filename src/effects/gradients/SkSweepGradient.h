@@ -42,6 +42,8 @@ protected:
     Context* onCreateContext(const ContextRec&, void* storage) const override;
 
 private:
+    class SweepGradient4fContext;
+
     const SkPoint fCenter;
 
     friend class SkGradientShader;
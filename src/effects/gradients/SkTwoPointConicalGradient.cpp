@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "Sk4fGradientBase.h"
 #include "SkTwoPointConicalGradient.h"
 #include "SkTwoPointConicalGradient_gpu.h"
 
@@ -186,6 +187,66 @@ static void twopoint_mirror(TwoPtRadialContext* rec, SkPMColor* SK_RESTRICT dstC
     }
 }
 
+// TwoPtRadialContext::nextT() for four points at once, with NaN in place of kDontDrawT.
+static Sk4f conical_ts(const TwoPtRadial& rec, const Sk4f& xs, const Sk4f& ys) {
+    const Sk4f relX = xs - Sk4f(rec.fCenterX),
+               relY = ys - Sk4f(rec.fCenterY),
+               B    = Sk4f(-2) * (Sk4f(rec.fDCenterX) * relX + Sk4f(rec.fDCenterY) * relY +
+                                  Sk4f(rec.fRDR)),
+               C    = relX * relX + relY * relY - Sk4f(rec.fRadius2),
+               nan  = Sk4f(SK_ScalarNaN);
+
+    Sk4f t0, t1;    // in find_quad_roots() order: t1 is preferred
+    Sk4f valid;
+    if (rec.fA == 0) {
+        valid = B != Sk4f(0);
+        t0 = t1 = valid.thenElse(Sk4f(0) - C / B, nan);
+    } else {
+        const Sk4f R = B * B - Sk4f(4 * rec.fA) * C;
+        valid = R >= Sk4f(0);
+        const Sk4f sqrtR = valid.thenElse(R, Sk4f(0)).sqrt(),
+                   Q     = Sk4f(-0.5f) * (B < Sk4f(0)).thenElse(B - sqrtR, B + sqrtR),
+                   Qzero = Q == Sk4f(0),
+                   r0    = Qzero.thenElse(Sk4f(0), Q / Sk4f(rec.fA)),
+                   r1    = Qzero.thenElse(Sk4f(0), C / Q),
+                   lo    = Sk4f::Min(r0, r1),
+                   hi    = Sk4f::Max(r0, r1);
+        t0 = rec.fFlipped ? hi : lo;
+        t1 = rec.fFlipped ? lo : hi;
+    }
+
+    // Prefer t1 if it gives radius(t) >= 0, then t0; otherwise there's nothing to draw.
+    const Sk4f r = Sk4f(rec.fRadius),
+               dr = Sk4f(rec.fDRadius);
+    const Sk4f t = (r + t1 * dr >= Sk4f(0)).thenElse(t1,
+                   (r + t0 * dr >= Sk4f(0)).thenElse(t0, nan));
+    return valid.thenElse(t, nan);
+}
+
+class SkTwoPointConicalGradient::
+TwoPointConical4fContext final : public GradientShaderBase4fContext {
+public:
+    TwoPointConical4fContext(const SkTwoPointConicalGradient& shader, const ContextRec& rec)
+        : INHERITED(shader, rec)
+        , fRec(shader.fRec) {
+        // As with TwoPointConicalGradientContext, pixels outside the cone are discarded.
+        fFlags &= ~kOpaqueAlpha_Flag;
+        this->buildIntervals(shader, rec, false);
+    }
+
+protected:
+    void mapTs(int x, int y, SkScalar ts[], int count) const override {
+        this->mapPointsToTs(x, y, ts, count, [this](const Sk4f& xs, const Sk4f& ys) {
+            return conical_ts(fRec, xs, ys);
+        });
+    }
+
+private:
+    using INHERITED = GradientShaderBase4fContext;
+
+    const TwoPtRadial& fRec;
+};
+
 /////////////////////////////////////////////////////////////////////
 
 SkTwoPointConicalGradient::SkTwoPointConicalGradient(
@@ -211,13 +272,17 @@ bool SkTwoPointConicalGradient::isOpaque() const {
     return false;
 }
 
-size_t SkTwoPointConicalGradient::onContextSize(const ContextRec&) const {
-    return sizeof(TwoPointConicalGradientContext);
+size_t SkTwoPointConicalGradient::onContextSize(const ContextRec& rec) const {
+    return this->use4fContext(rec)
+        ? sizeof(TwoPointConical4fContext)
+        : sizeof(TwoPointConicalGradientContext);
 }
 
 SkShader::Context* SkTwoPointConicalGradient::onCreateContext(const ContextRec& rec,
                                                               void* storage) const {
-    return new (storage) TwoPointConicalGradientContext(*this, rec);
+    return this->use4fContext(rec)
+        ? static_cast<SkShader::Context*>(new (storage) TwoPointConical4fContext(*this, rec))
+        : static_cast<SkShader::Context*>(new (storage) TwoPointConicalGradientContext(*this, rec));
 }
 
 SkTwoPointConicalGradient::TwoPointConicalGradientContext::TwoPointConicalGradientContext(
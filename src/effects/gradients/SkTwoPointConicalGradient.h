@@ -82,6 +82,8 @@ protected:
     Context* onCreateContext(const ContextRec&, void* storage) const override;
 
 private:
+    class TwoPointConical4fContext;
+
     SkPoint fCenter1;
     SkPoint fCenter2;
     SkScalar fRadius1;
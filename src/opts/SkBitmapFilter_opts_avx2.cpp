@@ -0,0 +1,227 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <immintrin.h>
+#include "SkBitmapFilter_opts_avx2.h"
+
+// These are the SSE2 convolutions with twice the pixels or taps per step.  Pixels and filter
+// coefficients are both 16-bit, and _mm256_madd_epi16 multiplies them two taps at a time into
+// 32-bit sums, exactly the sums the SSE2 and portable code compute.  So their results match.
+
+typedef SkConvolutionFilter1D::ConvolutionFixed ConvolutionFixed;
+
+// Convolves horizontally along N rows at once, one output pixel at a time, eight taps per step.
+template <int N>
+static inline void convolve_horizontally(const unsigned char* const* src_data,
+                                         const SkConvolutionFilter1D& filter,
+                                         unsigned char* const* out_row) {
+    const __m256i zero = _mm256_setzero_si256();
+    // Zero-extend each channel of pixels 0 and 1 of each lane next to each other,
+    // [16] a1 a0 b1 b0 g1 g0 r1 r0, and the same for pixels 2 and 3.
+    const __m256i shuffle_lo = _mm256_setr_epi8(0, -1, 4, -1, 1, -1, 5, -1,
+                                                2, -1, 6, -1, 3, -1, 7, -1,
+                                                0, -1, 4, -1, 1, -1, 5, -1,
+                                                2, -1, 6, -1, 3, -1, 7, -1);
+    const __m256i shuffle_hi = _mm256_setr_epi8( 8, -1, 12, -1,  9, -1, 13, -1,
+                                                10, -1, 14, -1, 11, -1, 15, -1,
+                                                 8, -1, 12, -1,  9, -1, 13, -1,
+                                                10, -1, 14, -1, 11, -1, 15, -1);
+    // Spread the 32-bit coefficient pairs (c1 c0) and (c5 c4), or (c3 c2) and (c7 c6),
+    // across the two lanes to match.
+    const __m256i pairs_lo = _mm256_setr_epi32(0, 0, 0, 0, 2, 2, 2, 2);
+    const __m256i pairs_hi = _mm256_setr_epi32(1, 1, 1, 1, 3, 3, 3, 3);
+    const __m128i taps = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+
+    // Accumulate eight pixels starting at byte |start| of each row against eight coefficients.
+    auto accumulate8 = [&](__m128i coeff, int start, __m256i accum[N]) {
+        const __m256i coeff8 = _mm256_broadcastsi128_si256(coeff);
+        const __m256i coeff_lo = _mm256_permutevar8x32_epi32(coeff8, pairs_lo),
+                      coeff_hi = _mm256_permutevar8x32_epi32(coeff8, pairs_hi);
+        for (int i = 0; i < N; i++) {
+            const __m256i src8 = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(src_data[i] + start));
+            // [32] a b g r of c0*p0 + c1*p1 | c4*p4 + c5*p5, then the same for c2, c3 | c6, c7.
+            accum[i] = _mm256_add_epi32(accum[i], _mm256_madd_epi16(
+                    _mm256_shuffle_epi8(src8, shuffle_lo), coeff_lo));
+            accum[i] = _mm256_add_epi32(accum[i], _mm256_madd_epi16(
+                    _mm256_shuffle_epi8(src8, shuffle_hi), coeff_hi));
+        }
+    };
+
+    const int num_values = filter.numValues();
+    int filter_offset, filter_length;
+    for (int out_x = 0; out_x < num_values; out_x++) {
+        const ConvolutionFixed* filter_values =
+            filter.FilterForValue(out_x, &filter_offset, &filter_length);
+
+        __m256i accum[N];
+        for (int i = 0; i < N; i++) {
+            accum[i] = zero;
+        }
+        int start = filter_offset << 2;
+        int filter_x = 0;
+        for (; filter_x + 8 <= filter_length; filter_x += 8) {
+            accumulate8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(filter_values)),
+                        start, accum);
+            start += 32;
+            filter_values += 8;
+        }
+
+        // Mask off the coefficients past the end of the filter.  The filter values are padded
+        // enough to load them, and by reading eight pixels only for more than four taps, we
+        // read no more than three pixels past the filter, as the SSE2 code does.
+        const int r = filter_length - filter_x;
+        const __m128i mask = _mm_cmpgt_epi16(_mm_set1_epi16(r), taps);
+        if (r > 4) {
+            accumulate8(_mm_and_si128(mask, _mm_loadu_si128(
+                                reinterpret_cast<const __m128i*>(filter_values))),
+                        start, accum);
+        }
+
+        __m128i sum[N];
+        for (int i = 0; i < N; i++) {
+            sum[i] = _mm_add_epi32(_mm256_castsi256_si128(accum[i]),
+                                   _mm256_extracti128_si256(accum[i], 1));
+        }
+        if (0 < r && r <= 4) {
+            const __m128i coeff = _mm_and_si128(mask, _mm_loadl_epi64(
+                                          reinterpret_cast<const __m128i*>(filter_values)));
+            const __m128i coeff_lo = _mm_shuffle_epi32(coeff, _MM_SHUFFLE(0, 0, 0, 0)),
+                          coeff_hi = _mm_shuffle_epi32(coeff, _MM_SHUFFLE(1, 1, 1, 1));
+            for (int i = 0; i < N; i++) {
+                const __m128i src8 = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(src_data[i] + start));
+                sum[i] = _mm_add_epi32(sum[i], _mm_madd_epi16(
+                        _mm_shuffle_epi8(src8, _mm256_castsi256_si128(shuffle_lo)), coeff_lo));
+                sum[i] = _mm_add_epi32(sum[i], _mm_madd_epi16(
+                        _mm_shuffle_epi8(src8, _mm256_castsi256_si128(shuffle_hi)), coeff_hi));
+            }
+        }
+
+        for (int i = 0; i < N; i++) {
+            // Shift right for fixed point, then pack to 16 and 8 bits with saturation.
+            __m128i result = _mm_srai_epi32(sum[i], SkConvolutionFilter1D::kShiftBits);
+            result = _mm_packs_epi32(result, _mm_setzero_si128());
+            result = _mm_packus_epi16(result, _mm_setzero_si128());
+            *(reinterpret_cast<int*>(out_row[i] + (out_x << 2))) = _mm_cvtsi128_si32(result);
+        }
+    }
+}
+
+void convolveHorizontally_avx2(const unsigned char* src_data,
+                               const SkConvolutionFilter1D& filter,
+                               unsigned char* out_row,
+                               bool /*has_alpha*/) {
+    convolve_horizontally<1>(&src_data, filter, &out_row);
+}
+
+void convolve4RowsHorizontally_avx2(const unsigned char* src_data[4],
+                                    const SkConvolutionFilter1D& filter,
+                                    unsigned char* out_row[4],
+                                    size_t outRowBytes) {
+    SkASSERT((size_t)filter.numValues() * 4 <= outRowBytes);
+    convolve_horizontally<4>(src_data, filter, out_row);
+}
+
+// Vertically convolves the eight pixels starting at byte |start| of the rows, two rows per step.
+template <bool has_alpha>
+static inline __m256i convolve8_vertically(const ConvolutionFixed* filter_values,
+                                           int filter_length,
+                                           unsigned char* const* source_data_rows,
+                                           int start) {
+    const __m256i zero = _mm256_setzero_si256();
+    // Accumulated results for pixels 0|4, 1|5, 2|6 and 3|7, 32 bits per channel.
+    __m256i accum0 = zero, accum1 = zero, accum2 = zero, accum3 = zero;
+
+    auto accumulate = [&](__m256i src0, __m256i src1, __m256i coeff) {
+        // [8] a1 A1 b1 B1 g1 G1 r1 R1 a0 A0 b0 B0 g0 G0 r0 R0, rows 0 and 1 side by side.
+        const __m256i lo = _mm256_unpacklo_epi8(src0, src1),
+                      hi = _mm256_unpackhi_epi8(src0, src1);
+        accum0 = _mm256_add_epi32(accum0,
+                                  _mm256_madd_epi16(_mm256_unpacklo_epi8(lo, zero), coeff));
+        accum1 = _mm256_add_epi32(accum1,
+                                  _mm256_madd_epi16(_mm256_unpackhi_epi8(lo, zero), coeff));
+        accum2 = _mm256_add_epi32(accum2,
+                                  _mm256_madd_epi16(_mm256_unpacklo_epi8(hi, zero), coeff));
+        accum3 = _mm256_add_epi32(accum3,
+                                  _mm256_madd_epi16(_mm256_unpackhi_epi8(hi, zero), coeff));
+    };
+    auto load = [&](int filter_y) {
+        return _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(source_data_rows[filter_y] + start));
+    };
+
+    int filter_y = 0;
+    for (; filter_y + 2 <= filter_length; filter_y += 2) {
+        const uint32_t pair = (uint16_t)filter_values[filter_y] |
+                              (uint32_t)(uint16_t)filter_values[filter_y + 1] << 16;
+        accumulate(load(filter_y), load(filter_y + 1), _mm256_set1_epi32((int)pair));
+    }
+    if (filter_y < filter_length) {
+        accumulate(load(filter_y), zero, _mm256_set1_epi32((uint16_t)filter_values[filter_y]));
+    }
+
+    // Shift right for fixed point, then pack to 16 and 8 bits with saturation.
+    // [8] p7 p6 p5 p4 | p3 p2 p1 p0
+    accum0 = _mm256_srai_epi32(accum0, SkConvolutionFilter1D::kShiftBits);
+    accum1 = _mm256_srai_epi32(accum1, SkConvolutionFilter1D::kShiftBits);
+    accum2 = _mm256_srai_epi32(accum2, SkConvolutionFilter1D::kShiftBits);
+    accum3 = _mm256_srai_epi32(accum3, SkConvolutionFilter1D::kShiftBits);
+    __m256i result = _mm256_packus_epi16(_mm256_packs_epi32(accum0, accum1),
+                                         _mm256_packs_epi32(accum2, accum3));
+
+    if (has_alpha) {
+        // Make sure the value of alpha channel is always larger than maximum
+        // value of color channels.
+        __m256i max = _mm256_max_epu8(_mm256_srli_epi32(result, 8), result);
+        max = _mm256_max_epu8(_mm256_srli_epi32(result, 16), max);
+        result = _mm256_max_epu8(_mm256_slli_epi32(max, 24), result);
+    } else {
+        // Set value of alpha channels to 0xFF.
+        result = _mm256_or_si256(result, _mm256_set1_epi32(0xff000000));
+    }
+    return result;
+}
+
+template <bool has_alpha>
+static void convolve_vertically(const ConvolutionFixed* filter_values,
+                                int filter_length,
+                                unsigned char* const* source_data_rows,
+                                int pixel_width,
+                                unsigned char* out_row) {
+    const int width = pixel_width & ~7;
+    for (int out_x = 0; out_x < width; out_x += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_row + (out_x << 2)),
+                            convolve8_vertically<has_alpha>(filter_values, filter_length,
+                                                            source_data_rows, out_x << 2));
+    }
+
+    // Rows in the buffer are padded out to 16 pixels, so the last few pixels can be convolved
+    // eight at a time too.  Only those in the output row are stored.
+    if (pixel_width & 7) {
+        uint32_t tail[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(tail),
+                            convolve8_vertically<has_alpha>(filter_values, filter_length,
+                                                            source_data_rows, width << 2));
+        memcpy(out_row + (width << 2), tail, (pixel_width & 7) * 4);
+    }
+}
+
+void convolveVertically_avx2(const ConvolutionFixed* filter_values,
+                             int filter_length,
+                             unsigned char* const* source_data_rows,
+                             int pixel_width,
+                             unsigned char* out_row,
+                             bool has_alpha) {
+    if (has_alpha) {
+        convolve_vertically<true>(filter_values, filter_length, source_data_rows,
+                                  pixel_width, out_row);
+    } else {
+        convolve_vertically<false>(filter_values, filter_length, source_data_rows,
+                                   pixel_width, out_row);
+    }
+}
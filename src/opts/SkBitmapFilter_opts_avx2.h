@@ -0,0 +1,29 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkBitmapFilter_opts_avx2_DEFINED
+#define SkBitmapFilter_opts_avx2_DEFINED
+
+#include "SkConvolver.h"
+
+// These read no further past their inputs than the SSE2 versions, and share their filter padding.
+void convolveVertically_avx2(const SkConvolutionFilter1D::ConvolutionFixed* filter_values,
+                             int filter_length,
+                             unsigned char* const* source_data_rows,
+                             int pixel_width,
+                             unsigned char* out_row,
+                             bool has_alpha);
+void convolve4RowsHorizontally_avx2(const unsigned char* src_data[4],
+                                    const SkConvolutionFilter1D& filter,
+                                    unsigned char* out_row[4],
+                                    size_t outRowBytes);
+void convolveHorizontally_avx2(const unsigned char* src_data,
+                               const SkConvolutionFilter1D& filter,
+                               unsigned char* out_row,
+                               bool has_alpha);
+
+#endif
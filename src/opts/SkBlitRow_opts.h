@@ -18,6 +18,21 @@
 
 namespace SK_OPTS_NS {
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+// SkPMSrcOver_SSE2(), 8 pixels at a time.
+static inline __m256i SkPMSrcOver_AVX2(const __m256i& src, const __m256i& dst) {
+    const __m256i mask = _mm256_set1_epi32(0xFF00FF);
+    __m256i scale = _mm256_sub_epi32(_mm256_set1_epi32(256),
+                                     _mm256_srli_epi32(_mm256_slli_epi32(src, 24 - SK_A32_SHIFT),
+                                                       24));
+    __m256i s = _mm256_or_si256(_mm256_slli_epi32(scale, 16), scale);
+
+    __m256i rb = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_and_si256(mask, dst), s), 8),
+            ag = _mm256_mullo_epi16(_mm256_srli_epi16(dst, 8), s);
+    return _mm256_add_epi32(src, _mm256_or_si256(rb, _mm256_andnot_si256(mask, ag)));
+}
+#endif
+
 // Color32 uses the blend_256_round_alt algorithm from tests/BlendTest.cpp.
 // It's not quite perfect, but it's never wrong in the interesting edge cases,
 // and it's quite a bit faster than blend_perfect.
@@ -42,6 +57,45 @@ void blit_row_s32a_opaque(SkPMColor* dst, const SkPMColor* src, int len, U8CPU a
     SkASSERT(alpha == 0xFF);
     sk_msan_assert_initialized(src, src+len);
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    while (len >= 16) {
+        // Load 16 source pixels.
+        auto s0 = _mm256_loadu_si256((const __m256i*)(src) + 0),
+             s1 = _mm256_loadu_si256((const __m256i*)(src) + 1);
+
+        const auto alphaMask = _mm256_set1_epi32(0xFF000000);
+
+        if (_mm256_testz_si256(_mm256_or_si256(s1, s0), alphaMask)) {
+            // All 16 source pixels are transparent.  Nothing to do.
+            src += 16;
+            dst += 16;
+            len -= 16;
+            continue;
+        }
+
+        auto d0 = (__m256i*)(dst) + 0,
+             d1 = (__m256i*)(dst) + 1;
+
+        if (_mm256_testc_si256(_mm256_and_si256(s1, s0), alphaMask)) {
+            // All 16 source pixels are opaque.  SrcOver becomes Src.
+            _mm256_storeu_si256(d0, s0);
+            _mm256_storeu_si256(d1, s1);
+            src += 16;
+            dst += 16;
+            len -= 16;
+            continue;
+        }
+
+        // Do SrcOver, with the same math as the SSE paths below.
+        _mm256_storeu_si256(d0, SkPMSrcOver_AVX2(s0, _mm256_loadu_si256(d0)));
+        _mm256_storeu_si256(d1, SkPMSrcOver_AVX2(s1, _mm256_loadu_si256(d1)));
+        src += 16;
+        dst += 16;
+        len -= 16;
+    }
+    // Fewer than 16 pixels remain, so the SSE4.1 loop below has nothing left to do.
+#endif
+
 #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE41
     while (len >= 16) {
         // Load 16 source pixels.
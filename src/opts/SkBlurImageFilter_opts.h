@@ -63,7 +63,136 @@ static inline __m128i mullo_epi32(__m128i a, __m128i b) {
     auto result = mullo_epi32(sum, scale); \
     result = _mm_add_epi32(result, half); \
     *dptr = repack(result);
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+// Wider vectors hold neighbouring rows side by side, with the same four 32-bit sums per pixel
+// as above: two rows with AVX2, four with AVX-512.
+#if defined(__AVX512BW__)
+static const int kBlurRows = 4;
+typedef __m512i BlurSums;
+static inline BlurSums blur_set1(int x) { return _mm512_set1_epi32(x); }
+static inline BlurSums blur_add(BlurSums a, BlurSums b) { return _mm512_add_epi32(a, b); }
+static inline BlurSums blur_sub(BlurSums a, BlurSums b) { return _mm512_sub_epi32(a, b); }
+static inline BlurSums blur_mul(BlurSums a, BlurSums b) { return _mm512_mullo_epi32(a, b); }
+// One pixel from each row, step apart, expanded to 32 bits per channel.
+static inline BlurSums blur_load(const SkPMColor* p, int step) {
+    __m128i px = (1 == step) ? _mm_loadu_si128((const __m128i*)p)
+                             : _mm_setr_epi32(p[0], p[step], p[2*step], p[3*step]);
+    return _mm512_cvtepu8_epi32(px);
+}
+// Each row's pixel from the top byte of its channels' 32-bit lanes.
+static inline void blur_store(SkPMColor* p, int step, BlurSums result) {
+    __m128i px = _mm512_cvtepi32_epi8(_mm512_srli_epi32(result, 24));
+    if (1 == step) {
+        _mm_storeu_si128((__m128i*)p, px);
+    } else {
+        p[0]      = _mm_extract_epi32(px, 0);
+        p[step]   = _mm_extract_epi32(px, 1);
+        p[2*step] = _mm_extract_epi32(px, 2);
+        p[3*step] = _mm_extract_epi32(px, 3);
+    }
+}
+#else
+static const int kBlurRows = 2;
+typedef __m256i BlurSums;
+static inline BlurSums blur_set1(int x) { return _mm256_set1_epi32(x); }
+static inline BlurSums blur_add(BlurSums a, BlurSums b) { return _mm256_add_epi32(a, b); }
+static inline BlurSums blur_sub(BlurSums a, BlurSums b) { return _mm256_sub_epi32(a, b); }
+static inline BlurSums blur_mul(BlurSums a, BlurSums b) { return _mm256_mullo_epi32(a, b); }
+static inline BlurSums blur_load(const SkPMColor* p, int step) {
+    __m128i px = (1 == step) ? _mm_loadl_epi64((const __m128i*)p)
+                             : _mm_unpacklo_epi32(_mm_cvtsi32_si128(p[0]),
+                                                  _mm_cvtsi32_si128(p[step]));
+    return _mm256_cvtepu8_epi32(px);
+}
+static inline void blur_store(SkPMColor* p, int step, BlurSums result) {
+    // Pack each 128-bit lane's pixel into its low 32 bits.
+    __m256i px = _mm256_srli_epi32(result, 24);
+    px = _mm256_packus_epi32(px, px);
+    px = _mm256_packus_epi16(px, px);
+    p[0]    = _mm256_extract_epi32(px, 0);
+    p[step] = _mm256_extract_epi32(px, 4);
+}
+#endif
+
+// Blurs kBlurRows rows at a time, as box_blur() does one, for as many as it can.  Returns the
+// first row left to box_blur(), having moved src and dst to it.
+template<BlurDirection srcDirection, BlurDirection dstDirection>
+static int box_blur_rows(const SkPMColor** src, int srcStride, const SkIRect& srcBounds,
+                         SkPMColor** dst, int kernelSize,
+                         int leftOffset, int rightOffset, int width, int height) {
+    int left = srcBounds.left();
+    int right = srcBounds.right();
+    int top = srcBounds.top();
+    int bottom = srcBounds.bottom();
+    int incrementStart = SkMax32(left - rightOffset - 1, left - right);
+    int incrementEnd = SkMax32(right - rightOffset - 1, 0);
+    int decrementStart = SkMin32(left + leftOffset, width);
+    int decrementEnd = SkMin32(right + leftOffset, width);
+    const int srcStrideX = srcDirection == BlurDirection::kX ? 1 : srcStride;
+    const int dstStrideX = dstDirection == BlurDirection::kX ? 1 : height;
+    const int srcStrideY = srcDirection == BlurDirection::kX ? srcStride : 1;
+    const int dstStrideY = dstDirection == BlurDirection::kX ? width : 1;
+    const BlurSums scale = blur_set1((1 << 24) / kernelSize),
+                   half  = blur_set1(1 << 23);
+
+    for (; bottom - top >= kBlurRows; top += kBlurRows) {
+        BlurSums sum = blur_set1(0);
+        const SkPMColor* lptr = *src;
+        const SkPMColor* rptr = *src;
+        SkPMColor* dptr = *dst;
+        // A zero sum stores zero, so storing the sums also clears outside our domain.
+        auto store = [&]() {
+            blur_store(dptr, dstStrideY, blur_add(blur_mul(sum, scale), half));
+            dptr += dstStrideX;
+        };
+        auto increment = [&]() {
+            sum = blur_add(sum, blur_load(rptr, srcStrideY));
+            rptr += srcStrideX;
+        };
+        auto decrement = [&]() {
+            sum = blur_sub(sum, blur_load(lptr, srcStrideY));
+            lptr += srcStrideX;
+        };
+        int x;
+        for (x = incrementStart; x < 0; ++x) {
+            increment();
+        }
+        for (x = 0; x < incrementStart; ++x) {
+            store();
+        }
+        for (; x < decrementStart && x < incrementEnd; ++x) {
+            store();
+            increment();
+        }
+        for (x = decrementStart; x < incrementEnd; ++x) {
+            store();
+            increment();
+            decrement();
+        }
+        for (x = incrementEnd; x < decrementStart; ++x) {
+            store();
+        }
+        for (; x < decrementEnd; ++x) {
+            store();
+            decrement();
+        }
+        for (; x < width; ++x) {
+            store();
+        }
+        *src += srcStrideY * kBlurRows;
+        *dst += dstStrideY * kBlurRows;
+    }
+    return top;
+}
+
+#define DOUBLE_ROW_OPTIMIZATION \
+    top = box_blur_rows<srcDirection, dstDirection>(&src, srcStride, srcBounds, &dst, \
+                                                    kernelSize, leftOffset, rightOffset, \
+                                                    width, height);
+#else
 #define DOUBLE_ROW_OPTIMIZATION
+#endif
 
 #elif defined(SK_ARM_HAS_NEON)
 
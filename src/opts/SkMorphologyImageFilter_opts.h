@@ -13,7 +13,93 @@ namespace SK_OPTS_NS {
 enum MorphType { kDilate, kErode };
 enum class MorphDirection { kX, kY };
 
-#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+// Neighbouring pixels are found together, each the extreme of its own window: 16 at a time with
+// AVX-512, 8 with AVX2.  Pixels whose windows are cut short by the ends of a row in the x
+// direction, and any left over at the end of a column in y, are found one at a time.
+#if defined(__AVX512BW__)
+    static const int kMorphPixels = 16;
+    static inline __m512i morph_load(const SkPMColor* p) { return _mm512_loadu_si512(p); }
+    static inline void morph_store(SkPMColor* p, __m512i v) { _mm512_storeu_si512(p, v); }
+    static inline __m512i morph_dilate(__m512i a, __m512i b) { return _mm512_max_epu8(a, b); }
+    static inline __m512i morph_erode (__m512i a, __m512i b) { return _mm512_min_epu8(a, b); }
+    static inline __m512i morph_start(MorphType type) {
+        return _mm512_set1_epi32(type == kDilate ? 0 : ~0);
+    }
+#else
+    static const int kMorphPixels = 8;
+    static inline __m256i morph_load(const SkPMColor* p) {
+        return _mm256_loadu_si256((const __m256i*)p);
+    }
+    static inline void morph_store(SkPMColor* p, __m256i v) { _mm256_storeu_si256((__m256i*)p, v); }
+    static inline __m256i morph_dilate(__m256i a, __m256i b) { return _mm256_max_epu8(a, b); }
+    static inline __m256i morph_erode (__m256i a, __m256i b) { return _mm256_min_epu8(a, b); }
+    static inline __m256i morph_start(MorphType type) {
+        return _mm256_set1_epi32(type == kDilate ? 0 : ~0);
+    }
+#endif
+
+template<MorphType type, MorphDirection direction>
+static void morph(const SkPMColor* src, SkPMColor* dst,
+                  int radius, int width, int height, int srcStride, int dstStride) {
+    // The extreme of n pixels starting at p, step apart.
+    auto one = [](const SkPMColor* p, int n, int step) {
+        __m128i extreme = (type == kDilate) ? _mm_setzero_si128() : _mm_set1_epi32(0xFFFFFFFF);
+        for (; n > 0; n--, p += step) {
+            __m128i src_pixel = _mm_cvtsi32_si128(*p);
+            extreme = (type == kDilate) ? _mm_max_epu8(src_pixel, extreme)
+                                        : _mm_min_epu8(src_pixel, extreme);
+        }
+        return (SkPMColor)_mm_cvtsi128_si32(extreme);
+    };
+    // The same for kMorphPixels neighbours of p, storing them to their neighbours at d.
+    auto many = [](const SkPMColor* p, int n, int step, SkPMColor* d) {
+        auto extreme = morph_start(type);
+        for (; n > 0; n--, p += step) {
+            extreme = (type == kDilate) ? morph_dilate(morph_load(p), extreme)
+                                        : morph_erode (morph_load(p), extreme);
+        }
+        morph_store(d, extreme);
+    };
+
+    // Along the direction, width pixels are each the extreme of their window of up to
+    // 2*radius+1, clamped to [0, width).  Across it, there are height of these lines.
+    radius = SkMin32(radius, width - 1);
+    if (direction == MorphDirection::kX) {
+        for (int y = 0; y < height; ++y) {
+            const SkPMColor* row = src + y * srcStride;
+            SkPMColor* dptr = dst + y * dstStride;
+            int x = 0;
+            while (x < width) {
+                if (x >= radius && x + kMorphPixels - 1 + radius < width) {
+                    many(row + x - radius, 2 * radius + 1, 1, dptr + x);
+                    x += kMorphPixels;
+                } else {
+                    const int lo = SkMax32(x - radius, 0),
+                              hi = SkMin32(x + radius, width - 1);
+                    dptr[x] = one(row + lo, hi - lo + 1, 1);
+                    x += 1;
+                }
+            }
+        }
+    } else {
+        for (int x = 0; x < width; ++x) {
+            const int lo = SkMax32(x - radius, 0),
+                      hi = SkMin32(x + radius, width - 1);
+            const SkPMColor* rows = src + lo * srcStride;
+            SkPMColor* dptr = dst + x * dstStride;
+            int y = 0;
+            for (; y + kMorphPixels <= height; y += kMorphPixels) {
+                many(rows + y, hi - lo + 1, srcStride, dptr + y);
+            }
+            for (; y < height; ++y) {
+                dptr[y] = one(rows + y, hi - lo + 1, srcStride);
+            }
+        }
+    }
+}
+
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
 template<MorphType type, MorphDirection direction>
 static void morph(const SkPMColor* src, SkPMColor* dst,
                   int radius, int width, int height, int srcStride, int dstStride) {
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkOpts.h"
+
+#define SK_OPTS_NS sk_avx2
+#include "SkBlitRow_opts.h"
+#include "SkBlurImageFilter_opts.h"
+#include "SkColorCubeFilter_opts.h"
+#include "SkMorphologyImageFilter_opts.h"
+#include "SkSwizzler_opts.h"
+
+#include <immintrin.h>
+
+#ifndef SK_SUPPORT_LEGACY_X86_BLITS
+
+// These are the blits from SkOpts_sse41.cpp, widened to 8 pixels at a time.
+// See there for the full story; the math is identical, so results match exactly.
+namespace sk_avx2_new {
+
+// Load 8 constant pixels or coverages (4x replicated).
+static __m256i next8(uint32_t val) { return _mm256_set1_epi32(val); }
+static __m256i next8(uint8_t  val) { return _mm256_set1_epi8(val); }
+
+// Load 8 variable pixels or coverages (4x replicated),
+// incrementing the pointer past what we read.
+static __m256i next8(const uint32_t*& ptr) {
+    auto r = _mm256_loadu_si256((const __m256i*)ptr);
+    ptr += 8;
+    return r;
+}
+static __m256i next8(const uint8_t*& ptr) {
+    // Zero extend each coverage byte to 32 bits, then multiply to copy it into all four bytes.
+    auto r = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)ptr)),
+                                _mm256_set1_epi32(0x01010101));
+    ptr += 8;
+    return r;
+}
+
+// Copy the last n < 8 values of a variable into a local 8-wide buffer, or pass constants through.
+template <typename T> struct Tail {
+    T val;
+    Tail(T v, int) : val(v) {}
+    T get() const { return val; }
+};
+template <typename T> struct Tail<const T*> {
+    T buf[8];
+    Tail(const T* ptr, int n) {
+        memset(buf, 0, sizeof(buf));
+        memcpy(buf, ptr, n * sizeof(T));
+    }
+    const T* get() const { return buf; }
+};
+
+// For i = 0...n, tgt = fn(dst,src,cov), where Dst,Src,and Cov can be constants or arrays.
+template <typename Dst, typename Src, typename Cov, typename Fn>
+static void loop(int n, uint32_t* t, const Dst dst, const Src src, const Cov cov, Fn&& fn) {
+    // We don't want to muck with the callers' pointers, so we make them const and copy here.
+    Dst d = dst;
+    Src s = src;
+    Cov c = cov;
+
+    while (n >= 8) {
+        _mm256_storeu_si256((__m256i*)t, fn(next8(d), next8(s), next8(c)));
+        t += 8;
+        n -= 8;
+    }
+    if (n > 0) {
+        // Run the tail through a stack buffer, so we never read or write past the end.
+        Tail<Dst> td(d, n);
+        Tail<Src> ts(s, n);
+        Tail<Cov> tc(c, n);
+        Dst dd = td.get();
+        Src ss = ts.get();
+        Cov cc = tc.get();
+        uint32_t tmp[8];
+        _mm256_storeu_si256((__m256i*)tmp, fn(next8(dd), next8(ss), next8(cc)));
+        memcpy(t, tmp, n * sizeof(uint32_t));
+    }
+}
+
+// Unpack to 16-bit lanes, call fn, and repack.  Unpacking and packing both work within
+// 128-bit lanes, so every pixel ends up back where it started.
+template <typename Fn>
+struct Adapt {
+    Fn fn;
+
+    __m256i operator()(__m256i d, __m256i s, __m256i c) {
+        auto lo = [](__m256i x) { return _mm256_unpacklo_epi8(x, _mm256_setzero_si256()); };
+        auto hi = [](__m256i x) { return _mm256_unpackhi_epi8(x, _mm256_setzero_si256()); };
+        return _mm256_packus_epi16(fn(lo(d), lo(s), lo(c)),
+                                   fn(hi(d), hi(s), hi(c)));
+    }
+};
+
+template <typename Fn>
+static Adapt<Fn> adapt(Fn&& fn) { return { fn }; }
+
+// Divide by 255 with rounding.
+// (x+127)/255 == ((x+128)*257)>>16.
+static __m256i div255_part1(__m256i x) { return _mm256_add_epi16(x, _mm256_set1_epi16(128)); }
+static __m256i div255_part2(__m256i x) { return _mm256_mulhi_epu16(x, _mm256_set1_epi16(257)); }
+static __m256i div255(__m256i x) { return div255_part2(div255_part1(x)); }
+
+// (x*y+127)/255, a byte multiply.
+static __m256i scale(__m256i x, __m256i y) { return div255(_mm256_mullo_epi16(x, y)); }
+
+// (255 * x).
+static __m256i mul255(__m256i x) { return _mm256_sub_epi16(_mm256_slli_epi16(x, 8), x); }
+
+// (255 - x).
+static __m256i inv(__m256i x) { return _mm256_xor_si256(_mm256_set1_epi16(0x00ff), x); }
+
+// ARGB argb -> AAAA aaaa, in each 128-bit lane.
+static __m256i alphas(__m256i px) {
+    const int a = 2 * (SK_A32_SHIFT/8);  // SK_A32_SHIFT is typically 24, so this is typically 6.
+    const int _ = ~0;
+    return _mm256_shuffle_epi8(px, _mm256_setr_epi8(a+0,_,a+0,_,a+0,_,a+0,_,
+                                                    a+8,_,a+8,_,a+8,_,a+8,_,
+                                                    a+0,_,a+0,_,a+0,_,a+0,_,
+                                                    a+8,_,a+8,_,a+8,_,a+8,_));
+}
+
+// SrcOver, with a constant source and full coverage.
+static void blit_row_color32(SkPMColor* tgt, const SkPMColor* dst, int n, SkPMColor src) {
+    __m256i s = _mm256_unpacklo_epi8(_mm256_set1_epi32(src), _mm256_setzero_si256()),
+            s_255_128 = div255_part1(mul255(s)),
+            A = inv(alphas(s));
+
+    const uint8_t cov = 0xff;
+    loop(n, tgt, dst, src, cov, adapt([=](__m256i d, __m256i, __m256i) {
+        return div255_part2(_mm256_add_epi16(s_255_128, _mm256_mullo_epi16(d, A)));
+    }));
+}
+
+// SrcOver, with a constant source and variable coverage.
+// If the source is opaque, SrcOver becomes Src.
+static void blit_mask_d32_a8(SkPMColor* dst,     size_t dstRB,
+                             const SkAlpha* cov, size_t covRB,
+                             SkColor color, int w, int h) {
+    if (SkColorGetA(color) == 0xFF) {
+        const SkPMColor src = SkSwizzle_BGRA_to_PMColor(color);
+        while (h --> 0) {
+            loop(w, dst, (const SkPMColor*)dst, src, cov,
+                    adapt([](__m256i d, __m256i s, __m256i c) {
+                // Src blend mode: a simple lerp from d to s by c.
+                return div255(_mm256_add_epi16(_mm256_mullo_epi16(inv(c),d),
+                                               _mm256_mullo_epi16(    c ,s)));
+            }));
+            dst += dstRB / sizeof(*dst);
+            cov += covRB / sizeof(*cov);
+        }
+    } else {
+        const SkPMColor src = SkPreMultiplyColor(color);
+        while (h --> 0) {
+            loop(w, dst, (const SkPMColor*)dst, src, cov,
+                    adapt([](__m256i d, __m256i s, __m256i c) {
+                // SrcOver blend mode, with coverage folded into source alpha.
+                __m256i sc = scale(s,c),
+                        AC = inv(alphas(sc));
+                return _mm256_add_epi16(sc, scale(d,AC));
+            }));
+            dst += dstRB / sizeof(*dst);
+            cov += covRB / sizeof(*cov);
+        }
+    }
+}
+
+}  // namespace sk_avx2_new
+
+#endif
+
+namespace sk_avx2 {
+    // F16C converts 8 halfs at a time, exactly.  (We build this file with -mf16c too.)
+    static void half_to_float(float dst[], const uint16_t src[], int n) {
+        while (n >= 8) {
+            _mm256_storeu_ps(dst, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)src)));
+            dst += 8;
+            src += 8;
+            n   -= 8;
+        }
+        while (n --> 0) {
+            *dst++ = _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(*src++)));
+        }
+    }
+}
+
+namespace SkOpts {
+    void Init_avx2() {
+        box_blur_xx = sk_avx2::box_blur_xx;
+        box_blur_xy = sk_avx2::box_blur_xy;
+        box_blur_yx = sk_avx2::box_blur_yx;
+
+        dilate_x = sk_avx2::dilate_x;
+        dilate_y = sk_avx2::dilate_y;
+         erode_x = sk_avx2::erode_x;
+         erode_y = sk_avx2::erode_y;
+
+        color_cube_filter_span = sk_avx2::color_cube_filter_span;
+
+    #ifndef SK_SUPPORT_LEGACY_X86_BLITS
+        blit_row_color32 = sk_avx2_new::blit_row_color32;
+        blit_mask_d32_a8 = sk_avx2_new::blit_mask_d32_a8;
+    #endif
+        blit_row_s32a_opaque = sk_avx2::blit_row_s32a_opaque;
+
+        RGBA_to_BGRA   = sk_avx2::RGBA_to_BGRA;
+        RGBA_to_rgbA   = sk_avx2::RGBA_to_rgbA;
+        RGBA_to_bgrA   = sk_avx2::RGBA_to_bgrA;
+        RGB_to_RGB1    = sk_avx2::RGB_to_RGB1;
+        RGB_to_BGR1    = sk_avx2::RGB_to_BGR1;
+        gray_to_RGB1   = sk_avx2::gray_to_RGB1;
+        RGBX_to_RGB1   = sk_avx2::RGBX_to_RGB1;
+        RGBX_to_BGR1   = sk_avx2::RGBX_to_BGR1;
+        PMColor_to_565 = sk_avx2::PMColor_to_565;
+
+        half_to_float = sk_avx2::half_to_float;
+    }
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkOpts.h"
+
+#define SK_OPTS_NS sk_avx512
+#include "SkBlitRow_opts.h"
+#include "SkBlurImageFilter_opts.h"
+#include "SkColorCubeFilter_opts.h"
+#include "SkMorphologyImageFilter_opts.h"
+#include "SkSwizzler_opts.h"
+
+#include <immintrin.h>
+
+// The MSVC versions we support can't target AVX-512, so SkOpts.cpp leaves this tier out there.
+#if !defined(_MSC_VER)
+
+// AVX-512 (F + BW) versions of the hottest entries, 16 pixels at a time.  Box blur, morphology,
+// color cube and the premul swizzles come from their _opts.h headers, which widen themselves when
+// built for AVX-512.  Everything else keeps the AVX2 tier's code, which Init_avx512() runs on top
+// of.
+namespace sk_avx512_new {
+
+static void RGBA_to_BGRA(uint32_t* dst, const void* vsrc, int count) {
+    auto src = (const uint32_t*)vsrc;
+    const __m512i swapRB = _mm512_broadcast_i32x4(
+            _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15));
+
+    while (count >= 16) {
+        __m512i rgba = _mm512_loadu_si512((const void*) src);
+        _mm512_storeu_si512((void*) dst, _mm512_shuffle_epi8(rgba, swapRB));
+        src += 16;
+        dst += 16;
+        count -= 16;
+    }
+    if (count > 0) {
+        // Masked loads and stores let us finish the tail without touching memory past the end.
+        const __mmask16 mask = (__mmask16)((1u << count) - 1);
+        __m512i rgba = _mm512_maskz_loadu_epi32(mask, src);
+        _mm512_mask_storeu_epi32(dst, mask, _mm512_shuffle_epi8(rgba, swapRB));
+    }
+}
+
+static void half_to_float(float dst[], const uint16_t src[], int n) {
+    while (n >= 16) {
+        _mm512_storeu_ps(dst, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)src)));
+        dst += 16;
+        src += 16;
+        n   -= 16;
+    }
+    if (n > 0) {
+        const __mmask16 mask = (__mmask16)((1u << n) - 1);
+        __m256i halfs = _mm256_maskz_loadu_epi16(mask, src);
+        _mm512_mask_storeu_ps(dst, mask, _mm512_cvtph_ps(halfs));
+    }
+}
+
+// SkPMSrcOver_SSE2(), 16 pixels at a time.
+static __m512i srcover(const __m512i& src, const __m512i& dst) {
+    const __m512i mask = _mm512_set1_epi32(0xFF00FF);
+    __m512i scale = _mm512_sub_epi32(_mm512_set1_epi32(256),
+                                     _mm512_srli_epi32(_mm512_slli_epi32(src, 24 - SK_A32_SHIFT),
+                                                       24));
+    __m512i s = _mm512_or_si512(_mm512_slli_epi32(scale, 16), scale);
+
+    __m512i rb = _mm512_srli_epi16(_mm512_mullo_epi16(_mm512_and_si512(mask, dst), s), 8),
+            ag = _mm512_mullo_epi16(_mm512_srli_epi16(dst, 8), s);
+    return _mm512_add_epi32(src, _mm512_or_si512(rb, _mm512_andnot_si512(mask, ag)));
+}
+
+static void blit_row_s32a_opaque(SkPMColor* dst, const SkPMColor* src, int len, U8CPU alpha) {
+    SkASSERT(alpha == 0xFF);
+    const __m512i alphaMask = _mm512_set1_epi32(0xFF000000);
+
+    while (len >= 16) {
+        __m512i s = _mm512_loadu_si512((const void*)src);
+
+        const __mmask16 hasAlpha = _mm512_test_epi32_mask(s, alphaMask);
+        if (hasAlpha == 0) {
+            // All 16 source pixels are transparent.  Nothing to do.
+        } else if (_mm512_cmpeq_epi32_mask(_mm512_and_si512(s, alphaMask), alphaMask) == 0xFFFF) {
+            // All 16 source pixels are opaque.  SrcOver becomes Src.
+            _mm512_storeu_si512((void*)dst, s);
+        } else {
+            // Do SrcOver, with the same math as the SSE and AVX2 paths.
+            _mm512_storeu_si512((void*)dst, srcover(s, _mm512_loadu_si512((const void*)dst)));
+        }
+        src += 16;
+        dst += 16;
+        len -= 16;
+    }
+
+    // Fewer than 16 pixels left; they take the portable path.
+    sk_avx512::blit_row_s32a_opaque(dst, src, len, alpha);
+}
+
+#ifndef SK_SUPPORT_LEGACY_X86_BLITS
+
+// The blits below are SkOpts_avx2.cpp's, 16 pixels at a time, with masked loads and stores for
+// the tail.  The math is identical, so results match exactly.
+
+// Load 16 constant pixels or coverages (4x replicated).
+static __m512i next16(uint32_t val, __mmask16) { return _mm512_set1_epi32(val); }
+static __m512i next16(uint8_t  val, __mmask16) { return _mm512_set1_epi8(val); }
+
+// Load up to 16 variable pixels or coverages (4x replicated), those not in mask as zero,
+// incrementing the pointer past them.
+static __m512i next16(const uint32_t*& ptr, __mmask16 mask) {
+    auto r = _mm512_maskz_loadu_epi32(mask, ptr);
+    ptr += 16;
+    return r;
+}
+static __m512i next16(const uint8_t*& ptr, __mmask16 mask) {
+    // Zero extend each coverage byte to 32 bits, then multiply to copy it into all four bytes.
+    auto r = _mm512_mullo_epi32(_mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(mask, ptr)),
+                                _mm512_set1_epi32(0x01010101));
+    ptr += 16;
+    return r;
+}
+
+// For i = 0...n, tgt = fn(dst,src,cov), where Dst,Src,and Cov can be constants or arrays.
+template <typename Dst, typename Src, typename Cov, typename Fn>
+static void loop(int n, uint32_t* t, const Dst dst, const Src src, const Cov cov, Fn&& fn) {
+    // We don't want to muck with the callers' pointers, so we make them const and copy here.
+    Dst d = dst;
+    Src s = src;
+    Cov c = cov;
+
+    while (n > 0) {
+        const __mmask16 mask = n >= 16 ? 0xFFFF : (__mmask16)((1u << n) - 1);
+        _mm512_mask_storeu_epi32(t, mask, fn(next16(d, mask), next16(s, mask), next16(c, mask)));
+        t += 16;
+        n -= 16;
+    }
+}
+
+// Unpack to 16-bit lanes, call fn, and repack, all within 128-bit lanes.
+template <typename Fn>
+struct Adapt {
+    Fn fn;
+
+    __m512i operator()(__m512i d, __m512i s, __m512i c) {
+        auto lo = [](__m512i x) { return _mm512_unpacklo_epi8(x, _mm512_setzero_si512()); };
+        auto hi = [](__m512i x) { return _mm512_unpackhi_epi8(x, _mm512_setzero_si512()); };
+        return _mm512_packus_epi16(fn(lo(d), lo(s), lo(c)),
+                                   fn(hi(d), hi(s), hi(c)));
+    }
+};
+
+template <typename Fn>
+static Adapt<Fn> adapt(Fn&& fn) { return { fn }; }
+
+// Divide by 255 with rounding.
+// (x+127)/255 == ((x+128)*257)>>16.
+static __m512i div255_part1(__m512i x) { return _mm512_add_epi16(x, _mm512_set1_epi16(128)); }
+static __m512i div255_part2(__m512i x) { return _mm512_mulhi_epu16(x, _mm512_set1_epi16(257)); }
+static __m512i div255(__m512i x) { return div255_part2(div255_part1(x)); }
+
+// (x*y+127)/255, a byte multiply.
+static __m512i scale(__m512i x, __m512i y) { return div255(_mm512_mullo_epi16(x, y)); }
+
+// (255 * x).
+static __m512i mul255(__m512i x) { return _mm512_sub_epi16(_mm512_slli_epi16(x, 8), x); }
+
+// (255 - x).
+static __m512i inv(__m512i x) { return _mm512_xor_si512(_mm512_set1_epi16(0x00ff), x); }
+
+// ARGB argb -> AAAA aaaa, in each 128-bit lane.
+static __m512i alphas(__m512i px) {
+    const int a = 2 * (SK_A32_SHIFT/8);  // SK_A32_SHIFT is typically 24, so this is typically 6.
+    const int _ = ~0;
+    return _mm512_shuffle_epi8(px, _mm512_broadcast_i32x4(_mm_setr_epi8(a+0,_,a+0,_,a+0,_,a+0,_,
+                                                                         a+8,_,a+8,_,a+8,_,a+8,_)));
+}
+
+// SrcOver, with a constant source and full coverage.
+static void blit_row_color32(SkPMColor* tgt, const SkPMColor* dst, int n, SkPMColor src) {
+    __m512i s = _mm512_unpacklo_epi8(_mm512_set1_epi32(src), _mm512_setzero_si512()),
+            s_255_128 = div255_part1(mul255(s)),
+            A = inv(alphas(s));
+
+    const uint8_t cov = 0xff;
+    loop(n, tgt, dst, src, cov, adapt([=](__m512i d, __m512i, __m512i) {
+        return div255_part2(_mm512_add_epi16(s_255_128, _mm512_mullo_epi16(d, A)));
+    }));
+}
+
+// SrcOver, with a constant source and variable coverage.
+// If the source is opaque, SrcOver becomes Src.
+static void blit_mask_d32_a8(SkPMColor* dst,     size_t dstRB,
+                             const SkAlpha* cov, size_t covRB,
+                             SkColor color, int w, int h) {
+    if (SkColorGetA(color) == 0xFF) {
+        const SkPMColor src = SkSwizzle_BGRA_to_PMColor(color);
+        while (h --> 0) {
+            loop(w, dst, (const SkPMColor*)dst, src, cov,
+                    adapt([](__m512i d, __m512i s, __m512i c) {
+                // Src blend mode: a simple lerp from d to s by c.
+                return div255(_mm512_add_epi16(_mm512_mullo_epi16(inv(c),d),
+                                               _mm512_mullo_epi16(    c ,s)));
+            }));
+            dst += dstRB / sizeof(*dst);
+            cov += covRB / sizeof(*cov);
+        }
+    } else {
+        const SkPMColor src = SkPreMultiplyColor(color);
+        while (h --> 0) {
+            loop(w, dst, (const SkPMColor*)dst, src, cov,
+                    adapt([](__m512i d, __m512i s, __m512i c) {
+                // SrcOver blend mode, with coverage folded into source alpha.
+                __m512i sc = scale(s,c),
+                        AC = inv(alphas(sc));
+                return _mm512_add_epi16(sc, scale(d,AC));
+            }));
+            dst += dstRB / sizeof(*dst);
+            cov += covRB / sizeof(*cov);
+        }
+    }
+}
+
+#endif
+
+}  // namespace sk_avx512_new
+
+namespace SkOpts {
+    void Init_avx512() {
+        RGBA_to_BGRA         = sk_avx512_new::RGBA_to_BGRA;
+        RGBA_to_rgbA         = sk_avx512::RGBA_to_rgbA;
+        RGBA_to_bgrA         = sk_avx512::RGBA_to_bgrA;
+        half_to_float        = sk_avx512_new::half_to_float;
+        blit_row_s32a_opaque = sk_avx512_new::blit_row_s32a_opaque;
+    #ifndef SK_SUPPORT_LEGACY_X86_BLITS
+        blit_row_color32     = sk_avx512_new::blit_row_color32;
+        blit_mask_d32_a8     = sk_avx512_new::blit_mask_d32_a8;
+    #endif
+
+        box_blur_xx = sk_avx512::box_blur_xx;
+        box_blur_xy = sk_avx512::box_blur_xy;
+        box_blur_yx = sk_avx512::box_blur_yx;
+
+        dilate_x = sk_avx512::dilate_x;
+        dilate_y = sk_avx512::dilate_y;
+         erode_x = sk_avx512::erode_x;
+         erode_y = sk_avx512::erode_y;
+
+        color_cube_filter_span = sk_avx512::color_cube_filter_span;
+    }
+}
+
+#endif
@@ -50,5 +50,8 @@ namespace SkOpts {
         grayA_to_rgbA         = sk_neon::grayA_to_rgbA;
         inverted_CMYK_to_RGB1 = sk_neon::inverted_CMYK_to_RGB1;
         inverted_CMYK_to_BGR1 = sk_neon::inverted_CMYK_to_BGR1;
+        RGBX_to_RGB1          = sk_neon::RGBX_to_RGB1;
+        RGBX_to_BGR1          = sk_neon::RGBX_to_BGR1;
+        PMColor_to_565        = sk_neon::PMColor_to_565;
     }
 }
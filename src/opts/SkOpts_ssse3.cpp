@@ -28,5 +28,8 @@ namespace SkOpts {
         grayA_to_rgbA         = sk_ssse3::grayA_to_rgbA;
         inverted_CMYK_to_RGB1 = sk_ssse3::inverted_CMYK_to_RGB1;
         inverted_CMYK_to_BGR1 = sk_ssse3::inverted_CMYK_to_BGR1;
+        RGBX_to_RGB1          = sk_ssse3::RGBX_to_RGB1;
+        RGBX_to_BGR1          = sk_ssse3::RGBX_to_BGR1;
+        PMColor_to_565        = sk_ssse3::PMColor_to_565;
     }
 }
@@ -160,6 +160,32 @@ static void inverted_CMYK_to_BGR1_portable(uint32_t* dst, const void* vsrc, int
     }
 }
 
+static void RGBX_to_RGB1_portable(uint32_t dst[], const void* vsrc, int count) {
+    const uint32_t* src = (const uint32_t*)vsrc;
+    for (int i = 0; i < count; i++) {
+        dst[i] = (uint32_t)0xFF << 24 | src[i];
+    }
+}
+
+static void RGBX_to_BGR1_portable(uint32_t dst[], const void* vsrc, int count) {
+    const uint32_t* src = (const uint32_t*)vsrc;
+    for (int i = 0; i < count; i++) {
+        uint8_t b = src[i] >> 16,
+                g = src[i] >>  8,
+                r = src[i] >>  0;
+        dst[i] = (uint32_t)0xFF << 24
+               | (uint32_t)r    << 16
+               | (uint32_t)g    <<  8
+               | (uint32_t)b    <<  0;
+    }
+}
+
+static void PMColor_to_565_portable(uint16_t dst[], const uint32_t src[], int count) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = SkPixel32ToPixel16(src[i]);
+    }
+}
+
 #if defined(SK_ARM_HAS_NEON)
 
 // Rounded divide by 255, (x + 127) / 255
@@ -484,6 +510,78 @@ static void inverted_CMYK_to_BGR1(uint32_t dst[], const void* src, int count) {
     inverted_cmyk_to<kBGR1>(dst, src, count);
 }
 
+template <bool kSwapRB>
+static void set_alpha_should_swaprb(uint32_t dst[], const void* vsrc, int count) {
+    auto src = (const uint32_t*)vsrc;
+    while (count >= 16) {
+        // Load 16 pixels.
+        uint8x16x4_t rgba = vld4q_u8((const uint8_t*) src);
+
+        // Make them opaque and swap if needed.
+        if (kSwapRB) {
+            SkTSwap(rgba.val[0], rgba.val[2]);
+        }
+        rgba.val[3] = vdupq_n_u8(0xFF);
+
+        // Store 16 pixels.
+        vst4q_u8((uint8_t*) dst, rgba);
+        src += 16;
+        dst += 16;
+        count -= 16;
+    }
+
+    if (count >= 8) {
+        // Load 8 pixels.
+        uint8x8x4_t rgba = vld4_u8((const uint8_t*) src);
+
+        // Make them opaque and swap if needed.
+        if (kSwapRB) {
+            SkTSwap(rgba.val[0], rgba.val[2]);
+        }
+        rgba.val[3] = vdup_n_u8(0xFF);
+
+        // Store 8 pixels.
+        vst4_u8((uint8_t*) dst, rgba);
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+
+    auto proc = kSwapRB ? RGBX_to_BGR1_portable : RGBX_to_RGB1_portable;
+    proc(dst, src, count);
+}
+
+static void RGBX_to_RGB1(uint32_t dst[], const void* src, int count) {
+    set_alpha_should_swaprb<false>(dst, src, count);
+}
+
+static void RGBX_to_BGR1(uint32_t dst[], const void* src, int count) {
+    set_alpha_should_swaprb<true>(dst, src, count);
+}
+
+static void PMColor_to_565(uint16_t dst[], const uint32_t src[], int count) {
+    static_assert(SK_R16_SHIFT == 11 && SK_G16_SHIFT == 5 && SK_B16_SHIFT == 0, "");
+    while (count >= 8) {
+        // Load 8 pixels, planar.
+        uint8x8x4_t px = vld4_u8((const uint8_t*) src);
+
+        // Widen each channel to the top of a 16-bit lane, then shift-and-insert
+        // green and blue below red, dropping the low bits of each.
+        uint16x8_t r = vshll_n_u8(px.val[SK_R32_SHIFT/8], 8),
+                   g = vshll_n_u8(px.val[SK_G32_SHIFT/8], 8),
+                   b = vshll_n_u8(px.val[SK_B32_SHIFT/8], 8);
+        uint16x8_t rgb = vsriq_n_u16(vsriq_n_u16(r, g, 5), b, 11);
+
+        // Store 8 pixels.
+        vst1q_u16(dst, rgb);
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+
+    PMColor_to_565_portable(dst, src, count);
+}
+
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
 
 // Scale a byte by another.
@@ -533,6 +631,108 @@ static void premul_should_swapRB(uint32_t* dst, const void* vsrc, int count) {
         *hi = _mm_unpackhi_epi16(rg, ba);                         // RGBARGBA RGBARGBA
     };
 
+#if defined(__AVX512BW__)
+    // The same steps as premul8(), 32 pixels at a time, again all within 128-bit lanes.
+    auto premul32 = [](__m512i* lo, __m512i* hi) {
+        const __m512i zeros = _mm512_setzero_si512();
+        const __m512i planar = _mm512_broadcast_i32x4(
+                kSwapRB ? _mm_setr_epi8(2,6,10,14, 1,5,9,13, 0,4,8,12, 3,7,11,15)
+                        : _mm_setr_epi8(0,4,8,12, 1,5,9,13, 2,6,10,14, 3,7,11,15));
+        auto scale16 = [](__m512i x, __m512i y) {
+            return _mm512_mulhi_epu16(_mm512_add_epi16(_mm512_mullo_epi16(x, y),
+                                                       _mm512_set1_epi16(128)),
+                                      _mm512_set1_epi16(257));
+        };
+
+        *lo = _mm512_shuffle_epi8(*lo, planar);
+        *hi = _mm512_shuffle_epi8(*hi, planar);
+        __m512i rg = _mm512_unpacklo_epi32(*lo, *hi),
+                ba = _mm512_unpackhi_epi32(*lo, *hi);
+
+        __m512i r = _mm512_unpacklo_epi8(rg, zeros),
+                g = _mm512_unpackhi_epi8(rg, zeros),
+                b = _mm512_unpacklo_epi8(ba, zeros),
+                a = _mm512_unpackhi_epi8(ba, zeros);
+
+        r = scale16(r, a);
+        g = scale16(g, a);
+        b = scale16(b, a);
+
+        rg = _mm512_or_si512(r, _mm512_slli_epi16(g, 8));
+        ba = _mm512_or_si512(b, _mm512_slli_epi16(a, 8));
+        *lo = _mm512_unpacklo_epi16(rg, ba);
+        *hi = _mm512_unpackhi_epi16(rg, ba);
+    };
+
+    while (count >= 32) {
+        __m512i lo = _mm512_loadu_si512(src +  0),
+                hi = _mm512_loadu_si512(src + 16);
+
+        premul32(&lo, &hi);
+
+        _mm512_storeu_si512(dst +  0, lo);
+        _mm512_storeu_si512(dst + 16, hi);
+
+        src += 32;
+        dst += 32;
+        count -= 32;
+    }
+#endif
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    // The same steps as premul8(), 16 pixels at a time.  Every step works within 128-bit lanes,
+    // so each lane of lo and hi comes back holding the same pixels it started with.
+    auto premul16 = [](__m256i* lo, __m256i* hi) {
+        const __m256i zeros = _mm256_setzero_si256();
+        __m256i planar;
+        if (kSwapRB) {
+            planar = _mm256_setr_epi8(2,6,10,14, 1,5,9,13, 0,4,8,12, 3,7,11,15,
+                                      2,6,10,14, 1,5,9,13, 0,4,8,12, 3,7,11,15);
+        } else {
+            planar = _mm256_setr_epi8(0,4,8,12, 1,5,9,13, 2,6,10,14, 3,7,11,15,
+                                      0,4,8,12, 1,5,9,13, 2,6,10,14, 3,7,11,15);
+        }
+        auto scale16 = [](__m256i x, __m256i y) {
+            return _mm256_mulhi_epu16(_mm256_add_epi16(_mm256_mullo_epi16(x, y),
+                                                       _mm256_set1_epi16(128)),
+                                      _mm256_set1_epi16(257));
+        };
+
+        *lo = _mm256_shuffle_epi8(*lo, planar);
+        *hi = _mm256_shuffle_epi8(*hi, planar);
+        __m256i rg = _mm256_unpacklo_epi32(*lo, *hi),
+                ba = _mm256_unpackhi_epi32(*lo, *hi);
+
+        __m256i r = _mm256_unpacklo_epi8(rg, zeros),
+                g = _mm256_unpackhi_epi8(rg, zeros),
+                b = _mm256_unpacklo_epi8(ba, zeros),
+                a = _mm256_unpackhi_epi8(ba, zeros);
+
+        r = scale16(r, a);
+        g = scale16(g, a);
+        b = scale16(b, a);
+
+        rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+        ba = _mm256_or_si256(b, _mm256_slli_epi16(a, 8));
+        *lo = _mm256_unpacklo_epi16(rg, ba);
+        *hi = _mm256_unpackhi_epi16(rg, ba);
+    };
+
+    while (count >= 16) {
+        __m256i lo = _mm256_loadu_si256((const __m256i*) (src + 0)),
+                hi = _mm256_loadu_si256((const __m256i*) (src + 8));
+
+        premul16(&lo, &hi);
+
+        _mm256_storeu_si256((__m256i*) (dst + 0), lo);
+        _mm256_storeu_si256((__m256i*) (dst + 8), hi);
+
+        src += 16;
+        dst += 16;
+        count -= 16;
+    }
+#endif
+
     while (count >= 8) {
         __m128i lo = _mm_loadu_si128((const __m128i*) (src + 0)),
                 hi = _mm_loadu_si128((const __m128i*) (src + 4));
@@ -577,6 +777,19 @@ static void RGBA_to_BGRA(uint32_t* dst, const void* vsrc, int count) {
     auto src = (const uint32_t*)vsrc;
     const __m128i swapRB = _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    const __m256i swapRB8 = _mm256_broadcastsi128_si256(swapRB);
+    while (count >= 8) {
+        __m256i rgba = _mm256_loadu_si256((const __m256i*) src);
+        __m256i bgra = _mm256_shuffle_epi8(rgba, swapRB8);
+        _mm256_storeu_si256((__m256i*) dst, bgra);
+
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+#endif
+
     while (count >= 4) {
         __m128i rgba = _mm_loadu_si128((const __m128i*) src);
         __m128i bgra = _mm_shuffle_epi8(rgba, swapRB);
@@ -603,6 +816,25 @@ static void insert_alpha_should_swaprb(uint32_t dst[], const void* vsrc, int cou
         expand = _mm_setr_epi8(0,1,2,X, 3,4,5,X, 6,7,8,X, 9,10,11,X);
     }
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    const __m256i expand8 = _mm256_broadcastsi128_si256(expand);
+    while (count >= 10) {
+        // Load 4 pixels into each lane, reading 16 bytes from each of src and src+12.
+        // That reads as far as src[27], so we need at least 10 pixels to be safe.
+        __m256i rgb = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*) (src +  0))),
+                                       _mm_loadu_si128((const __m128i*) (src + 12)), 1);
+
+        __m256i rgba = _mm256_or_si256(_mm256_shuffle_epi8(rgb, expand8),
+                                       _mm256_set1_epi32(0xFF000000));
+        _mm256_storeu_si256((__m256i*) dst, rgba);
+
+        src += 8*3;
+        dst += 8;
+        count -= 8;
+    }
+#endif
+
     while (count >= 6) {
         // Load a vector.  While this actually contains 5 pixels plus an
         // extra component, we will discard all but the first four pixels on
@@ -636,6 +868,23 @@ static void RGB_to_BGR1(uint32_t dst[], const void* src, int count) {
 static void gray_to_RGB1(uint32_t dst[], const void* vsrc, int count) {
     const uint8_t* src = (const uint8_t*) vsrc;
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    // Put 8 grays in each lane, then spread 4 of them out to pixels in each lane.
+    const int8_t Z = -1;  // Shuffles in a zero.
+    const __m256i spread = _mm256_setr_epi8(0,0,0,Z, 1,1,1,Z, 2,2,2,Z, 3,3,3,Z,
+                                            4,4,4,Z, 5,5,5,Z, 6,6,6,Z, 7,7,7,Z);
+    while (count >= 8) {
+        __m256i grays = _mm256_broadcastq_epi64(_mm_loadl_epi64((const __m128i*) src));
+        __m256i ggg1 = _mm256_or_si256(_mm256_shuffle_epi8(grays, spread),
+                                       _mm256_set1_epi32(0xFF000000));
+        _mm256_storeu_si256((__m256i*) dst, ggg1);
+
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+#endif
+
     const __m128i alphas = _mm_set1_epi8((uint8_t) 0xFF);
     while (count >= 16) {
         __m128i grays = _mm_loadu_si128((const __m128i*) src);
@@ -791,6 +1040,112 @@ static void inverted_CMYK_to_BGR1(uint32_t dst[], const void* src, int count) {
     inverted_cmyk_to<kBGR1>(dst, src, count);
 }
 
+template <bool kSwapRB>
+static void set_alpha_should_swaprb(uint32_t dst[], const void* vsrc, int count) {
+    auto src = (const uint32_t*)vsrc;
+    const __m128i swapRB = _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    const __m256i swapRB8 = _mm256_broadcastsi128_si256(swapRB);
+    while (count >= 8) {
+        __m256i rgba = _mm256_loadu_si256((const __m256i*) src);
+        if (kSwapRB) {
+            rgba = _mm256_shuffle_epi8(rgba, swapRB8);
+        }
+        rgba = _mm256_or_si256(rgba, _mm256_set1_epi32(0xFF000000));
+        _mm256_storeu_si256((__m256i*) dst, rgba);
+
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+#endif
+
+    while (count >= 4) {
+        __m128i rgba = _mm_loadu_si128((const __m128i*) src);
+        if (kSwapRB) {
+            rgba = _mm_shuffle_epi8(rgba, swapRB);
+        }
+        rgba = _mm_or_si128(rgba, _mm_set1_epi32(0xFF000000));
+        _mm_storeu_si128((__m128i*) dst, rgba);
+
+        src += 4;
+        dst += 4;
+        count -= 4;
+    }
+
+    auto proc = kSwapRB ? RGBX_to_BGR1_portable : RGBX_to_RGB1_portable;
+    proc(dst, src, count);
+}
+
+static void RGBX_to_RGB1(uint32_t dst[], const void* src, int count) {
+    set_alpha_should_swaprb<false>(dst, src, count);
+}
+
+static void RGBX_to_BGR1(uint32_t dst[], const void* src, int count) {
+    set_alpha_should_swaprb<true>(dst, src, count);
+}
+
+static void PMColor_to_565(uint16_t dst[], const uint32_t src[], int count) {
+    // Pack 4 pixels to 565 in the bottom half of each 32-bit lane.
+    auto pack4 = [](__m128i px) {
+        __m128i r = _mm_and_si128(_mm_srli_epi32(px, SK_R32_SHIFT + 3), _mm_set1_epi32(0x1F)),
+                g = _mm_and_si128(_mm_srli_epi32(px, SK_G32_SHIFT + 2), _mm_set1_epi32(0x3F)),
+                b = _mm_and_si128(_mm_srli_epi32(px, SK_B32_SHIFT + 3), _mm_set1_epi32(0x1F));
+        return _mm_or_si128(_mm_slli_epi32(r, SK_R16_SHIFT),
+               _mm_or_si128(_mm_slli_epi32(g, SK_G16_SHIFT),
+                            _mm_slli_epi32(b, SK_B16_SHIFT)));
+    };
+    // Gathers the bottom halves of the lanes into the low 64 bits.
+    const int8_t Z = -1;  // Shuffles in a zero.
+    const __m128i narrow = _mm_setr_epi8(0,1, 4,5, 8,9, 12,13, Z,Z, Z,Z, Z,Z, Z,Z);
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    const __m256i narrow8 = _mm256_broadcastsi128_si256(narrow);
+    while (count >= 8) {
+        __m256i px = _mm256_loadu_si256((const __m256i*) src);
+        __m256i r = _mm256_and_si256(_mm256_srli_epi32(px, SK_R32_SHIFT + 3),
+                                     _mm256_set1_epi32(0x1F)),
+                g = _mm256_and_si256(_mm256_srli_epi32(px, SK_G32_SHIFT + 2),
+                                     _mm256_set1_epi32(0x3F)),
+                b = _mm256_and_si256(_mm256_srli_epi32(px, SK_B32_SHIFT + 3),
+                                     _mm256_set1_epi32(0x1F));
+        __m256i rgb = _mm256_or_si256(_mm256_slli_epi32(r, SK_R16_SHIFT),
+                      _mm256_or_si256(_mm256_slli_epi32(g, SK_G16_SHIFT),
+                                      _mm256_slli_epi32(b, SK_B16_SHIFT)));
+
+        // Narrow within each lane, then bring the two low 64-bit halves together.
+        rgb = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(rgb, narrow8), 0x08);
+        _mm_storeu_si128((__m128i*) dst, _mm256_castsi256_si128(rgb));
+
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+#endif
+
+    while (count >= 8) {
+        __m128i lo = _mm_shuffle_epi8(pack4(_mm_loadu_si128((const __m128i*) (src + 0))), narrow),
+                hi = _mm_shuffle_epi8(pack4(_mm_loadu_si128((const __m128i*) (src + 4))), narrow);
+        _mm_storeu_si128((__m128i*) dst, _mm_unpacklo_epi64(lo, hi));
+
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+
+    if (count >= 4) {
+        __m128i rgb = _mm_shuffle_epi8(pack4(_mm_loadu_si128((const __m128i*) src)), narrow);
+        _mm_storel_epi64((__m128i*) dst, rgb);
+
+        src += 4;
+        dst += 4;
+        count -= 4;
+    }
+
+    PMColor_to_565_portable(dst, src, count);
+}
+
 #else
 
 static void RGBA_to_rgbA(uint32_t* dst, const void* src, int count) {
@@ -833,6 +1188,18 @@ static void inverted_CMYK_to_BGR1(uint32_t dst[], const void* src, int count) {
     inverted_CMYK_to_BGR1_portable(dst, src, count);
 }
 
+static void RGBX_to_RGB1(uint32_t dst[], const void* src, int count) {
+    RGBX_to_RGB1_portable(dst, src, count);
+}
+
+static void RGBX_to_BGR1(uint32_t dst[], const void* src, int count) {
+    RGBX_to_BGR1_portable(dst, src, count);
+}
+
+static void PMColor_to_565(uint16_t dst[], const uint32_t src[], int count) {
+    PMColor_to_565_portable(dst, src, count);
+}
+
 #endif
 
 }
@@ -6,6 +6,7 @@
  */
 
 #include "SkBitmapFilter_opts_SSE2.h"
+#include "SkBitmapFilter_opts_avx2.h"
 #include "SkBitmapProcState_opts_SSE2.h"
 #include "SkBitmapProcState_opts_SSSE3.h"
 #include "SkBitmapScaler.h"
@@ -45,6 +46,11 @@ void SkBitmapScaler::PlatformConvolutionProcs(SkConvolutionProcs* procs) {
         procs->fConvolveHorizontally = &convolveHorizontally_SSE2;
         procs->fApplySIMDPadding = &applySIMDPadding_SSE2;
     }
+    if (SkCpu::Supports(SkCpu::AVX2)) {
+        procs->fConvolveVertically = &convolveVertically_avx2;
+        procs->fConvolve4RowsHorizontally = &convolve4RowsHorizontally_avx2;
+        procs->fConvolveHorizontally = &convolveHorizontally_avx2;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
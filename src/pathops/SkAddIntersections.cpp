@@ -7,6 +7,9 @@
 #include "SkAddIntersections.h"
 #include "SkOpCoincidence.h"
 #include "SkPathOpsBounds.h"
+#include "SkTDArray.h"
+#include "SkTemplates.h"
+#include "SkTSort.h"
 
 #if DEBUG_ADD_INTERSECTING_TS
 
@@ -254,6 +257,127 @@ static void debugShowCubicIntersection(int , const SkIntersectionHelper& ,
 }
 #endif
 
+// Finds, in contour order, the segments of a contour whose bounds may intersect another segment's.
+// When many pairs would be tested, the contour's segments are indexed by a uniform grid of
+// horizontal bands, so pairs far apart are never visited.  Otherwise the contour is just walked.
+class SkSegmentGrid {
+public:
+    SkSegmentGrid(SkOpContour* contour, int queryCount)
+        : fContour(contour)
+        , fCount(contour->count() * queryCount >= kMinGridPairs &&
+                 SkScalarIsFinite(contour->bounds().height()) ? contour->count() : 0)
+        , fCursor(0)
+        , fStamp(0) {
+        if (!fCount) {
+            return;
+        }
+        fSegments.reset(fCount);
+        fStamps.reset(fCount);
+        SkOpSegment* segment = contour->first();
+        for (int index = 0; index < fCount; ++index, segment = segment->next()) {
+            fSegments[index] = segment;
+            fStamps[index] = 0;
+        }
+        const SkPathOpsBounds& bounds = contour->bounds();
+        fTop = bounds.fTop;
+        fBands = bounds.height() > 0 ? SkTPin(fCount / kSegmentsPerBand, 1, kMaxBands) : 1;
+        fScale = fBands / SkTMax(bounds.height(), SK_ScalarNearlyZero);
+
+        // Each band lists, in contour order, the segments whose bounds reach it.
+        fStarts.reset(fBands + 1);
+        sk_bzero(fStarts.get(), (fBands + 1) * sizeof(int));
+        for (int index = 0; index < fCount; ++index) {
+            for (int band = this->band(fSegments[index]->bounds().fTop);
+                    band <= this->band(fSegments[index]->bounds().fBottom); ++band) {
+                ++fStarts[band + 1];
+            }
+        }
+        for (int band = 0; band < fBands; ++band) {
+            fStarts[band + 1] += fStarts[band];
+        }
+        fEntries.reset(fStarts[fBands]);
+        SkAutoTMalloc<int> fill(fBands);
+        memcpy(fill.get(), fStarts.get(), fBands * sizeof(int));
+        for (int index = 0; index < fCount; ++index) {
+            for (int band = this->band(fSegments[index]->bounds().fTop);
+                    band <= this->band(fSegments[index]->bounds().fBottom); ++band) {
+                fEntries[fill[band]++] = index;
+            }
+        }
+    }
+
+    // Sets wn to the first candidate for wt, which is the wtIndex'th segment of the contour if
+    // sameContour.  Then only segments after it are candidates.
+    bool first(const SkIntersectionHelper& wt, bool sameContour, int wtIndex,
+               SkIntersectionHelper* wn) {
+        if (!fCount) {
+            if (sameContour) {
+                return wn->startAfter(wt);
+            }
+            wn->init(fContour);
+            return true;
+        }
+        const int skip = sameContour ? wtIndex + 1 : 0;
+        // The bounds test tolerates a few ulps, so look a band further either way to be sure.
+        const SkPathOpsBounds& bounds = wt.bounds();
+        const int firstBand = SkTMax(this->band(bounds.fTop) - 1, 0),
+                  lastBand = SkTMin(this->band(bounds.fBottom) + 1, fBands - 1);
+        ++fStamp;
+        fCandidates.rewind();
+        for (int band = firstBand; band <= lastBand; ++band) {
+            for (int entry = fStarts[band]; entry < fStarts[band + 1]; ++entry) {
+                const int index = fEntries[entry];
+                if (index >= skip && fStamps[index] != fStamp) {
+                    fStamps[index] = fStamp;
+                    if (SkPathOpsBounds::Intersects(bounds, fSegments[index]->bounds())) {
+                        *fCandidates.append() = index;
+                    }
+                }
+            }
+        }
+        if (fCandidates.isEmpty()) {
+            return false;
+        }
+        SkTQSort(fCandidates.begin(), fCandidates.end() - 1);
+        fCursor = 0;
+        wn->init(fSegments[fCandidates[0]]);
+        return true;
+    }
+
+    bool next(SkIntersectionHelper* wn) {
+        if (!fCount) {
+            return wn->advance();
+        }
+        if (++fCursor >= fCandidates.count()) {
+            return false;
+        }
+        wn->init(fSegments[fCandidates[fCursor]]);
+        return true;
+    }
+
+private:
+    static const int kMinGridPairs = 1024;
+    static const int kSegmentsPerBand = 4;
+    static const int kMaxBands = 1024;
+
+    int band(SkScalar y) const {
+        return (int) SkTPin((y - fTop) * fScale, 0.f, (float) (fBands - 1));
+    }
+
+    SkOpContour* fContour;
+    int fCount;  // zero if the contour is walked rather than indexed
+    int fBands;
+    SkScalar fTop;
+    SkScalar fScale;
+    SkAutoTMalloc<SkOpSegment*> fSegments;
+    SkAutoTMalloc<int> fStarts;  // fEntries index of each band's first segment
+    SkAutoTMalloc<int> fEntries;
+    SkAutoTMalloc<int> fStamps;  // the last query to visit each segment
+    SkTDArray<int> fCandidates;
+    int fCursor;
+    int fStamp;
+};
+
 bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coincidence,
         SkChunkAlloc* allocator) {
     if (test != next) {
@@ -265,14 +389,15 @@ bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coinc
             return true;
         }
     }
+    SkSegmentGrid grid(next, test->count());
     SkIntersectionHelper wt;
     wt.init(test);
+    int wtIndex = 0;
     do {
         SkIntersectionHelper wn;
-        wn.init(next);
         test->debugValidate();
         next->debugValidate();
-        if (test == next && !wn.startAfter(wt)) {
+        if (!grid.first(wt, test == next, wtIndex, &wn)) {
             continue;
         }
         do {
@@ -546,7 +671,7 @@ bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coinc
                 coinIndex = -1;
             }
             SkASSERT(coinIndex < 0);  // expect coincidence to be paired
-        } while (wn.advance());
-    } while (wt.advance());
+        } while (grid.next(&wn));
+    } while (++wtIndex, wt.advance());
     return true;
 }
@@ -44,6 +44,10 @@ public:
         fSegment = contour->first();
     }
 
+    void init(SkOpSegment* segment) {
+        fSegment = segment;
+    }
+
     SkScalar left() const {
         return bounds().fLeft;
     }
@@ -10,6 +10,8 @@
 #include "SkPathPriv.h"
 #include "SkPathOps.h"
 #include "SkPathOpsCommon.h"
+#include "SkTaskGroup.h"
+#include "SkTSort.h"
 
 static bool one_contour(const SkPath& path) {
     SkChunkAlloc allocator(256);
@@ -85,6 +87,9 @@ void FixWinding(SkPath* path) {
     path->setFillType(fillType);
 }
 
+// Unioning this many paths or more is done in batches.
+static const int kMinUnionBatch = 8;
+
 void SkOpBuilder::add(const SkPath& path, SkPathOp op) {
     if (0 == fOps.count() && op != kUnion_SkPathOp) {
         fPathRefs.push_back() = SkPath();
@@ -99,12 +104,136 @@ void SkOpBuilder::reset() {
     fOps.reset();
 }
 
+// Paths whose bounds overlap or touch, directly or through others, form a cluster.  Clusters can't
+// affect each other's union, so each is reduced on its own, and the results are just appended.
+static void cluster_by_bounds(const SkTArray<SkPath>& paths, SkTArray<SkTArray<SkPath>>* clusters) {
+    const int count = paths.count();
+    SkAutoTMalloc<int> order(count), parent(count), clusterOf(count);
+    for (int index = 0; index < count; ++index) {
+        order[index] = parent[index] = index;
+    }
+    auto left_of = [&paths](int a, int b) {
+        return paths[a].getBounds().fLeft < paths[b].getBounds().fLeft;
+    };
+    SkTQSort(order.get(), order.get() + count - 1, left_of);
+    auto root = [&parent](int index) {
+        while (parent[index] != index) {
+            index = parent[index] = parent[parent[index]];
+        }
+        return index;
+    };
+
+    // Sweep left to right: a path can only meet those after it that start before it ends.
+    for (int i = 0; i < count; ++i) {
+        const SkRect& a = paths[order[i]].getBounds();
+        for (int j = i + 1; j < count; ++j) {
+            const SkRect& b = paths[order[j]].getBounds();
+            if (b.fLeft > a.fRight) {
+                break;
+            }
+            if (b.fTop <= a.fBottom && a.fTop <= b.fBottom) {
+                parent[root(order[j])] = root(order[i]);
+            }
+        }
+    }
+
+    // Keep each cluster in sweep order, so neighbors in its reduction tend to be close.
+    for (int index = 0; index < count; ++index) {
+        clusterOf[index] = -1;
+    }
+    for (int i = 0; i < count; ++i) {
+        int& cluster = clusterOf[root(order[i])];
+        if (cluster < 0) {
+            cluster = clusters->count();
+            clusters->push_back();
+        }
+        (*clusters)[cluster].push_back(paths[order[i]]);
+    }
+}
+
+// Unions many paths by clustering them, then reducing each cluster as a balanced tree of
+// pairwise unions.  Each level's unions are independent, so they run in parallel.
+static bool union_batch(const SkTArray<SkPath>& paths, SkPath* result) {
+    SkTArray<SkPath> nonEmpty;
+    for (int index = 0; index < paths.count(); ++index) {
+        if (!paths[index].isEmpty()) {
+            nonEmpty.push_back(paths[index]);
+        }
+    }
+    SkTArray<SkTArray<SkPath>> clusters;
+    cluster_by_bounds(nonEmpty, &clusters);
+
+    // A cluster of one path still needs simplifying, as every union's result is.
+    SkTDArray<SkPath*> alone;
+    for (int index = 0; index < clusters.count(); ++index) {
+        if (1 == clusters[index].count()) {
+            *alone.append() = &clusters[index][0];
+        }
+    }
+    SkAutoTMalloc<bool> ok(SkTMax(alone.count(), nonEmpty.count() / 2));
+    sk_parallel_for(alone.count(), 1, [&](int index) {
+        ok[index] = Simplify(*alone[index], alone[index]);
+    });
+    for (int index = 0; index < alone.count(); ++index) {
+        if (!ok[index]) {
+            return false;
+        }
+    }
+
+    struct Pair { SkPath* fA; const SkPath* fB; };
+    SkTDArray<Pair> pairs;
+    for (int stride = 1; ; stride *= 2) {
+        pairs.rewind();
+        for (int index = 0; index < clusters.count(); ++index) {
+            SkTArray<SkPath>& cluster = clusters[index];
+            for (int a = 0; a + stride < cluster.count(); a += 2 * stride) {
+                *pairs.append() = { &cluster[a], &cluster[a + stride] };
+            }
+        }
+        if (pairs.isEmpty()) {
+            break;
+        }
+        sk_parallel_for(pairs.count(), 1, [&](int index) {
+            ok[index] = Op(*pairs[index].fA, *pairs[index].fB, kUnion_SkPathOp, pairs[index].fA);
+        });
+        for (int index = 0; index < pairs.count(); ++index) {
+            if (!ok[index]) {
+                return false;
+            }
+        }
+    }
+
+    result->reset();
+    for (int index = 0; index < clusters.count(); ++index) {
+        result->addPath(clusters[index][0]);
+    }
+    result->setFillType(SkPath::kEvenOdd_FillType);
+    return true;
+}
+
 /* OPTIMIZATION: Union doesn't need to be all-or-nothing. A run of three or more convex
    paths with union ops could be locally resolved and still improve over doing the
    ops one at a time. */
 bool SkOpBuilder::resolve(SkPath* result) {
     SkPath original = *result;
     int count = fOps.count();
+    if (count >= kMinUnionBatch) {
+        bool unionOnly = true;
+        for (int index = 0; index < count; ++index) {
+            if (kUnion_SkPathOp != fOps[index] || fPathRefs[index].isInverseFillType()) {
+                unionOnly = false;
+                break;
+            }
+        }
+        if (unionOnly) {
+            bool success = union_batch(fPathRefs, result);
+            if (!success) {
+                *result = original;
+            }
+            reset();
+            return success;
+        }
+    }
     bool allUnion = true;
     SkPathPriv::FirstDirection firstDir = SkPathPriv::kUnknown_FirstDirection;
     for (int index = 0; index < count; ++index) {
@@ -6,6 +6,21 @@
  */
 
 #include "SkPathOpsTSect.h"
+#include "SkTLS.h"
+
+void* SkTSectHeap::Create() {
+    return new SkTSectHeap;
+}
+
+void SkTSectHeap::Delete(void* heap) {
+    delete static_cast<SkTSectHeap*>(heap);
+}
+
+SkTSectHeap* SkTSectHeap::Acquire() {
+    SkTSectHeap* heap = static_cast<SkTSectHeap*>(SkTLS::Get(Create, Delete));
+    heap->fUsers++;
+    return heap;
+}
 
 int SkIntersections::intersect(const SkDQuad& quad1, const SkDQuad& quad2) {
     SkTSect<SkDQuad, SkDQuad> sect1(quad1 PATH_OPS_DEBUG_T_SECT_PARAMS(1));
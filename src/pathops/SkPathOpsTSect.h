@@ -213,10 +213,38 @@ private:
     friend class SkTSpan<OppCurve, TCurve>;
 };
 
+// The spans of every SkTSect on a thread come from one heap, rewound rather than freed once the
+// last of them is done, so after the first few curve pairs intersecting them rarely mallocs.
+class SkTSectHeap {
+public:
+    static SkTSectHeap* Acquire();
+
+    void release() {
+        SkASSERT(fUsers > 0);
+        if (0 == --fUsers) {
+            fHeap.rewind();
+        }
+    }
+
+    SkChunkAlloc* heap() { return &fHeap; }
+
+private:
+    SkTSectHeap() : fHeap(kMinBlockSize), fUsers(0) {}
+
+    static void* Create();
+    static void Delete(void*);
+
+    static const size_t kMinBlockSize = 4096;
+
+    SkChunkAlloc fHeap;
+    int fUsers;
+};
+
 template<typename TCurve, typename OppCurve>
 class SkTSect {
 public:
     SkTSect(const TCurve& c  PATH_OPS_DEBUG_T_SECT_PARAMS(int id));
+    ~SkTSect() { fPool->release(); }
     static void BinarySearch(SkTSect* sect1, SkTSect<OppCurve, TCurve>* sect2,
             SkIntersections* intersections);
 
@@ -312,7 +340,8 @@ private:
     void validateBounded() const;
 
     const TCurve& fCurve;
-    SkChunkAlloc fHeap;
+    SkTSectHeap* fPool;
+    SkChunkAlloc& fHeap;
     SkTSpan<TCurve, OppCurve>* fHead;
     SkTSpan<TCurve, OppCurve>* fCoincident;
     SkTSpan<TCurve, OppCurve>* fDeleted;
@@ -828,7 +857,8 @@ void SkTSpan<TCurve, OppCurve>::validatePerpPt(double t, const SkDPoint& pt) con
 template<typename TCurve, typename OppCurve>
 SkTSect<TCurve, OppCurve>::SkTSect(const TCurve& c PATH_OPS_DEBUG_T_SECT_PARAMS(int id))
     : fCurve(c)
-    , fHeap(sizeof(SkTSpan<TCurve, OppCurve>) * 4)
+    , fPool(SkTSectHeap::Acquire())
+    , fHeap(*fPool->heap())
     , fCoincident(nullptr)
     , fDeleted(nullptr)
     , fActiveCount(0)
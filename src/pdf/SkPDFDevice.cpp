@@ -1373,6 +1373,12 @@ const SkTDArray<SkPDFFont*>& SkPDFDevice::getFontResources() const {
     return fFontResources;
 }
 
+void SkPDFDevice::appendNonFontResources(SkTDArray<SkPDFObject*>* resources) const {
+    resources->append(fGraphicStateResources.count(), fGraphicStateResources.begin());
+    resources->append(fXObjectResources.count(), fXObjectResources.begin());
+    resources->append(fShaderResources.count(), fShaderResources.begin());
+}
+
 sk_sp<SkPDFArray> SkPDFDevice::copyMediaBox() const {
     auto mediaBox = sk_make_sp<SkPDFArray>();
     mediaBox->reserve(4);
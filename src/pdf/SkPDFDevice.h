@@ -138,6 +138,11 @@ public:
      */
     const SkTDArray<SkPDFFont*>& getFontResources() const;
 
+    /** Append the graphic states, XObjects and shaders used on this device,
+     *  i.e. all the resources but the fonts.
+     */
+    void appendNonFontResources(SkTDArray<SkPDFObject*>* resources) const;
+
     /** Add our annotations (link to urls and destinations) to the supplied
      *  array.
      *  @param array Array to add annotations to.
@@ -13,6 +13,8 @@
 #include "SkPDFStream.h"
 #include "SkPDFUtils.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
+#include "SkTHash.h"
 
 SkPDFObjectSerializer::SkPDFObjectSerializer() : fBaseOffset(0), fNextToBeSerialized(0) {}
 
@@ -48,24 +50,47 @@ void SkPDFObjectSerializer::serializeHeader(SkWStream* wStream, const SkPDFMetad
 }
 #undef SKPDF_MAGIC
 
+// At most this many objects are emitted in parallel, to bound the memory
+// their emitted bytes take while they wait their turn to be written.
+static const int kMaxParallelObjects = 16;
+
 // Serialize all objects in the fObjNumMap that have not yet been serialized;
+// Each object is emitted into its own buffer, in parallel, so the deflating of
+// content streams and images happens in parallel.  Then the buffers are
+// written in order.
 void SkPDFObjectSerializer::serializeObjects(SkWStream* wStream) {
     const SkTArray<sk_sp<SkPDFObject>>& objects = fObjNumMap.objects();
     while (fNextToBeSerialized < objects.count()) {
-        SkPDFObject* object = objects[fNextToBeSerialized].get();
-        int32_t index = fNextToBeSerialized + 1;  // Skip object 0.
-        // "The first entry in the [XREF] table (object number 0) is
-        // always free and has a generation number of 65,535; it is
-        // the head of the linked list of free objects."
-        SkASSERT(fOffsets.count() == fNextToBeSerialized);
-        fOffsets.push(this->offset(wStream));
-        SkASSERT(object == fSubstituteMap.getSubstitute(object));
-        wStream->writeDecAsText(index);
-        wStream->writeText(" 0 obj\n");  // Generation number is always 0.
-        object->emitObject(wStream, fObjNumMap, fSubstituteMap);
-        wStream->writeText("\nendobj\n");
-        object->drop();
-        ++fNextToBeSerialized;
+        const int first = fNextToBeSerialized;
+        const int count = SkTMin(objects.count() - first, kMaxParallelObjects);
+        std::unique_ptr<SkDynamicMemoryWStream[]> buffers;
+        if (count > 1) {
+            buffers.reset(new SkDynamicMemoryWStream[count]);
+            SkTaskGroup().batch(count, [&](int i) {
+                objects[first + i]->emitObject(&buffers[i], fObjNumMap, fSubstituteMap);
+            });
+        }
+        for (int i = 0; i < count; i++) {
+            SkPDFObject* object = objects[fNextToBeSerialized].get();
+            int32_t index = fNextToBeSerialized + 1;  // Skip object 0.
+            // "The first entry in the [XREF] table (object number 0) is
+            // always free and has a generation number of 65,535; it is
+            // the head of the linked list of free objects."
+            SkASSERT(fOffsets.count() == fNextToBeSerialized);
+            fOffsets.push(this->offset(wStream));
+            SkASSERT(object == fSubstituteMap.getSubstitute(object));
+            wStream->writeDecAsText(index);
+            wStream->writeText(" 0 obj\n");  // Generation number is always 0.
+            if (buffers) {
+                buffers[i].writeToStream(wStream);
+                buffers[i].reset();
+            } else {
+                object->emitObject(wStream, fObjNumMap, fSubstituteMap);
+            }
+            wStream->writeText("\nendobj\n");
+            object->drop();
+            ++fNextToBeSerialized;
+        }
     }
 }
 
@@ -228,7 +253,12 @@ SkPDFDocument::~SkPDFDocument() {
 
 void SkPDFDocument::serialize(const sk_sp<SkPDFObject>& object) {
     fObjectSerializer.addObjectRecursively(object);
-    fObjectSerializer.serializeObjects(this->getStream());
+    // Wait for a batch to serialize in parallel, or for the end of the page.
+    int queued = fObjectSerializer.fObjNumMap.objects().count() -
+                 fObjectSerializer.fNextToBeSerialized;
+    if (queued >= kMaxParallelObjects) {
+        fObjectSerializer.serializeObjects(this->getStream());
+    }
 }
 
 SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height,
@@ -275,15 +305,42 @@ void SkPDFDocument::onEndPage() {
     if (annotations->size() > 0) {
         page->insertObject("Annots", std::move(annotations));
     }
-    auto contentData = fPageDevice->content();
-    auto contentObject = sk_make_sp<SkPDFStream>(contentData.get());
-    this->serialize(contentObject);
+    // SkPDFSharedStream deflates when serialized, so in parallel with the page's images.
+    auto contentObject = sk_make_sp<SkPDFSharedStream>(fPageDevice->content().release());
+    fObjectSerializer.addObjectRecursively(contentObject);
+    this->serializeResources(*fPageDevice);
+    fObjectSerializer.serializeObjects(this->getStream());
     page->insertObjRef("Contents", std::move(contentObject));
     fPageDevice->appendDestinations(fDests.get(), page.get());
     fPages.emplace_back(std::move(page));
     fPageDevice.reset(nullptr);
 }
 
+// Serialize what we can of a page's resources now, so they can be dropped,
+// along with any images they hold, rather than kept until close.  Fonts, and
+// anything that uses one, must wait for close, where fonts are replaced by
+// subsets holding only the glyphs the whole document used.
+void SkPDFDocument::serializeResources(const SkPDFDevice& device) {
+    SkTHashSet<SkPDFObject*> fonts;
+    for (const auto& entry : fGlyphUsage) {
+        fonts.add(entry.fFont);
+    }
+    SkTDArray<SkPDFObject*> resources;
+    device.appendNonFontResources(&resources);
+    for (SkPDFObject* resource : resources) {
+        // Visit only what's new, as objects already serialized have been dropped.
+        SkPDFObjNumMap newObjects(&fObjectSerializer.fObjNumMap);
+        newObjects.addObjectRecursively(resource, fObjectSerializer.fSubstituteMap);
+        bool usesFont = false;
+        for (const sk_sp<SkPDFObject>& object : newObjects.objects()) {
+            usesFont = usesFont || fonts.contains(object.get());
+        }
+        if (!usesFont) {
+            fObjectSerializer.addObjectRecursively(sk_ref_sp(resource));
+        }
+    }
+}
+
 void SkPDFDocument::onAbort() {
     fCanvas.reset(nullptr);
     fPages.reset();
@@ -41,7 +41,9 @@ struct SkPDFObjectSerializer : SkNoncopyable {
 
 /** Concrete implementation of SkDocument that creates PDF files. This
     class does not produced linearized or optimized PDFs; instead it
-    it attempts to use a minimum amount of RAM. */
+    it attempts to use a minimum amount of RAM.  Each page and the
+    resources it uses are written out when the page ends, except for fonts
+    and whatever uses them, which wait until close() to be subset. */
 class SkPDFDocument : public SkDocument {
 public:
     SkPDFDocument(SkWStream*,
@@ -61,7 +63,8 @@ public:
        Serialize the object, as well as any other objects it
        indirectly refers to.  If any any other objects have been added
        to the SkPDFObjNumMap without serializing them, they will be
-       serialized as well.
+       serialized as well.  This may not happen until the end of the
+       page, so that objects can be serialized in parallel.
 
        It might go without saying that objects should not be changed
        after calling serialize, since those changes will be too late.
@@ -72,6 +75,8 @@ public:
     SkPDFCanon* canon() { return &fCanon; }
 
 private:
+    void serializeResources(const SkPDFDevice&);
+
     SkPDFObjectSerializer fObjectSerializer;
     SkPDFCanon fCanon;
     SkPDFGlyphSetMap fGlyphUsage;
@@ -545,7 +545,7 @@ SkPDFObject* SkPDFSubstituteMap::getSubstitute(SkPDFObject* object) const {
 ////////////////////////////////////////////////////////////////////////////////
 
 bool SkPDFObjNumMap::addObject(SkPDFObject* obj) {
-    if (fObjectNumbers.find(obj)) {
+    if (fObjectNumbers.find(obj) || (fPrevious && fPrevious->fObjectNumbers.find(obj))) {
         return false;
     }
     fObjectNumbers.set(obj, fObjectNumbers.count() + 1);
@@ -330,6 +330,14 @@ private:
 */
 class SkPDFObjNumMap : SkNoncopyable {
 public:
+    SkPDFObjNumMap() : fPrevious(nullptr) {}
+
+    /** A map that treats every object in previous as already added, so
+     *  addObjectRecursively() collects only objects new since previous.
+     *  The object numbers it hands out are meaningless.
+     */
+    explicit SkPDFObjNumMap(const SkPDFObjNumMap* previous) : fPrevious(previous) {}
+
     /** Add the passed object to the catalog.
      *  @param obj         The object to add.
      *  @return True iff the object was not already added to the catalog.
@@ -350,6 +358,7 @@ public:
     const SkTArray<sk_sp<SkPDFObject>>& objects() const { return fObjects; }
 
 private:
+    const SkPDFObjNumMap* fPrevious;
     SkTArray<sk_sp<SkPDFObject>> fObjects;
     SkTHashMap<SkPDFObject*, int32_t> fObjectNumbers;
 };
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "Sk4px.h"
 #include "SkAAClip.h"
 #include "SkCanvas.h"
 #include "SkMask.h"
@@ -435,6 +436,125 @@ static void test_crbug_422693(skiatest::Reporter* reporter) {
     rc.op(path, rc.getBounds(), SkRegion::kIntersect_Op, true);
 }
 
+static void check_path_clip(skiatest::Reporter* reporter, const SkPath& path,
+                            const SkMatrix& matrix, SkRegion::Op op, bool doAA) {
+    const SkIRect bounds = SkIRect::MakeWH(160, 160);
+    SkPath devPath;
+    path.transform(matrix, &devPath);
+
+    SkRasterClip expected(bounds), actual(bounds);
+    for (SkRasterClip* rc : { &expected, &actual }) {
+        rc->op(SkRect::MakeLTRB(5.5f, 5, 150, 150.5f), bounds, SkRegion::kIntersect_Op, true);
+    }
+    expected.op(devPath, bounds, op, doAA);
+    actual.op(path, matrix, devPath, bounds, op, doAA);
+    REPORTER_ASSERT(reporter, expected == actual);
+}
+
+// Clips made from a path are cached the second time they're seen, and found again under whole
+// pixel translations.  The path's coordinates are exact in floats under these matrices, and it
+// lies inside the clip, so scanning it whole for the cache must give just what scanning it
+// clipped does.  Each clip is made three times: once seen, once cached, once found.
+static void test_cached_path_clip(skiatest::Reporter* reporter) {
+    SkPath path;
+    path.moveTo(0, 0);
+    for (int i = 1; i < 12; i++) {
+        path.lineTo(SkIntToScalar(i * 8), SkIntToScalar((i & 1) ? 90 : 10 + i));
+    }
+    path.quadTo(40, -20, 0, 0);
+
+    static const SkScalar gTranslates[][2] = {
+        { 10, 20 }, { 10.25f, 17.5f }, { 13.25f, 15.5f }, { 8.75f, 20 }, { 10, 20 },
+    };
+    for (SkRegion::Op op : gRgnOps) {
+        for (bool doAA : { false, true }) {
+            for (const SkScalar* t : gTranslates) {
+                SkMatrix matrix;
+                matrix.setScale(1.5f, 1);
+                matrix.postTranslate(t[0], t[1]);
+                for (int i = 0; i < 3; i++) {
+                    check_path_clip(reporter, path, matrix, op, doAA);
+                }
+            }
+        }
+    }
+}
+
+// Changing a path's fill type keeps its gen ID, so the cache must tell the fill types apart.
+static void test_cached_path_clip_fill_type(skiatest::Reporter* reporter) {
+    SkPath star;
+    star.moveTo(80, 20);
+    for (int i = 1; i < 5; i++) {
+        const SkScalar angle = i * 4 * SK_ScalarPI / 5;
+        star.lineTo(80 + 60 * SkScalarSin(angle), 80 - 60 * SkScalarCos(angle));
+    }
+    star.close();
+    const uint32_t genID = star.getGenerationID();
+
+    for (bool doAA : { false, true }) {
+        for (SkPath::FillType fillType : { SkPath::kWinding_FillType,
+                                           SkPath::kEvenOdd_FillType,
+                                           SkPath::kWinding_FillType }) {
+            star.setFillType(fillType);
+            REPORTER_ASSERT(reporter, star.getGenerationID() == genID);
+            for (int i = 0; i < 3; i++) {
+                check_path_clip(reporter, star, SkMatrix::I(), SkRegion::kIntersect_Op, doAA);
+            }
+        }
+    }
+}
+
+// Rows busy with runs are intersected many alphas at a time, which must round just as one at a
+// time does.
+static void test_busy_intersect(skiatest::Reporter* reporter) {
+    for (int a = 0; a < 256; a++) {
+        uint8_t as[16], bs[16], products[16];
+        for (int b = 0; b < 256; b += 16) {
+            for (int i = 0; i < 16; i++) {
+                as[i] = a;
+                bs[i] = b + i;
+            }
+            Sk4px(Sk16b::Load(as)).mulWiden(Sk16b::Load(bs)).div255().store(products);
+            for (int i = 0; i < 16; i++) {
+                REPORTER_ASSERT(reporter, products[i] == SkMulDiv255Round(a, b + i));
+            }
+        }
+    }
+
+    SkPath stripes, spokes;
+    for (int i = 0; i < 40; i++) {
+        stripes.addRect(SkRect::MakeXYWH(i * 2.75f, 0, 1.25f, 100));
+    }
+    for (int i = 0; i < 60; i++) {
+        const SkScalar angle = i * SK_ScalarPI / 30;
+        spokes.moveTo(55, 50);
+        spokes.lineTo(55 + 60 * SkScalarCos(angle), 50 + 60 * SkScalarSin(angle));
+        spokes.lineTo(55 + 60 * SkScalarCos(angle + 0.05f), 50 + 60 * SkScalarSin(angle + 0.05f));
+        spokes.close();
+    }
+    SkAAClip clipA, clipB, sect;
+    clipA.setPath(stripes);
+    clipB.setPath(spokes);
+    REPORTER_ASSERT(reporter, sect.op(clipA, clipB, SkRegion::kIntersect_Op));
+
+    SkMask maskA, maskB, maskSect;
+    clipA.copyToMask(&maskA);
+    clipB.copyToMask(&maskB);
+    sect.copyToMask(&maskSect);
+    SkAutoMaskFreeImage freeA(maskA.fImage), freeB(maskB.fImage), freeSect(maskSect.fImage);
+    const SkIRect& b = clipB.getBounds();
+    for (int y = b.fTop; y < b.fBottom; y++) {
+        for (int x = b.fLeft; x < b.fRight; x++) {
+            U8CPU alpha = 0;
+            if (maskA.fBounds.contains(x, y)) {
+                alpha = SkMulDiv255Round(*maskA.getAddr8(x, y), *maskB.getAddr8(x, y));
+            }
+            const U8CPU actual = maskSect.fBounds.contains(x, y) ? *maskSect.getAddr8(x, y) : 0;
+            REPORTER_ASSERT(reporter, alpha == actual);
+        }
+    }
+}
+
 DEF_TEST(AAClip, reporter) {
     test_empty(reporter);
     test_path_bounds(reporter);
@@ -445,4 +565,7 @@ DEF_TEST(AAClip, reporter) {
     test_nearly_integral(reporter);
     test_really_a_rect(reporter);
     test_crbug_422693(reporter);
+    test_cached_path_clip(reporter);
+    test_cached_path_clip_fill_type(reporter);
+    test_busy_intersect(reporter);
 }
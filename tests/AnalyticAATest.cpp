@@ -0,0 +1,328 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBlitter.h"
+#include "SkGeometry.h"
+#include "SkMask.h"
+#include "SkPath.h"
+#include "SkRasterClip.h"
+#include "SkRRect.h"
+#include "SkScan.h"
+#include "SkTemplates.h"
+#include "Test.h"
+
+static const int kW = 64,
+                 kH = 64;
+
+// Records the coverage it's asked to blit into a kW x kH A8 buffer.
+struct CoverageBlitter : public SkBlitter {
+    CoverageBlitter() { sk_bzero(fCoverage, sizeof(fCoverage)); }
+
+    void blitH(int x, int y, int width) override {
+        memset(&fCoverage[y][x], 0xFF, width);
+    }
+    void blitAntiH(int x, int y, const SkAlpha alpha[], const int16_t runs[]) override {
+        for (int n = runs[0]; n > 0; n = runs[0]) {
+            memset(&fCoverage[y][x], alpha[0], n);
+            x     += n;
+            alpha += n;
+            runs  += n;
+        }
+    }
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        while (height --> 0) {
+            fCoverage[y++][x] = alpha;
+        }
+    }
+    void blitRect(int x, int y, int width, int height) override {
+        while (height --> 0) {
+            this->blitH(x, y++, width);
+        }
+    }
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        SkASSERT(mask.fFormat == SkMask::kA8_Format);
+        for (int y = clip.fTop; y < clip.fBottom; y++) {
+            for (int x = clip.fLeft; x < clip.fRight; x++) {
+                fCoverage[y][x] = *mask.getAddr8(x, y);
+            }
+        }
+    }
+
+    uint8_t fCoverage[kH][kW];
+};
+
+DEF_TEST(AnalyticAA_ExactCoverage, r) {
+    // Pixel coverage should be exactly the area of each pixel inside the path.
+    SkPath path;
+    path.addRect(SkRect::MakeLTRB(1.25f, 1.5f, 4.75f, 3.0f));
+
+    CoverageBlitter blitter;
+    SkScan::AAAFillPath(path, SkRasterClip(SkIRect::MakeWH(kW, kH)), &blitter);
+
+    REPORTER_ASSERT(r, blitter.fCoverage[0][1] == 0x00);
+    REPORTER_ASSERT(r, blitter.fCoverage[1][0] == 0x00);
+    REPORTER_ASSERT(r, blitter.fCoverage[1][1] == 0x60);  // 0.75 x 0.5
+    REPORTER_ASSERT(r, blitter.fCoverage[1][2] == 0x80);  // 1.0  x 0.5
+    REPORTER_ASSERT(r, blitter.fCoverage[1][4] == 0x60);  // 0.75 x 0.5
+    REPORTER_ASSERT(r, blitter.fCoverage[2][1] == 0xBF);  // 0.75 x 1.0
+    REPORTER_ASSERT(r, blitter.fCoverage[2][2] == 0xFF);
+    REPORTER_ASSERT(r, blitter.fCoverage[2][5] == 0x00);
+    REPORTER_ASSERT(r, blitter.fCoverage[3][2] == 0x00);
+
+    // A triangle cutting diagonally through a pixel covers half of it.
+    path.reset();
+    path.moveTo(10, 10);
+    path.lineTo(12, 10);
+    path.lineTo(10, 12);
+    path.close();
+
+    CoverageBlitter tri;
+    SkScan::AAAFillPath(path, SkRasterClip(SkIRect::MakeWH(kW, kH)), &tri);
+    REPORTER_ASSERT(r, tri.fCoverage[10][10] == 0xFF);
+    REPORTER_ASSERT(r, tri.fCoverage[10][11] == 0x80);
+    REPORTER_ASSERT(r, tri.fCoverage[11][10] == 0x80);
+    REPORTER_ASSERT(r, tri.fCoverage[11][11] == 0x00);
+}
+
+// Counts, for each pixel, how many of its kSamples x kSamples subpixel centers a path covers, by
+// filling the path scaled up kSamples times without anti-aliasing.
+static const int kSamples = 32;
+
+struct SampleBlitter : public SkBlitter {
+    SampleBlitter() { sk_bzero(fCount, sizeof(fCount)); }
+
+    void blitH(int x, int y, int width) override {
+        int* row = fCount[y / kSamples];
+        while (width > 0) {
+            int n = SkTMin(width, kSamples - x % kSamples);
+            row[x / kSamples] += n;
+            x     += n;
+            width -= n;
+        }
+    }
+    void blitRect(int x, int y, int width, int height) override {
+        while (height --> 0) {
+            this->blitH(x, y++, width);
+        }
+    }
+
+    int fCount[kH][kW];
+};
+
+// Coverage of the path within the clip, from kSamples x kSamples samples per pixel.  Straight
+// edges through a pixel may be off by a sample per subpixel row, less than 8/255.
+static void reference_coverage(const SkPath& path, const SkRasterClip& clip,
+                               uint8_t coverage[kH][kW]) {
+    SkPath scaled;
+    path.transform(SkMatrix::MakeScale(kSamples, kSamples), &scaled);
+    SampleBlitter samples;
+    SkScan::FillPath(scaled, SkRasterClip(SkIRect::MakeWH(kW * kSamples, kH * kSamples)),
+                     &samples);
+
+    SkMask clipMask;
+    clipMask.fImage = nullptr;
+    if (clip.isAA()) {
+        clip.aaRgn().copyToMask(&clipMask);
+    }
+    SkAutoMaskFreeImage freeClipMask(clipMask.fImage);
+
+    for (int y = 0; y < kH; y++) {
+        for (int x = 0; x < kW; x++) {
+            U8CPU alpha = (samples.fCount[y][x] * 255 + kSamples * kSamples / 2) /
+                          (kSamples * kSamples);
+            if (clip.isBW()) {
+                alpha = clip.bwRgn().contains(x, y) ? alpha : 0;
+            } else {
+                alpha = clipMask.fBounds.contains(x, y)
+                        ? SkMulDiv255Round(alpha, *clipMask.getAddr8(x, y)) : 0;
+            }
+            coverage[y][x] = alpha;
+        }
+    }
+}
+
+// Replaces each curve with 64 line segments, so the edge builder's own curve subdivision doesn't
+// count against the scan converter.
+static SkPath flatten(const SkPath& path) {
+    const int kSegments = 64;
+    SkPath lines;
+    lines.setFillType(path.getFillType());
+    SkPath::Iter iter(path, false);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                lines.moveTo(pts[0]);
+                break;
+            case SkPath::kLine_Verb:
+                lines.lineTo(pts[1]);
+                break;
+            case SkPath::kQuad_Verb:
+                for (int i = 1; i <= kSegments; i++) {
+                    SkPoint pt;
+                    SkEvalQuadAt(pts, SkIntToScalar(i) / kSegments, &pt);
+                    lines.lineTo(pt);
+                }
+                break;
+            case SkPath::kConic_Verb: {
+                SkConic conic(pts, iter.conicWeight());
+                for (int i = 1; i <= kSegments; i++) {
+                    lines.lineTo(conic.evalAt(SkIntToScalar(i) / kSegments));
+                }
+                break;
+            }
+            case SkPath::kCubic_Verb:
+                for (int i = 1; i <= kSegments; i++) {
+                    SkPoint pt;
+                    SkEvalCubicAt(pts, SkIntToScalar(i) / kSegments, &pt, nullptr, nullptr);
+                    lines.lineTo(pt);
+                }
+                break;
+            case SkPath::kClose_Verb:
+                lines.close();
+                break;
+            default:
+                break;
+        }
+    }
+    return lines;
+}
+
+// Pixels where two edges cross are only approximated, so a few of them may be off by more than
+// maxDiff, but never by more than kMaxCrossingDiff.
+static const int kMaxCrossingPixels = 4;
+static const int kMaxCrossingDiff   = 64;
+
+// Edges within a few levels of the reference, and on average within a sixteenth of that.
+static const int kMaxDiff = 4;
+// The edge builder splits curves into at most 2^6 lines, which can stray a tenth of a pixel or
+// so from the true curve.
+static const int kMaxCurveDiff = 48;
+
+static void compare(skiatest::Reporter* r, const char* name, const SkPath& path,
+                    const SkRasterClip& clip, int maxDiff) {
+    uint8_t expected[kH][kW];
+    reference_coverage(path, clip, expected);
+    CoverageBlitter analytic;
+    SkScan::AAAFillPath(path, clip, &analytic);
+
+    int outliers = 0, sumDiff = 0;
+    for (int y = 0; y < kH; y++) {
+        for (int x = 0; x < kW; x++) {
+            int diff = SkTAbs(expected[y][x] - analytic.fCoverage[y][x]);
+            REPORTER_ASSERT_MESSAGE(r, diff <= kMaxCrossingDiff, name);
+            outliers += diff > maxDiff;
+            sumDiff  += diff;
+        }
+    }
+    REPORTER_ASSERT_MESSAGE(r, outliers <= kMaxCrossingPixels, name);
+    REPORTER_ASSERT_MESSAGE(r, sumDiff <= kW * kH * maxDiff / 16, name);
+}
+
+DEF_TEST(AnalyticAA_MatchesSupersampling, r) {
+    const int kPathCount = 14;
+    SkPath paths[kPathCount];
+    const char* names[kPathCount] = {
+        "rect", "oval", "rrect", "star", "star_evenodd", "cubic", "sliver", "inverse_oval",
+        "concave", "concave_curves", "bowtie", "loops_evenodd", "near_vertical", "near_horizontal",
+    };
+    paths[0].addRect(SkRect::MakeLTRB(3.3f, 5.7f, 50.1f, 40.9f));
+    paths[1].addOval(SkRect::MakeLTRB(2.5f, 4.25f, 60.75f, 55.5f));
+    paths[2].addRRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(4, 4, 60, 60), 12, 20));
+    for (int i : { 3, 4 }) {
+        paths[i].moveTo(32, 2);
+        paths[i].lineTo(50, 60);
+        paths[i].lineTo(2, 22);
+        paths[i].lineTo(62, 22);
+        paths[i].lineTo(14, 60);
+        paths[i].close();
+    }
+    paths[4].setFillType(SkPath::kEvenOdd_FillType);
+    paths[5].moveTo(5, 60);
+    paths[5].cubicTo(-20, -10, 90, 10, 58, 61);
+    paths[5].close();
+    paths[6].moveTo(1, 1);
+    paths[6].lineTo(63, 30);
+    paths[6].lineTo(1, 1.75f);
+    paths[6].close();
+    paths[7].addOval(SkRect::MakeLTRB(10.5f, 8.2f, 54.25f, 50));
+    paths[7].setFillType(SkPath::kInverseWinding_FillType);
+    // An arrow head, notched deep into its base.
+    paths[8].moveTo(32.3f, 3.1f);
+    paths[8].lineTo(60.7f, 58.2f);
+    paths[8].lineTo(31.9f, 30.6f);
+    paths[8].lineTo(3.4f, 59.5f);
+    paths[8].close();
+    // A crescent, its inner curve bulging the same way as its outer one.
+    paths[9].moveTo(10, 5);
+    paths[9].cubicTo(70, 0, 70, 64, 10, 59);
+    paths[9].quadTo(45.5f, 32.2f, 10, 5);
+    // Two triangles meeting where their edges cross.
+    paths[10].moveTo(4.2f, 6.1f);
+    paths[10].lineTo(59.6f, 57.3f);
+    paths[10].lineTo(59.1f, 8.4f);
+    paths[10].lineTo(5.3f, 55.7f);
+    paths[10].close();
+    // A curve looping across itself twice, so the fill rule decides the inner regions.
+    paths[11].moveTo(6, 32);
+    paths[11].cubicTo(90, -30, 90, 94, 6, 32);
+    paths[11].moveTo(58, 32.5f);
+    paths[11].cubicTo(-26, -30, -26, 94, 58, 32.5f);
+    paths[11].setFillType(SkPath::kEvenOdd_FillType);
+    // Wedges whose long edges lean less than a pixel over the whole height, or width.
+    paths[12].moveTo(20.1f, 1.3f);
+    paths[12].lineTo(20.7f, 62.6f);
+    paths[12].lineTo(40.2f, 62.1f);
+    paths[12].lineTo(39.6f, 1.8f);
+    paths[12].close();
+    paths[13].moveTo(1.3f, 20.1f);
+    paths[13].lineTo(62.6f, 20.7f);
+    paths[13].lineTo(62.1f, 40.2f);
+    paths[13].lineTo(1.8f, 39.6f);
+    paths[13].close();
+
+    SkRasterClip clips[4] = {
+        SkRasterClip(SkIRect::MakeWH(kW, kH)),
+        SkRasterClip(SkIRect::MakeLTRB(7, 9, 41, 37)),
+        SkRasterClip(SkIRect::MakeLTRB(0, 0, 30, 30)),
+        SkRasterClip(SkIRect::MakeWH(kW, kH)),
+    };
+    // Clip to a rect that cuts through the path, then a complex region, then an AA clip.
+    clips[2].op(SkIRect::MakeLTRB(20, 25, 64, 64), SkRegion::kUnion_Op);
+    clips[3].op(SkRRect::MakeOval(SkRect::MakeLTRB(5.5f, 3.5f, 58.5f, 61.5f)),
+                SkIRect::MakeWH(kW, kH), SkRegion::kIntersect_Op, true);
+
+    for (int i = 0; i < kPathCount; i++) {
+        SkPath lines = flatten(paths[i]);
+        for (const SkRasterClip& clip : clips) {
+            compare(r, names[i], lines, clip, kMaxDiff);
+            compare(r, names[i], paths[i], clip, kMaxCurveDiff);
+        }
+    }
+}
+
+DEF_TEST(AnalyticAA_OffscreenEdges, r) {
+    // Edges far outside the clip still have to get their coverage right inside it.
+    SkPath path;
+    path.moveTo(-100000, -50000);
+    path.lineTo( 100000,  50000);
+    path.lineTo(-100000,  50000);
+    path.close();
+
+    CoverageBlitter blitter;
+    SkScan::AAAFillPath(path, SkRasterClip(SkIRect::MakeWH(kW, kH)), &blitter);
+
+    // The edge is x = 2y, crossing row 16 from (32,16) to (34,17).
+    REPORTER_ASSERT(r, blitter.fCoverage[ 8][ 8] == 0xFF);
+    REPORTER_ASSERT(r, blitter.fCoverage[ 8][24] == 0x00);
+    REPORTER_ASSERT(r, blitter.fCoverage[16][31] == 0xFF);
+    REPORTER_ASSERT(r, blitter.fCoverage[16][32] == 0xBF);  // 1/4 + 1/2
+    REPORTER_ASSERT(r, blitter.fCoverage[16][33] == 0x40);  // 1/4
+    REPORTER_ASSERT(r, blitter.fCoverage[16][34] == 0x00);
+    REPORTER_ASSERT(r, blitter.fCoverage[63][ 0] == 0xFF);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmapScaler.h"
+#include "SkConvolver.h"
+#include "SkRandom.h"
+#include "SkTemplates.h"
+#include "Test.h"
+
+// Adds a filter for each of count output pixels, reading from srcSize input pixels, and if asked,
+// each alone to one of filters.  Like the resize filters, they are spread evenly over the input,
+// and sum to about one.
+static void make_filter(SkRandom* rand, int srcSize, int count, int radius,
+                        SkConvolutionFilter1D* filter, SkConvolutionFilter1D* filters = nullptr) {
+    SkAutoTMalloc<SkConvolutionFilter1D::ConvolutionFixed> values(2 * radius + 1);
+    for (int i = 0; i < count; i++) {
+        const int center = (2 * i + 1) * srcSize / (2 * count),
+                  offset = SkTMax(0, center - radius),
+                  length = SkTMin(srcSize, center + radius + 1) - offset;
+        const int range = 2 * (1 << SkConvolutionFilter1D::kShiftBits) / length + 1000;
+        for (int j = 0; j < length; j++) {
+            // Mostly positive, with some zeros inside, but none at the ends for it to trim.
+            const int v = (int)rand->nextRangeU(0, range) - 1000;
+            if (0 == j || length - 1 == j) {
+                values[j] = SkToS16(v ? v : 1);
+            } else {
+                values[j] = rand->nextBool() ? 0 : SkToS16(v);
+            }
+        }
+        filter->AddFilter(offset, values.get(), length);
+        if (filters) {
+            filters[i].AddFilter(offset, values.get(), length);
+        }
+    }
+}
+
+// The platform's convolutions must match the portable ones exactly, whatever the widths of the
+// filters and images, and however the output rows are split into bands: the same as convolving
+// each row on its own.
+DEF_TEST(BitmapScaler_PlatformProcs, r) {
+    SkConvolutionProcs procs = { 0, nullptr, nullptr, nullptr, nullptr };
+    SkBitmapScaler::PlatformConvolutionProcs(&procs);
+    SkConvolutionProcs portable = { 0, nullptr, nullptr, nullptr, nullptr };
+
+    SkRandom rand;
+    const struct {
+        int srcW, srcH, dstW, dstH, radius;
+    } cases[] = {
+        {   1,   1,  1,  1,  0 },
+        {  13,   7,  5, 11,  2 },
+        {  37,  29, 19, 23,  4 },
+        {  70, 300, 33, 90, 12 },
+        { 300,  60, 77, 40, 20 },
+        {  40, 1200, 21, 200, 6 },
+    };
+    for (const auto& c : cases) {
+        SkAutoTMalloc<uint32_t> src(c.srcW * c.srcH);
+        for (int i = 0; i < c.srcW * c.srcH; i++) {
+            src[i] = rand.nextU();
+        }
+        SkConvolutionFilter1D filterX, filterY;
+        SkAutoTArray<SkConvolutionFilter1D> rowFilters(c.dstH);
+        make_filter(&rand, c.srcW, c.dstW, c.radius, &filterX);
+        make_filter(&rand, c.srcH, c.dstH, c.radius, &filterY, rowFilters.get());
+        if (procs.fApplySIMDPadding) {
+            procs.fApplySIMDPadding(&filterX);
+            procs.fApplySIMDPadding(&filterY);
+        }
+
+        const uint8_t* srcBytes = reinterpret_cast<const uint8_t*>(src.get());
+        const size_t dstSize = c.dstW * c.dstH * sizeof(uint32_t);
+        for (bool hasAlpha : { false, true }) {
+            SkAutoTMalloc<uint32_t> expected(c.dstW * c.dstH), actual(c.dstW * c.dstH);
+            for (int y = 0; y < c.dstH; y++) {
+                REPORTER_ASSERT(r, BGRAConvolve2D(srcBytes, c.srcW * 4, hasAlpha, filterX,
+                                                  rowFilters[y], c.dstW * 4,
+                                                  (uint8_t*)(expected.get() + y * c.dstW),
+                                                  portable, false));
+            }
+            for (const SkConvolutionProcs* p : { &portable, &procs }) {
+                sk_bzero(actual.get(), dstSize);
+                REPORTER_ASSERT(r, BGRAConvolve2D(srcBytes, c.srcW * 4, hasAlpha, filterX,
+                                                  filterY, c.dstW * 4, (uint8_t*)actual.get(),
+                                                  *p, true));
+                REPORTER_ASSERT(r, 0 == memcmp(expected.get(), actual.get(), dstSize));
+            }
+        }
+    }
+}
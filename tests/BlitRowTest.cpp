@@ -6,9 +6,11 @@
  */
 
 #include "SkBitmap.h"
+#include "SkBlitter.h"
 #include "SkCanvas.h"
 #include "SkColorPriv.h"
 #include "SkGradientShader.h"
+#include "SkRandom.h"
 #include "SkRect.h"
 #include "Test.h"
 
@@ -260,3 +262,117 @@ DEF_TEST(BlitRow, reporter) {
     test_00_FF(reporter);
     test_diagonal(reporter);
 }
+
+static void fill_random(SkRandom* rand, SkBitmap* bm) {
+    for (int x = 0; x < bm->width(); x++) {
+        *bm->getAddr32(x, 0) = SkPreMultiplyColor(rand->nextU());
+    }
+}
+
+static bool close_enough(SkPMColor a, SkPMColor b) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        if (SkTAbs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF)) > 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const int kAntiHWidth = 600;
+
+// Blitting a row of runs at once gathers its short runs into one span of coverage.  That should
+// match blitting each run on its own, to within the rounding of the vectorized blends.
+static void test_anti_h(skiatest::Reporter* r, SkRandom* rand, const int16_t runs[],
+                        const SkAlpha aa[]) {
+    const int kWidth = kAntiHWidth;
+
+    const SkPoint pts[] = { { 0, 0 }, { kWidth, 0 } };
+    const SkColor opaque[] = { SK_ColorRED, SK_ColorBLUE },
+                  translucent[] = { 0x80FF0000, 0x200000FF };
+    const struct {
+        SkColor            color;
+        const SkColor*     gradient;
+        SkXfermode::Mode   mode;
+    } cases[] = {
+        { SK_ColorBLACK, nullptr,     SkXfermode::kSrcOver_Mode },
+        { SK_ColorGREEN, nullptr,     SkXfermode::kSrcOver_Mode },
+        { 0x80408020,    nullptr,     SkXfermode::kSrcOver_Mode },
+        { SK_ColorBLACK, opaque,      SkXfermode::kSrcOver_Mode },
+        { SK_ColorBLACK, translucent, SkXfermode::kSrcOver_Mode },
+        { SK_ColorBLACK, translucent, SkXfermode::kSrc_Mode },
+        { SK_ColorBLACK, translucent, SkXfermode::kMultiply_Mode },
+    };
+    for (const auto& c : cases) {
+        SkPaint paint;
+        paint.setColor(c.color);
+        if (c.gradient) {
+            paint.setShader(SkGradientShader::MakeLinear(pts, c.gradient, nullptr, 2,
+                                                         SkShader::kClamp_TileMode));
+        }
+        paint.setXfermodeMode(c.mode);
+
+        SkBitmap whole, byRun;
+        whole.allocN32Pixels(kWidth, 1);
+        byRun.allocN32Pixels(kWidth, 1);
+        fill_random(rand, &whole);
+        memcpy(byRun.getPixels(), whole.getPixels(), whole.getSize());
+
+        SkPixmap wholePixels, byRunPixels;
+        whole.peekPixels(&wholePixels);
+        byRun.peekPixels(&byRunPixels);
+
+        SkTBlitterAllocator wholeAlloc, byRunAlloc;
+        SkBlitter* wholeBlitter = SkBlitter::Choose(wholePixels, SkMatrix::I(), paint,
+                                                    &wholeAlloc);
+        SkBlitter* byRunBlitter = SkBlitter::Choose(byRunPixels, SkMatrix::I(), paint,
+                                                    &byRunAlloc);
+
+        wholeBlitter->blitAntiH(0, 0, aa, runs);
+        for (int x = 0; x < kWidth; x += runs[x]) {
+            int16_t oneRun[kWidth + 1];
+            oneRun[0] = runs[x];
+            oneRun[runs[x]] = 0;
+            byRunBlitter->blitAntiH(x, 0, aa + x, oneRun);
+        }
+
+        for (int x = 0; x < kWidth; x++) {
+            REPORTER_ASSERT(r, close_enough(*whole.getAddr32(x, 0), *byRun.getAddr32(x, 0)));
+        }
+    }
+}
+
+DEF_TEST(BlitRow_AntiH, r) {
+    const int kWidth = kAntiHWidth;
+    SkRandom rand;
+
+    int16_t runs[kWidth + 1];
+    SkAlpha aa[kWidth + 1];
+    for (int x = 0; x < kWidth;) {
+        int count = rand.nextRangeU(0, 9) ? rand.nextRangeU(1, 4) : rand.nextRangeU(8, 40);
+        count = SkTMin(count, kWidth - x);
+        runs[x] = SkToS16(count);
+        switch (rand.nextRangeU(0, 4)) {
+            case 0:  aa[x] = 0;   break;
+            case 1:  aa[x] = 255; break;
+            default: aa[x] = SkToU8(rand.nextRangeU(1, 254)); break;
+        }
+        x += count;
+    }
+    runs[kWidth] = 0;
+    test_anti_h(r, &rand, runs, aa);
+
+    // Groups of one half covered pixel and two uncovered ones fill the 256 pixels of coverage
+    // blended at once, and the uncovered run that overflows it must not start the next stretch.
+    // Here that stretch holds only one covered run, which is blitted on its own.
+    int x = 0;
+    for (int i = 0; i < 87; i++) {
+        runs[x] = 1;
+        aa[x] = 128;
+        runs[x + 1] = 2;
+        aa[x + 1] = 0;
+        x += 3;
+    }
+    runs[x] = SkToS16(kWidth - x);
+    aa[x] = 0;
+    test_anti_h(r, &rand, runs, aa);
+}
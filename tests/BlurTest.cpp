@@ -8,6 +8,7 @@
 #include "SkBlurMask.h"
 #include "SkBlurMaskFilter.h"
 #include "SkBlurDrawLooper.h"
+#include "SkBlurImageFilter.h"
 #include "SkCanvas.h"
 #include "SkEmbossMaskFilter.h"
 #include "SkLayerDrawLooper.h"
@@ -375,6 +376,66 @@ DEF_TEST(BlurSigmaRange, reporter) {
     }
 }
 
+// Sigmas this large take the recursive Gaussian rather than the box blurs; its result should still
+// match a brute force Gaussian, for masks and for premultiplied color.
+DEF_TEST(BlurLargeSigma, reporter) {
+    static const int kSize = 100;
+
+    int bruteForce1DResult[kSize];
+    int maskResult[kSize];
+    int colorResult[kSize];
+
+    for (SkScalar sigma : { 8.0f, 50.0f, 100.0f }) {
+        brute_force_1d(-50.0f, 50.0f, sigma, bruteForce1DResult, kSize);
+        // At these sigmas the square's height attenuates its middle row too.
+        int expected[kSize];
+        for (int i = 0; i < kSize; ++i) {
+            expected[i] = SkMulDiv255Round(bruteForce1DResult[i], bruteForce1DResult[0]);
+        }
+
+        SkMask src, dst;
+        src.fBounds.set(0, 0, kSize, kSize);
+        src.fFormat = SkMask::kA8_Format;
+        src.fRowBytes = src.fBounds.width();
+        src.fImage = SkMask::AllocImage(src.computeTotalImageSize());
+        memset(src.fImage, 0xff, src.computeTotalImageSize());
+        REPORTER_ASSERT(reporter, SkBlurMask::BoxBlur(&dst, src, sigma, kNormal_SkBlurStyle,
+                                                      kHigh_SkBlurQuality));
+        const uint8_t* row = dst.getAddr8(dst.fBounds.centerX(), dst.fBounds.centerY());
+        for (int i = 0; i < kSize; ++i) {
+            maskResult[i] = i < dst.fBounds.fRight - dst.fBounds.centerX() ? row[i] : 0;
+        }
+        SkMask::FreeImage(src.fImage);
+        SkMask::FreeImage(dst.fImage);
+        REPORTER_ASSERT(reporter, match(maskResult, expected, kSize, 3));
+
+        const int bmSize = 2 * kSize + 2 * SkScalarCeilToInt(3 * sigma);
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(bmSize, bmSize);
+        SkCanvas canvas(bitmap);
+        canvas.clear(SK_ColorTRANSPARENT);
+        SkPaint paint;
+        paint.setColor(0xFF4080C0);
+        paint.setImageFilter(SkBlurImageFilter::Make(sigma, sigma, nullptr));
+        canvas.drawRect(SkRect::MakeXYWH(bmSize / 2 - kSize / 2, bmSize / 2 - kSize / 2,
+                                         kSize, kSize), paint);
+        bool premul = true;
+        for (int y = 0; y < bmSize; ++y) {
+            for (int x = 0; x < bmSize; ++x) {
+                SkPMColor c = *bitmap.getAddr32(x, y);
+                unsigned a = SkGetPackedA32(c);
+                premul &= SkGetPackedR32(c) <= a && SkGetPackedG32(c) <= a &&
+                          SkGetPackedB32(c) <= a;
+            }
+        }
+        REPORTER_ASSERT(reporter, premul);
+        for (int i = 0; i < kSize; ++i) {
+            colorResult[i] = SkGetPackedA32(*bitmap.getAddr32(bmSize / 2 + i, bmSize / 2));
+        }
+        REPORTER_ASSERT(reporter, match(colorResult, expected, kSize, 3));
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 
 static SkBlurQuality blurMaskFilterFlags_as_quality(uint32_t blurMaskFilterFlags) {
@@ -511,6 +511,36 @@ static void test_path_replace(skiatest::Reporter* reporter) {
     }
 }
 
+// An intersected rect covering every pixel the clip reaches isn't pushed, keeping the gen ID.
+static void test_redundant_rect(skiatest::Reporter* reporter) {
+    SkPath path;
+    path.addCircle(50.5f, 50.5f, 40);
+
+    for (bool doAA : { false, true }) {
+        SkClipStack stack;
+        stack.clipDevPath(path, SkRegion::kIntersect_Op, doAA);
+        const int32_t genID = stack.getTopmostGenID();
+        REPORTER_ASSERT(reporter, 1 == count(stack));
+
+        stack.clipDevRect(SkRect::MakeLTRB(10, 10, 91, 91), SkRegion::kIntersect_Op, doAA);
+        REPORTER_ASSERT(reporter, 1 == count(stack));
+        REPORTER_ASSERT(reporter, genID == stack.getTopmostGenID());
+
+        stack.save();
+        stack.clipDevRect(SkRect::MakeLTRB(0, 0, 100, 100), SkRegion::kIntersect_Op, !doAA);
+        REPORTER_ASSERT(reporter, 1 == count(stack));
+        REPORTER_ASSERT(reporter, genID == stack.getTopmostGenID());
+
+        // Rects cutting into the clip's bounds, even only its partly covered pixels, still count.
+        stack.clipDevRect(SkRect::MakeLTRB(10.5f, 10, 91, 91), SkRegion::kIntersect_Op, doAA);
+        REPORTER_ASSERT(reporter, 2 == count(stack));
+        REPORTER_ASSERT(reporter, genID != stack.getTopmostGenID());
+        stack.restore();
+        REPORTER_ASSERT(reporter, 1 == count(stack));
+        REPORTER_ASSERT(reporter, genID == stack.getTopmostGenID());
+    }
+}
+
 // Test out SkClipStack's merging of rect clips. In particular exercise
 // merging of aa vs. bw rects.
 static void test_rect_merging(skiatest::Reporter* reporter) {
@@ -600,7 +630,7 @@ static void test_rect_merging(skiatest::Reporter* reporter) {
         REPORTER_ASSERT(reporter, isIntersectionOfRects);
     }
 
-    // reverse nested (aa inside bw) - should _not_ merge
+    // reverse nested (aa around bw) - changes nothing, so isn't pushed at all
     {
         SkClipStack stack;
 
@@ -608,11 +638,12 @@ static void test_rect_merging(skiatest::Reporter* reporter) {
 
         stack.clipDevRect(nestedParent, SkRegion::kIntersect_Op, true);
 
-        REPORTER_ASSERT(reporter, 2 == count(stack));
+        REPORTER_ASSERT(reporter, 1 == count(stack));
 
         stack.getBounds(&bound, &type, &isIntersectionOfRects);
 
-        REPORTER_ASSERT(reporter, !isIntersectionOfRects);
+        REPORTER_ASSERT(reporter, isIntersectionOfRects);
+        REPORTER_ASSERT(reporter, bound == nestedChild);
     }
 }
 
@@ -1209,6 +1240,7 @@ DEF_TEST(ClipStack, reporter) {
     test_bounds(reporter, SkClipStack::Element::kPath_Type);
     test_isWideOpen(reporter);
     test_rect_merging(reporter);
+    test_redundant_rect(reporter);
     test_rect_replace(reporter);
     test_rect_inverse_fill(reporter);
     test_path_replace(reporter);
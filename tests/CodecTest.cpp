@@ -972,3 +972,64 @@ DEF_TEST(Codec_wbmp_max_size, r) {
 
     REPORTER_ASSERT(r, !codec);
 }
+
+static void decode_with_threads(skiatest::Reporter* r, SkData* data, const SkImageInfo& info,
+                                int maxThreads, SkBitmap* bm, SkCodec::Result expected) {
+    SkAutoTDelete<SkCodec> codec(SkCodec::NewFromData(data));
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+    bm->allocPixels(info);
+    bm->eraseColor(SK_ColorYELLOW);
+    SkCodec::Options options;
+    options.fMaxThreads = maxThreads;
+    SkPMColor colors[256];
+    int colorCount = 256;
+    SkCodec::Result result = codec->getPixels(info, bm->getPixels(), bm->rowBytes(), &options,
+                                              colors, &colorCount);
+    REPORTER_ASSERT(r, result == expected);
+}
+
+// Decoding with threads gives the same pixels as decoding without.
+static void test_threads(skiatest::Reporter* r, const char path[], float scale, size_t truncate) {
+    sk_sp<SkData> data = SkData::MakeFromFileName(GetResourcePath(path).c_str());
+    if (!data) {
+        SkDebugf("Missing resource '%s'\n", path);
+        return;
+    }
+    SkCodec::Result expected = SkCodec::kSuccess;
+    if (truncate) {
+        data = SkData::MakeSubset(data.get(), 0, data->size() - truncate);
+        expected = SkCodec::kIncompleteInput;
+    }
+    SkAutoTDelete<SkCodec> codec(SkCodec::NewFromData(data.get()));
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+    const SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType)
+                                             .makeWH(codec->getScaledDimensions(scale).width(),
+                                                     codec->getScaledDimensions(scale).height());
+    SkBitmap serial;
+    decode_with_threads(r, data.get(), info, 1, &serial, expected);
+    SkMD5::Digest digest;
+    md5(serial, &digest);
+    for (int maxThreads : { 2, 3, 8 }) {
+        SkBitmap threaded;
+        decode_with_threads(r, data.get(), info, maxThreads, &threaded, expected);
+        compare_to_good_digest(r, digest, threaded);
+    }
+}
+
+DEF_TEST(Codec_threads, r) {
+    // This JPEG has a restart marker at the end of each MCU row.
+    test_threads(r, "icc-v2-gbr.jpg", 1.0f, 0);
+    test_threads(r, "icc-v2-gbr.jpg", 0.5f, 0);
+    test_threads(r, "icc-v2-gbr.jpg", 0.125f, 0);
+    test_threads(r, "mandrill_512_q075.jpg", 1.0f, 0);
+    test_threads(r, "mandrill_512.png", 1.0f, 0);
+    test_threads(r, "yellow_rose.png", 1.0f, 0);
+    test_threads(r, "plane_interlaced.png", 1.0f, 0);
+    test_threads(r, "mandrill_512.png", 1.0f, 100000);
+}
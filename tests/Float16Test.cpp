@@ -68,6 +68,21 @@ DEF_TEST(float_to_half, reporter) {
     REPORTER_ASSERT(reporter, 0 == memcmp(fscratch, fs, sizeof(fs)));
 }
 
+DEF_TEST(half_to_float_all, reporter) {
+    // Wider CPU tiers convert 8 or 16 halfs at a time; check every half against SkHalfToFloat.
+    SkAutoTMalloc<uint16_t> hs(1 << 16);
+    SkAutoTMalloc<float>    fs(1 << 16);
+    for (int i = 0; i < (1 << 16); i++) {
+        hs[i] = (uint16_t)i;
+    }
+    // An odd count leaves a tail for the SIMD loops to finish.
+    SkOpts::half_to_float(fs.get(), hs.get(), (1 << 16) - 3);
+    for (int i = 0; i < (1 << 16) - 3; i++) {
+        float want = SkHalfToFloat(hs[i]);
+        REPORTER_ASSERT(reporter, fs[i] == want || (SkScalarIsNaN(fs[i]) && SkScalarIsNaN(want)));
+    }
+}
+
 static uint32_t u(float f) {
     uint32_t x;
     memcpy(&x, &f, 4);
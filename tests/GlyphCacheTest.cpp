@@ -0,0 +1,185 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Resources.h"
+#include "SkData.h"
+#include "SkGlyphCache.h"
+#include "SkGlyphDiskCache.h"
+#include "SkGraphics.h"
+#include "SkOSFile.h"
+#include "SkPaint.h"
+#include "SkPath.h"
+#include "SkRandomScalerContext.h"
+#include "SkStream.h"
+#include "SkTaskGroup.h"
+#include "Test.h"
+
+static void make_paint(SkPaint* paint) {
+    paint->setAntiAlias(true);
+    paint->setTextSize(17);
+}
+
+// Threads asking for the same strike share it, and all see the same glyphs.
+DEF_TEST(GlyphCache_shared_strike, reporter) {
+    SkPaint paint;
+    make_paint(&paint);
+
+    // Holding the strike ourselves keeps it from being purged or freed while we compare.
+    SkAutoGlyphCacheNoGamma held(paint, nullptr, nullptr);
+
+    const int kThreads = 8;
+    SkGlyphCache* caches[kThreads];
+    float advances[kThreads];
+    SkTaskGroup().batch(kThreads, [&](int i) {
+        SkAutoGlyphCacheNoGamma autoCache(paint, nullptr, nullptr);
+        SkGlyphCache* cache = autoCache.getCache();
+        float advance = 0;
+        for (int c = ' '; c < 'z'; c++) {
+            const SkGlyph& glyph = cache->getUnicharMetrics(c);
+            cache->findImage(glyph);
+            advance += glyph.fAdvanceX;
+        }
+        caches[i] = cache;
+        advances[i] = advance;
+    });
+
+    for (int i = 0; i < kThreads; i++) {
+        REPORTER_ASSERT(reporter, caches[i] == held.getCache());
+        REPORTER_ASSERT(reporter, advances[i] == advances[0]);
+    }
+}
+
+// A scaler may change a glyph's mask format as it draws the image, and the glyph must then
+// report the format its image was drawn in.
+DEF_TEST(GlyphCache_image_mask_format, reporter) {
+    SkAutoTUnref<SkTypeface> proxy(SkTypeface::RefDefault());
+    SkPaint paint;
+    make_paint(&paint);
+    // SkRandomScalerContext picks each glyph's format by its glyph ID.
+    SkAutoTUnref<SkTypeface> random(new SkRandomTypeface(proxy, paint, true));
+    paint.setTypeface(random);
+
+    SkAutoGlyphCacheNoGamma autoCache(paint, nullptr, nullptr);
+    SkGlyphCache* cache = autoCache.getCache();
+    for (int c = 'A'; c <= 'Z'; c++) {
+        const SkGlyph& glyph = cache->getUnicharMetrics(c);
+        SkMask::Format expected;
+        switch (glyph.getGlyphID() % 4) {
+            case 1:  expected = SkMask::kA8_Format;     break;
+            case 2:  expected = SkMask::kARGB32_Format; break;
+            case 3:  expected = SkMask::kBW_Format;     break;
+            // LCD images are bigger than the A8 ones measured for them, so skip them.
+            default: continue;
+        }
+        if (0 == glyph.fWidth) {
+            continue;
+        }
+        REPORTER_ASSERT(reporter, cache->findImage(glyph));
+        REPORTER_ASSERT(reporter, expected == glyph.fMaskFormat);
+    }
+}
+
+// Purging the font cache must not free a strike that is still in use.
+DEF_TEST(GlyphCache_purge_while_in_use, reporter) {
+    SkPaint paint;
+    make_paint(&paint);
+
+    SkAutoGlyphCacheNoGamma autoCache(paint, nullptr, nullptr);
+    SkGlyphCache* cache = autoCache.getCache();
+    const SkGlyph& before = cache->getUnicharMetrics('A');
+
+    SkGraphics::PurgeFontCache();
+
+    const SkGlyph& after = cache->getUnicharMetrics('A');
+    REPORTER_ASSERT(reporter, &before == &after);
+    REPORTER_ASSERT(reporter, cache->findImage(after) || 0 == after.fWidth);
+}
+
+// Saves the glyphs of a strike of our own, made from a typeface nobody else has, to a directory
+// of our own, and checks they load back as they were.  Nothing global is touched.
+DEF_TEST(GlyphCache_disk, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    SkAutoTUnref<SkTypeface> typeface(GetResourceAsTypeface("/fonts/Funkster.ttf"));
+    if (tmpDir.isEmpty() || !typeface) {
+        return;
+    }
+    SkString dir = SkOSPath::Join(tmpDir.c_str(), "glyph_disk_cache_test");
+    sk_mkdir(dir.c_str());
+
+    SkPaint paint;
+    make_paint(&paint);
+    paint.setTypeface(typeface);
+    SkAutoGlyphCacheNoGamma autoCache(paint, nullptr, nullptr);
+    SkGlyphCache* cache = autoCache.getCache();
+    const SkDescriptor& desc = cache->getDescriptor();
+
+    const int kCount = 26;
+    const SkGlyph* glyphs[kCount];
+    for (int i = 0; i < kCount; i++) {
+        const SkGlyph& glyph = cache->getUnicharMetrics('A' + i);
+        cache->findImage(glyph);
+        cache->findPath(glyph);
+        glyphs[i] = &glyph;
+    }
+
+    auto check = [&](const SkGlyphDiskCache& saved, int start, int count) {
+        for (int i = start; i < start + count; i++) {
+            const SkGlyph& glyph = *glyphs[i];
+            SkGlyph loaded;
+            loaded.initGlyphIdFrom(glyph);
+            REPORTER_ASSERT(reporter, saved.findMetrics(&loaded));
+            REPORTER_ASSERT(reporter, loaded.fAdvanceX   == glyph.fAdvanceX &&
+                                      loaded.fWidth      == glyph.fWidth &&
+                                      loaded.fHeight     == glyph.fHeight &&
+                                      loaded.fTop        == glyph.fTop &&
+                                      loaded.fLeft       == glyph.fLeft &&
+                                      loaded.fMaskFormat == glyph.fMaskFormat);
+            if (glyph.fImage) {
+                const void* image = saved.findImage(loaded);
+                REPORTER_ASSERT(reporter,
+                                image && !memcmp(image, glyph.fImage, glyph.computeImageSize()));
+            }
+            if (glyph.fPathData && glyph.fPathData->fPath) {
+                SkPath path;
+                REPORTER_ASSERT(reporter, saved.findPath(loaded, &path) &&
+                                          path == *glyph.fPathData->fPath);
+            }
+        }
+    };
+
+    // Save the first half, then the second half on top of it, which should keep both.
+    const int kHalf = kCount / 2;
+    REPORTER_ASSERT(reporter, SkGlyphDiskCache::Save(dir.c_str(), desc, nullptr, glyphs, kHalf));
+    std::unique_ptr<SkGlyphDiskCache> first = SkGlyphDiskCache::Open(dir.c_str(), desc);
+    REPORTER_ASSERT(reporter, first);
+    if (first) {
+        check(*first, 0, kHalf);
+        REPORTER_ASSERT(reporter, SkGlyphDiskCache::Save(dir.c_str(), desc, first.get(),
+                                                         glyphs + kHalf, kCount - kHalf));
+    }
+    std::unique_ptr<SkGlyphDiskCache> both = SkGlyphDiskCache::Open(dir.c_str(), desc);
+    REPORTER_ASSERT(reporter, both);
+    if (both) {
+        check(*both, 0, kCount);
+    }
+
+    // Cut the file short.  It should be ignored rather than trusted.
+    SkString name;
+    name.printf("%08x.skglyphs", desc.getChecksum());
+    SkString path = SkOSPath::Join(dir.c_str(), name.c_str());
+    sk_sp<SkData> data = SkData::MakeFromFileName(path.c_str());
+    REPORTER_ASSERT(reporter, data && data->size() > 100);
+    if (data) {
+        sk_sp<SkData> truncated = SkData::MakeWithCopy(data->data(), data->size() - 100);
+        data.reset();
+        first.reset();
+        both.reset();
+        SkFILEWStream(path.c_str()).write(truncated->data(), truncated->size());
+        REPORTER_ASSERT(reporter, !SkGlyphDiskCache::Open(dir.c_str(), desc));
+    }
+    remove(path.c_str());
+}
@@ -234,6 +234,82 @@ static void test_two_point_conical_zero_radius(skiatest::Reporter* reporter) {
     REPORTER_ASSERT(reporter, SkGetPackedR32(centerPMColor) == 0);
 }
 
+// The float (4f) contexts should shade like the legacy ones, up to the precision of the legacy
+// 256 entry color cache.  Where t jumps (a repeat's seam, the edge of a conical's cone) the two
+// may land on either side, so allow a few outliers.
+static void test_4f_matches_legacy(skiatest::Reporter* reporter) {
+    const int kSize = 64;
+    const SkColor colors[] = { SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE };
+    const int count = SK_ARRAY_COUNT(colors);
+    const SkPoint center = SkPoint::Make(32, 32);
+
+    const sk_sp<SkShader> shaders[] = {
+        SkGradientShader::MakeRadial(center, 24, colors, nullptr, count,
+                                     SkShader::kClamp_TileMode),
+        SkGradientShader::MakeRadial(center, 12, colors, nullptr, count,
+                                     SkShader::kRepeat_TileMode),
+        SkGradientShader::MakeRadial(center, 12, colors, nullptr, count,
+                                     SkShader::kMirror_TileMode),
+        SkGradientShader::MakeSweep(center.x(), center.y(), colors, nullptr, count),
+        SkGradientShader::MakeTwoPointConical(SkPoint::Make(24, 28), 4, center, 24,
+                                              colors, nullptr, count, SkShader::kClamp_TileMode),
+        SkGradientShader::MakeTwoPointConical(SkPoint::Make(16, 16), 6, center, 20,
+                                              colors, nullptr, count, SkShader::kRepeat_TileMode),
+        SkGradientShader::MakeTwoPointConical(center, 20, SkPoint::Make(40, 36), 4,
+                                              colors, nullptr, count, SkShader::kMirror_TileMode),
+    };
+
+    SkMatrix matrices[3];
+    matrices[0].reset();
+    matrices[1].setRotate(30, center.x(), center.y());
+    matrices[1].postScale(1.5f, 0.75f);
+    matrices[2].reset();
+    matrices[2].setPerspX(0.002f);
+
+    SkPaint paint;
+    for (const auto& shader : shaders) {
+        for (const SkMatrix& matrix : matrices) {
+            if (matrix.hasPerspective() &&
+                SkShader::kRadial_GradientType == shader->asAGradient(nullptr)) {
+                // The legacy radial context samples pixel corners, not centers, in perspective.
+                continue;
+            }
+            const SkShader::ContextRec legacyRec(paint, matrix, nullptr,
+                                                 SkShader::ContextRec::kPMColor_DstType);
+            const SkShader::ContextRec floatRec(paint, matrix, nullptr,
+                                                SkShader::ContextRec::kPM4f_DstType);
+            SkAutoMalloc legacyStorage(shader->contextSize(legacyRec)),
+                         floatStorage(shader->contextSize(floatRec));
+            SkShader::Context* legacy = shader->createContext(legacyRec, legacyStorage.get());
+            SkShader::Context* ctx4f  = shader->createContext(floatRec, floatStorage.get());
+            REPORTER_ASSERT(reporter, legacy && ctx4f);
+            if (!legacy || !ctx4f) {
+                continue;
+            }
+
+            int outliers = 0;
+            SkPMColor expected[kSize], actual[kSize];
+            for (int y = 0; y < kSize; ++y) {
+                legacy->shadeSpan(0, y, expected, kSize);
+                ctx4f->shadeSpan(0, y, actual, kSize);
+                for (int x = 0; x < kSize; ++x) {
+                    for (int shift = 0; shift < 32; shift += 8) {
+                        if (SkTAbs((int)((expected[x] >> shift) & 0xFF) -
+                                   (int)((actual[x] >> shift) & 0xFF)) > 6) {
+                            outliers++;
+                            break;
+                        }
+                    }
+                }
+            }
+            REPORTER_ASSERT(reporter, outliers <= kSize * kSize / 100);
+
+            legacy->~Context();
+            ctx4f->~Context();
+        }
+    }
+}
+
 DEF_TEST(Gradient, reporter) {
     TestGradientShaders(reporter);
     TestConstantGradient(reporter);
@@ -241,4 +317,5 @@ DEF_TEST(Gradient, reporter) {
     test_nearly_vertical(reporter);
     test_linear_fuzz(reporter);
     test_two_point_conical_zero_radius(reporter);
+    test_4f_matches_legacy(reporter);
 }
@@ -1737,6 +1737,104 @@ DEF_TEST(ImageFilterBlurLargeImage, reporter) {
     test_large_blur_input(reporter, surface->getCanvas());
 }
 
+// Draws a filter result into a clip-sized bitmap, so results with different bounds compare.
+static SkBitmap draw_filter_result(SkSpecialImage* result, const SkIPoint& offset,
+                                   const SkIRect& clip) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(clip.width(), clip.height());
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+    if (result) {
+        SkCanvas canvas(bitmap);
+        result->draw(&canvas, SkIntToScalar(offset.x() - clip.x()),
+                     SkIntToScalar(offset.y() - clip.y()), nullptr);
+    }
+    return bitmap;
+}
+
+static void test_filter_in_tiles(SkImageFilter::Proxy* proxy,
+                                 skiatest::Reporter* reporter,
+                                 GrContext* context) {
+    const int width = 500, height = 620;
+    SkBitmap srcBM;
+    srcBM.allocN32Pixels(width, height);
+    {
+        SkCanvas canvas(srcBM);
+        canvas.clear(SK_ColorTRANSPARENT);
+        draw_gradient_circle(&canvas, width, height);
+        SkPaint paint;
+        paint.setColor(0x8000FF00);
+        canvas.drawRect(SkRect::MakeXYWH(30, 400, 400, 90), paint);
+    }
+    sk_sp<SkSpecialImage> srcImg(SkSpecialImage::MakeFromRaster(proxy,
+                                                                SkIRect::MakeWH(width, height),
+                                                                srcBM));
+
+    sk_sp<SkImageFilter> blur(SkBlurImageFilter::Make(3, 3, nullptr));
+    sk_sp<SkImageFilter> dilate(SkDilateImageFilter::Make(3, 2, nullptr));
+    sk_sp<SkImageFilter> shadow(SkDropShadowImageFilter::Make(
+            5, 7, 4, 4, SK_ColorBLUE,
+            SkDropShadowImageFilter::kDrawShadowAndForeground_ShadowMode, nullptr));
+    sk_sp<SkImageFilter> merged[] = {
+        blur, SkOffsetImageFilter::Make(10, -5, dilate), blur, shadow,
+    };
+    const SkImageFilter::CropRect cropRect(SkRect::MakeXYWH(20, 50, 400, 500));
+    SkPoint3 location = SkPoint3::Make(100, 200, 50);
+
+    const struct {
+        const char*          fName;
+        sk_sp<SkImageFilter> fFilter;
+    } filters[] = {
+        { "blur", SkBlurImageFilter::Make(10, 6, nullptr) },
+        { "drop shadow", shadow },
+        { "merge", SkMergeImageFilter::Make(merged, SK_ARRAY_COUNT(merged)) },
+        { "xfermode", SkXfermodeImageFilter::Make(SkXfermode::Make(SkXfermode::kMultiply_Mode),
+                                                  SkBlurImageFilter::Make(6, 6, nullptr),
+                                                  SkErodeImageFilter::Make(2, 2, nullptr),
+                                                  nullptr) },
+        { "cropped color filter", SkColorFilterImageFilter::Make(
+                SkColorFilter::MakeModeFilter(0x40FF0000, SkXfermode::kSrcOver_Mode),
+                blur, &cropRect) },
+        { "lighting", SkLightingImageFilter::MakePointLitDiffuse(location, SK_ColorWHITE, 1, 2,
+                                                                 shadow) },
+    };
+
+    SkMatrix scale;
+    scale.setScale(1.5f, 1.5f);
+    const SkMatrix* ctms[] = { &SkMatrix::I(), &scale };
+    const SkIRect clips[] = { SkIRect::MakeWH(width, height), SkIRect::MakeLTRB(-7, 3, 480, 700) };
+
+    for (const SkMatrix* ctm : ctms) {
+        for (const SkIRect& clip : clips) {
+            for (const auto& filter : filters) {
+                SkIPoint offset = SkIPoint::Make(0, 0), tiledOffset = SkIPoint::Make(0, 0);
+                SkImageFilter::Context ctx(*ctm, clip, nullptr);
+                SkImageFilter::Context tiledCtx(*ctm, clip, nullptr, 8);
+                sk_sp<SkSpecialImage> result(filter.fFilter->filterImage(srcImg.get(), ctx,
+                                                                         &offset));
+                sk_sp<SkSpecialImage> tiledResult(
+                        filter.fFilter->filterImage(srcImg.get(), tiledCtx, &tiledOffset));
+
+                SkBitmap expected = draw_filter_result(result.get(), offset, clip);
+                SkBitmap actual = draw_filter_result(tiledResult.get(), tiledOffset, clip);
+                SkAutoLockPixels expectedLock(expected), actualLock(actual);
+                for (int y = 0; y < clip.height(); y++) {
+                    if (memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y),
+                               expected.rowBytes())) {
+                        ERRORF(reporter, "%s filtered in tiles differs at row %d",
+                               filter.fName, y);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Filtering in bands on several threads gives the same pixels as filtering all at once.
+DEF_TEST(ImageFilterFilterInTiles, reporter) {
+    run_raster_test(reporter, 100, test_filter_in_tiles);
+}
+
 #if SK_SUPPORT_GPU
 
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageFilterHugeBlur_Gpu, reporter, ctxInfo) {
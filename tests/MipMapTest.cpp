@@ -6,6 +6,7 @@
  */
 
 #include "SkBitmap.h"
+#include "SkColorPriv.h"
 #include "SkMipMap.h"
 #include "SkRandom.h"
 #include "Test.h"
@@ -150,3 +151,68 @@ DEF_TEST(MipMap_ComputeLevelCount, reporter) {
         REPORTER_ASSERT(reporter, currentTest.fExpectedLevelCount == levelCount);
     }
 }
+
+// Levels built lazily, a few at a time, must match those built all at once, for every color type.
+DEF_TEST(MipMap_Lazy, reporter) {
+    SkRandom rand;
+    const SkImageInfo infos[] = {
+        SkImageInfo::MakeN32Premul(701, 600),
+        SkImageInfo::MakeN32Premul(300, 701, kSRGB_SkColorProfileType),
+        SkImageInfo::Make(257, 512, kRGB_565_SkColorType, kOpaque_SkAlphaType),
+        SkImageInfo::Make(512, 257, kARGB_4444_SkColorType, kPremul_SkAlphaType),
+        SkImageInfo::MakeA8(333, 333),
+        SkImageInfo::Make(128, 129, kRGBA_F16_SkColorType, kPremul_SkAlphaType),
+    };
+    for (const SkImageInfo& info : infos) {
+        SkBitmap bm;
+        bm.allocPixels(info);
+        if (kRGBA_F16_SkColorType == info.colorType()) {
+            // Halfs in [0, 1].
+            uint16_t* halfs = (uint16_t*)bm.getPixels();
+            for (size_t i = 0; i < bm.getSize() / 2; i++) {
+                halfs[i] = rand.nextULessThan(0x3C01);
+            }
+        } else {
+            uint8_t* bytes = (uint8_t*)bm.getPixels();
+            for (size_t i = 0; i < bm.getSize(); i++) {
+                bytes[i] = rand.nextU() & 0xFF;
+            }
+        }
+
+        SkAutoTUnref<SkMipMap> eager(SkMipMap::Build(bm, nullptr));
+        SkAutoTUnref<SkMipMap> lazy(SkMipMap::Build(bm, nullptr, true));
+        REPORTER_ASSERT(reporter, eager && lazy);
+        REPORTER_ASSERT(reporter, eager->countLevels() == lazy->countLevels());
+
+        // Ask for every other level, then each again, so the lazy one builds a few at a time.
+        for (int step : { 2, 1 }) {
+            for (int i = step - 1; i < lazy->countLevels(); i += step) {
+                SkMipMap::Level expected, actual;
+                REPORTER_ASSERT(reporter, eager->getLevel(i, &expected));
+                REPORTER_ASSERT(reporter, lazy->getLevel(i, &actual));
+                REPORTER_ASSERT(reporter, expected.fPixmap.info() == actual.fPixmap.info());
+                for (int y = 0; y < expected.fPixmap.height(); y++) {
+                    REPORTER_ASSERT(reporter, 0 == memcmp(expected.fPixmap.addr(0, y),
+                                                          actual.fPixmap.addr(0, y),
+                                                          expected.fPixmap.info().minRowBytes()));
+                }
+            }
+        }
+    }
+}
+
+// sRGB-encoded pixels are averaged in linear space.
+DEF_TEST(MipMap_SRGB, reporter) {
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::MakeN32Premul(2, 2, kSRGB_SkColorProfileType));
+    *bm.getAddr32(0, 0) = *bm.getAddr32(1, 1) = SkPreMultiplyColor(SK_ColorBLACK);
+    *bm.getAddr32(1, 0) = *bm.getAddr32(0, 1) = SkPreMultiplyColor(SK_ColorWHITE);
+
+    SkAutoTUnref<SkMipMap> mm(SkMipMap::Build(bm, nullptr));
+    SkMipMap::Level level;
+    REPORTER_ASSERT(reporter, mm && mm->getLevel(0, &level));
+    // Half way between black and white in linear is about 180 in sRGB, not 127.
+    const SkPMColor c = *level.fPixmap.addr32();
+    REPORTER_ASSERT(reporter, 0xFF == SkGetPackedA32(c));
+    REPORTER_ASSERT(reporter, SkTAbs((int)SkGetPackedG32(c) - 180) <= 8);
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBlurImageFilter.h"
+#include "SkCanvas.h"
+#include "SkColorCubeFilter.h"
+#include "SkColorPriv.h"
+#include "SkMorphologyImageFilter.h"
+#include "SkOpts.h"
+#include "SkRandom.h"
+#include "Test.h"
+
+// The wider x86 tiers of SkOpts must give exactly what the SSE4.1 tier does.  Since they all
+// agree, switching between them can't upset tests running alongside this one.
+static const SkOpts::Tier kTiers[] = {
+    SkOpts::kSSE41_Tier, SkOpts::kAVX2_Tier, SkOpts::kAVX512_Tier,
+};
+
+// Calls draw(&bitmap) with SkOpts limited to each supported tier, comparing each bitmap to the
+// SSE4.1 tier's.
+template <typename Fn>
+static void compare_tiers(skiatest::Reporter* r, const char* name, Fn&& draw) {
+    if (!SkOpts::SupportsTier(kTiers[0])) {
+        return;
+    }
+    SkBitmap expected;
+    for (SkOpts::Tier tier : kTiers) {
+        if (!SkOpts::SupportsTier(tier)) {
+            continue;
+        }
+        SkOpts::InitUpToTierForTesting(tier);
+        SkBitmap actual;
+        draw(&actual);
+        if (expected.isNull()) {
+            expected = std::move(actual);
+            continue;
+        }
+        for (int y = 0; y < expected.height(); y++) {
+            if (0 != memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y),
+                            expected.width() * sizeof(SkPMColor))) {
+                ERRORF(r, "%s: tier %d differs from SSE4.1 in row %d", name, tier, y);
+                break;
+            }
+        }
+    }
+    SkOpts::InitUpToTierForTesting(SkOpts::kBest_Tier);
+}
+
+// Odd sizes leave every tier some pixels and rows over, to finish one at a time.
+static const int kW = 53, kH = 37;
+
+static SkBitmap random_bitmap(SkRandom* rand) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(kW, kH);
+    for (int y = 0; y < kH; y++) {
+        for (int x = 0; x < kW; x++) {
+            SkColor color = rand->nextU();
+            switch (rand->nextULessThan(4)) {
+                case 0: color = SkColorSetA(color, 0);    break;
+                case 1: color = SkColorSetA(color, 0xFF); break;
+            }
+            *bitmap.getAddr32(x, y) = SkPreMultiplyColor(color);
+        }
+    }
+    return bitmap;
+}
+
+static void draw_filtered(const SkBitmap& src, const SkPaint& paint, SkBitmap* dst) {
+    dst->allocN32Pixels(kW, kH);
+    dst->eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(*dst);
+    canvas.drawBitmap(src, 0, 0, &paint);
+}
+
+DEF_TEST(OptsTier_Filters, r) {
+    SkRandom rand;
+    const SkBitmap src = random_bitmap(&rand);
+
+    // Image filters cache their results, so each tier gets a new filter.
+    const struct { SkScalar x, y; } sigmas[] = { { 2, 2 }, { 0.5f, 5 }, { 4, 0 }, { 0, 3 } };
+    for (const auto& sigma : sigmas) {
+        compare_tiers(r, "blur", [&](SkBitmap* dst) {
+            SkPaint paint;
+            paint.setImageFilter(SkBlurImageFilter::Make(sigma.x, sigma.y, nullptr));
+            draw_filtered(src, paint, dst);
+        });
+    }
+
+    const struct { int x, y; } radii[] = { { 1, 1 }, { 3, 0 }, { 0, 2 }, { 9, 20 }, { 60, 1 } };
+    for (const auto& radius : radii) {
+        compare_tiers(r, "dilate", [&](SkBitmap* dst) {
+            SkPaint paint;
+            paint.setImageFilter(SkDilateImageFilter::Make(radius.x, radius.y, nullptr));
+            draw_filtered(src, paint, dst);
+        });
+        compare_tiers(r, "erode", [&](SkBitmap* dst) {
+            SkPaint paint;
+            paint.setImageFilter(SkErodeImageFilter::Make(radius.x, radius.y, nullptr));
+            draw_filtered(src, paint, dst);
+        });
+    }
+
+    for (int dim : { 4, 17 }) {
+        sk_sp<SkData> cube = SkData::MakeUninitialized(dim * dim * dim * sizeof(SkColor));
+        SkColor* colors = (SkColor*)cube->writable_data();
+        for (int i = 0; i < dim * dim * dim; i++) {
+            colors[i] = rand.nextU();
+        }
+        compare_tiers(r, "color cube", [&](SkBitmap* dst) {
+            SkPaint paint;
+            paint.setColorFilter(SkColorCubeFilter::Make(cube, dim));
+            draw_filtered(src, paint, dst);
+        });
+    }
+}
+
+DEF_TEST(OptsTier_Blits, r) {
+    SkRandom rand;
+    const SkBitmap dst = random_bitmap(&rand);
+    SkAlpha coverage[kW * kH];
+    for (SkAlpha& c : coverage) {
+        c = rand.nextBool() ? rand.nextULessThan(256) : (rand.nextBool() ? 0 : 0xFF);
+    }
+
+    for (SkColor color : { 0xFF336699u, 0x80336699u, 0x00000000u, 0x01FFFFFFu }) {
+        compare_tiers(r, "blit_row_color32", [&](SkBitmap* result) {
+            result->allocN32Pixels(kW, kH);
+            for (int y = 0; y < kH; y++) {
+                SkOpts::blit_row_color32(result->getAddr32(0, y), dst.getAddr32(0, y), kW - y,
+                                         SkPreMultiplyColor(color));
+                memcpy(result->getAddr32(kW - y, y), dst.getAddr32(kW - y, y),
+                       y * sizeof(SkPMColor));
+            }
+        });
+        compare_tiers(r, "blit_mask_d32_a8", [&](SkBitmap* result) {
+            result->allocN32Pixels(kW, kH);
+            dst.readPixels(result->info(), result->getPixels(), result->rowBytes(), 0, 0);
+            SkOpts::blit_mask_d32_a8(result->getAddr32(0, 0), result->rowBytes(),
+                                     coverage, kW, color, kW, kH);
+        });
+    }
+
+    compare_tiers(r, "RGBA_to_rgbA", [&](SkBitmap* result) {
+        result->allocN32Pixels(kW, kH);
+        for (int y = 0; y < kH; y++) {
+            SkOpts::RGBA_to_rgbA(result->getAddr32(0, y), dst.getAddr32(0, y), kW - y);
+            memcpy(result->getAddr32(kW - y, y), dst.getAddr32(kW - y, y), y * sizeof(SkPMColor));
+        }
+    });
+    compare_tiers(r, "RGBA_to_bgrA", [&](SkBitmap* result) {
+        result->allocN32Pixels(kW, kH);
+        for (int y = 0; y < kH; y++) {
+            SkOpts::RGBA_to_bgrA(result->getAddr32(0, y), dst.getAddr32(0, y), kW - y);
+            memcpy(result->getAddr32(kW - y, y), dst.getAddr32(kW - y, y), y * sizeof(SkPMColor));
+        }
+    });
+}
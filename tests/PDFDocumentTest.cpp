@@ -8,6 +8,7 @@
 
 #include "Resources.h"
 #include "SkCanvas.h"
+#include "SkData.h"
 #include "SkDocument.h"
 #include "SkOSFile.h"
 #include "SkStream.h"
@@ -33,8 +34,15 @@ static void test_abort(skiatest::Reporter* reporter) {
 
     doc->abort();
 
-    // Test that only the header is written, not the full document.
-    REPORTER_ASSERT(reporter, stream.bytesWritten() < 256);
+    // Finished pages are written as they end, but the document must not be.
+    sk_sp<SkData> data(stream.copyToData());
+    const char* bytes = (const char*)data->data();
+    const char kEOF[] = "%%EOF";
+    bool finished = false;
+    for (size_t i = 0; i + strlen(kEOF) <= data->size(); i++) {
+        finished = finished || 0 == memcmp(bytes + i, kEOF, strlen(kEOF));
+    }
+    REPORTER_ASSERT(reporter, !finished);
 }
 
 static void test_abortWithFile(skiatest::Reporter* reporter) {
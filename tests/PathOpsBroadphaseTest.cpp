@@ -0,0 +1,50 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "PathOpsExtendedTest.h"
+
+// Adds count lines or quads around (cx, cy), with a wavy radius.
+static void add_wavy_ring(SkPath* path, SkScalar cx, SkScalar cy, int count, bool quads,
+                          bool moveTo) {
+    auto point = [=](SkScalar step) {
+        const SkScalar angle = step * 2 * SK_ScalarPI / count,
+                       radius = 100 + 5 * SkScalarSin(angle * 23);
+        return SkPoint::Make(cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle));
+    };
+    if (moveTo) {
+        path->moveTo(point(0));
+    } else {
+        path->lineTo(point(0));
+    }
+    for (int index = 1; index <= count; ++index) {
+        if (quads) {
+            path->quadTo(point(index - 0.5f), point(SkIntToScalar(index)));
+        } else {
+            path->lineTo(point(SkIntToScalar(index)));
+        }
+    }
+}
+
+// Contours long enough to be indexed in bands when finding intersections.
+DEF_TEST(PathOpsBroadphase, reporter) {
+    for (bool quads : { false, true }) {
+        SkPath one, two;
+        add_wavy_ring(&one, 0, 0, 300, quads, true);
+        one.close();
+        add_wavy_ring(&two, 60, 30, 300, quads, true);
+        two.close();
+        for (int op = kDifference_SkPathOp; op <= kReverseDifference_SkPathOp; ++op) {
+            testPathOp(reporter, one, two, (SkPathOp) op, "broadphaseOp");
+        }
+
+        // Both rings in one contour, so it crosses itself.
+        SkPath both;
+        add_wavy_ring(&both, 0, 0, 300, quads, true);
+        add_wavy_ring(&both, 60, 30, 300, quads, false);
+        both.close();
+        testSimplify(reporter, both, "broadphaseSimplify");
+    }
+}
@@ -8,6 +8,7 @@
 #include "PathOpsExtendedTest.h"
 #include "PathOpsTestCommon.h"
 #include "SkBitmap.h"
+#include "SkRandom.h"
 #include "Test.h"
 
 DEF_TEST(PathOpsBuilder, reporter) {
@@ -301,3 +302,58 @@ DEF_TEST(Issue569540, reporter) {
     SkPath result;
     builder.resolve(&result);
 }
+
+static int count_contours(const SkPath& path) {
+    SkPath::Iter iter(path, false);
+    SkPoint pts[4];
+    int contours = 0;
+    for (SkPath::Verb verb; (verb = iter.next(pts)) != SkPath::kDone_Verb; ) {
+        contours += SkPath::kMove_Verb == verb;
+    }
+    return contours;
+}
+
+// Enough unions for the builder to batch them should match unioning the paths one at a time.
+DEF_TEST(BuilderUnionBatch, reporter) {
+    SkRandom rand;
+    for (int test = 0; test < 4; ++test) {
+        SkOpBuilder builder;
+        SkPath expected;
+        for (int index = 0; index < 60; ++index) {
+            // Footprints scattered in a few neighborhoods, some overlapping, some touching.
+            SkPath path;
+            const SkScalar x = rand.nextRangeScalar(0, 40) + 100 * (index % 3),
+                           y = rand.nextRangeScalar(0, 40) + 100 * (index % 2),
+                           w = rand.nextRangeScalar(2, 12),
+                           h = rand.nextRangeScalar(2, 12);
+            switch (index % 4) {
+                case 0:
+                    path.addRect(x, y, x + w, y + h);
+                    break;
+                case 1:
+                    path.addCircle(x, y, w / 2, SkPath::kCCW_Direction);
+                    break;
+                case 2:
+                    path.moveTo(x, y);
+                    path.lineTo(x + w, y);
+                    path.lineTo(x + w, y + h / 2);
+                    path.lineTo(x + w / 2, y + h / 2);
+                    path.lineTo(x + w / 2, y + h);
+                    path.lineTo(x, y + h);
+                    path.close();
+                    break;
+                default:
+                    path.addRect(SkRect::MakeXYWH(SkScalarFloorToScalar(x), y, 4, 4));
+                    path.addRect(SkRect::MakeXYWH(SkScalarFloorToScalar(x) + 4, y, 4, 4));
+                    break;
+            }
+            builder.add(path, kUnion_SkPathOp);
+            REPORTER_ASSERT(reporter, Op(expected, path, kUnion_SkPathOp, &expected));
+        }
+        SkPath result;
+        REPORTER_ASSERT(reporter, builder.resolve(&result));
+        REPORTER_ASSERT(reporter, count_contours(expected) == count_contours(result));
+        int pixelDiff = comparePaths(reporter, __FUNCTION__, expected, result);
+        REPORTER_ASSERT(reporter, pixelDiff == 0);
+    }
+}
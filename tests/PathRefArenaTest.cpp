@@ -0,0 +1,114 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCanvas.h"
+#include "SkPathRefArena.h"
+#include "SkPictureRecorder.h"
+#include "Test.h"
+
+// Every third path repeats an earlier one exactly, and all but a few share their verbs.
+static SkPath make_path(int i) {
+    while (i > 0 && 0 == i % 3) {
+        i /= 3;
+    }
+    const SkScalar x = SkIntToScalar(i),
+                   y = SkIntToScalar(2 * i);
+    SkPath path;
+    path.moveTo(x, y);
+    path.lineTo(x + 10, y);
+    path.quadTo(x + 20, y + 5, x + 10, y + 10);
+    if (i % 7 == 1) {
+        path.conicTo(x + 5, y + 15, x, y + 10, 0.5f);
+    }
+    path.close();
+    return path;
+}
+
+DEF_TEST(PathRefArena_Pack, r) {
+    const int kCount = 100;
+    SkPath paths[kCount];
+    SkPath* ptrs[kCount];
+    uint32_t ids[kCount];
+    size_t separateBytes = 0;
+    for (int i = 0; i < kCount; i++) {
+        paths[i] = make_path(i);
+        ptrs[i] = &paths[i];
+        ids[i] = paths[i].getGenerationID();
+        separateBytes += paths[i].countPoints() * sizeof(SkPoint) + paths[i].countVerbs();
+    }
+    // Shared paths and empty ones are left as they are.
+    SkPath shared = paths[5];
+    paths[6].reset();
+    ids[6] = paths[6].getGenerationID();
+
+    const size_t size = SkPathRefArena::Pack(ptrs, kCount);
+    REPORTER_ASSERT(r, size > 0 && size < separateBytes * 3 / 4);
+    for (int i = 0; i < kCount; i++) {
+        REPORTER_ASSERT(r, paths[i] == (6 == i ? SkPath() : make_path(i)));
+        REPORTER_ASSERT(r, paths[i].getGenerationID() == ids[i]);
+        if (6 != i) {
+            REPORTER_ASSERT(r, paths[i].getBounds() == make_path(i).getBounds());
+        }
+    }
+    REPORTER_ASSERT(r, shared.getGenerationID() == paths[5].getGenerationID());
+    REPORTER_ASSERT(r, 0 == SkPathRefArena::Pack(ptrs, kCount));
+
+    // The block is counted once, with each packed path ref, but not the shared or empty ones.
+    SkTHashSet<const void*> seen;
+    size_t bytes = 0;
+    for (int i = 0; i < kCount; i++) {
+        if (5 != i && 6 != i) {
+            bytes += SkPathRefArena::ApproximateBytesUsed(paths[i], &seen);
+        }
+    }
+    REPORTER_ASSERT(r, bytes >= size && bytes < size + kCount * sizeof(SkPathRef) + 256);
+
+    // Editing a packed path copies it out, leaving the others sharing its runs alone.
+    paths[3].lineTo(100, 100);
+    REPORTER_ASSERT(r, paths[3].getGenerationID() != ids[3]);
+    REPORTER_ASSERT(r, paths[3].countVerbs() > make_path(3).countVerbs());
+    paths[9].transform(SkMatrix::MakeTrans(5, 5));
+    SkPath moved = make_path(9);
+    moved.transform(SkMatrix::MakeTrans(5, 5));
+    REPORTER_ASSERT(r, paths[9] == moved);
+    paths[12].rewind();
+    REPORTER_ASSERT(r, paths[12].isEmpty());
+    for (int i = 0; i < kCount; i++) {
+        if (3 != i && 6 != i && 9 != i && 12 != i) {
+            REPORTER_ASSERT(r, paths[i] == make_path(i));
+        }
+    }
+}
+
+// Paths drawn into a recording are packed when it finishes, and still draw the same.
+DEF_TEST(PathRefArena_Record, r) {
+    SkBitmap expected, actual;
+    expected.allocN32Pixels(300, 300);
+    actual.allocN32Pixels(300, 300);
+    expected.eraseColor(SK_ColorWHITE);
+    actual.eraseColor(SK_ColorWHITE);
+    SkCanvas direct(expected);
+
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(300, 300);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 100; i++) {
+        paint.setColor(0xFF000000 | (i * 0x020406));
+        canvas->drawPath(make_path(i), paint);
+        direct.drawPath(make_path(i), paint);
+    }
+    canvas->clipPath(make_path(50), SkRegion::kIntersect_Op, true);
+    direct.clipPath(make_path(50), SkRegion::kIntersect_Op, true);
+    canvas->drawPaint(paint);
+    direct.drawPaint(paint);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+    SkCanvas played(actual);
+    picture->playback(&played);
+
+    REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(), expected.getSize()));
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCanvas.h"
+#include "SkColorPriv.h"
+#include "SkPerlinNoiseShader.h"
+#include "Test.h"
+
+static void draw_columns(SkBitmap* bitmap, sk_sp<SkShader> shader, const int widths[], int count) {
+    bitmap->allocN32Pixels(150, 16);
+    bitmap->eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(*bitmap);
+    canvas.translate(-13.5f, 7.25f);
+    SkPaint paint;
+    paint.setShader(std::move(shader));
+    paint.setAlpha(0xC0);
+    int x = 0;
+    for (int i = 0; x < bitmap->width(); i = (i + 1) % count) {
+        canvas.save();
+        canvas.clipRect(SkRect::MakeXYWH(SkIntToScalar(x) + 13.5f, -7.25f,
+                                         SkIntToScalar(widths[i]),
+                                         SkIntToScalar(bitmap->height())));
+        canvas.drawPaint(paint);
+        canvas.restore();
+        x += widths[i];
+    }
+}
+
+// Noise is evaluated span by span, several octaves and pixels at a time; a pixel's color must not
+// depend on how its row was split into spans.
+DEF_TEST(PerlinNoiseSpans, reporter) {
+    const SkISize tileSize = SkISize::Make(40, 30);
+    const int whole[] = { 150 };
+    const int pieces[] = { 1, 7, 64, 65, 2, 11 };
+
+    for (bool turbulence : { false, true }) {
+        for (const SkISize* tile : { (const SkISize*)nullptr, &tileSize }) {
+            auto make = [&]() {
+                return turbulence
+                    ? SkPerlinNoiseShader::MakeTurbulence(0.05f, 0.1f, 4, 3, tile)
+                    : SkPerlinNoiseShader::MakeFractalNoise(0.05f, 0.1f, 4, 3, tile);
+            };
+            SkBitmap expected, actual;
+            draw_columns(&expected, make(), whole, SK_ARRAY_COUNT(whole));
+            draw_columns(&actual, make(), pieces, SK_ARRAY_COUNT(pieces));
+            REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                                  expected.getSize()));
+        }
+    }
+}
+
+// Pixels from the scalar shader this one replaced, which noised one pixel, octave and channel at a
+// time.  They're written as 0xAARRGGBB premultiplied colors, to compare on any SkPMColor order.
+DEF_TEST(PerlinNoiseReference, reporter) {
+    static const SkIPoint kPoints[] = {
+        { 0, 0 }, { 3, 1 }, { 17, 5 }, { 38, 29 }, { 41, 2 }, { 55, 47 }, { 79, 63 },
+    };
+    static const struct {
+        bool     turbulence;
+        bool     stitch;
+        int      octaves;
+        SkScalar seed;
+        uint32_t expected[SK_ARRAY_COUNT(kPoints)];
+    } kCases[] = {
+        { false, false, 3, 0, { 0x83354b5e, 0x88274b46, 0x632e392d, 0x56311c43,
+                                0x5f303c4a, 0x562f3327, 0x490f242c } },
+        { false, true,  4, 2, { 0x4e1f291b, 0x3e122417, 0x59311e2f, 0x51282739,
+                                0x7a2e4148, 0x714a4e21, 0x73234e34 } },
+        { true,  false, 1, 7, { 0x1f0b0406, 0x290e0202, 0x08010001, 0x1f03040e,
+                                0x3f040002, 0x25030804, 0x01000000 } },
+        { true,  true,  5, 3, { 0x6213130f, 0x580c0f22, 0x1c04050b, 0x320b0921,
+                                0x3f191208, 0x60292c11, 0x5a2a3024 } },
+    };
+    const SkISize tileSize = SkISize::Make(40, 30);
+
+    for (const auto& c : kCases) {
+        const SkISize* tile = c.stitch ? &tileSize : nullptr;
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(80, 64);
+        bitmap.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(bitmap);
+        canvas.translate(-13.5f, 7.25f);
+        canvas.rotate(15);
+        SkPaint paint;
+        paint.setShader(c.turbulence
+            ? SkPerlinNoiseShader::MakeTurbulence(0.05f, 0.1f, c.octaves, c.seed, tile)
+            : SkPerlinNoiseShader::MakeFractalNoise(0.05f, 0.1f, c.octaves, c.seed, tile));
+        paint.setAlpha(0xC0);
+        canvas.drawPaint(paint);
+
+        for (size_t i = 0; i < SK_ARRAY_COUNT(kPoints); i++) {
+            const uint32_t e = c.expected[i];
+            const SkPMColor expected = SkPackARGB32(SkColorGetA(e), SkColorGetR(e),
+                                                    SkColorGetG(e), SkColorGetB(e));
+            const SkPMColor actual = *bitmap.getAddr32(kPoints[i].x(), kPoints[i].y());
+            if (actual != expected) {
+                ERRORF(reporter, "%s%s, (%d, %d): expected %08x, got %08x",
+                       c.turbulence ? "turbulence" : "fractal noise", c.stitch ? ", stitched" : "",
+                       kPoints[i].x(), kPoints[i].y(), expected, actual);
+            }
+        }
+    }
+}
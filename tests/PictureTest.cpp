@@ -1411,3 +1411,72 @@ DEF_TEST(Picture_preserveCullRect, r) {
     REPORTER_ASSERT(r, deserializedPicture->cullRect().right() == 3);
     REPORTER_ASSERT(r, deserializedPicture->cullRect().bottom() == 4);
 }
+
+DEF_TEST(Picture_MakeFromData, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* sub = recorder.beginRecording(SkRect::MakeWH(50, 50));
+    sub->drawCircle(25, 25, 20, SkPaint());
+    sk_sp<SkPicture> subPicture(recorder.finishRecordingAsPicture());
+
+    SkBitmap bitmap;
+    make_bm(&bitmap, 20, 20, SK_ColorBLUE, true);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    SkPath concave;
+    concave.moveTo(10, 10);
+    concave.lineTo(90, 10);
+    concave.lineTo(50, 30);
+    concave.lineTo(90, 90);
+    concave.lineTo(10, 90);
+    concave.close();
+
+    SkCanvas* c = recorder.beginRecording(SkRect::MakeWH(200, 100));
+    c->drawColor(SK_ColorWHITE);
+    c->save();
+        c->clipRect(SkRect::MakeWH(150, 100));
+        paint.setColor(SK_ColorGREEN);
+        c->drawPath(concave, paint);
+        c->drawBitmap(bitmap, 120, 60);
+    c->restore();
+    paint.setColor(SK_ColorBLACK);
+    c->drawText("text", 4, 100, 50, paint);
+    c->translate(140, 10);
+    c->drawPicture(subPicture.get());
+    sk_sp<SkPicture> picture(recorder.finishRecordingAsPicture());
+
+    SkDynamicMemoryWStream wstream;
+    picture->serialize(&wstream);
+    sk_sp<SkData> data(wstream.copyToData());
+
+    SkMemoryStream rstream(data);
+    sk_sp<SkPicture> fromStream(SkPicture::MakeFromStream(&rstream));
+    sk_sp<SkPicture> fromData(SkPicture::MakeFromData(data));
+    REPORTER_ASSERT(r, fromStream && fromData);
+    REPORTER_ASSERT(r, fromData->cullRect() == picture->cullRect());
+    REPORTER_ASSERT(r, fromData->hasText());
+    REPORTER_ASSERT(r, fromData->willPlayBackBitmaps());
+    REPORTER_ASSERT(r, fromData->approximateOpCount() >= picture->approximateOpCount());
+
+    // Both ways of loading the picture should draw just the same, with or without a clip.
+    for (const SkRect& clip : { SkRect::MakeWH(200, 100), SkRect::MakeXYWH(110, 50, 40, 40) }) {
+        SkBitmap expected, actual;
+        expected.allocN32Pixels(200, 100);
+        actual.allocN32Pixels(200, 100);
+        expected.eraseColor(SK_ColorRED);
+        actual.eraseColor(SK_ColorRED);
+        SkCanvas expectedCanvas(expected), actualCanvas(actual);
+        expectedCanvas.clipRect(clip);
+        actualCanvas.clipRect(clip);
+        expectedCanvas.drawPicture(fromStream.get());
+        actualCanvas.drawPicture(fromData.get());
+
+        SkAutoLockPixels expectedLock(expected), actualLock(actual);
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.getSize()));
+    }
+
+    // Truncated data is rejected.
+    REPORTER_ASSERT(r, !SkPicture::MakeFromData(SkData::MakeSubset(data.get(), 0, 20)));
+    REPORTER_ASSERT(r, !SkPicture::MakeFromData(nullptr));
+}
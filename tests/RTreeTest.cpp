@@ -89,3 +89,56 @@ DEF_TEST(RTree, reporter) {
                                   expectedDepthMax >= rtree.getDepth());
     }
 }
+
+// Trees of each fanout must find exactly the rects a brute force search does, in order, whether
+// their rects come in a row-by-row order or scattered, and skip any empty ones.  Only scattered
+// rects should be worth sorting.
+template <int kFanout>
+static void test_fanout(skiatest::Reporter* reporter, SkRandom& rand) {
+    static const int kGridWidth = 64;
+    for (int count : { 1, kFanout, kFanout + 1, 1000, 40000 }) {
+        for (bool scattered : { false, true }) {
+            SkAutoTMalloc<SkRect> rects(count);
+            int empties = 0;
+            for (int i = 0; i < count; i++) {
+                SkPoint origin = SkPoint::Make(SkIntToScalar(i % kGridWidth * 10),
+                                               SkIntToScalar(i / kGridWidth * 10));
+                if (scattered) {
+                    origin.set(rand.nextRangeF(0, 1000), rand.nextRangeF(0, 1000));
+                }
+                rects[i] = SkRect::MakeXYWH(origin.fX, origin.fY,
+                                            rand.nextRangeF(1, 30), rand.nextRangeF(1, 30));
+                if (rand.nextU() % 16 == 0) {
+                    rects[i].setEmpty();
+                    empties++;
+                }
+            }
+
+            SkTRTree<kFanout> rtree;
+            rtree.insert(rects.get(), count);
+            REPORTER_ASSERT(reporter, count - empties == rtree.getCount());
+            if (count >= 1000) {
+                REPORTER_ASSERT(reporter, scattered == rtree.isSorted());
+            }
+
+            for (size_t i = 0; i < NUM_QUERIES; ++i) {
+                SkRect query = random_rect(rand);
+                SkTDArray<int> expected, found;
+                for (int j = 0; j < count; ++j) {
+                    if (SkRect::Intersects(query, rects[j])) {
+                        expected.push(j);
+                    }
+                }
+                rtree.search(query, &found);
+                REPORTER_ASSERT(reporter, expected == found);
+            }
+        }
+    }
+}
+
+DEF_TEST(RTree_Fanout, reporter) {
+    SkRandom rand;
+    test_fanout<4>(reporter, rand);
+    test_fanout<8>(reporter, rand);
+    test_fanout<16>(reporter, rand);
+}
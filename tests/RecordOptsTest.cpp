@@ -8,6 +8,7 @@
 #include "Test.h"
 #include "RecordTestUtils.h"
 
+#include "SkBlurDrawLooper.h"
 #include "SkColorFilter.h"
 #include "SkRecord.h"
 #include "SkRecordOpts.h"
@@ -16,6 +17,7 @@
 #include "SkXfermode.h"
 #include "SkPictureRecorder.h"
 #include "SkPictureImageFilter.h"
+#include "SkRandom.h"
 
 static const int W = 1920, H = 1080;
 
@@ -343,3 +345,156 @@ DEF_TEST(RecordOpts_MergeSvgOpacityAndFilterLayers, r) {
     assert_type<SkRecords::Restore>(r, record, index + 3);
     index += 4;
 }
+
+DEF_TEST(RecordOpts_MergeDraws, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint paint, redPaint;
+    redPaint.setColor(SK_ColorRED);
+    const SkPoint pts[] = { { 10, 10 }, { 20, 20 }, { 30, 10 } },
+                  farPts[] = { { 110, 10 }, { 120, 20 } };
+
+    recorder.drawPoints(SkCanvas::kPoints_PointMode, 3, pts, paint);  // 0
+    recorder.drawPoints(SkCanvas::kPoints_PointMode, 3, pts, paint);  // 1: merged into 0
+    recorder.drawPoints(SkCanvas::kPoints_PointMode, 2, farPts, paint);// 2: merged into 0
+    recorder.drawRect(SkRect::MakeXYWH(200, 200, 10, 10), redPaint);   // 3
+    recorder.drawPoints(SkCanvas::kPoints_PointMode, 3, pts, paint);  // 4: won't move past 3
+    recorder.drawPoints(SkCanvas::kPoints_PointMode, 3, pts, redPaint);// 5: different paint
+    recorder.drawPoints(SkCanvas::kPolygon_PointMode, 3, pts, paint); // 6: different mode
+    recorder.drawPoints(SkCanvas::kPolygon_PointMode, 3, pts, paint); // 7: polygons don't merge
+    recorder.clipRect(SkRect::MakeWH(1000, 1000));                     // 8
+    recorder.drawPoints(SkCanvas::kPoints_PointMode, 2, farPts, paint);// 9
+
+    // A long run merges into its first draw, in order.
+    const int kRun = 1000;
+    for (int i = 0; i < kRun; i++) {
+        const SkPoint pt = { SkIntToScalar(i % 100), SkIntToScalar(i / 100) };
+        recorder.drawPoints(SkCanvas::kPoints_PointMode, 1, &pt, paint);  // 10...
+    }
+
+    SkRecordMergeDraws(&record);
+
+    const SkRecords::DrawPoints* merged = assert_type<SkRecords::DrawPoints>(r, record, 0);
+    REPORTER_ASSERT(r, 8 == merged->count);
+    REPORTER_ASSERT(r, merged->pts[5] == pts[2] && merged->pts[7] == farPts[1]);
+    assert_type<SkRecords::NoOp>(r, record, 1);
+    assert_type<SkRecords::NoOp>(r, record, 2);
+    for (int i : { 4, 5, 6, 7 }) {
+        REPORTER_ASSERT(r, 3 == assert_type<SkRecords::DrawPoints>(r, record, i)->count);
+    }
+    assert_type<SkRecords::ClipRect>(r, record, 8);
+
+    merged = assert_type<SkRecords::DrawPoints>(r, record, 9);
+    REPORTER_ASSERT(r, 2 + kRun == merged->count);
+    for (int i = 0; i < kRun; i++) {
+        REPORTER_ASSERT(r, merged->pts[2 + i] == SkPoint::Make(SkIntToScalar(i % 100),
+                                                               SkIntToScalar(i / 100)));
+        assert_type<SkRecords::NoOp>(r, record, 10 + i);
+    }
+}
+
+DEF_TEST(RecordOpts_MergeDrawsText, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint paint;
+    paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+    const uint16_t glyphs[] = { 1, 2, 3 };
+    const SkScalar xpos[] = { 0, 10, 20 };
+    const SkPoint pos[] = { { 0, 300 }, { 10, 300 }, { 20, 310 } };
+
+    recorder.drawPosTextH(glyphs, sizeof(glyphs), xpos, 100, paint);  // 0
+    recorder.drawPosTextH(glyphs, sizeof(glyphs), xpos, 100, paint);  // 1: merged into 0
+    recorder.drawPosTextH(glyphs, sizeof(glyphs), xpos, 120, paint);  // 2: another baseline
+    recorder.drawPosText(glyphs, sizeof(glyphs), pos, paint);         // 3
+    recorder.drawPosText(glyphs, sizeof(glyphs), pos, paint);         // 4: merged into 3
+
+    SkPaint looperPaint(paint);
+    looperPaint.setLooper(SkBlurDrawLooper::Make(SK_ColorBLACK, 1, 1, 1));
+    recorder.drawPosText(glyphs, sizeof(glyphs), pos, looperPaint);   // 5
+    recorder.drawPosText(glyphs, sizeof(glyphs), pos, looperPaint);   // 6: loopers don't merge
+
+    SkRecordMergeDraws(&record);
+
+    const SkRecords::DrawPosTextH* textH = assert_type<SkRecords::DrawPosTextH>(r, record, 0);
+    REPORTER_ASSERT(r, 2 * sizeof(glyphs) == textH->byteLength);
+    REPORTER_ASSERT(r, 0 == memcmp(glyphs, (const char*)textH->text + sizeof(glyphs),
+                                   sizeof(glyphs)));
+    REPORTER_ASSERT(r, 20 == textH->xpos[5]);
+    assert_type<SkRecords::NoOp>(r, record, 1);
+    assert_type<SkRecords::DrawPosTextH>(r, record, 2);
+    const SkRecords::DrawPosText* text = assert_type<SkRecords::DrawPosText>(r, record, 3);
+    REPORTER_ASSERT(r, 2 * sizeof(glyphs) == text->byteLength);
+    REPORTER_ASSERT(r, pos[2] == text->pos[5]);
+    assert_type<SkRecords::NoOp>(r, record, 4);
+    assert_type<SkRecords::DrawPosText>(r, record, 5);
+    assert_type<SkRecords::DrawPosText>(r, record, 6);
+}
+
+// Merged draws must play back exactly as they were drawn, scaled or not.
+DEF_TEST(RecordOpts_MergeDrawsPixels, r) {
+    auto drawScene = [](SkCanvas* canvas) {
+        SkRandom rand;
+        SkPaint textPaint, pointPaint;
+        textPaint.setAntiAlias(true);
+        textPaint.setColor(0x80102030);
+        textPaint.setTextSize(12);
+        pointPaint.setAntiAlias(true);
+        pointPaint.setColor(0xC0FF8000);
+        pointPaint.setStrokeWidth(3);
+        pointPaint.setStrokeCap(SkPaint::kRound_Cap);
+
+        // These points miss the rect by a pixel, but overlap it once scaled down.
+        SkPaint rectPaint;
+        rectPaint.setAntiAlias(true);
+        rectPaint.setColor(0x800000FF);
+        const SkPoint near[] = { { 5, 15 }, { 33.5f, 15 } };
+        canvas->drawPoints(SkCanvas::kPoints_PointMode, 1, &near[0], pointPaint);
+        canvas->drawRect(SkRect::MakeLTRB(20, 10, 30.5f, 20), rectPaint);
+        canvas->drawPoints(SkCanvas::kPoints_PointMode, 1, &near[1], pointPaint);
+
+        for (int i = 0; i < 200; i++) {
+            const SkScalar x = rand.nextRangeScalar(0, 200),
+                           y = rand.nextRangeScalar(10, 200);
+            SkPoint pos[5];
+            for (int j = 0; j < 5; j++) {
+                pos[j].set(x + 7 * j, y);
+            }
+            switch (rand.nextULessThan(3)) {
+                case 0: canvas->drawPosText("Skia!", 5, pos, textPaint); break;
+                case 1: canvas->drawPoints(SkCanvas::kPoints_PointMode, 5, pos, pointPaint);
+                        break;
+                case 2: {
+                    SkPaint rectPaint;
+                    rectPaint.setColor(rand.nextU() | 0x40000000);
+                    canvas->drawRect(SkRect::MakeXYWH(x, y, 10, 10), rectPaint);
+                } break;
+            }
+        }
+    };
+
+    SkPictureRecorder pictureRecorder;
+    drawScene(pictureRecorder.beginRecording(256, 256));
+    sk_sp<SkPicture> picture = pictureRecorder.finishRecordingAsPicture();
+    REPORTER_ASSERT(r, picture->approximateOpCount() < 200);
+
+    for (SkScalar scale : { 1.0f, 0.4f }) {
+        SkBitmap expected, actual;
+        expected.allocN32Pixels(256, 256);
+        actual.allocN32Pixels(256, 256);
+        expected.eraseColor(SK_ColorWHITE);
+        actual.eraseColor(SK_ColorWHITE);
+
+        SkCanvas expectedCanvas(expected);
+        expectedCanvas.scale(scale, scale);
+        drawScene(&expectedCanvas);
+
+        SkCanvas actualCanvas(actual);
+        actualCanvas.scale(scale, scale);
+        actualCanvas.drawPicture(picture);
+
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.getSize()));
+    }
+}
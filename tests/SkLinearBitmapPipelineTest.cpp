@@ -9,6 +9,7 @@
 #include <array>
 #include <tuple>
 #include <vector>
+#include "SkBitmap.h"
 #include "SkLinearBitmapPipeline.h"
 #include "SkColor.h"
 #include "SkNx.h"
@@ -255,3 +256,78 @@ DEF_TEST(LBPStrategyRepeatTile, reporter) {
 #endif
 }
 */
+
+static bool close_enough(const SkPM4f& a, const SkPM4f& b, float tolerance) {
+    for (int i = 0; i < 4; i++) {
+        if (SkScalarAbs(a.fVec[i] - b.fVec[i]) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Nearest neighbor sampling of the opaque 16 and 8 bit sources must give back their own colors.
+DEF_TEST(LBPOpaqueSources, reporter) {
+    const int kWidth = 7, kHeight = 5;
+    for (SkColorType colorType : { kRGB_565_SkColorType, kGray_8_SkColorType }) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(SkImageInfo::Make(kWidth, kHeight, colorType, kOpaque_SkAlphaType));
+        for (int y = 0; y < kHeight; y++) {
+            for (int x = 0; x < kWidth; x++) {
+                if (kRGB_565_SkColorType == colorType) {
+                    *bitmap.getAddr16(x, y) = SkPackRGB16(4 * x + y, 9 * y + x, 31 - 3 * x);
+                } else {
+                    *bitmap.getAddr8(x, y) = SkToU8(37 * x + 11 * y);
+                }
+            }
+        }
+        SkPixmap pixmap;
+        bitmap.peekPixels(&pixmap);
+
+        SkLinearBitmapPipeline pipeline{SkMatrix::I(), kNone_SkFilterQuality,
+                                        SkShader::kClamp_TileMode, SkShader::kClamp_TileMode,
+                                        1.0f, pixmap};
+        SkPM4f row[kWidth];
+        for (int y = 0; y < kHeight; y++) {
+            pipeline.shadeSpan4f(0, y, row, kWidth);
+            for (int x = 0; x < kWidth; x++) {
+                SkPM4f expected = SkPM4f::FromPMColor(SkPreMultiplyColor(bitmap.getColor(x, y)));
+                REPORTER_ASSERT_MESSAGE(reporter, close_enough(row[x], expected, 1 / 255.0f),
+                                        SkStringPrintf("color type %d at (%d, %d)",
+                                                       colorType, x, y));
+            }
+        }
+    }
+}
+
+// The bicubic filter's weights add up to one, so a source of one color gives back that color
+// everywhere, including where its taps run off the edges and get tiled.
+DEF_TEST(LBPBicubicUniform, reporter) {
+    const int kSize = 5;
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(kSize, kSize);
+    bitmap.eraseColor(SkColorSetARGB(0xC0, 0x40, 0x80, 0x20));
+    SkPixmap pixmap;
+    bitmap.peekPixels(&pixmap);
+    const SkPM4f expected = SkPM4f::FromPMColor(*bitmap.getAddr32(0, 0));
+
+    SkMatrix inverse;
+    inverse.setRotate(30);
+    inverse.postScale(0.37f, 0.41f);
+    inverse.postTranslate(-1.3f, 0.7f);
+    for (auto tile : { SkShader::kClamp_TileMode,
+                       SkShader::kRepeat_TileMode,
+                       SkShader::kMirror_TileMode }) {
+        SkLinearBitmapPipeline pipeline{inverse, kHigh_SkFilterQuality, tile, tile, 1.0f, pixmap};
+        const int kCount = 23;
+        SkPM4f row[kCount];
+        for (int y = -3; y < 2 * kSize; y++) {
+            pipeline.shadeSpan4f(-3, y, row, kCount);
+            for (int x = 0; x < kCount; x++) {
+                REPORTER_ASSERT_MESSAGE(reporter, close_enough(row[x], expected, 1e-5f),
+                                        SkStringPrintf("tile mode %d at (%d, %d)",
+                                                       tile, x - 3, y));
+            }
+        }
+    }
+}
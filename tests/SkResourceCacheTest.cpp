@@ -10,10 +10,12 @@
 #include "SkCanvas.h"
 #include "SkDiscardableMemoryPool.h"
 #include "SkGraphics.h"
+#include "SkMutex.h"
 #include "SkPicture.h"
 #include "SkPictureRecorder.h"
 #include "SkResourceCache.h"
 #include "SkSurface.h"
+#include "SkTaskGroup.h"
 #include "SkTypes.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -327,3 +329,61 @@ DEF_TEST(BitmapCache_discarded_image, reporter) {
         });
     }
 }
+
+namespace {
+static int gThreadedNamespace;
+
+struct ThreadedKey : public SkResourceCache::Key {
+    int32_t fThread, fIndex;
+
+    ThreadedKey(int thread, int index) : fThread(thread), fIndex(index) {
+        this->init(&gThreadedNamespace, 0, sizeof(fThread) + sizeof(fIndex));
+    }
+};
+
+struct ThreadedRec : public SkResourceCache::Rec {
+    ThreadedKey fKey;
+
+    ThreadedRec(const ThreadedKey& key) : fKey(key) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this); }
+    const char* getCategory() const override { return "threaded-test"; }
+
+    static bool Visitor(const SkResourceCache::Rec& rec, void* context) {
+        *(int32_t*)context = static_cast<const ThreadedRec&>(rec).fKey.fIndex;
+        return true;
+    }
+};
+}  // namespace
+
+// Adds and Finds from several threads at once, each behind the lock a shard of the global cache
+// would hold, should find only what was added under the same key.  This drives a private cache so
+// no other test can purge it underneath us.
+DEF_TEST(ResourceCache_threaded, reporter) {
+    const int kThreads = 8,
+              kRecs    = 200;
+    SkResourceCache cache(kThreads * kRecs * sizeof(ThreadedRec) * 2);
+    SkMutex mutex;
+    SkAtomic<int32_t> misses(0);
+
+    SkTaskGroup().batch(kThreads, [&](int thread) {
+        for (int i = 0; i < kRecs; i++) {
+            SkAutoMutexAcquire am(mutex);
+            cache.add(new ThreadedRec(ThreadedKey(thread, i)));
+        }
+        for (int i = 0; i < kRecs; i++) {
+            int32_t found = -1;
+            SkAutoMutexAcquire am(mutex);
+            if (!cache.find(ThreadedKey(thread, i), ThreadedRec::Visitor, &found) || found != i) {
+                misses.fetch_add(1);
+            }
+        }
+    });
+    REPORTER_ASSERT(reporter, 0 == misses.load());
+    REPORTER_ASSERT(reporter,
+                    cache.getTotalBytesUsed() == kThreads * kRecs * sizeof(ThreadedRec));
+
+    int32_t found;
+    REPORTER_ASSERT(reporter, !cache.find(ThreadedKey(kThreads, 0), ThreadedRec::Visitor, &found));
+}
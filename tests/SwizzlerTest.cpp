@@ -5,10 +5,12 @@
  * found in the LICENSE file.
  */
 
+#include "SkCodecPriv.h"
 #include "SkSwizzle.h"
 #include "SkSwizzler.h"
 #include "Test.h"
 #include "SkOpts.h"
+#include "SkRandom.h"
 
 // These are the values that we will look for to indicate that the fill was successful
 static const uint8_t kFillIndex = 0x11;
@@ -159,6 +161,182 @@ DEF_TEST(SwizzleOpts, r) {
     REPORTER_ASSERT(r, dst == 0xFA04ADCA);
 }
 
+DEF_TEST(SwizzleOpts_LongRuns, r) {
+    // Wider CPU tiers swizzle 8 or 16 pixels at a time; exercise those loops and their tails.
+    SkRandom rand;
+    uint32_t src[67], dst[67];
+    for (uint32_t& px : src) {
+        px = rand.nextU();
+    }
+
+    for (int count = 0; count <= 67; count++) {
+        SkOpts::RGBA_to_BGRA(dst, src, count);
+        for (int i = 0; i < count; i++) {
+            uint32_t expected;
+            SkOpts::RGBA_to_BGRA(&expected, src + i, 1);
+            REPORTER_ASSERT(r, dst[i] == expected);
+        }
+
+        SkOpts::RGBA_to_rgbA(dst, src, count);
+        for (int i = 0; i < count; i++) {
+            uint32_t expected;
+            SkOpts::RGBA_to_rgbA(&expected, src + i, 1);
+            REPORTER_ASSERT(r, dst[i] == expected);
+        }
+
+        SkOpts::RGBA_to_bgrA(dst, src, count);
+        for (int i = 0; i < count; i++) {
+            uint32_t expected;
+            SkOpts::RGBA_to_bgrA(&expected, src + i, 1);
+            REPORTER_ASSERT(r, dst[i] == expected);
+        }
+    }
+}
+
+DEF_TEST(SwizzleOpts_Opaque, r) {
+    SkRandom rand;
+    uint32_t src[67], dst[67];
+    uint16_t dst565[67];
+    for (uint32_t& px : src) {
+        px = rand.nextU();
+    }
+    const uint8_t* bytes = (const uint8_t*)src;
+
+    for (int count = 0; count <= 67; count++) {
+        SkOpts::RGBX_to_RGB1(dst, src, count);
+        for (int i = 0; i < count; i++) {
+            REPORTER_ASSERT(r, dst[i] == (src[i] | 0xFF000000));
+        }
+
+        SkOpts::RGBX_to_BGR1(dst, src, count);
+        for (int i = 0; i < count; i++) {
+            uint32_t expected;
+            SkOpts::RGBA_to_BGRA(&expected, src + i, 1);
+            REPORTER_ASSERT(r, dst[i] == (expected | 0xFF000000));
+        }
+
+        SkOpts::RGB_to_RGB1(dst, bytes, count);
+        for (int i = 0; i < count; i++) {
+            const uint8_t* rgb = bytes + 3*i;
+            REPORTER_ASSERT(r, dst[i] == (0xFF000000 | rgb[2] << 16 | rgb[1] << 8 | rgb[0]));
+        }
+
+        SkOpts::RGB_to_BGR1(dst, bytes, count);
+        for (int i = 0; i < count; i++) {
+            const uint8_t* rgb = bytes + 3*i;
+            REPORTER_ASSERT(r, dst[i] == (0xFF000000 | rgb[0] << 16 | rgb[1] << 8 | rgb[2]));
+        }
+
+        SkOpts::gray_to_RGB1(dst, bytes, count);
+        for (int i = 0; i < count; i++) {
+            REPORTER_ASSERT(r, dst[i] == (0xFF000000 | bytes[i] * 0x010101));
+        }
+
+        SkOpts::PMColor_to_565(dst565, src, count);
+        for (int i = 0; i < count; i++) {
+            REPORTER_ASSERT(r, dst565[i] == SkPixel32ToPixel16(src[i]));
+        }
+    }
+}
+
+// What every SkSwizzler RowProc should produce for one source pixel.
+static SkPMColor expected_n32(SkSwizzler::SrcConfig sc, const uint8_t* p, SkAlphaType at,
+                              const SkPMColor ctable[]) {
+    auto pack = [at](U8CPU a, U8CPU r, U8CPU g, U8CPU b) {
+        return kPremul_SkAlphaType == at ? SkPremultiplyARGBInline(a, r, g, b)
+                                         : SkPackARGB32NoCheck(a, r, g, b);
+    };
+    switch (sc) {
+        case SkSwizzler::kGray:      return pack(0xFF, p[0], p[0], p[0]);
+        case SkSwizzler::kGrayAlpha: return pack(p[1], p[0], p[0], p[0]);
+        case SkSwizzler::kIndex:     return ctable[p[0]];
+        case SkSwizzler::kRGB:       return pack(0xFF, p[0], p[1], p[2]);
+        case SkSwizzler::kBGR:
+        case SkSwizzler::kBGRX:      return pack(0xFF, p[2], p[1], p[0]);
+        case SkSwizzler::kRGBA:      return pack(p[3], p[0], p[1], p[2]);
+        case SkSwizzler::kBGRA:      return pack(p[3], p[2], p[1], p[0]);
+        case SkSwizzler::kCMYK:      return pack(0xFF, SkMulDiv255Round(p[0], p[3]),
+                                                       SkMulDiv255Round(p[1], p[3]),
+                                                       SkMulDiv255Round(p[2], p[3]));
+        default:
+            SkASSERT(false);
+            return 0;
+    }
+}
+
+// Swizzled rows match the pixel-at-a-time formulas, whether or not we sample or subset them.
+DEF_TEST(SwizzlerRowProcs, r) {
+    const SkSwizzler::SrcConfig configs[] = {
+        SkSwizzler::kGray, SkSwizzler::kGrayAlpha, SkSwizzler::kIndex, SkSwizzler::kRGB,
+        SkSwizzler::kBGR, SkSwizzler::kBGRX, SkSwizzler::kRGBA, SkSwizzler::kBGRA,
+        SkSwizzler::kCMYK,
+    };
+    const SkColorType colorTypes[] = { kN32_SkColorType, kRGB_565_SkColorType };
+    const SkAlphaType alphaTypes[] = { kPremul_SkAlphaType, kUnpremul_SkAlphaType };
+    const SkCodec::ZeroInitialized zeroInits[] = {
+        SkCodec::kNo_ZeroInitialized, SkCodec::kYes_ZeroInitialized,
+    };
+
+    // Long enough for a few chunks of gathered pixels, even when sampling.
+    const int kWidth = 1000;
+    SkRandom rand;
+    SkAutoTMalloc<uint8_t> src(kWidth * 4);
+    for (int i = 0; i < kWidth * 4; i++) {
+        src[i] = rand.nextU();
+    }
+    // Start with a run of zeros, for the swizzlers that skip them.
+    memset(src.get(), 0, 37);
+    SkPMColor ctable[256];
+    for (SkPMColor& c : ctable) {
+        c = rand.nextU();
+    }
+
+    SkAutoTMalloc<uint32_t> dst(kWidth);
+    SkIRect subset = SkIRect::MakeLTRB(13, 0, kWidth - 7, 1);
+    for (SkSwizzler::SrcConfig sc : configs)
+    for (SkColorType ct : colorTypes)
+    for (SkAlphaType at : alphaTypes)
+    for (SkCodec::ZeroInitialized zeroInit : zeroInits)
+    for (SkIRect* subsetPtr : { (SkIRect*)nullptr, &subset })
+    for (int sampleX : { 1, 2, 3, 5 }) {
+        // Only opaque sources swizzle to 565.
+        if (kRGB_565_SkColorType == ct && (SkSwizzler::kGrayAlpha == sc ||
+                                           SkSwizzler::kRGBA == sc || SkSwizzler::kBGRA == sc)) {
+            continue;
+        }
+        const SkImageInfo info = SkImageInfo::Make(kWidth, 1, ct, at);
+        SkCodec::Options options;
+        options.fZeroInitialized = zeroInit;
+        options.fSubset = subsetPtr;
+        SkAutoTDelete<SkSwizzler> swizzler(
+                SkSwizzler::CreateSwizzler(sc, ctable, info, options));
+        if (!swizzler) {
+            continue;
+        }
+        const int width = swizzler->setSampleX(sampleX);
+
+        memset(dst.get(), 0, kWidth * sizeof(uint32_t));
+        swizzler->swizzle(dst.get(), src.get());
+
+        const int bpp = SkSwizzler::BytesPerPixel(sc);
+        const int left = subsetPtr ? subsetPtr->left() : 0;
+        for (int x = 0; x < width; x++) {
+            const uint8_t* p = src.get() + (left + get_start_coord(sampleX) + x * sampleX) * bpp;
+            SkPMColor expected = expected_n32(sc, p, at, ctable);
+            if (kRGB_565_SkColorType == ct) {
+                if (((const uint16_t*)dst.get())[x] != SkPixel32ToPixel16(expected)) {
+                    ERRORF(r, "config %d to 565, sampleX %d: pixel %d is wrong", sc, sampleX, x);
+                    break;
+                }
+            } else if (dst[x] != expected) {
+                ERRORF(r, "config %d to n32, alpha type %d, sampleX %d: pixel %d is %08x not %08x",
+                       sc, at, sampleX, x, dst[x], expected);
+                break;
+            }
+        }
+    }
+}
+
 DEF_TEST(PublicSwizzleOpts, r) {
     uint32_t dst, src;
 
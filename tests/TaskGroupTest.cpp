@@ -0,0 +1,66 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkAtomics.h"
+#include "SkTaskGroup.h"
+#include "SkTDArray.h"
+#include "Test.h"
+
+DEF_TEST(SkTaskGroup_Batch, r) {
+    static const int N = 10000;
+    SkAtomic<int32_t> hits[N];
+    for (int i = 0; i < N; i++) {
+        hits[i].store(0);
+    }
+
+    SkTaskGroup tg;
+    tg.batch(N, [&](int i) { hits[i].fetch_add(1); });
+    tg.wait();
+
+    for (int i = 0; i < N; i++) {
+        REPORTER_ASSERT(r, 1 == hits[i].load());
+    }
+}
+
+DEF_TEST(SkTaskGroup_Nested, r) {
+    // Tasks that themselves add tasks and wait() on them must not deadlock,
+    // however few threads we have.
+    SkAtomic<int32_t> count(0);
+
+    SkTaskGroup outer;
+    for (int i = 0; i < 64; i++) {
+        outer.add([&] {
+            SkTaskGroup inner;
+            inner.batch(64, [&](int) {
+                SkTaskGroup innermost;
+                innermost.add([&] { count.fetch_add(1); });
+                innermost.wait();
+            });
+            inner.wait();
+        });
+    }
+    outer.wait();
+
+    REPORTER_ASSERT(r, 64*64 == count.load());
+}
+
+DEF_TEST(SkTaskGroup_ParallelFor, r) {
+    const int grains[] = { -1, 0, 1, 7, 100, 5000 };
+    for (int grain : grains) {
+        for (int N : { 0, 1, 13, 4096 }) {
+            SkTDArray<int> hits;
+            hits.setCount(N);
+            sk_bzero(hits.begin(), hits.bytes());
+
+            sk_parallel_for(N, grain, [&](int i) { hits[i]++; });
+
+            for (int i = 0; i < N; i++) {
+                REPORTER_ASSERT(r, 1 == hits[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCanvas.h"
+#include "SkGradientShader.h"
+#include "SkPath.h"
+#include "SkRandom.h"
+#include "SkTiledRasterDraw.h"
+#include "Test.h"
+
+static void draw_scene(SkCanvas* canvas, int w, int h) {
+    SkRandom rand;
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    const SkPoint pts[] = { { 0, 0 }, { SkIntToScalar(w), SkIntToScalar(h) } };
+    const SkColor colors[] = { SK_ColorRED, SK_ColorBLUE };
+    paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                 SkShader::kClamp_TileMode));
+    canvas->drawPaint(paint);
+    paint.setShader(nullptr);
+
+    for (int i = 0; i < 200; i++) {
+        paint.setColor(rand.nextU() | 0x80000000);
+        SkScalar x = rand.nextRangeScalar(-20, SkIntToScalar(w)),
+                 y = rand.nextRangeScalar(-20, SkIntToScalar(h));
+        switch (i % 3) {
+            case 0:
+                canvas->drawRect(SkRect::MakeXYWH(x, y, rand.nextRangeScalar(1, 60),
+                                                        rand.nextRangeScalar(1, 60)), paint);
+                break;
+            case 1:
+                canvas->drawCircle(x, y, rand.nextRangeScalar(1, 40), paint);
+                break;
+            default: {
+                SkPath path;
+                path.moveTo(x, y);
+                path.quadTo(x + 50, y - 30, x + 70, y + 40);
+                path.lineTo(x - 10, y + 25);
+                canvas->drawPath(path, paint);
+            }
+        }
+    }
+
+    canvas->saveLayerAlpha(nullptr, 0x80);
+    canvas->rotate(15);
+    paint.setColor(SK_ColorGREEN);
+    canvas->drawRect(SkRect::MakeXYWH(SkIntToScalar(w/4), SkIntToScalar(h/4),
+                                      SkIntToScalar(w/2), SkIntToScalar(h/2)), paint);
+    canvas->restore();
+}
+
+DEF_TEST(TiledRasterDraw_MatchesSerial, r) {
+    const int w = 301, h = 257;
+
+    SkBitmap serial;
+    serial.allocN32Pixels(w, h);
+    serial.eraseColor(SK_ColorTRANSPARENT);
+    {
+        SkCanvas canvas(serial);
+        draw_scene(&canvas, w, h);
+    }
+
+    const int tileSizes[] = { 1000, 64, 37 };
+    for (int tileSize : tileSizes) {
+        SkBitmap tiled;
+        tiled.allocN32Pixels(w, h);
+        tiled.eraseColor(SK_ColorTRANSPARENT);
+
+        SkTiledRasterDraw tiledDraw(tiled, tileSize, tileSize);
+        draw_scene(tiledDraw.getRecordingCanvas(), w, h);
+        tiledDraw.draw();
+
+        REPORTER_ASSERT(r, tiledDraw.tileTimesMS().count() == tiledDraw.tileCount());
+
+        SkIRect covered = SkIRect::MakeEmpty();
+        for (int i = 0; i < tiledDraw.tileCount(); i++) {
+            covered.join(tiledDraw.tileBounds(i));
+        }
+        REPORTER_ASSERT(r, covered == SkIRect::MakeWH(w, h));
+
+        bool same = true;
+        for (int y = 0; y < h && same; y++) {
+            same = 0 == memcmp(serial.getAddr32(0, y), tiled.getAddr32(0, y), w * 4);
+        }
+        REPORTER_ASSERT(r, same);
+    }
+}
+
+DEF_TEST(TiledRasterDraw_Reset, r) {
+    SkBitmap bm;
+    bm.allocN32Pixels(64, 64);
+    bm.eraseColor(SK_ColorWHITE);
+
+    SkTiledRasterDraw tiledDraw(bm, 16, 16);
+    REPORTER_ASSERT(r, 16 == tiledDraw.tileCount());
+
+    tiledDraw.getRecordingCanvas()->drawColor(SK_ColorBLACK);
+    tiledDraw.reset();
+    tiledDraw.draw();  // Nothing recorded, nothing drawn.
+    REPORTER_ASSERT(r, SK_ColorWHITE == bm.getColor(10, 10));
+
+    tiledDraw.getRecordingCanvas()->drawColor(SK_ColorBLACK);
+    tiledDraw.draw();
+    REPORTER_ASSERT(r, SK_ColorBLACK == bm.getColor(10, 10));
+    REPORTER_ASSERT(r, SK_ColorBLACK == bm.getColor(63, 63));
+}
@@ -5,11 +5,14 @@
  * found in the LICENSE file.
  */
 
+#include "ProcStats.h"
 #include "SkCommandLineFlags.h"
+#include "SkData.h"
 #include "SkPicture.h"
 #include "SkPictureData.h"
 #include "SkStream.h"
 #include "SkFontDescriptor.h"
+#include "SkTime.h"
 
 DEFINE_string2(input, i, "", "skp on which to report");
 DEFINE_bool2(version, v, true, "version");
@@ -17,6 +20,7 @@ DEFINE_bool2(cullRect, c, true, "cullRect");
 DEFINE_bool2(flags, f, true, "flags");
 DEFINE_bool2(tags, t, true, "tags");
 DEFINE_bool2(quiet, q, false, "quiet");
+DEFINE_bool2(load, l, false, "load the picture, reporting load time and peak RSS");
 
 // This tool can print simple information about an SKP but its main use
 // is just to check if an SKP has been truncated during the recording
@@ -87,12 +91,32 @@ int tool_main(int argc, char** argv) {
         SkDebugf("\n");
     }
 
+    if (FLAGS_load) {
+        const double start = SkTime::GetMSecs();
+        sk_sp<SkPicture> picture(SkPicture::MakeFromData(SkData::MakeFromFileName(FLAGS_input[0])));
+        const double loadMs = SkTime::GetMSecs() - start;
+        if (!picture) {
+            if (!FLAGS_quiet) {
+                SkDebugf("Couldn't load picture\n");
+            }
+            return kInvalidTag;
+        }
+        if (!FLAGS_quiet) {
+            SkDebugf("Load: %.2fms, %d ops, peak RSS %dMB\n",
+                     loadMs, picture->approximateOpCount(), sk_tools::getMaxResidentSetSizeMB());
+        }
+    }
+
     if (!stream.readBool()) {
         // If we read true there's a picture playback object flattened
         // in the file; if false, there isn't a playback, so we're done
         // reading the file.
         return kSuccess;
     }
+    if (info.fVersion >= 46 && stream.skip(3) != 3) {
+        // Padding after the bool, so the ops are aligned.
+        return kTruncatedFile;
+    }
 
     for (;;) {
         uint32_t tag = stream.readU32();